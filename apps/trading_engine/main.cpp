@@ -1,24 +1,49 @@
 #include "trading/core/matching_engine.hpp"
 #include "trading/core/order.hpp"
+#include "trading/core/order_request.hpp"
+#include "trading/core/order_state_store.hpp"
 #include "trading/core/orderbook.hpp"
 #include "trading/execution/executor.hpp"
+#include "trading/execution/simulated_venue.hpp"
 #include "trading/logging/app_logger.hpp"
 #include "trading/logging/trade_logger.hpp"
+#include "trading/messaging/inprocess_transport.hpp"
+#include "trading/messaging/kafka_transport.hpp"
 #include "trading/messaging/queue_client.hpp"
+#include "trading/messaging/shm_transport.hpp"
+#include "trading/network/body_writer.hpp"
 #include "trading/network/http_server.hpp"
+#include "trading/network/websocket_hub.hpp"
 #include "trading/statistics/statistics_collector.hpp"
+#include "trading/utils/clock.hpp"
+#include "trading/utils/completion_registry.hpp"
 #include "trading/utils/config.hpp"
+#include "trading/utils/journal.hpp"
+#include "trading/utils/sequenced_ring.hpp"
+#include "trading/utils/snapshot.hpp"
+#include "trading/utils/task.hpp"
+#include "trading/utils/version_counter.hpp"
 #include "trading/validation/order_validator.hpp"
+#include "trading/validation/rate_limiter.hpp"
 #include "../json.hpp"
 using json = nlohmann::json;
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <signal.h>
 
 namespace {
@@ -39,6 +64,332 @@ trading::core::OrderSide stringToOrderSide(const std::string& side_str) {
         return trading::core::OrderSide::SELL;
     throw std::invalid_argument("Invalid order side string: " + side_str);
 }
+
+template <size_t N>
+void setRequestField(char (&field)[N], const nlohmann::json& body, const char* name) {
+    if (!trading::core::OrderRequest::setField(field, body.at(name).get<std::string>())) {
+        throw std::invalid_argument("Field '" + std::string(name) + "' is too long");
+    }
+}
+
+// Decodes a new-order or amend request body into the fixed-size form the matcher consumes
+trading::core::OrderRequest decodeOrderRequest(const nlohmann::json& body) {
+    using trading::core::OrderRequest;
+    using trading::core::OrderType;
+
+    OrderRequest request;
+    setRequestField(request.id, body, "id");
+    setRequestField(request.user_id, body, "userId");
+    setRequestField(request.symbol, body, "symbol");
+
+    if (body.contains("action") && body["action"] == "amend") {
+        request.action = OrderRequest::Action::AMEND;
+        if (body.contains("quantity")) {
+            request.has_quantity = true;
+            request.quantity = body.at("quantity").get<double>();
+        }
+        if (body.contains("price")) {
+            request.has_price = true;
+            request.price = body.at("price").get<double>();
+        }
+        return request;
+    }
+
+    request.type = stringToOrderType(body.at("type"));
+    request.side = stringToOrderSide(body.at("side"));
+    request.has_quantity = true;
+    request.quantity = body.at("quantity").get<double>();
+    if (request.type == OrderType::LIMIT || request.type == OrderType::STOP) {
+        request.has_price = true;
+        request.price = body.at("price").get<double>();
+    }
+
+    // Optional good-till-time expiry for limit orders, in epoch milliseconds
+    if (request.type == OrderType::LIMIT && body.contains("expireAt")) {
+        request.has_expiry = true;
+        request.expire_at_ms = body.at("expireAt").get<int64_t>();
+    }
+    return request;
+}
+
+// Outcome of one order-entry request, reported back to the HTTP thread that submitted it
+struct OrderResult {
+    std::string status;  // RESTED, PARTIALLY_FILLED, FILLED, CANCELLED, ACCEPTED, AMENDED, REJECTED
+    std::string reason;  // Why the request was rejected or its remainder cancelled
+    double filled_quantity = 0.0;
+    double remaining_quantity = 0.0;
+    std::vector<trading::core::Trade> fills;
+};
+
+OrderResult rejectedResult(const std::string& reason) {
+    OrderResult result;
+    result.status = "REJECTED";
+    result.reason = reason;
+    return result;
+}
+
+// Queue payloads starting with this byte carry a batch of raw OrderRequest records instead of
+// one JSON order; JSON never starts with it
+constexpr char kOrderBatchMarker = '\x01';
+constexpr const char* kOrderBatchContentType = "application/x-order-batch";
+
+// Header names keep the client's casing
+std::string headerValue(const trading::network::HttpRequest& request, std::string_view name) {
+    for (const auto& [key, value] : request.headers) {
+        if (key.size() == name.size() &&
+            std::equal(key.begin(), key.end(), name.begin(), [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) ==
+                       std::tolower(static_cast<unsigned char>(b));
+            })) {
+            return value;
+        }
+    }
+    return "";
+}
+
+// True if an If-None-Match header value lists etag (or is "*"). Weak comparison, as RFC 9110
+// prescribes for If-None-Match.
+bool etagMatches(std::string_view if_none_match, std::string_view etag) {
+    while (!if_none_match.empty()) {
+        const size_t comma = if_none_match.find(',');
+        std::string_view candidate = if_none_match.substr(0, comma);
+        while (!candidate.empty() && std::isspace(static_cast<unsigned char>(candidate.front()))) {
+            candidate.remove_prefix(1);
+        }
+        while (!candidate.empty() && std::isspace(static_cast<unsigned char>(candidate.back()))) {
+            candidate.remove_suffix(1);
+        }
+        if (candidate.starts_with("W/")) {
+            candidate.remove_prefix(2);
+        }
+        if (candidate == "*" || candidate == etag) {
+            return true;
+        }
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        if_none_match.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+// Checks an OrderRequest record received as raw bytes before it is copied into one: enum and
+// bool bytes in range and every string NUL-terminated. A bool byte other than 0 or 1 must never
+// be read as a bool, so the fields are checked in place rather than after the copy.
+bool isWellFormed(const char* record) {
+    using trading::core::OrderRequest;
+    using trading::core::OrderSide;
+    using trading::core::OrderType;
+    static_assert(sizeof(OrderRequest::Action) == 1 && sizeof(OrderType) == 1 &&
+                      sizeof(OrderSide) == 1 && sizeof(bool) == 1,
+                  "isWellFormed reads enums and bools as single bytes");
+
+    const auto byte = [record](size_t offset) { return static_cast<uint8_t>(record[offset]); };
+    const auto terminated = [record](size_t offset, size_t size) {
+        return std::memchr(record + offset, '\0', size) != nullptr;
+    };
+    return byte(offsetof(OrderRequest, action)) ==
+               static_cast<uint8_t>(OrderRequest::Action::NEW) &&
+           byte(offsetof(OrderRequest, type)) <= static_cast<uint8_t>(OrderType::STOP) &&
+           byte(offsetof(OrderRequest, side)) <= static_cast<uint8_t>(OrderSide::SELL) &&
+           byte(offsetof(OrderRequest, has_quantity)) <= 1 &&
+           byte(offsetof(OrderRequest, has_price)) <= 1 &&
+           byte(offsetof(OrderRequest, has_expiry)) <= 1 &&
+           terminated(offsetof(OrderRequest, id), sizeof(OrderRequest::id)) &&
+           terminated(offsetof(OrderRequest, user_id), sizeof(OrderRequest::user_id)) &&
+           terminated(offsetof(OrderRequest, symbol), sizeof(OrderRequest::symbol));
+}
+
+// Streaming channels are "<kind>.<symbol or userId>"
+bool isStreamChannel(const std::string& channel) {
+    const size_t dot = channel.find('.');
+    if (dot == std::string::npos || dot + 1 == channel.size()) {
+        return false;
+    }
+    const std::string_view kind(channel.data(), dot);
+    return kind == "trades" || kind == "book" || kind == "depth" || kind == "orders";
+}
+
+nlohmann::json topOfBookJson(const std::vector<trading::core::DepthLevel>& bids,
+                             const std::vector<trading::core::DepthLevel>& asks) {
+    return nlohmann::json{{"best_bid", bids.empty() ? 0.0 : bids.front().price},
+                          {"bid_quantity", bids.empty() ? 0.0 : bids.front().quantity},
+                          {"best_ask", asks.empty() ? 0.0 : asks.front().price},
+                          {"ask_quantity", asks.empty() ? 0.0 : asks.front().quantity}};
+}
+
+nlohmann::json depthJson(const std::vector<trading::core::DepthLevel>& levels) {
+    nlohmann::json result = nlohmann::json::array();
+    for (const auto& level : levels) {
+        result.push_back({{"price", level.price}, {"quantity", level.quantity}});
+    }
+    return result;
+}
+
+// Per-thread output buffer for response bodies: the body is copied out at the end, and the
+// buffer keeps the capacity of the largest response the worker has written
+std::string& responseBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+// Market data bodies written straight from the engine's structures, in any response encoding
+void writeBucket(trading::network::BodyWriter& writer,
+                 const trading::statistics::OHLCVBucket& bucket) {
+    writer.beginMap(10)
+        .field("open", bucket.open)
+        .field("high", bucket.high)
+        .field("low", bucket.low)
+        .field("close", bucket.close)
+        .field("volume", bucket.volume)
+        .field("dollar_volume", bucket.dollar_volume)
+        .field("simple_return", bucket.simple_return)
+        .field("volatility", bucket.volatility)
+        .field("trade_count", bucket.trade_count)
+        .field("vwap", bucket.getVWAP())
+        .endMap();
+}
+
+void writeInstrumentStats(trading::network::BodyWriter& writer,
+                          const trading::statistics::InstrumentStats& stats) {
+    writer.beginMap(3)
+        .field("symbol", stats.symbol)
+        .field("last_trade_price", stats.last_trade_price)
+        .key("timeframes")
+        .beginMap(stats.timeframes.size());
+    for (const auto& [timeframe, bucket] : stats.timeframes) {
+        writer.key(timeframe);
+        writeBucket(writer, bucket);
+    }
+    writer.endMap().endMap();
+}
+
+// Order ids are only unique per user
+std::string completionKey(std::string_view user_id, std::string_view order_id) {
+    std::string key;
+    key.reserve(user_id.size() + order_id.size() + 1);
+    key.append(user_id).append(1, '/').append(order_id);
+    return key;
+}
+
+// The settings that can change while the engine runs. A reload parses and checks all of them
+// before applying any, so an invalid file changes nothing; applying them is per component.
+struct RuntimeConfig {
+    trading::validation::OrderValidator::Limits validation;
+    bool rate_limit_enabled = false;
+    trading::validation::RateLimiter::Config rate_limit;
+    double consumer_burst_multiplier = 2.0;
+    trading::logging::LogLevel log_level = trading::logging::LogLevel::INFO;
+};
+
+const char* logLevelName(trading::logging::LogLevel level) {
+    switch (level) {
+        case trading::logging::LogLevel::DEBUG:
+            return "DEBUG";
+        case trading::logging::LogLevel::INFO:
+            return "INFO";
+        case trading::logging::LogLevel::WARNING:
+            return "WARNING";
+        case trading::logging::LogLevel::ERROR:
+        default:
+            return "ERROR";
+    }
+}
+
+// Builds the runtime settings from the config file's JSON; nullopt, with error set, if any of
+// them is malformed or inconsistent
+std::optional<RuntimeConfig> parseRuntimeConfig(const nlohmann::json& config_json,
+                                                std::string& error) {
+    RuntimeConfig config;
+    try {
+        if (config_json.contains("validation")) {
+            auto& validation_cfg = config_json["validation"];
+            auto& limits = config.validation;
+            limits.market_open = validation_cfg.value("market_open", limits.market_open);
+            limits.min_quantity = validation_cfg.value("min_quantity", limits.min_quantity);
+            limits.max_quantity = validation_cfg.value("max_quantity", limits.max_quantity);
+            limits.min_price = validation_cfg.value("min_price", limits.min_price);
+            limits.max_price = validation_cfg.value("max_price", limits.max_price);
+            if (validation_cfg.contains("valid_symbols")) {
+                limits.valid_symbols =
+                    validation_cfg["valid_symbols"].get<std::vector<std::string>>();
+            }
+            if (!(limits.min_quantity > 0.0 && limits.min_quantity <= limits.max_quantity)) {
+                error = "validation: need 0 < min_quantity <= max_quantity";
+                return std::nullopt;
+            }
+            if (!(limits.min_price > 0.0 && limits.min_price <= limits.max_price)) {
+                error = "validation: need 0 < min_price <= max_price";
+                return std::nullopt;
+            }
+        }
+
+        if (config_json.contains("rate_limit")) {
+            auto& rate_cfg = config_json["rate_limit"];
+            auto& limiter_config = config.rate_limit;
+            config.rate_limit_enabled = rate_cfg.value("enabled", false);
+            if (rate_cfg.contains("capacity"))
+                limiter_config.capacity = rate_cfg["capacity"];
+            if (rate_cfg.contains("default_tier"))
+                limiter_config.default_tier = rate_cfg["default_tier"];
+            if (rate_cfg.contains("tiers")) {
+                limiter_config.tiers.clear();
+                for (auto& [name, tier_cfg] : rate_cfg["tiers"].items()) {
+                    limiter_config.tiers[name] = trading::validation::RateLimiter::Tier(
+                        tier_cfg.value("orders_per_second", 50.0), tier_cfg.value("burst", 100.0));
+                }
+            }
+            if (rate_cfg.contains("users")) {
+                for (auto& [user_id, tier_name] : rate_cfg["users"].items()) {
+                    limiter_config.user_tiers[user_id] = tier_name.get<std::string>();
+                }
+            }
+            config.consumer_burst_multiplier =
+                rate_cfg.value("consumer_burst_multiplier", config.consumer_burst_multiplier);
+
+            if (!limiter_config.tiers.contains(limiter_config.default_tier)) {
+                error = "rate_limit: unknown default_tier " + limiter_config.default_tier;
+                return std::nullopt;
+            }
+            for (const auto& [user_id, tier_name] : limiter_config.user_tiers) {
+                if (!limiter_config.tiers.contains(tier_name)) {
+                    error = "rate_limit: unknown tier " + tier_name + " for user " + user_id;
+                    return std::nullopt;
+                }
+            }
+        }
+
+        if (config_json.contains("logging") && config_json["logging"].contains("level")) {
+            const std::string level = config_json["logging"]["level"];
+            if (level == "DEBUG") {
+                config.log_level = trading::logging::LogLevel::DEBUG;
+            } else if (level == "INFO") {
+                config.log_level = trading::logging::LogLevel::INFO;
+            } else if (level == "WARNING" || level == "WARN") {
+                config.log_level = trading::logging::LogLevel::WARNING;
+            } else if (level == "ERROR") {
+                config.log_level = trading::logging::LogLevel::ERROR;
+            } else {
+                error = "logging: unknown level " + level;
+                return std::nullopt;
+            }
+        }
+    } catch (const nlohmann::json::exception& e) {
+        error = e.what();
+        return std::nullopt;
+    }
+    return config;
+}
+
+// The limiter settings for the matcher's consumer-side check, with its burst scaled to absorb
+// queueing jitter
+trading::validation::RateLimiter::Config consumerLimiterConfig(const RuntimeConfig& config) {
+    trading::validation::RateLimiter::Config consumer_config = config.rate_limit;
+    for (auto& [name, tier] : consumer_config.tiers) {
+        tier.burst *= config.consumer_burst_multiplier;
+    }
+    return consumer_config;
+}
 }  // namespace
 
 using namespace trading;
@@ -55,6 +406,8 @@ class TradingEngine {
           http_server_(nullptr),
           queue_client_(nullptr),
           stats_collector_(nullptr),
+          trade_ring_(nullptr),
+          coarse_clock_(nullptr),
           running_(false),
           trading_active_(true),
           admin_password_(""),
@@ -85,6 +438,8 @@ class TradingEngine {
         std::string host = "0.0.0.0";
         int port = 8080;
         int threads = 4;
+        int acceptors = 1;
+        std::string backend = "blocking";
 
         if (config_json.contains("http")) {
             auto& http_config = config_json["http"];
@@ -94,16 +449,209 @@ class TradingEngine {
                 port = http_config["port"];
             if (http_config.contains("threads"))
                 threads = http_config["threads"];
+            if (http_config.contains("acceptors"))
+                acceptors = http_config["acceptors"];
+            if (http_config.contains("backend"))
+                backend = http_config["backend"];
+            if (http_config.contains("long_poll_max_wait_ms"))
+                max_long_poll_ =
+                    std::chrono::milliseconds(http_config["long_poll_max_wait_ms"].get<int>());
+            if (http_config.contains("long_poll_max_waiters"))
+                max_long_polls_ = http_config["long_poll_max_waiters"];
         }
+        etag_epoch_ = std::to_string(utils::defaultClock()->nowSeconds());
 
         http_server_ = std::make_unique<network::HttpServer>(host, port, threads);
+        http_server_->setAcceptors(acceptors);
+        if (backend == "io_uring") {
+            if (network::HttpServer::ioUringSupported()) {
+                http_server_->setBackend(network::HttpServer::Backend::IO_URING);
+            } else {
+                app_logger_->log(logging::LogLevel::WARNING,
+                                 "io_uring is not supported here; using the blocking HTTP backend");
+                backend = "blocking";
+            }
+        } else if (backend != "blocking") {
+            app_logger_->log(logging::LogLevel::ERROR, "Unknown HTTP backend: " + backend);
+            return false;
+        }
+        app_logger_->log(logging::LogLevel::INFO, "HTTP backend: " + backend);
+
+        // Optional admission control: sheds order and read traffic separately under overload
+        if (config_json.contains("admission") &&
+            config_json["admission"].value("enabled", false)) {
+            auto& admission_cfg = config_json["admission"];
+            network::AdmissionController::Config admission_config;
+            auto read_budget = [&admission_cfg](const char* name,
+                                                network::AdmissionController::ClassBudget& budget) {
+                if (!admission_cfg.contains(name))
+                    return;
+                auto& budget_cfg = admission_cfg[name];
+                if (budget_cfg.contains("max_in_flight"))
+                    budget.max_in_flight = budget_cfg["max_in_flight"];
+                if (budget_cfg.contains("min_in_flight"))
+                    budget.min_in_flight = budget_cfg["min_in_flight"];
+                if (budget_cfg.contains("target_latency_ms"))
+                    budget.target_latency =
+                        std::chrono::milliseconds(budget_cfg["target_latency_ms"].get<int>());
+                if (budget_cfg.contains("max_queued"))
+                    budget.max_queued = budget_cfg["max_queued"];
+            };
+            read_budget("orders", admission_config.orders);
+            read_budget("reads", admission_config.reads);
+            if (admission_cfg.contains("max_order_backlog"))
+                admission_config.max_order_backlog = admission_cfg["max_order_backlog"];
+            if (admission_cfg.contains("retry_after_seconds"))
+                admission_config.retry_after_seconds = admission_cfg["retry_after_seconds"];
+
+            admission_ = std::make_shared<network::AdmissionController>(admission_config);
+            admission_->setBacklogProbe([this]() -> size_t {
+                const uint64_t consumed = orders_consumed_.load(std::memory_order_relaxed);
+                const uint64_t published = orders_published_.load(std::memory_order_relaxed);
+                return published > consumed ? published - consumed : 0;
+            });
+            http_server_->setAdmissionController(admission_);
+        }
+
+        // Optional gzip/zstd compression of large responses
+        if (config_json.contains("compression") &&
+            config_json["compression"].value("enabled", false)) {
+            auto& compression_cfg = config_json["compression"];
+            network::ResponseCompressor::Config compression_config;
+            if (compression_cfg.contains("min_size_bytes"))
+                compression_config.min_size = compression_cfg["min_size_bytes"];
+            if (compression_cfg.contains("gzip_level"))
+                compression_config.gzip_level = compression_cfg["gzip_level"];
+            if (compression_cfg.contains("zstd_level"))
+                compression_config.zstd_level = compression_cfg["zstd_level"];
+            if (compression_cfg.contains("cache_slots"))
+                compression_config.cache_slots = compression_cfg["cache_slots"];
+            if (!network::contentEncodingSupported(network::ContentEncoding::GZIP) &&
+                !network::contentEncodingSupported(network::ContentEncoding::ZSTD)) {
+                app_logger_->log(logging::LogLevel::WARNING,
+                                 "Built without zlib or libzstd; responses are not compressed");
+            } else {
+                compressor_ = std::make_shared<network::ResponseCompressor>(compression_config);
+                http_server_->setResponseCompressor(compressor_);
+            }
+        }
+
+        // Optional push streaming of trades, book updates and order events
+        if (config_json.contains("websocket") &&
+            config_json["websocket"].value("enabled", false)) {
+            auto& websocket_cfg = config_json["websocket"];
+            network::WebSocketHub::Config hub_config;
+            if (websocket_cfg.contains("max_connections"))
+                hub_config.max_connections = websocket_cfg["max_connections"];
+            if (websocket_cfg.contains("conflate_threshold_bytes"))
+                hub_config.conflate_threshold_bytes = websocket_cfg["conflate_threshold_bytes"];
+            if (websocket_cfg.contains("max_backlog_bytes"))
+                hub_config.max_backlog_bytes = websocket_cfg["max_backlog_bytes"];
+            if (websocket_cfg.contains("depth_levels"))
+                depth_levels_ = websocket_cfg["depth_levels"];
+            ws_hub_ = std::make_shared<network::WebSocketHub>(hub_config);
+            http_server_->registerWebSocket(websocket_cfg.value("path", "/ws"), ws_hub_);
+        }
 
         // Initialize queue client
         std::string brokers = "localhost:9092";
         if (config_json.contains("redpanda") && config_json["redpanda"].contains("brokers")) {
             brokers = config_json["redpanda"]["brokers"];
         }
-        queue_client_ = std::make_unique<messaging::QueueClient>(brokers, app_logger_);
+
+        // Order transport: Kafka/Redpanda by default, or an in-process queue / shared-memory ring
+        std::string transport_type = "kafka";
+        std::string shm_name = "/trading-engine-orders";
+        if (config_json.contains("messaging")) {
+            auto& messaging_cfg = config_json["messaging"];
+            if (messaging_cfg.contains("transport"))
+                transport_type = messaging_cfg["transport"];
+            if (messaging_cfg.contains("shm_name"))
+                shm_name = messaging_cfg["shm_name"];
+        }
+
+        std::unique_ptr<messaging::Transport> transport;
+        if (transport_type == "kafka") {
+            transport = std::make_unique<messaging::KafkaTransport>(brokers, app_logger_);
+        } else if (transport_type == "inprocess") {
+            transport = std::make_unique<messaging::InProcessTransport>("trading-engine");
+        } else if (transport_type == "shm") {
+            transport = std::make_unique<messaging::SharedMemoryTransport>(shm_name);
+        } else {
+            app_logger_->log(logging::LogLevel::ERROR,
+                             "Unknown messaging transport: " + transport_type);
+            return false;
+        }
+        app_logger_->log(logging::LogLevel::INFO, "Messaging transport: " + transport_type);
+        queue_client_ = std::make_unique<messaging::QueueClient>(std::move(transport), app_logger_);
+
+        // Order ingress: through the message queue, or decoded on the HTTP thread and handed to
+        // the matcher over an in-process ring with a local audit journal. The journal is written
+        // ahead of matching but never replayed; the books start empty on every run.
+        std::string ingress_mode = "queue";
+        size_t ingress_ring_capacity = 65536;
+        utils::Journal::Config journal_config;
+        journal_config.path = "logs/order_journal.bin";
+        if (config_json.contains("ingress")) {
+            auto& ingress_cfg = config_json["ingress"];
+            if (ingress_cfg.contains("mode"))
+                ingress_mode = ingress_cfg["mode"];
+            if (ingress_cfg.contains("ring_capacity"))
+                ingress_ring_capacity = ingress_cfg["ring_capacity"];
+            if (ingress_cfg.contains("journal_path"))
+                journal_config.path = ingress_cfg["journal_path"];
+            if (ingress_cfg.contains("journal_sync"))
+                journal_config.sync_on_flush = ingress_cfg["journal_sync"];
+            if (ingress_cfg.contains("sync_ack_timeout_ms"))
+                sync_ack_timeout_ =
+                    std::chrono::milliseconds(ingress_cfg["sync_ack_timeout_ms"].get<int>());
+            if (ingress_cfg.contains("max_batch_size"))
+                max_batch_size_ = ingress_cfg["max_batch_size"];
+        }
+        if (ingress_mode != "queue" && ingress_mode != "direct") {
+            app_logger_->log(logging::LogLevel::ERROR, "Unknown ingress mode: " + ingress_mode);
+            return false;
+        }
+        direct_ingress_ = ingress_mode == "direct";
+        if (direct_ingress_) {
+            order_ring_ = std::make_unique<utils::SequencedRing<core::OrderRequest>>(
+                ingress_ring_capacity);
+            order_journal_ = std::make_unique<utils::Journal>(journal_config);
+            // A batch is published in one claim, so it can never exceed the ring
+            max_batch_size_ = std::min(max_batch_size_, order_ring_->capacity());
+        }
+        app_logger_->log(logging::LogLevel::INFO, "Order ingress mode: " + ingress_mode);
+
+        // Validation bands, rate limit tiers and the log level; reloadable while running
+        std::string config_error;
+        auto runtime_config = parseRuntimeConfig(config_json, config_error);
+        if (!runtime_config) {
+            app_logger_->log(logging::LogLevel::ERROR, "Invalid configuration: " + config_error);
+            return false;
+        }
+        config_file_ = config_file;
+
+        // Optional per-user order rate limits, enforced at ingress and again as the matcher
+        // consumes. Whether they are on, and the table capacity, are fixed at startup.
+        if (runtime_config->rate_limit_enabled) {
+            ingress_limiter_ =
+                std::make_unique<validation::RateLimiter>(runtime_config->rate_limit);
+            consumer_limiter_ =
+                std::make_unique<validation::RateLimiter>(consumerLimiterConfig(*runtime_config));
+        }
+        applyRuntimeConfig(std::move(*runtime_config));
+
+        // Order status store for the query endpoints
+        core::OrderStateStore::Config order_state_config;
+        if (config_json.contains("order_state")) {
+            auto& order_state_cfg = config_json["order_state"];
+            if (order_state_cfg.contains("capacity"))
+                order_state_config.capacity = order_state_cfg["capacity"];
+            if (order_state_cfg.contains("terminal_ttl_seconds"))
+                order_state_config.terminal_ttl =
+                    std::chrono::seconds(order_state_cfg["terminal_ttl_seconds"].get<int64_t>());
+        }
+        order_states_ = std::make_unique<core::OrderStateStore>(order_state_config);
 
         // Initialize statistics collector
         statistics::StatisticsCollector::Config stats_config;
@@ -126,6 +674,59 @@ class TradingEngine {
 
         stats_collector_ = std::make_unique<statistics::StatisticsCollector>(stats_config);
 
+        // Initialize post-trade fan-out ring
+        size_t ring_capacity = 65536;
+        size_t ring_max_batch = 256;
+        if (config_json.contains("post_trade")) {
+            auto& post_trade_cfg = config_json["post_trade"];
+            if (post_trade_cfg.contains("ring_capacity"))
+                ring_capacity = post_trade_cfg["ring_capacity"];
+            if (post_trade_cfg.contains("max_batch"))
+                ring_max_batch = post_trade_cfg["max_batch"];
+        }
+        trade_ring_ =
+            std::make_unique<utils::SequencedRing<core::Trade>>(ring_capacity, ring_max_batch);
+
+        // Initialize clocks: cycle-counter clock for trade timestamps, cached coarse clock for
+        // second-resolution response timestamps
+        int coarse_resolution_us = 1000;
+        int recalibrate_interval_ms = 1000;
+        if (config_json.contains("clock")) {
+            auto& clock_cfg = config_json["clock"];
+            if (clock_cfg.contains("coarse_resolution_us"))
+                coarse_resolution_us = clock_cfg["coarse_resolution_us"];
+            if (clock_cfg.contains("recalibrate_interval_ms"))
+                recalibrate_interval_ms = clock_cfg["recalibrate_interval_ms"];
+        }
+        coarse_clock_ = std::make_shared<utils::CoarseClock>(
+            utils::defaultClock(), std::chrono::microseconds(coarse_resolution_us),
+            std::chrono::milliseconds(recalibrate_interval_ms));
+
+        // Initialize the execution pipeline. Only the simulated venue exists so far; its latency
+        // and reject rate are configurable for testing.
+        size_t max_in_flight = execution::Executor::kDefaultMaxInFlight;
+        int execution_timeout_ms = 5000;
+        int max_retries = 3;
+        execution::SimulatedVenue::Config venue_config;
+        if (config_json.contains("execution")) {
+            auto& exec_cfg = config_json["execution"];
+            if (exec_cfg.contains("max_in_flight"))
+                max_in_flight = exec_cfg["max_in_flight"];
+            if (exec_cfg.contains("timeout_ms"))
+                execution_timeout_ms = exec_cfg["timeout_ms"];
+            if (exec_cfg.contains("max_retries"))
+                max_retries = exec_cfg["max_retries"];
+            if (exec_cfg.contains("simulated_latency_us"))
+                venue_config.latency =
+                    std::chrono::microseconds(exec_cfg["simulated_latency_us"].get<int64_t>());
+            if (exec_cfg.contains("simulated_reject_probability"))
+                venue_config.reject_probability = exec_cfg["simulated_reject_probability"];
+        }
+        executor_ = std::make_shared<execution::Executor>(
+            std::make_shared<execution::SimulatedVenue>(venue_config), max_in_flight);
+        executor_->setTimeout(execution_timeout_ms);
+        executor_->setMaxRetries(max_retries);
+
         // Load admin configuration directly from JSON
         admin_enabled_ = false;
         admin_password_ = "";
@@ -156,6 +757,9 @@ class TradingEngine {
             return false;
         }
 
+        // Start the clock ticker first so every component sees fresh timestamps
+        coarse_clock_->start();
+
         // Start async logging threads
         try {
             app_logger_->start();
@@ -166,6 +770,12 @@ class TradingEngine {
             return false;
         }
 
+        // The streaming hub must be up before the server can hand it upgraded connections
+        if (ws_hub_ && !ws_hub_->start()) {
+            trade_logger_->logMessage(logging::LogLevel::ERROR, "Failed to start WebSocket hub");
+            return false;
+        }
+
         // Start HTTP server
         if (!http_server_->start()) {
             trade_logger_->logMessage(logging::LogLevel::ERROR, "Failed to start HTTP server");
@@ -179,22 +789,45 @@ class TradingEngine {
             return false;
         }
 
-        // Connect to message queue
-        if (!queue_client_->connect()) {
+        // Start the execution pipeline and post-trade consumers before any order can be matched
+        if (!executor_->start()) {
             trade_logger_->logMessage(logging::LogLevel::ERROR,
-                                      "Failed to connect to message queue");
+                                      "Failed to start execution pipeline");
             return false;
         }
+        trade_ring_->start();
+
+        if (direct_ingress_) {
+            // Direct ingress: the ring's single consumer is the matcher
+            if (!order_journal_->open()) {
+                trade_logger_->logMessage(logging::LogLevel::ERROR,
+                                          "Failed to open order journal");
+                return false;
+            }
+            order_ring_->start();
+        } else {
+            // Connect to message queue
+            if (!queue_client_->connect()) {
+                trade_logger_->logMessage(logging::LogLevel::ERROR,
+                                          "Failed to connect to message queue");
+                return false;
+            }
 
-        // Setup queue message handler for processing orders from Redpanda
-        if (!queue_client_->subscribe("order-requests", [this](const messaging::Message& msg) {
-                processOrderFromQueue(msg);
-            })) {
-            trade_logger_->logMessage(logging::LogLevel::ERROR,
-                                      "Failed to subscribe to order-requests topic");
-            return false;
+            // Setup queue message handler for processing orders from Redpanda
+            if (!queue_client_->subscribe("order-requests",
+                                          [this](const messaging::Message& msg) {
+                                              processOrderFromQueue(msg);
+                                          })) {
+                trade_logger_->logMessage(logging::LogLevel::ERROR,
+                                          "Failed to subscribe to order-requests topic");
+                return false;
+            }
         }
 
+        // Drive order expiry
+        housekeeping_running_ = true;
+        housekeeping_thread_ = std::thread([this] { housekeepingLoop(); });
+
         running_ = true;
         trade_logger_->logMessage(logging::LogLevel::INFO, "Trading engine started");
         return true;
@@ -211,62 +844,160 @@ class TradingEngine {
             http_server_->stop();
         }
 
-        if (stats_collector_) {
-            stats_collector_->stop();
-        }
-
         if (queue_client_) {
             queue_client_->disconnect();
         }
 
+        // Match whatever was already accepted, then make it durable
+        if (order_ring_) {
+            order_ring_->stop();
+        }
+        if (order_journal_) {
+            order_journal_->close();
+        }
+
+        housekeeping_running_ = false;
+        if (housekeeping_thread_.joinable()) {
+            housekeeping_thread_.join();
+        }
+
+        // Drain post-trade work once no more trades can be produced
+        if (trade_ring_) {
+            trade_ring_->stop();
+        }
+        executor_->stop();
+
+        if (ws_hub_) {
+            ws_hub_->stop();
+        }
+
+        if (stats_collector_) {
+            stats_collector_->stop();
+        }
+
         trade_logger_->logMessage(logging::LogLevel::INFO, "Trading engine stopped");
 
         // Stop async logging threads (this will flush all remaining messages)
         trade_logger_->stop();
         app_logger_->stop();
+
+        if (coarse_clock_) {
+            coarse_clock_->stop();
+        }
     }
 
     bool isRunning() const {
         return running_;
     }
 
-  private:
-    void setupCallbacks() {
-        // Setup HTTP request handlers using new routing system
-        http_server_->registerRoute("POST", "/order", [this](const network::HttpRequest& request) {
-            return handleOrderRequest(request);
-        });
-
-        http_server_->registerRoute("GET", "/health", [this](const network::HttpRequest& request) {
-            return handleHealthRequest(request);
-        });
-
-        http_server_->registerRoute("GET", "/api/v1/orderbook/{symbol}",
-                                    [this](const network::HttpRequest& request) {
-                                        return handleOrderBookRequest(request);
-                                    });
+    // Re-reads the config file and applies its runtime settings (validation, rate limit tiers,
+    // log level); everything else in the file takes effect on restart. On failure the current
+    // settings stay in place and error says why.
+    bool reloadConfiguration(std::string& error) {
+        std::lock_guard<std::mutex> lock(reload_mutex_);
+        std::ifstream file(config_file_);
+        json config_json;
+        if (!file.is_open()) {
+            error = "Failed to open configuration file: " + config_file_;
+        } else {
+            try {
+                file >> config_json;
+            } catch (const json::exception& e) {
+                error = "Failed to parse JSON configuration: " + std::string(e.what());
+            }
+        }
 
-        http_server_->registerRoute(
-            "GET", "/api/v1/stats/{symbol}",
-            [this](const network::HttpRequest& request) { return handleStatsRequest(request); });
+        std::optional<RuntimeConfig> runtime_config;
+        if (error.empty()) {
+            runtime_config = parseRuntimeConfig(config_json, error);
+        }
+        if (!runtime_config) {
+            app_logger_->log(logging::LogLevel::ERROR, "Configuration reload failed: " + error);
+            return false;
+        }
 
-        http_server_->registerRoute(
-            "GET", "/api/v1/stats/{symbol}/{timeframe}",
-            [this](const network::HttpRequest& request) { return handleStatsRequest(request); });
+        if (runtime_config->rate_limit_enabled != static_cast<bool>(ingress_limiter_)) {
+            app_logger_->log(logging::LogLevel::WARNING,
+                             "rate_limit.enabled only changes on restart");
+        }
+        applyRuntimeConfig(std::move(*runtime_config));
+        app_logger_->log(logging::LogLevel::INFO, "Configuration reloaded from " + config_file_);
+        return true;
+    }
 
-        http_server_->registerRoute(
-            "GET", "/api/v1/stats/all",
-            [this](const network::HttpRequest& request) { return handleAllStatsRequest(request); });
+  private:
+    // Validation has already passed for the whole config. Publication is per component: the
+    // validator, the rate limiters and the loggers each swap in their own snapshot in turn, so
+    // a request running concurrently may see one component's new settings next to another's
+    // old ones. runtime_config_ is published last, for /admin/config.
+    void applyRuntimeConfig(RuntimeConfig config) {
+        validator_->setLimits(config.validation);
+        if (ingress_limiter_) {
+            ingress_limiter_->reconfigure(config.rate_limit);
+            consumer_limiter_->reconfigure(consumerLimiterConfig(config));
+        }
+        config.rate_limit_enabled = static_cast<bool>(ingress_limiter_);
+        app_logger_->setLogLevel(config.log_level);
+        trade_logger_->setLogLevel(config.log_level);
+        runtime_config_.publish(std::move(config));
+    }
 
-        http_server_->registerRoute("GET", "/api/v1/stats/summary",
+    void setupCallbacks() {
+        // Setup HTTP request handlers using new routing system
+        // Order entry and health checks have their own admission classes; everything else is a
+        // read
+        using network::RequestClass;
+        // Order entry waits for the matcher's ack as a coroutine, so a request waiting on its
+        // outcome holds no worker
+        http_server_->registerAsyncRoute(
+            "POST", "/order",
+            [this](const network::HttpRequest& request) { return handleOrderRequest(request); },
+            RequestClass::ORDER);
+
+        http_server_->registerAsyncRoute("POST", "/api/v1/orders/batch",
+                                         [this](const network::HttpRequest& request) {
+                                             return handleBatchOrderRequest(request);
+                                         },
+                                         RequestClass::ORDER);
+
+        http_server_->registerAsyncRoute(
+            "POST", "/order/amend",
+            [this](const network::HttpRequest& request) { return handleAmendRequest(request); },
+            RequestClass::ORDER);
+
+        http_server_->registerRoute("POST", "/order/cancel_all",
                                     [this](const network::HttpRequest& request) {
-                                        return handleStatsSummaryRequest(request);
-                                    });
+                                        return handleCancelAllRequest(request);
+                                    },
+                                    RequestClass::ORDER);
 
-        http_server_->registerRoute("GET", "/api/v1/leaderboard",
-                                    [this](const network::HttpRequest& request) {
-                                        return handleLeaderboardRequest(request);
-                                    });
+        http_server_->registerRoute(
+            "GET", "/health",
+            [this](const network::HttpRequest& request) { return handleHealthRequest(request); },
+            RequestClass::EXEMPT);
+
+        registerLongPollRoute("/api/v1/orderbook/{symbol}", &TradingEngine::handleOrderBookRequest,
+                              market_version_);
+
+        // Routes match in registration order, so the fixed stats paths go before {symbol}
+        const utils::VersionCounter& stats_version = stats_collector_->version();
+        registerLongPollRoute("/api/v1/stats/all", &TradingEngine::handleAllStatsRequest,
+                              stats_version);
+        registerLongPollRoute("/api/v1/stats/summary", &TradingEngine::handleStatsSummaryRequest,
+                              stats_version);
+        registerLongPollRoute("/api/v1/stats/{symbol}", &TradingEngine::handleStatsRequest,
+                              stats_version);
+        registerLongPollRoute("/api/v1/stats/{symbol}/{timeframe}",
+                              &TradingEngine::handleStatsRequest, stats_version);
+
+        // An order's updates are all followed by a bump of the market version
+        registerLongPollRoute("/api/v1/orders/{id}", &TradingEngine::handleOrderStatusRequest,
+                              market_version_);
+        registerLongPollRoute("/api/v1/users/{id}/orders", &TradingEngine::handleUserOrdersRequest,
+                              market_version_);
+
+        registerLongPollRoute("/api/v1/leaderboard", &TradingEngine::handleLeaderboardRequest,
+                              market_version_);
 
         // Admin endpoints
         if (admin_enabled_) {
@@ -279,35 +1010,208 @@ class TradingEngine {
             http_server_->registerRoute("POST", "/admin/stop_trading",
                                         [this](const network::HttpRequest& request) {
                                             return handleAdminStopTrading(request);
-                                        });
+                                        },
+                                        RequestClass::EXEMPT);
+
+            http_server_->registerRoute("POST", "/admin/cancel_orders",
+                                        [this](const network::HttpRequest& request) {
+                                            return handleAdminCancelOrders(request);
+                                        },
+                                        RequestClass::EXEMPT);
 
             http_server_->registerRoute("POST", "/admin/flush_system",
                                         [this](const network::HttpRequest& request) {
                                             return handleAdminFlushSystem(request);
-                                        });
+                                        },
+                                        RequestClass::EXEMPT);
 
             http_server_->registerRoute("POST", "/admin/resume_trading",
                                         [this](const network::HttpRequest& request) {
                                             return handleAdminResumeTrading(request);
-                                        });
+                                        },
+                                        RequestClass::EXEMPT);
 
             http_server_->registerRoute(
                 "GET", "/admin/status",
-                [this](const network::HttpRequest& request) { return handleAdminStatus(request); });
+                [this](const network::HttpRequest& request) { return handleAdminStatus(request); },
+                RequestClass::EXEMPT);
+
+            http_server_->registerRoute(
+                "GET", "/admin/config",
+                [this](const network::HttpRequest& request) { return handleAdminConfig(request); },
+                RequestClass::EXEMPT);
+
+            http_server_->registerRoute("POST", "/admin/config/reload",
+                                        [this](const network::HttpRequest& request) {
+                                            return handleAdminReloadConfig(request);
+                                        },
+                                        RequestClass::EXEMPT);
         } else {
             app_logger_->log(logging::LogLevel::INFO, "Admin endpoints disabled");
         }
 
-        // Setup trade callback
-        matching_engine_->setTradeCallback(
-            [this](const core::Trade& trade) { handleTrade(trade); });
+        // Setup trade callback - the matching thread only records fills and publishes into the
+        // ring; everything else happens on the ring's consumers
+        matching_engine_->setTradeCallback([this](const core::Trade& trade) {
+            const std::string& buyer = core::userName(trade.buy_user);
+            const std::string& seller = core::userName(trade.sell_user);
+            order_states_->recordFill(buyer, core::clientOrderId(trade.buy_order),
+                                      trade.quantity, trade.price, trade.timestamp_ns);
+            order_states_->recordFill(seller, core::clientOrderId(trade.sell_order),
+                                      trade.quantity, trade.price, trade.timestamp_ns);
+            trade_ring_->publish(trade);
+        });
+
+        // Post-trade consumers, each advancing independently on its own thread
+        trade_ring_->addConsumer("trade_logger", [this](const core::Trade& trade, int64_t, bool) {
+            trade_logger_->logTrade(trade);
+        });
+        trade_ring_->addConsumer("statistics", [this](const core::Trade& trade, int64_t, bool) {
+            if (stats_collector_ && stats_collector_->isRunning()) {
+                stats_collector_->submitTrade(trade);
+            }
+        });
+        trade_ring_->addConsumer("confirmations", [this](const core::Trade& trade, int64_t, bool) {
+            handleTradeConfirmation(trade);
+        });
+
+        if (ws_hub_) {
+            trade_ring_->addConsumer("stream", [this](const core::Trade& trade, int64_t, bool) {
+                const std::string& symbol = core::symbolName(trade.symbol);
+                const std::string channel = "trades." + symbol;
+                if (ws_hub_->hasSubscribers(channel)) {
+                    ws_hub_->publish(channel, json{{"trade_id", core::tradeIdString(trade)},
+                                                   {"symbol", symbol},
+                                                   {"price", trade.price},
+                                                   {"quantity", trade.quantity},
+                                                   {"timestamp_ns", trade.timestamp_ns}}
+                                                  .dump());
+                }
+                // Both sides' order events, read from the store without locking. Each is the
+                // order's state when read, so it can trail a newer event streamed by the matcher;
+                // subscribers order them by updated_ns.
+                publishOrderEvent(core::userName(trade.buy_user),
+                                  core::clientOrderId(trade.buy_order));
+                publishOrderEvent(core::userName(trade.sell_user),
+                                  core::clientOrderId(trade.sell_order));
+            });
+            ws_hub_->setChannelFilter(isStreamChannel);
+            ws_hub_->setSnapshotProvider(
+                [this](const std::string& channel, const network::WebSocketHub::Sender& send) {
+                    sendStreamSnapshot(channel, send);
+                });
+        }
+
+        // Direct ingress matcher: write-ahead journal with one group commit per batch. Requests
+        // are matched only after the batch is on disk; once a write fails the journal's tail is
+        // unknown, so every request from then on is rejected instead of matched.
+        if (order_ring_) {
+            order_ring_->addConsumer(
+                "matcher",
+                [this](const core::OrderRequest& order_request, int64_t, bool end_of_batch) {
+                    if (!journal_failed_ && !order_journal_->appendRecord(order_request)) {
+                        failJournal("Failed to journal order " +
+                                    std::string(order_request.getId()));
+                    }
+                    pending_orders_.push_back(order_request);
+                    if (!end_of_batch) {
+                        return;
+                    }
+
+                    if (!journal_failed_ && !order_journal_->flush()) {
+                        failJournal("Failed to flush order journal");
+                    }
+                    for (const auto& request : pending_orders_) {
+                        pending_acks_.emplace_back(
+                            completionKey(request.getUserId(), request.getId()),
+                            journal_failed_ ? rejectedResult("Order journal unavailable")
+                                            : processOrderRequest(request));
+                    }
+                    pending_orders_.clear();
+                    for (auto& [key, result] : pending_acks_) {
+                        order_completions_.complete(key, std::move(result));
+                    }
+                    pending_acks_.clear();
+                });
+        }
 
         // Setup execution callback
         executor_->setExecutionCallback(
             [this](const execution::ExecutionResult& result) { handleExecution(result); });
     }
 
-    network::HttpResponse handleOrderRequest(const network::HttpRequest& request) {
+    // Hands a request to the matcher over the configured ingress path. With synchronous acks
+    // enabled, the calling task then parks on a completion slot until the matcher reports the
+    // outcome or the deadline passes; result stays empty if no outcome arrived in time.
+    utils::Task<bool> dispatchOrderRequest(const json& json_body, const std::string& payload,
+                                           std::optional<OrderResult>& result) {
+        const std::string user_id = json_body.at("userId");
+
+        // Decode before registering so a malformed request never leaves a slot behind
+        std::optional<core::OrderRequest> decoded;
+        if (direct_ingress_) {
+            decoded = decodeOrderRequest(json_body);
+        }
+
+        std::string key;
+        OrderCompletions::Ticket ticket;
+        if (sync_ack_timeout_.count() > 0) {
+            key = completionKey(user_id, json_body.at("id").get<std::string>());
+            ticket = order_completions_.expect(key);  // Null if this id is already in flight
+        }
+
+        const bool published = decoded
+                                    ? order_ring_->publish(*decoded) >= 0
+                                    : queue_client_->publish("order-requests", user_id, payload);
+        if (published) {
+            orders_published_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!ticket) {
+            co_return published;
+        }
+        if (!published) {
+            order_completions_.abandon(key, ticket);
+            co_return false;
+        }
+        result = co_await awaitOrderResult(key, ticket, sync_ack_timeout_);
+        co_return true;
+    }
+
+    // Suspends the calling task, holding no thread, until the matcher reports the outcome for
+    // key or timeout passes; nullopt if none arrived in time
+    utils::Task<std::optional<OrderResult>> awaitOrderResult(
+        const std::string& key, const utils::CompletionRegistry<OrderResult>::Ticket& ticket,
+        std::chrono::milliseconds timeout) {
+        auto delivered = http_server_->waitFor(
+            [this, ticket](std::function<void()> notify) {
+                order_completions_.onComplete(ticket, std::move(notify));
+            },
+            timeout);
+        co_await delivered;
+        // Delivered by now, or withdrawn here
+        co_return order_completions_.wait(key, ticket, std::chrono::milliseconds(0));
+    }
+
+    // Charges cost orders to the user's ingress bucket; a 429 response if it cannot cover them
+    std::optional<network::HttpResponse> checkRateLimit(std::string_view user_id, uint32_t cost) {
+        if (!ingress_limiter_) {
+            return std::nullopt;
+        }
+        const auto decision =
+            ingress_limiter_->tryAcquire(user_id, utils::defaultClock()->nowNanos(), cost);
+        if (decision.allowed) {
+            return std::nullopt;
+        }
+        network::HttpResponse response =
+            createErrorResponse(429, "Order rate limit exceeded for user " + std::string(user_id));
+        // Whole seconds, rounded up
+        response.headers["Retry-After"] =
+            std::to_string(std::max<int64_t>(1, (decision.retry_after_ns + 999'999'999) /
+                                                    1'000'000'000));
+        return response;
+    }
+
+    utils::Task<network::HttpResponse> handleOrderRequest(const network::HttpRequest& request) {
         try {
             // Check if trading is active
             if (!trading_active_) {
@@ -315,7 +1219,7 @@ class TradingEngine {
                 response.status_code = 503;  // Service Unavailable
                 response.body = "{\"error\": \"Trading is currently suspended\"}";
                 response.headers["Content-Type"] = "application/json";
-                return response;
+                co_return response;
             }
 
             // Light validation on the incoming request
@@ -323,116 +1227,697 @@ class TradingEngine {
             if (!json_body.contains("userId") || !json_body.contains("id")) {
                 throw std::invalid_argument("Request must contain 'userId' and 'id'");
             }
+            if (auto limited = checkRateLimit(json_body.at("userId").get<std::string>(), 1)) {
+                co_return *limited;
+            }
 
-            std::string user_id = json_body.at("userId");
-
-            // Publish the full request body to Redpanda, using userId as the key
-            bool published = queue_client_->publish("order-requests", user_id, request.body);
-
-            if (!published) {
+            std::optional<OrderResult> result;
+            if (!co_await dispatchOrderRequest(json_body, request.body, result)) {
                 app_logger_->log(logging::LogLevel::ERROR, "Failed to publish order to queue");
                 network::HttpResponse response;
                 response.status_code = 500;  // Internal Server Error
                 response.body = "{\"error\": \"Failed to queue order for processing\"}";
                 response.headers["Content-Type"] = "application/json";
-                return response;
+                co_return response;
+            }
+            if (result) {
+                co_return createOrderResultResponse(json_body.at("id"), *result);
             }
 
-            // Immediately acknowledge the request
+            // No outcome before the deadline (or sync acks disabled): acknowledge receipt only
             network::HttpResponse response;
             response.status_code = 202;  // Accepted
             response.body = "{\"status\": \"order accepted for processing\", \"order_id\": \"" +
                             json_body.at("id").get<std::string>() + "\"}";
             response.headers["Content-Type"] = "application/json";
-            return response;
+            co_return response;
 
         } catch (const json::exception& e) {
             network::HttpResponse response;
             response.status_code = 400;
             response.body = "{\"error\": \"Invalid JSON format: " + std::string(e.what()) + "\"}";
             response.headers["Content-Type"] = "application/json";
-            return response;
+            co_return response;
         } catch (const std::invalid_argument& e) {
             network::HttpResponse response;
             response.status_code = 400;
             response.body = "{\"error\": \"" + std::string(e.what()) + "\"}";
             response.headers["Content-Type"] = "application/json";
-            return response;
+            co_return response;
+        }
+    }
+
+    utils::Task<network::HttpResponse> handleAmendRequest(const network::HttpRequest& request) {
+        try {
+            // Check if trading is active
+            if (!trading_active_) {
+                co_return createErrorResponse(503, "Trading is currently suspended");
+            }
+
+            auto json_body = json::parse(request.body);
+            if (!json_body.contains("userId") || !json_body.contains("id") ||
+                !json_body.contains("symbol")) {
+                throw std::invalid_argument("Request must contain 'userId', 'id' and 'symbol'");
+            }
+            if (!json_body.contains("quantity") && !json_body.contains("price")) {
+                throw std::invalid_argument("Amend must change 'quantity' and/or 'price'");
+            }
+            if (auto limited = checkRateLimit(json_body.at("userId").get<std::string>(), 1)) {
+                co_return *limited;
+            }
+
+            // Amends travel the same partitioned queue as new orders so they are applied in
+            // order with the user's other requests
+            json_body["action"] = "amend";
+            const std::string payload = json_body.dump();
+            std::optional<OrderResult> result;
+            if (!co_await dispatchOrderRequest(json_body, payload, result)) {
+                app_logger_->log(logging::LogLevel::ERROR, "Failed to publish amend to queue");
+                co_return createErrorResponse(500, "Failed to queue amend for processing");
+            }
+            if (result) {
+                co_return createOrderResultResponse(json_body.at("id"), *result);
+            }
+
+            network::HttpResponse response;
+            response.status_code = 202;  // Accepted
+            response.body = json{{"status", "amend accepted for processing"},
+                                 {"order_id", json_body.at("id").get<std::string>()}}
+                                .dump();
+            response.headers["Content-Type"] = "application/json";
+            co_return response;
+
+        } catch (const json::exception& e) {
+            co_return createErrorResponse(400, "Invalid JSON format: " + std::string(e.what()));
+        } catch (const std::invalid_argument& e) {
+            co_return createErrorResponse(400, e.what());
+        }
+    }
+
+    // Decodes a batch body: raw OrderRequest records for kOrderBatchContentType, otherwise JSON,
+    // either an array of orders or {"orders": [...]}
+    std::vector<core::OrderRequest> decodeOrderBatch(const network::HttpRequest& request) {
+        std::vector<core::OrderRequest> orders;
+        if (headerValue(request, "Content-Type") == kOrderBatchContentType) {
+            if (request.body.size() % sizeof(core::OrderRequest) != 0) {
+                throw std::invalid_argument(
+                    "Binary batch size is not a multiple of the record size");
+            }
+            for (size_t offset = 0; offset < request.body.size();
+                 offset += sizeof(core::OrderRequest)) {
+                if (!isWellFormed(request.body.data() + offset)) {
+                    throw std::invalid_argument("Malformed order record in binary batch");
+                }
+            }
+            orders.resize(request.body.size() / sizeof(core::OrderRequest));
+            std::memcpy(orders.data(), request.body.data(), request.body.size());
+            return orders;
+        }
+
+        const auto json_body = json::parse(request.body);
+        const json& entries = json_body.is_array() ? json_body : json_body.at("orders");
+        if (!entries.is_array()) {
+            throw std::invalid_argument("'orders' must be an array");
+        }
+        orders.reserve(entries.size());
+        for (const auto& entry : entries) {
+            if (entry.contains("action") && entry["action"] != "new") {
+                throw std::invalid_argument("A batch may only contain new orders");
+            }
+            orders.push_back(decodeOrderRequest(entry));
+        }
+        return orders;
+    }
+
+    // Checks the whole batch before anything is published; returns one error per order, empty
+    // where the order passed
+    std::vector<std::string> validateOrderBatch(const std::vector<core::OrderRequest>& orders) {
+        std::vector<std::string> errors(orders.size());
+        std::unordered_set<std::string_view> seen_ids;
+        for (size_t i = 0; i < orders.size(); ++i) {
+            const auto& order = orders[i];
+            if (order.getUserId() != orders.front().getUserId()) {
+                errors[i] = "All orders in a batch must belong to one user";
+            } else if (!seen_ids.insert(order.getId()).second) {
+                errors[i] = "Duplicate order id in batch";
+            } else if (auto validation = validator_->validate(order); !validation.is_valid) {
+                errors[i] = validation.error_message;
+            }
+        }
+        return errors;
+    }
+
+    // Publishes a validated batch as a unit: one ring claim in direct mode, one queue message
+    // otherwise, so the matcher sees the orders back to back
+    bool publishOrderBatch(const std::vector<core::OrderRequest>& orders) {
+        bool published;
+        if (direct_ingress_) {
+            published = order_ring_->publishBatch(orders.data(), orders.size()) >= 0;
+        } else {
+            std::string payload(1, kOrderBatchMarker);
+            payload.append(reinterpret_cast<const char*>(orders.data()),
+                           orders.size() * sizeof(core::OrderRequest));
+            published = queue_client_->publish(
+                "order-requests", std::string(orders.front().getUserId()), payload);
+        }
+        if (published) {
+            orders_published_.fetch_add(orders.size(), std::memory_order_relaxed);
+        }
+        return published;
+    }
+
+    utils::Task<network::HttpResponse> handleBatchOrderRequest(
+        const network::HttpRequest& request) {
+        try {
+            if (!trading_active_) {
+                co_return createErrorResponse(503, "Trading is currently suspended");
+            }
+
+            const auto orders = decodeOrderBatch(request);
+            if (orders.empty()) {
+                throw std::invalid_argument("Batch contains no orders");
+            }
+            if (orders.size() > max_batch_size_) {
+                throw std::invalid_argument("Batch exceeds the maximum of " +
+                                            std::to_string(max_batch_size_) + " orders");
+            }
+
+            // All or nothing: one bad order rejects the batch before any of it is published
+            const auto errors = validateOrderBatch(orders);
+            if (std::any_of(errors.begin(), errors.end(),
+                            [](const std::string& error) { return !error.empty(); })) {
+                json results = json::array();
+                for (size_t i = 0; i < orders.size(); ++i) {
+                    results.push_back(
+                        {{"order_id", orders[i].getId()},
+                         {"status", errors[i].empty() ? "NOT_SUBMITTED" : "REJECTED"}});
+                    if (!errors[i].empty()) {
+                        results.back()["reason"] = errors[i];
+                    }
+                }
+                network::HttpResponse response;
+                response.status_code = 400;
+                response.body = json{{"error", "Batch rejected"}, {"results", std::move(results)}}
+                                    .dump();
+                response.headers["Content-Type"] = "application/json";
+                co_return response;
+            }
+
+            // Validation guarantees a single user, whose bucket is charged for the whole batch
+            if (auto limited = checkRateLimit(orders.front().getUserId(),
+                                              static_cast<uint32_t>(orders.size()))) {
+                co_return *limited;
+            }
+
+            std::vector<std::string> keys(orders.size());
+            std::vector<OrderCompletions::Ticket> tickets(orders.size());
+            if (sync_ack_timeout_.count() > 0) {
+                for (size_t i = 0; i < orders.size(); ++i) {
+                    keys[i] = completionKey(orders[i].getUserId(), orders[i].getId());
+                    tickets[i] = order_completions_.expect(keys[i]);
+                }
+            }
+
+            if (!publishOrderBatch(orders)) {
+                for (size_t i = 0; i < orders.size(); ++i) {
+                    if (tickets[i]) {
+                        order_completions_.abandon(keys[i], tickets[i]);
+                    }
+                }
+                app_logger_->log(logging::LogLevel::ERROR, "Failed to publish order batch");
+                co_return createErrorResponse(500, "Failed to queue batch for processing");
+            }
+
+            if (sync_ack_timeout_.count() == 0) {
+                json order_ids = json::array();
+                for (const auto& order : orders) {
+                    order_ids.push_back(order.getId());
+                }
+                network::HttpResponse response;
+                response.status_code = 202;  // Accepted
+                response.body = json{{"status", "batch accepted for processing"},
+                                     {"order_ids", std::move(order_ids)}}
+                                    .dump();
+                response.headers["Content-Type"] = "application/json";
+                co_return response;
+            }
+
+            // One deadline for the whole batch; orders without an outcome by then are QUEUED
+            const auto deadline = std::chrono::steady_clock::now() + sync_ack_timeout_;
+            json results = json::array();
+            for (size_t i = 0; i < orders.size(); ++i) {
+                std::optional<OrderResult> result;
+                if (tickets[i]) {
+                    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - std::chrono::steady_clock::now());
+                    result = co_await awaitOrderResult(
+                        keys[i], tickets[i], std::max(remaining, std::chrono::milliseconds(0)));
+                }
+                const std::string order_id(orders[i].getId());
+                results.push_back(result ? orderResultToJson(order_id, *result)
+                                         : json{{"order_id", order_id}, {"status", "QUEUED"}});
+            }
+
+            network::HttpResponse response;
+            response.status_code = 200;
+            response.body = json{{"results", std::move(results)}}.dump();
+            response.headers["Content-Type"] = "application/json";
+            co_return response;
+
+        } catch (const json::exception& e) {
+            co_return createErrorResponse(400, "Invalid JSON format: " + std::string(e.what()));
+        } catch (const std::invalid_argument& e) {
+            co_return createErrorResponse(400, e.what());
+        }
+    }
+
+    network::HttpResponse handleCancelAllRequest(const network::HttpRequest& request) {
+        try {
+            auto json_body = json::parse(request.body);
+            if (!json_body.contains("userId")) {
+                throw std::invalid_argument("Request must contain 'userId'");
+            }
+
+            // Applied synchronously so a client can pull its quotes immediately; cancels are
+            // allowed even while trading is suspended
+            std::string user_id = json_body.at("userId");
+            std::string symbol = json_body.value("symbol", "");
+            std::vector<std::shared_ptr<core::Order>> cancelled;
+            {
+                std::lock_guard<std::mutex> book_lock(book_mutex_);
+                cancelled = matching_engine_->cancelUserOrders(user_id, symbol);
+                recordTerminal(cancelled, core::OrderStatus::CANCELLED);
+            }
+
+            app_logger_->log(logging::LogLevel::INFO,
+                             "Cancelled " + std::to_string(cancelled.size()) +
+                                 " orders for user " + user_id);
+            return createCancelResponse(cancelled);
+
+        } catch (const json::exception& e) {
+            return createErrorResponse(400, "Invalid JSON format: " + std::string(e.what()));
+        } catch (const std::invalid_argument& e) {
+            return createErrorResponse(400, e.what());
+        }
+    }
+
+    OrderResult processAmend(const core::OrderRequest& order_request) {
+        const std::string id(order_request.getId());
+        const std::string user_id(order_request.getUserId());
+
+        std::optional<double> quantity;
+        std::optional<double> price;
+        if (order_request.has_quantity)
+            quantity = order_request.quantity;
+        if (order_request.has_price)
+            price = order_request.price;
+
+        auto orderbook = matching_engine_->getOrderBook(std::string(order_request.getSymbol()));
+        const core::UserId user = core::internUser(user_id);
+        auto order = orderbook ? orderbook->findOrder(user, id) : nullptr;
+        if (!order) {
+            app_logger_->log(logging::LogLevel::ERROR,
+                             "Amend rejected: no resting order " + id + " for user " + user_id);
+            return rejectedResult("No resting order " + id + " for user " + user_id);
+        }
+
+        // The amended order must pass the same bands and market hours as a new one
+        auto validation_result = validator_->validateAmend(*order, order_request);
+        if (!validation_result.is_valid) {
+            app_logger_->log(logging::LogLevel::ERROR,
+                             "Amend rejected for order " + id + ": " +
+                                 validation_result.error_message);
+            return rejectedResult(validation_result.error_message);
+        }
+
+        const core::OrderHandle handle = order->getHandle();
+        auto result = matching_engine_->amendOrder(user, id, quantity, price, *orderbook);
+        switch (result.status) {
+            case core::AmendStatus::AMENDED_IN_PLACE:
+                app_logger_->log(logging::LogLevel::INFO,
+                                 "Order " + id + " amended in place (priority kept)");
+                break;
+            case core::AmendStatus::REQUEUED:
+                app_logger_->log(logging::LogLevel::INFO,
+                                 "Order " + id + " amended and requeued, generated " +
+                                     std::to_string(result.trades.size()) + " trades");
+                break;
+            case core::AmendStatus::NOT_FOUND:
+            case core::AmendStatus::INVALID:
+                app_logger_->log(logging::LogLevel::ERROR, "Amend rejected for order " + id);
+                return rejectedResult("Amend rejected for order " + id);
+        }
+
+        OrderResult amended;
+        amended.status = "AMENDED";
+        collectFills(amended, handle, result.trades);
+        auto resting = orderbook->findOrder(user, id);
+        amended.remaining_quantity = resting ? resting->getQuantity() : 0.0;
+        if (resting) {
+            order_states_->recordAmend(user_id, id, resting->getQuantity(), resting->getPrice(),
+                                       utils::defaultClock()->nowNanos());
+        }
+        return amended;
+    }
+
+    // Cancels and expiries change both the orders and their books; book_mutex_ held
+    void recordTerminal(const std::vector<std::shared_ptr<core::Order>>& orders,
+                        core::OrderStatus status) {
+        const int64_t now_ns = utils::defaultClock()->nowNanos();
+        std::unordered_set<std::string> symbols;
+        for (const auto& order : orders) {
+            order_states_->recordStatus(order->getUserId(), order->getId(), status, 0.0, now_ns);
+            publishOrderEvent(order->getUserId(), order->getId());
+            symbols.insert(order->getSymbol());
+        }
+        for (const auto& symbol : symbols) {
+            publishBookUpdates(symbol);
+        }
+    }
+
+    // Pushes an order's latest state to its owner's order-event channel
+    void publishOrderEvent(std::string_view user_id, std::string_view order_id) {
+        if (!ws_hub_ || !ws_hub_->hasSubscribers()) {
+            return;
+        }
+        auto state = order_states_->find(user_id, order_id);
+        if (!state) {
+            return;
+        }
+        const std::string channel = "orders." + std::string(state->getUserId());
+        if (ws_hub_->hasSubscribers(channel)) {
+            network::BodyWriter writer(network::BodyFormat::JSON);
+            writeOrderState(writer, *state);
+            ws_hub_->publish(channel, writer.take());
+        }
+    }
+
+    // Called after every change to symbol's book: advances the versions conditional GETs
+    // compare against and streams top-of-book and depth changes; book_mutex_ held
+    void publishBookUpdates(const std::string& symbol) {
+        auto orderbook = matching_engine_->getOrderBook(symbol);
+        if (orderbook) {
+            orderbook->bumpVersion();
+        }
+        market_version_.bump();
+
+        if (!ws_hub_ || !ws_hub_->hasSubscribers()) {
+            return;
+        }
+        const std::string book_channel = "book." + symbol;
+        const std::string depth_channel = "depth." + symbol;
+        const bool book_wanted = ws_hub_->hasSubscribers(book_channel);
+        const bool depth_wanted = ws_hub_->hasSubscribers(depth_channel);
+        if ((!book_wanted && !depth_wanted) || !orderbook) {
+            return;
+        }
+
+        MarketView& view = market_views_[symbol];
+        if (book_wanted) {
+            std::string top = topOfBookJson(orderbook->getDepth(core::OrderSide::BUY, 1),
+                                            orderbook->getDepth(core::OrderSide::SELL, 1))
+                                  .dump();
+            if (top != view.top_of_book) {
+                // Only the latest top of book matters to a reader that has fallen behind
+                ws_hub_->publish(book_channel, top, book_channel);
+                view.top_of_book = std::move(top);
+            }
+        }
+        if (depth_wanted) {
+            auto bids = orderbook->getDepth(core::OrderSide::BUY, depth_levels_);
+            auto asks = orderbook->getDepth(core::OrderSide::SELL, depth_levels_);
+            publishDepthChanges(depth_channel, "bid", view.bids, bids);
+            publishDepthChanges(depth_channel, "ask", view.asks, asks);
+            view.bids = std::move(bids);
+            view.asks = std::move(asks);
+        }
+    }
+
+    // Deltas carry a level's new total (0 once it leaves the top depth_levels_), so each level
+    // can be conflated independently for slow readers
+    void publishDepthChanges(const std::string& channel, const std::string& side,
+                             const std::vector<core::DepthLevel>& before,
+                             const std::vector<core::DepthLevel>& after) {
+        const auto quantityAt = [](const std::vector<core::DepthLevel>& levels, double price) {
+            for (const auto& level : levels) {
+                if (level.price == price) {
+                    return level.quantity;
+                }
+            }
+            return 0.0;
+        };
+        const auto send = [&](double price, double quantity) {
+            ws_hub_->publish(channel,
+                             json{{"side", side}, {"price", price}, {"quantity", quantity}}.dump(),
+                             channel + ':' + side + ':' + std::to_string(price));
+        };
+
+        for (const auto& level : after) {
+            if (quantityAt(before, level.price) != level.quantity) {
+                send(level.price, level.quantity);
+            }
+        }
+        for (const auto& level : before) {
+            if (quantityAt(after, level.price) == 0.0) {
+                send(level.price, 0.0);
+            }
+        }
+    }
+
+    // Runs on the hub's I/O thread right after a client subscribes
+    void sendStreamSnapshot(const std::string& channel, const network::WebSocketHub::Sender& send) {
+        const size_t dot = channel.find('.');
+        const std::string kind = channel.substr(0, dot);
+        const std::string key = channel.substr(dot + 1);
+
+        if (kind == "orders") {
+            const auto states = order_states_->findByUser(key);
+            network::BodyWriter writer(network::BodyFormat::JSON);
+            writer.beginArray(states.size());
+            for (const auto& state : states) {
+                writeOrderState(writer, state);
+            }
+            send(writer.endArray().take());
+            return;
+        }
+        if (kind != "book" && kind != "depth") {
+            return;  // Trades carry no state to catch up on
+        }
+
+        // Taken under the book lock so no update older than the snapshot is queued after it
+        std::lock_guard<std::mutex> book_lock(book_mutex_);
+        auto orderbook = matching_engine_->getOrderBook(key);
+        MarketView& view = market_views_[key];
+        if (kind == "book") {
+            std::vector<core::DepthLevel> bids;
+            std::vector<core::DepthLevel> asks;
+            if (orderbook) {
+                bids = orderbook->getDepth(core::OrderSide::BUY, 1);
+                asks = orderbook->getDepth(core::OrderSide::SELL, 1);
+            }
+            view.top_of_book = topOfBookJson(bids, asks).dump();
+            send(view.top_of_book);
+            return;
+        }
+
+        view.bids.clear();
+        view.asks.clear();
+        if (orderbook) {
+            view.bids = orderbook->getDepth(core::OrderSide::BUY, depth_levels_);
+            view.asks = orderbook->getDepth(core::OrderSide::SELL, depth_levels_);
+        }
+        send(json{{"bids", depthJson(view.bids)}, {"asks", depthJson(view.asks)}}.dump());
+    }
+
+    // Keeps the trades an order took part in; matching can also release unrelated stop orders
+    static void collectFills(OrderResult& result, core::OrderHandle handle,
+                             const std::vector<core::Trade>& trades) {
+        for (const auto& trade : trades) {
+            if (trade.buy_order == handle || trade.sell_order == handle) {
+                result.filled_quantity += trade.quantity;
+                result.fills.push_back(trade);
+            }
         }
     }
 
+    // Stops direct ingress from matching anything further; the journal can no longer vouch
+    // for what reached the disk
+    void failJournal(const std::string& message) {
+        journal_failed_ = true;
+        app_logger_->log(logging::LogLevel::ERROR,
+                         message + "; rejecting direct ingress orders until restart");
+    }
+
     void processOrderFromQueue(const messaging::Message& msg) {
+        if (!msg.value.empty() && msg.value.front() == kOrderBatchMarker) {
+            processOrderBatchFromQueue(msg);
+            return;
+        }
         try {
-            // Check if trading is active
-            if (!trading_active_) {
-                app_logger_->log(logging::LogLevel::INFO,
-                                 "Skipping order processing - trading suspended");
-                return;
+            const auto order_request = decodeOrderRequest(json::parse(msg.value));
+            order_completions_.complete(
+                completionKey(order_request.getUserId(), order_request.getId()),
+                processOrderRequest(order_request));
+        } catch (const json::exception& e) {
+            app_logger_->log(logging::LogLevel::ERROR,
+                             "Failed to parse order from queue: " + std::string(e.what()));
+        } catch (const std::invalid_argument& e) {
+            app_logger_->log(logging::LogLevel::ERROR,
+                             "Invalid data in order from queue: " + std::string(e.what()));
+        }
+    }
+
+    void processOrderBatchFromQueue(const messaging::Message& msg) {
+        const size_t size = msg.value.size() - 1;
+        if (size % sizeof(core::OrderRequest) != 0) {
+            app_logger_->log(logging::LogLevel::ERROR, "Malformed order batch from queue");
+            return;
+        }
+        core::OrderRequest order_request;
+        for (size_t offset = 1; offset < msg.value.size(); offset += sizeof(order_request)) {
+            if (!isWellFormed(msg.value.data() + offset)) {
+                app_logger_->log(logging::LogLevel::ERROR,
+                                 "Malformed order record in batch from queue");
+                continue;
             }
+            std::memcpy(&order_request, msg.value.data() + offset, sizeof(order_request));
+            order_completions_.complete(
+                completionKey(order_request.getUserId(), order_request.getId()),
+                processOrderRequest(order_request));
+        }
+    }
 
-            auto json_body = json::parse(msg.value);
+    // Applies one decoded request to the books; runs on the queue consumer or ring matcher
+    OrderResult processOrderRequest(const core::OrderRequest& order_request) {
+        orders_consumed_.fetch_add(1, std::memory_order_relaxed);
 
-            // Extract order data safely
-            std::string id = json_body.at("id");
-            std::string userId = json_body.at("userId");
-            std::string symbol = json_body.at("symbol");
-            std::string type_str = json_body.at("type");
-            std::string side_str = json_body.at("side");
-            double quantity = json_body.at("quantity");
+        // Check if trading is active
+        if (!trading_active_) {
+            app_logger_->log(logging::LogLevel::INFO,
+                             "Skipping order processing - trading suspended");
+            return rejectedResult("Trading is currently suspended");
+        }
 
-            // Log processing but without the full message body for performance
-            app_logger_->log(logging::LogLevel::INFO, "Processing order from queue: " + id);
+        // Second line of defence for producers that bypass the HTTP ingress
+        if (consumer_limiter_ &&
+            !consumer_limiter_
+                 ->tryAcquire(order_request.getUserId(), utils::defaultClock()->nowNanos())
+                 .allowed) {
+            return rejectedResult("Order rate limit exceeded");
+        }
 
-            core::OrderType type = stringToOrderType(type_str);
-            core::OrderSide side = stringToOrderSide(side_str);
+        // Books are shared with the synchronous cancel endpoints
+        std::lock_guard<std::mutex> book_lock(book_mutex_);
+
+        OrderResult result = order_request.action == core::OrderRequest::Action::AMEND
+                                 ? processAmend(order_request)
+                                 : processNewOrder(order_request);
+        // Stops released by this request's trades are gone once they run out of liquidity
+        recordTerminal(matching_engine_->takeCancelledStops(), core::OrderStatus::CANCELLED);
+        // Streamed while the books are still locked, so they interleave correctly with the
+        // snapshots sent to new subscribers
+        publishBookUpdates(std::string(order_request.getSymbol()));
+        publishOrderEvent(order_request.getUserId(), order_request.getId());
+        return result;
+    }
 
-            double price = 0.0;
-            if (type == core::OrderType::LIMIT || type == core::OrderType::STOP) {
-                price = json_body.at("price");
-            }
+    OrderResult processNewOrder(const core::OrderRequest& order_request) {
+        const std::string id(order_request.getId());
+        const std::string user_id(order_request.getUserId());
+        const std::string symbol(order_request.getSymbol());
+        const core::OrderType type = order_request.type;
 
-            // Create order object
-            core::Order order(id, userId, symbol, type, side, quantity, price);
+        // Log processing but without the full message body for performance
+        app_logger_->log(logging::LogLevel::INFO, "Processing order: " + id);
 
-            // Validate order
-            auto validation_result = validator_->validate(std::make_shared<core::Order>(order));
-            if (!validation_result.is_valid) {
-                app_logger_->log(logging::LogLevel::ERROR, "Invalid order from queue rejected: " +
-                                                               validation_result.error_message);
-                // Optionally, publish to a "dead-letter" or "rejected-orders" topic
-                return;
-            }
+        // Create order object in the book's order pool
+        auto order_ptr =
+            core::makeOrder(id, user_id, symbol, type, order_request.side, order_request.quantity,
+                            order_request.price);
 
-            // Add order to matching engine
-            auto orderbook = matching_engine_->getOrderBook(symbol);
+        // Track the order from here on so fills during matching land on its record
+        const int64_t now_ns = utils::defaultClock()->nowNanos();
+        order_states_->recordNew(*order_ptr, now_ns);
 
-            if (!orderbook) {
-                orderbook = std::make_shared<core::OrderBook>(symbol);
-                matching_engine_->addOrderBook(symbol, orderbook);
-            }
+        // Validate order
+        auto validation_result = validator_->validate(order_ptr);
+        if (!validation_result.is_valid) {
+            order_states_->recordStatus(user_id, id, core::OrderStatus::REJECTED, 0.0, now_ns);
+            app_logger_->log(logging::LogLevel::ERROR,
+                             "Invalid order rejected: " + validation_result.error_message);
+            // Optionally, publish to a "dead-letter" or "rejected-orders" topic
+            return rejectedResult(validation_result.error_message);
+        }
 
-            auto order_ptr = std::make_shared<core::Order>(order);
-            if (!orderbook->addOrder(order_ptr)) {
-                app_logger_->log(logging::LogLevel::ERROR,
-                                 "Failed to add order " + id + " to order book");
-                return;
-            }
+        // Add order to matching engine
+        auto orderbook = matching_engine_->getOrderBook(symbol);
 
-            // Match the order against existing orders in the book
-            auto trades = matching_engine_->matchOrder(order_ptr, *orderbook);
+        if (!orderbook) {
+            orderbook = std::make_shared<core::OrderBook>(symbol);
+            matching_engine_->addOrderBook(symbol, orderbook);
+        }
 
-            // Log info about generated trades
-            if (!trades.empty()) {
-                app_logger_->log(
-                    logging::LogLevel::INFO,
-                    "Order " + id + " generated " + std::to_string(trades.size()) + " trades");
-            }
-        } catch (const json::exception& e) {
-            app_logger_->log(logging::LogLevel::ERROR,
-                             "Failed to parse order from queue: " + std::string(e.what()));
-        } catch (const std::invalid_argument& e) {
+        // Only limit orders rest in the book; market orders execute immediately and stop
+        // orders wait in the matching engine's trigger index
+        if (type == core::OrderType::LIMIT && !orderbook->addOrder(order_ptr)) {
             app_logger_->log(logging::LogLevel::ERROR,
-                             "Invalid data in order from queue: " + std::string(e.what()));
+                             "Failed to add order " + id + " to order book");
+            order_states_->recordStatus(user_id, id, core::OrderStatus::REJECTED, 0.0, now_ns);
+            return rejectedResult("Failed to add order to order book");
+        }
+
+        // Match the order against existing orders in the book
+        auto trades = matching_engine_->matchOrder(order_ptr, *orderbook);
+
+        // Log info about generated trades
+        if (!trades.empty()) {
+            app_logger_->log(
+                logging::LogLevel::INFO,
+                "Order " + id + " generated " + std::to_string(trades.size()) + " trades");
+        }
+
+        const bool resting =
+            orderbook->findOrder(order_ptr->getUserKey(), id) == order_ptr;
+        if (order_request.has_expiry && resting) {
+            matching_engine_->scheduleExpiry(order_ptr, order_request.expire_at_ms * 1'000'000);
+        }
+
+        OrderResult result;
+        collectFills(result, order_ptr->getHandle(), trades);
+        result.remaining_quantity = std::max(0.0, order_request.quantity - result.filled_quantity);
+        if (result.remaining_quantity <= 0.0) {
+            result.status = "FILLED";
+        } else if (resting) {
+            result.status = result.fills.empty() ? "RESTED" : "PARTIALLY_FILLED";
+        } else if (type == core::OrderType::STOP &&
+                   order_ptr->getStatus() == core::OrderStatus::PENDING) {
+            result.status = "ACCEPTED";  // Parked until its trigger price
+        } else {
+            // Market orders and triggered stops never rest; whatever did not fill is dropped
+            result.status = result.fills.empty() ? "CANCELLED" : "PARTIALLY_FILLED";
+            result.reason = "Insufficient liquidity";
+            order_states_->recordStatus(user_id, id, core::OrderStatus::CANCELLED, 0.0,
+                                        utils::defaultClock()->nowNanos());
+        }
+        return result;
+    }
+
+    void housekeepingLoop() {
+        while (housekeeping_running_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            size_t expired = 0;
+            {
+                std::lock_guard<std::mutex> book_lock(book_mutex_);
+                auto expired_orders = matching_engine_->expireOrders();
+                recordTerminal(expired_orders, core::OrderStatus::EXPIRED);
+                expired = expired_orders.size();
+            }
+            order_states_->evictExpired(utils::defaultClock()->nowNanos());
+            if (expired > 0) {
+                app_logger_->log(logging::LogLevel::INFO,
+                                 "Expired " + std::to_string(expired) + " orders");
+            }
         }
     }
 
@@ -446,6 +1931,197 @@ class TradingEngine {
         return response;
     }
 
+    static void writeOrderState(network::BodyWriter& writer, const core::OrderState& state) {
+        static constexpr const char* kStatusNames[] = {"PENDING",  "PARTIALLY_FILLED", "FILLED",
+                                                       "REJECTED", "CANCELLED",        "EXPIRED"};
+        writer.beginMap(12)
+            .field("order_id", state.getId())
+            .field("user_id", state.getUserId())
+            .field("symbol", state.getSymbol())
+            .field("type", orderTypeToString(state.type))
+            .field("side", orderSideToString(state.side))
+            .field("status", kStatusNames[static_cast<size_t>(state.status)])
+            .field("quantity", state.quantity)
+            .field("filled_quantity", state.filled_quantity)
+            .field("remaining_quantity", state.remaining_quantity)
+            .field("price", state.price)
+            .field("average_fill_price", state.average_fill_price)
+            .field("updated_ns", state.updated_ns)
+            .endMap();
+    }
+
+    // Served from the order state store only; never touches the books or book_mutex_
+    network::HttpResponse handleOrderStatusRequest(const network::HttpRequest& request) {
+        auto it = request.path_params.find("id");
+        if (it == request.path_params.end()) {
+            return createErrorResponse(400, "Order id parameter is required");
+        }
+        // Client order ids are only unique per user
+        auto user_it = request.query_params.find("userId");
+        if (user_it == request.query_params.end() || user_it->second.empty()) {
+            return createErrorResponse(400, "userId query parameter is required");
+        }
+        const std::string& user_id = user_it->second;
+
+        auto state = order_states_->find(user_id, it->second);
+        if (!state) {
+            return createErrorResponse(404, "Order not found: " + it->second);
+        }
+
+        // An order's version is the time of its last update; every update is followed by a bump
+        // of the market version
+        std::string etag;
+        const auto order_version = [&]() -> uint64_t {
+            auto latest = order_states_->find(user_id, it->second);
+            return latest ? static_cast<uint64_t>(latest->updated_ns) : 0;
+        };
+        if (auto not_modified = checkNotModified(request, order_version, etag)) {
+            return *not_modified;
+        }
+        // Re-read so the ETag names the version actually served
+        state = order_states_->find(user_id, it->second);
+        if (!state) {
+            return createErrorResponse(404, "Order not found: " + it->second);
+        }
+        etag = makeETag(request, static_cast<uint64_t>(state->updated_ns));
+
+        const auto format = network::negotiateBodyFormat(headerValue(request, "Accept"));
+        network::BodyWriter writer(format, responseBuffer());
+        writeOrderState(writer, *state);
+        return createEncodedResponse(format, writer.take(), etag);
+    }
+
+    network::HttpResponse handleUserOrdersRequest(const network::HttpRequest& request) {
+        auto it = request.path_params.find("id");
+        if (it == request.path_params.end()) {
+            return createErrorResponse(400, "User id parameter is required");
+        }
+
+        std::string etag;
+        if (auto not_modified = checkNotModified(
+                request, [this] { return market_version_.current(); }, etag)) {
+            return *not_modified;
+        }
+
+        auto states = order_states_->findByUser(it->second);
+        std::sort(states.begin(), states.end(), [](const auto& a, const auto& b) {
+            return a.updated_ns > b.updated_ns;
+        });
+
+        const auto format = network::negotiateBodyFormat(headerValue(request, "Accept"));
+        network::BodyWriter writer(format, responseBuffer());
+        writer.beginMap(3)
+            .field("user_id", it->second)
+            .field("count", states.size())
+            .key("orders")
+            .beginArray(states.size());
+        for (const auto& state : states) {
+            writeOrderState(writer, state);
+        }
+        writer.endArray().endMap();
+        return createEncodedResponse(format, writer.take(), etag);
+    }
+
+    // Conditional GET for a resource whose content is identified by version(). Returns a 304
+    // while the client's If-None-Match still names the current version, before the handler
+    // serializes or locks anything; otherwise sets etag for the fresh response.
+    std::optional<network::HttpResponse> checkNotModified(
+        const network::HttpRequest& request, const std::function<uint64_t()>& version,
+        std::string& etag) {
+        etag = makeETag(request, version());
+        const std::string if_none_match = headerValue(request, "If-None-Match");
+        if (if_none_match.empty() || !etagMatches(if_none_match, etag)) {
+            return std::nullopt;
+        }
+
+        network::HttpResponse response;
+        response.status_code = 304;
+        response.headers["ETag"] = etag;
+        return response;
+    }
+
+    using ReadHandler = network::HttpResponse (TradingEngine::*)(const network::HttpRequest&);
+
+    // Registers a conditional GET that clients may long-poll; changes is bumped whenever the
+    // handler's answer may have moved on
+    void registerLongPollRoute(const std::string& path_pattern, ReadHandler handler,
+                               const utils::VersionCounter& changes) {
+        http_server_->registerAsyncRoute(
+            "GET", path_pattern, [this, handler, &changes](const network::HttpRequest& request) {
+                return serveLongPoll(request, handler, changes);
+            });
+    }
+
+    // Runs a conditional GET. With ?wait=<ms>, a client already holding the current version (a
+    // 304) is parked until changes is bumped and the handler runs again, until it answers with a
+    // new version or the wait runs out. A parked request holds no thread, only its coroutine.
+    utils::Task<network::HttpResponse> serveLongPoll(const network::HttpRequest& request,
+                                                     ReadHandler handler,
+                                                     const utils::VersionCounter& changes) {
+        // Read before each run so a bump in between is not slept through
+        uint64_t seen = changes.current();
+        network::HttpResponse response = (this->*handler)(request);
+        const std::chrono::milliseconds wait = longPollWait(request);
+        if (response.status_code != 304 || wait.count() <= 0) {
+            co_return response;
+        }
+        // Bounds the coroutines and change callbacks held at once
+        if (long_polls_.fetch_add(1) >= max_long_polls_) {
+            long_polls_.fetch_sub(1);
+            co_return response;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + wait;
+        while (response.status_code == 304) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                break;
+            }
+            auto changed = http_server_->waitFor(
+                [&changes, seen](std::function<void()> notify) {
+                    changes.onChange(seen, std::move(notify));
+                },
+                remaining);
+            co_await changed;
+            seen = changes.current();
+            response = (this->*handler)(request);
+        }
+        long_polls_.fetch_sub(1);
+        co_return response;
+    }
+
+    // The request's ?wait=<ms>, capped at the configured maximum; zero if absent or malformed
+    std::chrono::milliseconds longPollWait(const network::HttpRequest& request) const {
+        auto wait_it = request.query_params.find("wait");
+        if (wait_it == request.query_params.end() || max_long_poll_.count() <= 0) {
+            return std::chrono::milliseconds(0);
+        }
+        try {
+            return std::min(std::chrono::milliseconds(std::stoll(wait_it->second)),
+                            max_long_poll_);
+        } catch (const std::exception&) {
+            return std::chrono::milliseconds(0);  // Malformed wait: answer immediately
+        }
+    }
+
+    // Versions restart with the process, so the start time keeps ETags from an earlier run
+    // from matching. Each body encoding is a different representation with its own tag.
+    std::string makeETag(const network::HttpRequest& request, uint64_t version) const {
+        std::string etag = "\"" + etag_epoch_ + "-" + std::to_string(version);
+        switch (network::negotiateBodyFormat(headerValue(request, "Accept"))) {
+            case network::BodyFormat::CBOR:
+                etag += "-cbor";
+                break;
+            case network::BodyFormat::MSGPACK:
+                etag += "-msgpack";
+                break;
+            case network::BodyFormat::JSON:
+                break;
+        }
+        return etag + "\"";
+    }
+
     network::HttpResponse handleOrderBookRequest(const network::HttpRequest& request) {
         try {
             // Extract symbol from path parameters
@@ -469,14 +2145,14 @@ class TradingEngine {
                 return response;
             }
 
-            // Get orderbook data as JSON
-            std::string orderbook_json = orderbook->toJSON();
+            std::string etag;
+            if (auto not_modified = checkNotModified(
+                    request, [&orderbook] { return orderbook->getVersion(); }, etag)) {
+                return *not_modified;
+            }
 
-            network::HttpResponse response;
-            response.status_code = 200;
-            response.body = orderbook_json;
-            response.headers["Content-Type"] = "application/json";
-            return response;
+            const auto format = network::negotiateBodyFormat(headerValue(request, "Accept"));
+            return createEncodedResponse(format, orderbook->encode(format), etag);
 
         } catch (const std::exception& e) {
             network::HttpResponse response;
@@ -504,42 +2180,44 @@ class TradingEngine {
                 return createErrorResponse(503, "Statistics collector not available");
             }
 
+            std::string etag;
+            if (auto not_modified = checkNotModified(
+                    request, [this] { return stats_collector_->version().current(); }, etag)) {
+                return *not_modified;
+            }
+
             // Get statistics for the symbol
             auto stats_opt = stats_collector_->getStatsForSymbol(symbol);
             if (!stats_opt.has_value()) {
                 return createErrorResponse(404, "No statistics available for symbol: " + symbol);
             }
 
-            json response_json;
-            response_json["symbol"] = symbol;
-            response_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
-                                             std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
-
+            const auto format = network::negotiateBodyFormat(headerValue(request, "Accept"));
+            network::BodyWriter writer(format, responseBuffer());
             if (timeframe_it != request.path_params.end()) {
                 // Return specific timeframe data
-                std::string timeframe = timeframe_it->second;
-                auto& timeframes = stats_opt->timeframes;
-                auto tf_it = timeframes.find(timeframe);
-
-                if (tf_it == timeframes.end()) {
-                    return createErrorResponse(404,
-                                               "No data available for timeframe: " + timeframe);
+                auto tf_it = stats_opt->timeframes.find(timeframe_it->second);
+                if (tf_it == stats_opt->timeframes.end()) {
+                    return createErrorResponse(
+                        404, "No data available for timeframe: " + timeframe_it->second);
                 }
-
-                response_json["timeframe"] = timeframe;
-                response_json["data"] = tf_it->second.toJson();
-                response_json["last_trade_price"] = stats_opt->last_trade_price;
+                writer.beginMap(5)
+                    .field("symbol", symbol)
+                    .field("timestamp", coarse_clock_->nowSeconds())
+                    .field("timeframe", tf_it->first)
+                    .key("data");
+                writeBucket(writer, tf_it->second);
+                writer.field("last_trade_price", stats_opt->last_trade_price).endMap();
             } else {
                 // Return all timeframes
-                response_json["data"] = stats_opt->toJson();
+                writer.beginMap(3)
+                    .field("symbol", symbol)
+                    .field("timestamp", coarse_clock_->nowSeconds())
+                    .key("data");
+                writeInstrumentStats(writer, *stats_opt);
+                writer.endMap();
             }
-
-            network::HttpResponse response;
-            response.status_code = 200;
-            response.body = response_json.dump();
-            response.headers["Content-Type"] = "application/json";
-            return response;
+            return createEncodedResponse(format, writer.take(), etag);
 
         } catch (const std::exception& e) {
             return createErrorResponse(500, "Internal server error: " + std::string(e.what()));
@@ -547,30 +2225,32 @@ class TradingEngine {
     }
 
     network::HttpResponse handleAllStatsRequest(const network::HttpRequest& request) {
-        (void)request;  // Suppress unused parameter warning
         try {
             if (!stats_collector_ || !stats_collector_->isRunning()) {
                 return createErrorResponse(503, "Statistics collector not available");
             }
 
-            auto all_stats = stats_collector_->getAllStats();
+            std::string etag;
+            if (auto not_modified = checkNotModified(
+                    request, [this] { return stats_collector_->version().current(); }, etag)) {
+                return *not_modified;
+            }
 
-            json response_json;
-            response_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
-                                             std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
-            response_json["total_symbols"] = all_stats.size();
-            response_json["symbols"] = json::object();
+            auto all_stats = stats_collector_->getAllStats();
 
+            const auto format = network::negotiateBodyFormat(headerValue(request, "Accept"));
+            network::BodyWriter writer(format, responseBuffer());
+            writer.beginMap(3)
+                .field("timestamp", coarse_clock_->nowSeconds())
+                .field("total_symbols", all_stats.size())
+                .key("symbols")
+                .beginMap(all_stats.size());
             for (const auto& [symbol, stats] : all_stats) {
-                response_json["symbols"][symbol] = stats.toJson();
+                writer.key(symbol);
+                writeInstrumentStats(writer, stats);
             }
-
-            network::HttpResponse response;
-            response.status_code = 200;
-            response.body = response_json.dump();
-            response.headers["Content-Type"] = "application/json";
-            return response;
+            writer.endMap().endMap();
+            return createEncodedResponse(format, writer.take(), etag);
 
         } catch (const std::exception& e) {
             return createErrorResponse(500, "Internal server error: " + std::string(e.what()));
@@ -578,22 +2258,18 @@ class TradingEngine {
     }
 
     network::HttpResponse handleStatsSummaryRequest(const network::HttpRequest& request) {
-        (void)request;  // Suppress unused parameter warning
         try {
             if (!stats_collector_ || !stats_collector_->isRunning()) {
                 return createErrorResponse(503, "Statistics collector not available");
             }
 
-            auto all_stats = stats_collector_->getAllStats();
+            std::string etag;
+            if (auto not_modified = checkNotModified(
+                    request, [this] { return stats_collector_->version().current(); }, etag)) {
+                return *not_modified;
+            }
 
-            json response_json;
-            response_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
-                                             std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
-            response_json["total_symbols"] = all_stats.size();
-            response_json["total_trades_processed"] = stats_collector_->getTotalTradesProcessed();
-            response_json["total_trades_dropped"] = stats_collector_->getTotalTradesDropped();
-            response_json["queue_size"] = stats_collector_->getQueueSize();
+            auto all_stats = stats_collector_->getAllStats();
 
             // Market-wide aggregates
             double total_volume = 0.0;
@@ -618,19 +2294,27 @@ class TradingEngine {
                 }
             }
 
-            response_json["market_summary"] = {
-                {"total_volume", total_volume},
-                {"total_dollar_volume", total_dollar_volume},
-                {"total_trades", total_trades},
-                {"price_range",
-                 {{"min", min_price == std::numeric_limits<double>::max() ? 0.0 : min_price},
-                  {"max", max_price}}}};
-
-            network::HttpResponse response;
-            response.status_code = 200;
-            response.body = response_json.dump();
-            response.headers["Content-Type"] = "application/json";
-            return response;
+            const auto format = network::negotiateBodyFormat(headerValue(request, "Accept"));
+            network::BodyWriter writer(format, responseBuffer());
+            writer.beginMap(6)
+                .field("timestamp", coarse_clock_->nowSeconds())
+                .field("total_symbols", all_stats.size())
+                .field("total_trades_processed", stats_collector_->getTotalTradesProcessed())
+                .field("total_trades_dropped", stats_collector_->getTotalTradesDropped())
+                .field("queue_size", stats_collector_->getQueueSize())
+                .key("market_summary")
+                .beginMap(4)
+                .field("total_volume", total_volume)
+                .field("total_dollar_volume", total_dollar_volume)
+                .field("total_trades", total_trades)
+                .key("price_range")
+                .beginMap(2)
+                .field("min", min_price == std::numeric_limits<double>::max() ? 0.0 : min_price)
+                .field("max", max_price)
+                .endMap()
+                .endMap()
+                .endMap();
+            return createEncodedResponse(format, writer.take(), etag);
 
         } catch (const std::exception& e) {
             return createErrorResponse(500, "Internal server error: " + std::string(e.what()));
@@ -638,26 +2322,16 @@ class TradingEngine {
     }
 
     network::HttpResponse handleLeaderboardRequest(const network::HttpRequest& request) {
-        (void)request;  // Suppress unused parameter warning
         try {
-            auto& all_users = matching_engine_->getAllUsers();
-
-            if (all_users.empty()) {
-                json response_json;
-                response_json["timestamp"] =
-                    std::chrono::duration_cast<std::chrono::seconds>(
-                        std::chrono::system_clock::now().time_since_epoch())
-                        .count();
-                response_json["total_users"] = 0;
-                response_json["leaderboard"] = json::array();
-
-                network::HttpResponse response;
-                response.status_code = 200;
-                response.body = response_json.dump();
-                response.headers["Content-Type"] = "application/json";
-                return response;
+            // Net worth moves with fills and book prices, all of which bump the market version
+            std::string etag;
+            if (auto not_modified = checkNotModified(
+                    request, [this] { return market_version_.current(); }, etag)) {
+                return *not_modified;
             }
 
+            auto& all_users = matching_engine_->getAllUsers();
+
             // Calculate net worth for each user
             std::vector<std::pair<std::string, double>> user_networth_pairs;
 
@@ -710,34 +2384,34 @@ class TradingEngine {
                           return a.second > b.second;  // Higher net worth first
                       });
 
-            // Build response JSON
-            json response_json;
-            response_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
-                                             std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
-            response_json["total_users"] = user_networth_pairs.size();
-
-            json leaderboard = json::array();
+            // Build the response; every user in user_networth_pairs has a user record
+            const auto format = network::negotiateBodyFormat(headerValue(request, "Accept"));
+            network::BodyWriter writer(format, responseBuffer());
+            writer.beginMap(3)
+                .field("timestamp", coarse_clock_->nowSeconds())
+                .field("total_users", user_networth_pairs.size())
+                .key("leaderboard")
+                .beginArray(user_networth_pairs.size());
             int rank = 1;
             for (const auto& [user_id, net_worth] : user_networth_pairs) {
-                auto user_ptr = all_users.at(user_id);
-                if (!user_ptr)
-                    continue;
-
-                json user_entry;
-                user_entry["rank"] = rank++;
-                user_entry["user_id"] = user_id;
-                user_entry["net_worth"] = net_worth;
-                user_entry["cash_balance"] = user_ptr->getCashBalance();
-                user_entry["realized_pnl"] = user_ptr->getRealizedPnl();
-
-                // Calculate portfolio value
-                double portfolio_value = net_worth - user_ptr->getCashBalance();
-                user_entry["portfolio_value"] = portfolio_value;
+                const auto& user_ptr = all_users.at(user_id);
+                const auto& positions = user_ptr->getAllPositions();
+                const auto open_positions =
+                    std::count_if(positions.begin(), positions.end(),
+                                  [](const auto& entry) { return entry.second.quantity > 0.0; });
+
+                // Portfolio value is what the positions add to cash
+                writer.beginMap(7)
+                    .field("rank", rank++)
+                    .field("user_id", user_id)
+                    .field("net_worth", net_worth)
+                    .field("cash_balance", user_ptr->getCashBalance())
+                    .field("realized_pnl", user_ptr->getRealizedPnl())
+                    .field("portfolio_value", net_worth - user_ptr->getCashBalance())
+                    .key("positions")
+                    .beginArray(static_cast<size_t>(open_positions));
 
                 // Add position details
-                const auto& positions = user_ptr->getAllPositions();
-                json positions_json = json::array();
                 for (const auto& [symbol, position] : positions) {
                     if (position.quantity <= 0.0)
                         continue;
@@ -759,43 +2433,27 @@ class TradingEngine {
                         }
                     }
 
-                    json pos_json;
-                    pos_json["symbol"] = symbol;
-                    pos_json["quantity"] = position.quantity;
-                    pos_json["average_price"] = position.average_price;
-                    pos_json["current_price"] = market_price;
-                    pos_json["market_value"] = position.quantity * market_price;
-                    pos_json["unrealized_pnl"] =
-                        (market_price - position.average_price) * position.quantity;
-
-                    positions_json.push_back(pos_json);
+                    writer.beginMap(6)
+                        .field("symbol", symbol)
+                        .field("quantity", position.quantity)
+                        .field("average_price", position.average_price)
+                        .field("current_price", market_price)
+                        .field("market_value", position.quantity * market_price)
+                        .field("unrealized_pnl",
+                               (market_price - position.average_price) * position.quantity)
+                        .endMap();
                 }
-                user_entry["positions"] = positions_json;
-
-                leaderboard.push_back(user_entry);
+                writer.endArray().endMap();
             }
-
-            response_json["leaderboard"] = leaderboard;
-
-            network::HttpResponse response;
-            response.status_code = 200;
-            response.body = response_json.dump();
-            response.headers["Content-Type"] = "application/json";
-            return response;
+            writer.endArray().endMap();
+            return createEncodedResponse(format, writer.take(), etag);
 
         } catch (const std::exception& e) {
             return createErrorResponse(500, "Internal server error: " + std::string(e.what()));
         }
     }
 
-    void handleTrade(const core::Trade& trade) {
-        trade_logger_->logTrade(trade);
-
-        // Submit trade to statistics collector
-        if (stats_collector_ && stats_collector_->isRunning()) {
-            stats_collector_->submitTrade(trade);
-        }
-
+    void handleTradeConfirmation(const core::Trade& trade) {
         // Execute the trade
         execution::ExecutionResult result = executor_->execute(trade);
 
@@ -855,9 +2513,7 @@ class TradingEngine {
             response_json["status"] = "success";
             response_json["message"] = "Trading suspended - existing orders will be processed";
             response_json["trading_active"] = trading_active_;
-            response_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
-                                             std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
+            response_json["timestamp"] = coarse_clock_->nowSeconds();
 
             network::HttpResponse response;
             response.status_code = 200;
@@ -887,9 +2543,7 @@ class TradingEngine {
             response_json["status"] = "success";
             response_json["message"] = "Trading resumed";
             response_json["trading_active"] = trading_active_;
-            response_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
-                                             std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
+            response_json["timestamp"] = coarse_clock_->nowSeconds();
 
             network::HttpResponse response;
             response.status_code = 200;
@@ -902,6 +2556,40 @@ class TradingEngine {
         }
     }
 
+    network::HttpResponse handleAdminCancelOrders(const network::HttpRequest& request) {
+        if (!validateAdminPassword(request)) {
+            return createErrorResponse(401, "Unauthorized: Invalid admin credentials");
+        }
+
+        try {
+            auto json_body = json::parse(request.body);
+            std::string user_id = json_body.value("userId", "");
+            std::string symbol = json_body.value("symbol", "");
+            if (user_id.empty() && symbol.empty()) {
+                return createErrorResponse(400, "Request must contain 'userId' and/or 'symbol'");
+            }
+
+            std::vector<std::shared_ptr<core::Order>> cancelled;
+            {
+                std::lock_guard<std::mutex> book_lock(book_mutex_);
+                cancelled = user_id.empty() ? matching_engine_->cancelSymbolOrders(symbol)
+                                            : matching_engine_->cancelUserOrders(user_id, symbol);
+                recordTerminal(cancelled, core::OrderStatus::CANCELLED);
+            }
+
+            app_logger_->log(logging::LogLevel::WARNING,
+                             "Admin cancelled " + std::to_string(cancelled.size()) +
+                                 " orders (user: " + (user_id.empty() ? "*" : user_id) +
+                                 ", symbol: " + (symbol.empty() ? "*" : symbol) + ")");
+            return createCancelResponse(cancelled);
+
+        } catch (const json::exception& e) {
+            return createErrorResponse(400, "Invalid JSON format: " + std::string(e.what()));
+        } catch (const std::exception& e) {
+            return createErrorResponse(500, "Internal server error: " + std::string(e.what()));
+        }
+    }
+
     network::HttpResponse handleAdminFlushSystem(const network::HttpRequest& request) {
         if (!validateAdminPassword(request)) {
             return createErrorResponse(401, "Unauthorized: Invalid admin credentials");
@@ -915,16 +2603,15 @@ class TradingEngine {
 
             app_logger_->log(logging::LogLevel::WARNING, "Admin initiated system flush");
 
-            // For system flush, we'll remove order books by recreating them
-            std::vector<std::string> valid_symbols = {"AAPL", "MSFT", "GOOGL", "AMZN", "TSLA"};
+            // Cancel every resting order and pending stop in every book
             int cleared_orderbooks = 0;
-
-            for (const auto& symbol : valid_symbols) {
-                auto existing_orderbook = matching_engine_->getOrderBook(symbol);
-                if (existing_orderbook) {
-                    // Create a new empty orderbook to replace the existing one
-                    auto new_orderbook = std::make_shared<core::OrderBook>(symbol);
-                    matching_engine_->addOrderBook(symbol, new_orderbook);
+            size_t cancelled_orders = 0;
+            {
+                std::lock_guard<std::mutex> book_lock(book_mutex_);
+                for (const auto& symbol : matching_engine_->getSymbols()) {
+                    auto cancelled = matching_engine_->cancelSymbolOrders(symbol);
+                    recordTerminal(cancelled, core::OrderStatus::CANCELLED);
+                    cancelled_orders += cancelled.size();
                     cleared_orderbooks++;
                 }
             }
@@ -952,13 +2639,12 @@ class TradingEngine {
             response_json["message"] =
                 "System flushed - order books cleared, user portfolio reset limited by API";
             response_json["cleared_orderbooks"] = cleared_orderbooks;
+            response_json["cancelled_orders"] = cancelled_orders;
             response_json["noted_users"] = cleared_users;
             response_json["starting_cash"] = starting_cash;
             response_json["trading_active"] = trading_active_;
             response_json["note"] = "Complete user portfolio reset requires User class API updates";
-            response_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
-                                             std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
+            response_json["timestamp"] = coarse_clock_->nowSeconds();
 
             network::HttpResponse response;
             response.status_code = 200;
@@ -971,6 +2657,64 @@ class TradingEngine {
         }
     }
 
+    json runtimeConfigJson() const {
+        const RuntimeConfig& config = runtime_config_.get();
+        const auto& limits = config.validation;
+        json tiers = json::object();
+        for (const auto& [name, tier] : config.rate_limit.tiers) {
+            tiers[name] = {{"orders_per_second", tier.orders_per_second}, {"burst", tier.burst}};
+        }
+        return {{"validation",
+                 {{"market_open", limits.market_open},
+                  {"min_quantity", limits.min_quantity},
+                  {"max_quantity", limits.max_quantity},
+                  {"min_price", limits.min_price},
+                  {"max_price", limits.max_price},
+                  {"valid_symbols", limits.valid_symbols}}},
+                {"rate_limit",
+                 {{"enabled", config.rate_limit_enabled},
+                  {"default_tier", config.rate_limit.default_tier},
+                  {"tiers", tiers},
+                  {"users", config.rate_limit.user_tiers},
+                  {"consumer_burst_multiplier", config.consumer_burst_multiplier}}},
+                {"logging", {{"level", logLevelName(config.log_level)}}}};
+    }
+
+    network::HttpResponse handleAdminConfig(const network::HttpRequest& request) {
+        if (!validateAdminPassword(request)) {
+            return createErrorResponse(401, "Unauthorized: Invalid admin credentials");
+        }
+
+        network::HttpResponse response;
+        response.status_code = 200;
+        response.body = runtimeConfigJson().dump();
+        response.headers["Content-Type"] = "application/json";
+        return response;
+    }
+
+    network::HttpResponse handleAdminReloadConfig(const network::HttpRequest& request) {
+        if (!validateAdminPassword(request)) {
+            return createErrorResponse(401, "Unauthorized: Invalid admin credentials");
+        }
+
+        std::string error;
+        if (!reloadConfiguration(error)) {
+            return createErrorResponse(400, "Configuration not reloaded: " + error);
+        }
+
+        json response_json;
+        response_json["status"] = "success";
+        response_json["message"] = "Configuration reloaded";
+        response_json["config"] = runtimeConfigJson();
+        response_json["timestamp"] = coarse_clock_->nowSeconds();
+
+        network::HttpResponse response;
+        response.status_code = 200;
+        response.body = response_json.dump();
+        response.headers["Content-Type"] = "application/json";
+        return response;
+    }
+
     network::HttpResponse handleAdminStatus(const network::HttpRequest& request) {
         if (!validateAdminPassword(request)) {
             return createErrorResponse(401, "Unauthorized: Invalid admin credentials");
@@ -985,16 +2729,10 @@ class TradingEngine {
             // Get system stats
             auto& all_users = matching_engine_->getAllUsers();
 
-            // Count orderbooks by checking known symbols
-            std::vector<std::string> valid_symbols = {"AAPL", "MSFT", "GOOGL", "AMZN", "TSLA"};
-            int total_orderbooks = 0;
-            for (const auto& symbol : valid_symbols) {
-                if (matching_engine_->getOrderBook(symbol)) {
-                    total_orderbooks++;
-                }
+            {
+                std::lock_guard<std::mutex> book_lock(book_mutex_);
+                response_json["total_orderbooks"] = matching_engine_->getSymbols().size();
             }
-
-            response_json["total_orderbooks"] = total_orderbooks;
             response_json["total_users"] = all_users.size();
 
             if (stats_collector_ && stats_collector_->isRunning()) {
@@ -1004,9 +2742,61 @@ class TradingEngine {
                     {"queue_size", stats_collector_->getQueueSize()}};
             }
 
-            response_json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
-                                             std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
+            if (trade_ring_) {
+                auto ring_metrics = trade_ring_->getMetrics();
+                json consumers_json = json::array();
+                for (const auto& consumer : ring_metrics.consumers) {
+                    consumers_json.push_back({{"name", consumer.name},
+                                              {"processed", consumer.processed},
+                                              {"batches", consumer.batches},
+                                              {"max_batch", consumer.max_batch},
+                                              {"lag", consumer.lag}});
+                }
+                response_json["post_trade"] = {{"capacity", ring_metrics.capacity},
+                                               {"published", ring_metrics.published},
+                                               {"producer_stalls", ring_metrics.producer_stalls},
+                                               {"dropped", ring_metrics.dropped},
+                                               {"consumers", consumers_json}};
+            }
+
+            if (admission_) {
+                const auto admission_metrics = admission_->getMetrics();
+                auto class_json = [](const network::AdmissionController::ClassMetrics& metrics) {
+                    return json{{"admitted", metrics.admitted},
+                                {"rejected_busy", metrics.rejected_busy},
+                                {"rejected_overloaded", metrics.rejected_overloaded},
+                                {"in_flight", metrics.in_flight},
+                                {"limit", metrics.limit},
+                                {"latency_ewma_us", metrics.latency_ewma_us}};
+                };
+                response_json["admission"] = {
+                    {"orders", class_json(admission_metrics.orders)},
+                    {"reads", class_json(admission_metrics.reads)},
+                    {"rejected_connections", admission_metrics.rejected_connections}};
+            }
+
+            if (compressor_) {
+                const auto compression_metrics = compressor_->getMetrics();
+                response_json["compression"] = {
+                    {"compressed", compression_metrics.compressed},
+                    {"cache_hits", compression_metrics.cache_hits},
+                    {"bytes_in", compression_metrics.bytes_in},
+                    {"bytes_out", compression_metrics.bytes_out}};
+            }
+
+            if (ingress_limiter_) {
+                auto limiter_json = [](const validation::RateLimiter::Metrics& metrics) {
+                    return json{{"allowed", metrics.allowed},
+                                {"limited", metrics.limited},
+                                {"untracked", metrics.untracked},
+                                {"tracked_users", metrics.tracked_users}};
+                };
+                response_json["rate_limit"] = {
+                    {"ingress", limiter_json(ingress_limiter_->getMetrics())},
+                    {"consumer", limiter_json(consumer_limiter_->getMetrics())}};
+            }
+
+            response_json["timestamp"] = coarse_clock_->nowSeconds();
 
             network::HttpResponse response;
             response.status_code = 200;
@@ -1019,6 +2809,55 @@ class TradingEngine {
         }
     }
 
+    network::HttpResponse createCancelResponse(
+        const std::vector<std::shared_ptr<core::Order>>& cancelled) {
+        json order_ids = json::array();
+        for (const auto& order : cancelled) {
+            order_ids.push_back(order->getId());
+        }
+
+        json response_json;
+        response_json["status"] = "success";
+        response_json["cancelled"] = cancelled.size();
+        response_json["order_ids"] = order_ids;
+        response_json["timestamp"] = coarse_clock_->nowSeconds();
+
+        network::HttpResponse response;
+        response.status_code = 200;
+        response.body = response_json.dump();
+        response.headers["Content-Type"] = "application/json";
+        return response;
+    }
+
+    json orderResultToJson(const std::string& order_id, const OrderResult& result) {
+        json fills = json::array();
+        for (const auto& trade : result.fills) {
+            fills.push_back({{"trade_id", core::tradeIdString(trade)},
+                             {"quantity", trade.quantity},
+                             {"price", trade.price}});
+        }
+
+        json response_json;
+        response_json["status"] = result.status;
+        response_json["order_id"] = order_id;
+        response_json["filled_quantity"] = result.filled_quantity;
+        response_json["remaining_quantity"] = result.remaining_quantity;
+        response_json["fills"] = std::move(fills);
+        if (!result.reason.empty()) {
+            response_json["reason"] = result.reason;
+        }
+        return response_json;
+    }
+
+    network::HttpResponse createOrderResultResponse(const std::string& order_id,
+                                                    const OrderResult& result) {
+        network::HttpResponse response;
+        response.status_code = result.status == "REJECTED" ? 400 : 200;
+        response.body = orderResultToJson(order_id, result).dump();
+        response.headers["Content-Type"] = "application/json";
+        return response;
+    }
+
     network::HttpResponse createErrorResponse(int status_code, const std::string& message) {
         network::HttpResponse response;
         response.status_code = status_code;
@@ -1027,6 +2866,16 @@ class TradingEngine {
         return response;
     }
 
+    network::HttpResponse createEncodedResponse(network::BodyFormat format, std::string body,
+                                                const std::string& etag) {
+        network::HttpResponse response;
+        response.status_code = 200;
+        response.body = std::move(body);
+        response.headers["Content-Type"] = network::contentTypeFor(format);
+        response.headers["ETag"] = etag;
+        return response;
+    }
+
   private:
     std::shared_ptr<utils::Config> config_;
     std::shared_ptr<logging::TradeLogger> trade_logger_;
@@ -1037,6 +2886,57 @@ class TradingEngine {
     std::unique_ptr<network::HttpServer> http_server_;
     std::unique_ptr<messaging::QueueClient> queue_client_;
     std::unique_ptr<statistics::StatisticsCollector> stats_collector_;
+    std::unique_ptr<utils::SequencedRing<core::Trade>> trade_ring_;
+    bool direct_ingress_ = false;
+    std::unique_ptr<utils::SequencedRing<core::OrderRequest>> order_ring_;  // Direct ingress
+    std::unique_ptr<utils::Journal> order_journal_;
+    std::unique_ptr<core::OrderStateStore> order_states_;  // Read lock-free by status endpoints
+    using OrderCompletions = utils::CompletionRegistry<OrderResult>;
+    OrderCompletions order_completions_;  // HTTP threads waiting for synchronous acks
+    std::chrono::milliseconds sync_ack_timeout_{100};
+    size_t max_batch_size_ = 256;  // Orders per /api/v1/orders/batch request
+
+    // Ingress shedding; null unless enabled. The difference of the two counters is the order
+    // backlog it sheds on.
+    std::shared_ptr<network::AdmissionController> admission_;
+    std::shared_ptr<network::ResponseCompressor> compressor_;
+
+    // Per-user order rate limits; null unless enabled
+    std::unique_ptr<validation::RateLimiter> ingress_limiter_;
+    std::unique_ptr<validation::RateLimiter> consumer_limiter_;  // Matcher thread
+
+    // Settings reloadable at runtime, as last applied; see reloadConfiguration()
+    std::string config_file_;
+    std::mutex reload_mutex_;
+    utils::Snapshot<RuntimeConfig> runtime_config_;
+
+    // Conditional GET. Each book carries its own version; market_version_ advances with every
+    // book change and is what long polls on book-derived resources wait on.
+    utils::VersionCounter market_version_;
+    std::string etag_epoch_;
+    std::chrono::milliseconds max_long_poll_{30000};
+    size_t max_long_polls_ = 4096;
+    std::atomic<size_t> long_polls_{0};
+    std::atomic<uint64_t> orders_published_{0};
+    std::atomic<uint64_t> orders_consumed_{0};
+
+    // Push streaming; null unless enabled. market_views_ holds the last book state streamed per
+    // symbol and is guarded by book_mutex_.
+    struct MarketView {
+        std::string top_of_book;
+        std::vector<core::DepthLevel> bids;
+        std::vector<core::DepthLevel> asks;
+    };
+    std::shared_ptr<network::WebSocketHub> ws_hub_;
+    size_t depth_levels_ = 10;
+    std::unordered_map<std::string, MarketView> market_views_;
+    std::vector<core::OrderRequest> pending_orders_;  // Matcher thread only
+    std::vector<std::pair<std::string, OrderResult>> pending_acks_;  // Matcher thread only
+    bool journal_failed_ = false;                                    // Matcher thread only
+    std::shared_ptr<utils::CoarseClock> coarse_clock_;  // Response timestamps
+    std::mutex book_mutex_;  // Serializes book mutations from the queue and cancel endpoints
+    std::thread housekeeping_thread_;
+    std::atomic<bool> housekeeping_running_{false};
     bool running_;
     bool trading_active_;
     std::string admin_password_;
@@ -1047,6 +2947,13 @@ class TradingEngine {
 TradingEngine* g_engine = nullptr;
 std::shared_ptr<logging::AppLogger> g_logger = nullptr;
 
+// Set by SIGHUP; the main loop does the reload, outside signal context
+volatile sig_atomic_t g_reload_requested = 0;
+
+void reloadSignalHandler(int) {
+    g_reload_requested = 1;
+}
+
 void signalHandler(int signal) {
     if (g_engine) {
         if (g_logger) {
@@ -1082,6 +2989,7 @@ int main(int argc, char* argv[]) {
     // Setup signal handlers
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
+    signal(SIGHUP, reloadSignalHandler);
 
     // Initialize engine
     if (!engine.initialize(config_file)) {
@@ -1100,6 +3008,11 @@ int main(int argc, char* argv[]) {
     // Main loop
     while (engine.isRunning()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (g_reload_requested) {
+            g_reload_requested = 0;
+            std::string error;
+            engine.reloadConfiguration(error);  // Logs the outcome
+        }
     }
 
     g_logger->log(logging::LogLevel::INFO, "Trading engine stopped.");
@@ -0,0 +1,177 @@
+// HTTP server microbenchmark: request throughput and latency of each HttpServer backend.
+//
+// Every client thread runs a closed loop of connect / request / response / close against a
+// handler that returns a small JSON body, so the numbers are dominated by the server's
+// per-connection and per-request syscall cost rather than by handler work.
+//
+//   http_server_bench [duration_seconds=5] [clients=16] [port=18180]
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trading/network/http_server.hpp"
+
+using trading::network::HttpRequest;
+using trading::network::HttpResponse;
+using trading::network::HttpServer;
+
+namespace {
+
+struct BenchConfig {
+    const char* name;
+    HttpServer::Backend backend;
+    int acceptors;
+};
+
+struct Result {
+    uint64_t requests = 0;
+    uint64_t errors = 0;
+    std::vector<int64_t> latencies_ns;
+};
+
+// One request on a fresh connection; returns false on any socket error or short response
+bool roundTrip(int port, const std::string& request) {
+    int sock = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+        return false;
+    }
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (::connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(sock);
+        return false;
+    }
+    if (::send(sock, request.data(), request.size(), MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(request.size())) {
+        ::close(sock);
+        return false;
+    }
+    // The server closes the connection after every response
+    std::string response;
+    char buffer[1024];
+    ssize_t n;
+    while ((n = ::recv(sock, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(sock);
+    return response.compare(0, 12, "HTTP/1.1 200") == 0;
+}
+
+Result run(const BenchConfig& config, int port, int clients, std::chrono::seconds duration) {
+    HttpServer server("127.0.0.1", port, 8);
+    server.setBackend(config.backend);
+    server.setAcceptors(config.acceptors);
+    server.setMaxConnections(4096);
+    server.registerRoute("GET", "/health", [](const HttpRequest&) {
+        HttpResponse response;
+        response.status_code = 200;
+        response.body = R"({"status":"healthy"})";
+        return response;
+    });
+    if (!server.start()) {
+        std::fprintf(stderr, "%s: failed to start server\n", config.name);
+        return {};
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const std::string request = "GET /health HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    std::atomic<bool> done{false};
+    std::vector<Result> per_client(static_cast<size_t>(clients));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < clients; ++i) {
+        threads.emplace_back([&, i]() {
+            Result& result = per_client[static_cast<size_t>(i)];
+            while (!done.load(std::memory_order_relaxed)) {
+                const auto start = std::chrono::steady_clock::now();
+                if (roundTrip(port, request)) {
+                    ++result.requests;
+                    result.latencies_ns.push_back(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+                } else {
+                    ++result.errors;
+                }
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    done = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    server.stop();
+
+    Result total;
+    for (auto& result : per_client) {
+        total.requests += result.requests;
+        total.errors += result.errors;
+        total.latencies_ns.insert(total.latencies_ns.end(), result.latencies_ns.begin(),
+                                  result.latencies_ns.end());
+    }
+    std::sort(total.latencies_ns.begin(), total.latencies_ns.end());
+    return total;
+}
+
+double percentileUs(const std::vector<int64_t>& sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t index =
+        std::min(sorted.size() - 1, static_cast<size_t>(percentile * sorted.size()));
+    return static_cast<double>(sorted[index]) / 1000.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int duration_seconds = argc > 1 ? std::atoi(argv[1]) : 5;
+    const int clients = argc > 2 ? std::atoi(argv[2]) : 16;
+    const int base_port = argc > 3 ? std::atoi(argv[3]) : 18180;
+    const int acceptors = static_cast<int>(std::max(2u, std::thread::hardware_concurrency() / 2));
+
+    std::vector<BenchConfig> configs = {
+        {"blocking", HttpServer::Backend::BLOCKING, 1},
+        {"blocking+reuseport", HttpServer::Backend::BLOCKING, acceptors},
+    };
+    if (HttpServer::ioUringSupported()) {
+        configs.push_back({"io_uring", HttpServer::Backend::IO_URING, 1});
+        configs.push_back({"io_uring+reuseport", HttpServer::Backend::IO_URING, acceptors});
+    } else {
+        std::printf("io_uring not supported here; skipping its backend\n");
+    }
+
+    std::printf("%d clients, %ds per backend, %d acceptors when sharded\n\n", clients,
+                duration_seconds, acceptors);
+    std::printf("%-20s %12s %10s %10s %10s %8s\n", "backend", "req/s", "p50 us", "p99 us",
+                "p99.9 us", "errors");
+    int port = base_port;
+    for (const auto& config : configs) {
+        // A fresh port per run keeps TIME_WAIT sockets from one run out of the next
+        const Result result = run(config, port++, clients, std::chrono::seconds(duration_seconds));
+        std::printf("%-20s %12.0f %10.1f %10.1f %10.1f %8llu\n", config.name,
+                    static_cast<double>(result.requests) / duration_seconds,
+                    percentileUs(result.latencies_ns, 0.50),
+                    percentileUs(result.latencies_ns, 0.99),
+                    percentileUs(result.latencies_ns, 0.999),
+                    static_cast<unsigned long long>(result.errors));
+    }
+    return 0;
+}
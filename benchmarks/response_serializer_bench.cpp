@@ -0,0 +1,342 @@
+// Response serializer microbenchmark: CPU time and heap allocations per response body for the
+// engine's larger read endpoints, written through a nlohmann::json DOM and dump() (how handlers
+// built bodies before) versus BodyWriter straight into a string.
+//
+// Three documents are encoded: a full order book (through OrderBook::toJSON), a leaderboard of
+// users with open positions and an all-symbol statistics dump. BodyWriter runs twice, once into
+// its own string and once into a buffer reused across iterations, as the handlers do.
+//
+//   response_serializer_bench [iterations=2000] [scale=200]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../apps/json.hpp"
+#include "trading/core/order.hpp"
+#include "trading/core/orderbook.hpp"
+#include "trading/network/body_writer.hpp"
+
+using json = nlohmann::json;
+using trading::network::BodyFormat;
+using trading::network::BodyWriter;
+
+// Every heap allocation in the process goes through these, so the benchmark can count them.
+// GCC pairs the inlined malloc with free across the replaced operators and warns spuriously.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+namespace {
+uint64_t g_allocations = 0;
+uint64_t g_allocated_bytes = 0;
+}  // namespace
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    g_allocated_bytes += size;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+struct Position {
+    std::string symbol;
+    double quantity;
+    double average_price;
+    double current_price;
+};
+
+struct UserRow {
+    std::string user_id;
+    double cash_balance;
+    double realized_pnl;
+    std::vector<Position> positions;
+};
+
+struct Bucket {
+    double open, high, low, close, volume, dollar_volume, simple_return, volatility;
+    int trade_count;
+};
+
+struct SymbolStats {
+    std::string symbol;
+    double last_trade_price;
+    std::vector<std::pair<std::string, Bucket>> timeframes;
+};
+
+struct Result {
+    double ns_per_op;
+    double allocations_per_op;
+    double bytes_per_op;
+    size_t body_size;
+};
+
+Result measure(int iterations, const std::function<std::string()>& encode) {
+    size_t body_size = encode().size();  // Warm up; also sizes the reused buffer
+    const uint64_t allocations = g_allocations;
+    const uint64_t bytes = g_allocated_bytes;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        body_size = encode().size();
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    return Result{static_cast<double>(elapsed.count()) / iterations,
+                  static_cast<double>(g_allocations - allocations) / iterations,
+                  static_cast<double>(g_allocated_bytes - bytes) / iterations, body_size};
+}
+
+// The order book as OrderBook::toJSON used to build it
+std::string orderBookDom(trading::core::OrderBook& book) {
+    auto levels = [](const auto& side) {
+        json result = json::array();
+        for (const auto& [price, orders] : side) {
+            if (orders.empty()) {
+                continue;
+            }
+            double total_quantity = 0.0;
+            for (const auto& order : orders) {
+                total_quantity += order->getQuantity();
+            }
+            result.push_back({{"price", price}, {"quantity", total_quantity}});
+        }
+        return result;
+    };
+    json document;
+    document["symbol"] = book.getSymbol();
+    document["bids"] = levels(book.getBuyOrdersMap());
+    document["asks"] = levels(book.getSellOrdersMap());
+    document["best_bid"] = book.getBestBid();
+    document["best_ask"] = book.getBestAsk();
+    document["spread"] = book.getSpread();
+    return document.dump();
+}
+
+std::string leaderboardDom(const std::vector<UserRow>& users) {
+    json document;
+    document["timestamp"] = 1700000000;
+    document["total_users"] = users.size();
+    json leaderboard = json::array();
+    int rank = 1;
+    for (const auto& user : users) {
+        json entry;
+        entry["rank"] = rank++;
+        entry["user_id"] = user.user_id;
+        entry["net_worth"] = user.cash_balance + 1000.0;
+        entry["cash_balance"] = user.cash_balance;
+        entry["realized_pnl"] = user.realized_pnl;
+        entry["portfolio_value"] = 1000.0;
+        json positions = json::array();
+        for (const auto& position : user.positions) {
+            json row;
+            row["symbol"] = position.symbol;
+            row["quantity"] = position.quantity;
+            row["average_price"] = position.average_price;
+            row["current_price"] = position.current_price;
+            row["market_value"] = position.quantity * position.current_price;
+            row["unrealized_pnl"] =
+                (position.current_price - position.average_price) * position.quantity;
+            positions.push_back(row);
+        }
+        entry["positions"] = positions;
+        leaderboard.push_back(entry);
+    }
+    document["leaderboard"] = leaderboard;
+    return document.dump();
+}
+
+void writeLeaderboard(BodyWriter& writer, const std::vector<UserRow>& users) {
+    writer.beginMap(3)
+        .field("timestamp", 1700000000)
+        .field("total_users", users.size())
+        .key("leaderboard")
+        .beginArray(users.size());
+    int rank = 1;
+    for (const auto& user : users) {
+        writer.beginMap(7)
+            .field("rank", rank++)
+            .field("user_id", user.user_id)
+            .field("net_worth", user.cash_balance + 1000.0)
+            .field("cash_balance", user.cash_balance)
+            .field("realized_pnl", user.realized_pnl)
+            .field("portfolio_value", 1000.0)
+            .key("positions")
+            .beginArray(user.positions.size());
+        for (const auto& position : user.positions) {
+            writer.beginMap(6)
+                .field("symbol", position.symbol)
+                .field("quantity", position.quantity)
+                .field("average_price", position.average_price)
+                .field("current_price", position.current_price)
+                .field("market_value", position.quantity * position.current_price)
+                .field("unrealized_pnl",
+                       (position.current_price - position.average_price) * position.quantity)
+                .endMap();
+        }
+        writer.endArray().endMap();
+    }
+    writer.endArray().endMap();
+}
+
+json bucketDom(const Bucket& bucket) {
+    return json{{"open", bucket.open},
+                {"high", bucket.high},
+                {"low", bucket.low},
+                {"close", bucket.close},
+                {"volume", bucket.volume},
+                {"dollar_volume", bucket.dollar_volume},
+                {"simple_return", bucket.simple_return},
+                {"volatility", bucket.volatility},
+                {"trade_count", bucket.trade_count},
+                {"vwap", bucket.volume > 0.0 ? bucket.dollar_volume / bucket.volume : 0.0}};
+}
+
+std::string statsDom(const std::vector<SymbolStats>& all_stats) {
+    json document;
+    document["timestamp"] = 1700000000;
+    document["total_symbols"] = all_stats.size();
+    document["symbols"] = json::object();
+    for (const auto& stats : all_stats) {
+        json timeframes;
+        for (const auto& [name, bucket] : stats.timeframes) {
+            timeframes[name] = bucketDom(bucket);
+        }
+        document["symbols"][stats.symbol] = {{"symbol", stats.symbol},
+                                             {"last_trade_price", stats.last_trade_price},
+                                             {"timeframes", timeframes}};
+    }
+    return document.dump();
+}
+
+void writeStats(BodyWriter& writer, const std::vector<SymbolStats>& all_stats) {
+    writer.beginMap(3)
+        .field("timestamp", 1700000000)
+        .field("total_symbols", all_stats.size())
+        .key("symbols")
+        .beginMap(all_stats.size());
+    for (const auto& stats : all_stats) {
+        writer.key(stats.symbol)
+            .beginMap(3)
+            .field("symbol", stats.symbol)
+            .field("last_trade_price", stats.last_trade_price)
+            .key("timeframes")
+            .beginMap(stats.timeframes.size());
+        for (const auto& [name, bucket] : stats.timeframes) {
+            writer.key(name)
+                .beginMap(10)
+                .field("open", bucket.open)
+                .field("high", bucket.high)
+                .field("low", bucket.low)
+                .field("close", bucket.close)
+                .field("volume", bucket.volume)
+                .field("dollar_volume", bucket.dollar_volume)
+                .field("simple_return", bucket.simple_return)
+                .field("volatility", bucket.volatility)
+                .field("trade_count", bucket.trade_count)
+                .field("vwap", bucket.volume > 0.0 ? bucket.dollar_volume / bucket.volume : 0.0)
+                .endMap();
+        }
+        writer.endMap().endMap();
+    }
+    writer.endMap().endMap();
+}
+
+void report(const char* document, const char* serializer, const Result& result) {
+    std::printf("%-12s %-22s %10.1f %10.1f %12.0f %10zu\n", document, serializer,
+                result.ns_per_op / 1000.0, result.allocations_per_op, result.bytes_per_op,
+                result.body_size);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const int scale = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    // scale price levels per side, two resting orders each
+    trading::core::OrderBook book("AAPL");
+    int order_id = 0;
+    for (int level = 0; level < scale; ++level) {
+        for (int i = 0; i < 2; ++i) {
+            book.addOrder(std::make_shared<trading::core::Order>(
+                std::to_string(order_id++), "user", "AAPL", trading::core::OrderType::LIMIT,
+                trading::core::OrderSide::BUY, 10 + i, 100.0 - level * 0.01));
+            book.addOrder(std::make_shared<trading::core::Order>(
+                std::to_string(order_id++), "user", "AAPL", trading::core::OrderType::LIMIT,
+                trading::core::OrderSide::SELL, 10 + i, 100.01 + level * 0.01));
+        }
+    }
+
+    // scale users holding four positions each
+    std::vector<UserRow> users;
+    for (int u = 0; u < scale; ++u) {
+        UserRow user{"trader_" + std::to_string(u), 100000.0 - u * 37.5, u * 1.25, {}};
+        for (const char* symbol : {"AAPL", "MSFT", "GOOGL", "TSLA"}) {
+            user.positions.push_back({symbol, 10.0 + u, 99.5 + u * 0.01, 100.25});
+        }
+        users.push_back(std::move(user));
+    }
+
+    // scale / 4 symbols with four timeframes each
+    std::vector<SymbolStats> all_stats;
+    for (int s = 0; s < std::max(1, scale / 4); ++s) {
+        SymbolStats stats{"SYM" + std::to_string(s), 100.0 + s, {}};
+        for (const char* timeframe : {"1m", "5m", "1h", "1d"}) {
+            stats.timeframes.push_back(
+                {timeframe, Bucket{100.0, 101.5, 99.25, 100.75, 1200.0, 120900.0, 0.0075,
+                                   0.0123, 48}});
+        }
+        all_stats.push_back(std::move(stats));
+    }
+
+    std::printf("%d iterations, scale %d\n\n", iterations, scale);
+    std::printf("%-12s %-22s %10s %10s %12s %10s\n", "document", "serializer", "us/op",
+                "allocs/op", "bytes/op", "body");
+
+    std::string buffer;
+    report("orderbook", "json DOM + dump", measure(iterations, [&] { return orderBookDom(book); }));
+    report("orderbook", "BodyWriter", measure(iterations, [&] { return book.toJSON(); }));
+
+    report("leaderboard", "json DOM + dump",
+           measure(iterations, [&] { return leaderboardDom(users); }));
+    report("leaderboard", "BodyWriter", measure(iterations, [&] {
+               BodyWriter writer(BodyFormat::JSON);
+               writeLeaderboard(writer, users);
+               return writer.take();
+           }));
+    report("leaderboard", "BodyWriter, reused buf", measure(iterations, [&] {
+               BodyWriter writer(BodyFormat::JSON, buffer);
+               writeLeaderboard(writer, users);
+               return writer.take();
+           }));
+
+    report("stats/all", "json DOM + dump",
+           measure(iterations, [&] { return statsDom(all_stats); }));
+    report("stats/all", "BodyWriter", measure(iterations, [&] {
+               BodyWriter writer(BodyFormat::JSON);
+               writeStats(writer, all_stats);
+               return writer.take();
+           }));
+    report("stats/all", "BodyWriter, reused buf", measure(iterations, [&] {
+               BodyWriter writer(BodyFormat::JSON, buffer);
+               writeStats(writer, all_stats);
+               return writer.take();
+           }));
+    return 0;
+}
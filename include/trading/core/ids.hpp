@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace trading::core {
+
+// Compact identifiers used on the matching hot path. Strings are interned once when an order
+// enters the engine and only rendered back at serialization edges (logs, APIs, confirmations).
+using SymbolId = uint32_t;
+using UserId = uint32_t;
+using OrderHandle = uint64_t;
+
+inline constexpr SymbolId kInvalidSymbolId = 0;
+inline constexpr UserId kInvalidUserId = 0;
+inline constexpr OrderHandle kInvalidOrderHandle = 0;
+
+// Process-wide symbol registry
+SymbolId internSymbol(std::string_view symbol);
+[[nodiscard]] const std::string& symbolName(SymbolId id) noexcept;
+
+// Process-wide user registry
+UserId internUser(std::string_view user_id);
+[[nodiscard]] const std::string& userName(UserId id) noexcept;
+
+// Cold per-order metadata, kept out of the matching-path Order record and looked up by handle.
+// Fixed-size so a reader on another thread can copy it out while its slot is being reused.
+struct OrderMetadata {
+    static constexpr size_t kMaxClientOrderIdLength = 63;
+
+    char client_order_id[kMaxClientOrderIdLength + 1] = {};
+    UserId user = kInvalidUserId;
+    SymbolId symbol = kInvalidSymbolId;
+    int64_t created_ns = 0;  // Nanoseconds since the Unix epoch
+
+    [[nodiscard]] std::string_view getClientOrderId() const noexcept {
+        return client_order_id;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<OrderMetadata>,
+              "OrderMetadata must stay trivially copyable");
+
+// Order handles name a slot in a side table holding the client-supplied order id and other
+// cold metadata, so they can be rendered from a handle without touching the order. The low 32
+// bits are the slot and the high 32 bits its generation.
+//
+// releaseOrder() gives a slot back once its order is gone; it is reused after
+// kOrderHandleReuseDelay more orders have been released. Lookups by handle copy the metadata
+// out under the slot's sequence lock and check the generation, so a stale handle resolves to
+// empty metadata rather than to another order's, even while the slot is being rewritten.
+// Only the order that owns a handle may hold a view into its slot (ownedOrderId()).
+inline constexpr size_t kOrderHandleReuseDelay = size_t{1} << 18;
+
+// Throws std::invalid_argument if the id is longer than kMaxClientOrderIdLength
+OrderHandle registerOrder(std::string_view client_order_id, UserId user = kInvalidUserId,
+                          SymbolId symbol = kInvalidSymbolId);
+void releaseOrder(OrderHandle handle) noexcept;
+[[nodiscard]] OrderMetadata orderMetadata(OrderHandle handle) noexcept;
+[[nodiscard]] std::string clientOrderId(OrderHandle handle);
+// The id of a handle that has not been released; valid until it is
+[[nodiscard]] std::string_view ownedOrderId(OrderHandle handle) noexcept;
+
+}  // namespace trading::core
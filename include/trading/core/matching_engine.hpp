@@ -3,25 +3,22 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include "order.hpp"
 #include "orderbook.hpp"
+#include "trade.hpp"
 #include "user.hpp"
+#include "../utils/clock.hpp"
+#include "../utils/timer_wheel.hpp"
 
 namespace trading {
 namespace core {
 
-struct Trade {
-    std::string trade_id;
-    std::string buy_order_id;
-    std::string sell_order_id;
-    std::string buy_user_id;   // User ID of the buyer
-    std::string sell_user_id;  // User ID of the seller
-    std::string symbol;
-    double quantity;
-    double price;
-    uint64_t timestamp;
+struct AmendResult {
+    AmendStatus status;
+    std::vector<Trade> trades;  // Produced when a repriced order crosses the spread
 };
 
 class MatchingEngine {
@@ -34,10 +31,40 @@ class MatchingEngine {
     // Add order book management
     void addOrderBook(const std::string& symbol, std::shared_ptr<OrderBook> orderbook);
     std::shared_ptr<OrderBook> getOrderBook(const std::string& symbol);
+    std::vector<std::string> getSymbols() const;
 
-    // Matching logic
+    // Matching logic. STOP orders are held in the stop trigger index until the symbol's last
+    // trade price reaches their stop price, then released into matching as market orders; the
+    // returned trades include any produced by stops released as a consequence of this order.
     std::vector<Trade> matchOrder(std::shared_ptr<Order> order, OrderBook& orderbook);
 
+    // Amends a resting order (cancel/replace without leaving the book). Omitted fields keep
+    // their current value; a repriced order that crosses the spread is matched immediately.
+    AmendResult amendOrder(UserId user, const std::string& order_id,
+                           std::optional<double> new_quantity, std::optional<double> new_price,
+                           OrderBook& orderbook);
+
+    // Mass cancel of resting orders and pending stops. An empty symbol means all symbols.
+    std::vector<std::shared_ptr<Order>> cancelUserOrders(const std::string& user_id,
+                                                         const std::string& symbol = "");
+    std::vector<std::shared_ptr<Order>> cancelSymbolOrders(const std::string& symbol);
+
+    // Good-till-time expiry. A resting order scheduled here is removed from its book and marked
+    // EXPIRED once the engine clock reaches expire_at_ns; orders that fill or are cancelled
+    // first are skipped. expireOrders() is driven periodically by the owner.
+    void scheduleExpiry(std::shared_ptr<Order> order, int64_t expire_at_ns);
+    std::vector<std::shared_ptr<Order>> expireOrders();
+    size_t getPendingExpiryCount() const;
+
+    // Stop trigger index
+    size_t getPendingStopCount(const std::string& symbol) const;
+    double getLastTradePrice(const std::string& symbol) const;
+
+    // Released stops execute as market orders, so whatever they cannot fill is dropped and the
+    // stop is marked CANCELLED. A stop triggered on arrival is marked on the incoming order; the
+    // ones released by the trades of the last matchOrder/amendOrder call are returned here.
+    std::vector<std::shared_ptr<Order>> takeCancelledStops();
+
     // User management
     void addUser(std::shared_ptr<User> user);
     std::shared_ptr<User> getUser(const std::string& user_id);
@@ -48,20 +75,49 @@ class MatchingEngine {
     // Event handling
     void setTradeCallback(TradeCallback callback);
 
+    // Time source for trade timestamps and expiry (defaults to utils::defaultClock()). Set it
+    // before scheduling expiries: pending expiries are dropped when the clock changes.
+    void setClock(std::shared_ptr<utils::Clock> clock);
+
     // Statistics
     uint64_t getTotalTrades() const;
     double getTotalVolume() const;
 
   private:
+    // Untriggered stops for one symbol, sorted so that the stops a price move triggers always
+    // form a prefix: buy stops fire when the last price rises to their level, sell stops when it
+    // falls to theirs. Equal prices keep arrival order.
+    struct StopBook {
+        std::multimap<double, std::shared_ptr<Order>> buy_stops;
+        std::multimap<double, std::shared_ptr<Order>, std::greater<double>> sell_stops;
+        double last_trade_price = 0.0;
+        bool has_last_trade = false;
+    };
+
     TradeCallback trade_callback_;
     uint64_t total_trades_;
     double total_volume_;
     uint64_t next_trade_id_;
     std::map<std::string, std::shared_ptr<OrderBook>> orderbooks_;
     std::map<std::string, std::shared_ptr<User>> users_;  // User registry
+    std::shared_ptr<utils::Clock> clock_;
+    std::map<SymbolId, StopBook> stop_books_;
+    std::unique_ptr<utils::TimerWheel> expiry_wheel_;
+    std::vector<std::shared_ptr<Order>> expired_;  // Filled by expiry callbacks
+    std::vector<std::shared_ptr<Order>> cancelled_stops_;  // Reset by each matching call
 
     std::vector<Trade> matchMarketOrder(std::shared_ptr<Order> order, OrderBook& orderbook);
     std::vector<Trade> matchLimitOrder(std::shared_ptr<Order> order, OrderBook& orderbook);
+
+    // Stop handling helpers
+    static bool isStopTriggered(const Order& order, const StopBook& stops);
+    std::vector<std::shared_ptr<Order>> takeTriggeredStops(StopBook& stops);
+    void releaseTriggeredStops(OrderBook& orderbook, std::vector<Trade>& trades);
+    static bool dropUnfilledStop(Order& stop);
+    static void cancelStops(StopBook& stops, UserId user,
+                            std::vector<std::shared_ptr<Order>>& cancelled);
+    void settleIncomingOrder(const std::shared_ptr<Order>& order, double remaining_quantity,
+                             OrderBook& orderbook);
     Trade createTrade(std::shared_ptr<Order> buy_order, std::shared_ptr<Order> sell_order,
                       double quantity, double price);
 
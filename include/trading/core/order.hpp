@@ -1,7 +1,13 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "ids.hpp"
+#include "../utils/block_pool.hpp"
 
 namespace trading::core {
 
@@ -9,8 +15,18 @@ enum class OrderType : std::uint8_t { LIMIT, MARKET, STOP };
 
 enum class OrderSide : std::uint8_t { BUY, SELL };
 
-enum class OrderStatus : std::uint8_t { PENDING, PARTIALLY_FILLED, FILLED, REJECTED, CANCELLED };
+enum class OrderStatus : std::uint8_t {
+    PENDING,
+    PARTIALLY_FILLED,
+    FILLED,
+    REJECTED,
+    CANCELLED,
+    EXPIRED
+};
 
+// Matching-path order record. Only the fields the matcher reads and writes live here, so an
+// order fits in one cache line; the client order id, creation time and the user/symbol strings
+// are cold metadata resolved by handle through the registries in ids.hpp.
 class Order {
   public:
     Order();
@@ -18,10 +34,22 @@ class Order {
           OrderType type, OrderSide side, double quantity, double price = 0.0);
     ~Order() = default;
 
-    // Getters
-    [[nodiscard]] const std::string& getId() const noexcept;
+    // Cold metadata, resolved through the side tables
+    [[nodiscard]] std::string_view getId() const noexcept;
     [[nodiscard]] const std::string& getUserId() const noexcept;
     [[nodiscard]] const std::string& getSymbol() const noexcept;
+    [[nodiscard]] int64_t getCreatedNanos() const noexcept;
+
+    // Hot fields
+    [[nodiscard]] constexpr OrderHandle getHandle() const noexcept {
+        return handle_;
+    }
+    [[nodiscard]] constexpr UserId getUserKey() const noexcept {
+        return user_key_;
+    }
+    [[nodiscard]] constexpr SymbolId getSymbolKey() const noexcept {
+        return symbol_key_;
+    }
     [[nodiscard]] constexpr OrderType getType() const noexcept {
         return type_;
     }
@@ -47,22 +75,51 @@ class Order {
     void setQuantity(double quantity) noexcept {
         quantity_ = quantity;
     }
+    void setPrice(double price) noexcept {
+        price_ = price;
+    }
 
     // C++23 formatting support
     [[nodiscard]] std::string toString() const;
 
   private:
-    std::string id_;
-    std::string userId_;
-    std::string symbol_;
-    OrderType type_;
-    OrderSide side_;
-    double quantity_;
+    OrderHandle handle_;
     double price_;
+    double quantity_;
     double filled_quantity_;
+    UserId user_key_;
+    SymbolId symbol_key_;
+    OrderType type_;
+    OrderSide side_;
     OrderStatus status_;
 };
 
+static_assert(sizeof(Order) <= 64, "Order must fit in a cache line");
+static_assert(std::is_trivially_copyable_v<Order>, "Order must stay trivially copyable");
+
+// Orders handed to the book are allocated from a cache-line-aligned pool; the shared_ptr
+// control block and the order share one pool block.
+using OrderAllocator = utils::PoolAllocator<Order, 64>;
+
+namespace detail {
+// An order created by makeOrder(), which gives its metadata slot back when the last reference
+// goes. Copies of the Order taken before then keep the handle, which stays resolvable for
+// kOrderHandleReuseDelay releases.
+class PooledOrder : public Order {
+  public:
+    using Order::Order;
+    ~PooledOrder() {
+        releaseOrder(getHandle());
+    }
+};
+}  // namespace detail
+
+template <typename... Args>
+[[nodiscard]] std::shared_ptr<Order> makeOrder(Args&&... args) {
+    return std::allocate_shared<detail::PooledOrder>(OrderAllocator(),
+                                                     std::forward<Args>(args)...);
+}
+
 }  // namespace trading::core
 
 // Helper functions for enum to string conversion
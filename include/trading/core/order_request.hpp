@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include "order.hpp"
+
+namespace trading::core {
+
+// Decoded order-entry request. Fixed-size and trivially copyable so HTTP threads can hand it to
+// the matcher through a ring and the journal can persist it as raw bytes. Strings are stored
+// inline rather than as interned ids, which are only meaningful inside one process.
+struct OrderRequest {
+    enum class Action : std::uint8_t { NEW, AMEND };
+
+    static constexpr size_t kMaxIdLength = 63;
+    static constexpr size_t kMaxSymbolLength = 15;
+
+    Action action = Action::NEW;
+    OrderType type = OrderType::LIMIT;
+    OrderSide side = OrderSide::BUY;
+    bool has_quantity = false;
+    bool has_price = false;
+    bool has_expiry = false;
+    double quantity = 0.0;
+    double price = 0.0;
+    int64_t expire_at_ms = 0;  // Good-till-time, epoch milliseconds
+    char id[kMaxIdLength + 1] = {};
+    char user_id[kMaxIdLength + 1] = {};
+    char symbol[kMaxSymbolLength + 1] = {};
+
+    // Copies value into a fixed field; fails if it does not fit
+    template <size_t N>
+    static bool setField(char (&field)[N], std::string_view value) {
+        if (value.size() >= N) {
+            return false;
+        }
+        std::memcpy(field, value.data(), value.size());
+        field[value.size()] = '\0';
+        return true;
+    }
+
+    [[nodiscard]] std::string_view getId() const noexcept {
+        return id;
+    }
+    [[nodiscard]] std::string_view getUserId() const noexcept {
+        return user_id;
+    }
+    [[nodiscard]] std::string_view getSymbol() const noexcept {
+        return symbol;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<OrderRequest>,
+              "OrderRequest must stay trivially copyable");
+
+}  // namespace trading::core
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "order.hpp"
+
+namespace trading::core {
+
+// Last known state of one order, as served by the status endpoints
+struct OrderState {
+    char id[64];
+    char user_id[64];
+    char symbol[16];
+    OrderType type;
+    OrderSide side;
+    OrderStatus status;
+    double quantity;            // Total ordered; changes only on amend
+    double filled_quantity;
+    double remaining_quantity;  // Still open; 0 once the order is terminal
+    double price;
+    double average_fill_price;
+    int64_t updated_ns;
+
+    [[nodiscard]] std::string_view getId() const noexcept {
+        return id;
+    }
+    [[nodiscard]] std::string_view getUserId() const noexcept {
+        return user_id;
+    }
+    [[nodiscard]] std::string_view getSymbol() const noexcept {
+        return symbol;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<OrderState>, "OrderState must stay trivially copyable");
+
+[[nodiscard]] constexpr bool isTerminal(OrderStatus status) noexcept {
+    return status == OrderStatus::FILLED || status == OrderStatus::CANCELLED ||
+           status == OrderStatus::REJECTED || status == OrderStatus::EXPIRED;
+}
+
+// In-memory order status store covering live orders and recently terminal ones.
+//
+// A fixed-capacity open-addressing table (linear probing) keyed by user and client order id,
+// since client order ids are only unique per user. Writers are
+// whoever mutates the books and are serialized by an internal mutex. Readers never lock: every
+// slot is guarded by a sequence counter, and a table-wide layout epoch makes a probe retry if
+// eviction moved entries underneath it. Lookups therefore never touch the order books. Each
+// user's records are also chained through their slots from a per-user head table, so listing a
+// user's orders walks only that user's records.
+//
+// Terminal orders are retired by generation: time is divided into kGenerations slices of the
+// configured TTL, and a terminal record is evicted once kGenerations slices have passed since it
+// became terminal. Live orders are never evicted; when the table is full of them new orders are
+// not tracked.
+class OrderStateStore {
+  public:
+    static constexpr uint32_t kGenerations = 4;
+
+    struct Config {
+        size_t capacity = 65536;  // Rounded up to a power of two
+        std::chrono::seconds terminal_ttl{300};
+        Config() = default;
+    };
+
+    OrderStateStore();
+    explicit OrderStateStore(const Config& config);
+    ~OrderStateStore();
+
+    OrderStateStore(const OrderStateStore&) = delete;
+    OrderStateStore& operator=(const OrderStateStore&) = delete;
+
+    // Writers. Each returns false if the order is not (or can no longer be) tracked.
+    bool recordNew(const Order& order, int64_t now_ns);
+    bool recordFill(std::string_view user_id, std::string_view id, double quantity, double price,
+                    int64_t now_ns);
+    bool recordStatus(std::string_view user_id, std::string_view id, OrderStatus status,
+                      double remaining_quantity, int64_t now_ns);
+    bool recordAmend(std::string_view user_id, std::string_view id, double open_quantity,
+                     double price, int64_t now_ns);
+
+    // Advances generations up to now_ns and evicts terminal records past their TTL; returns the
+    // number evicted. Driven periodically by the owner.
+    size_t evictExpired(int64_t now_ns);
+
+    // Lock-free readers
+    [[nodiscard]] std::optional<OrderState> find(std::string_view user_id,
+                                                 std::string_view id) const;
+    [[nodiscard]] std::vector<OrderState> findByUser(std::string_view user_id) const;
+
+    [[nodiscard]] size_t size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+  private:
+    struct Slot;
+    struct UserChain;
+
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    size_t capacity_;
+    size_t mask_;
+    size_t max_size_;  // Load factor cap
+    std::unique_ptr<Slot[]> slots_;
+    // Chain heads by user hash, with the same capacity as slots_ since every user in it owns at
+    // least one record
+    std::unique_ptr<UserChain[]> user_chains_;
+    std::atomic<uint64_t> layout_epoch_{0};  // Odd while eviction is moving entries
+    std::atomic<size_t> size_{0};
+
+    std::mutex writer_mutex_;
+    int64_t generation_ns_;
+    int64_t next_generation_at_ns_ = 0;
+    uint32_t generation_ = 0;
+
+    // Writer helpers; writer_mutex_ held
+    Slot* findSlot(std::string_view user_id, std::string_view id, uint64_t hash);
+    Slot* claimSlot(std::string_view user_id, std::string_view id, uint64_t hash);
+    size_t evictGeneration();
+    void erase(size_t index);
+    size_t findChain(uint64_t user_hash) const;
+    void linkUser(size_t index);
+    void unlinkUser(size_t index);
+    void relinkUser(size_t from, size_t to);
+    void eraseChain(size_t index);
+    void markTerminal(Slot& slot, const OrderState& state);
+    void publish(Slot& slot, const OrderState& state);
+
+    bool readSlot(const Slot& slot, OrderState& state) const;
+};
+
+}  // namespace trading::core
@@ -1,14 +1,28 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include "order.hpp"
+#include "trading/utils/body_writer.hpp"
 
 namespace trading {
 namespace core {
 
+// Aggregated resting quantity at one price
+struct DepthLevel {
+    double price;
+    double quantity;
+};
+
+// Outcome of amending a resting order
+enum class AmendStatus : std::uint8_t { AMENDED_IN_PLACE, REQUEUED, NOT_FOUND, INVALID };
+
 class OrderBook {
   public:
     OrderBook(const std::string& symbol);
@@ -16,22 +30,53 @@ class OrderBook {
 
     // Order management
     bool addOrder(std::shared_ptr<Order> order);
-    bool removeOrder(const std::string& order_id);
+    bool removeOrder(UserId user, std::string_view order_id);
+
+    // Amends a resting order. A quantity reduction at the same price is applied in place and
+    // keeps time priority; a price change or size increase moves the order to the back of its
+    // (new) price level in one unlink/link.
+    AmendStatus amendOrder(UserId user, std::string_view order_id, double new_quantity,
+                           double new_price);
+
+    // Mass cancel. Each user's resting orders are chained in an intrusive list, so cancelling a
+    // user's orders costs time proportional to the orders cancelled rather than the book size.
+    // Cancelled orders are marked CANCELLED and returned.
+    std::vector<std::shared_ptr<Order>> cancelUserOrders(UserId user);
+    std::vector<std::shared_ptr<Order>> cancelAllOrders();
+    std::vector<std::shared_ptr<Order>> getUserOrders(UserId user) const;
 
     // Market data
     double getBestBid() const;
     double getBestAsk() const;
     double getSpread() const;
+    // Up to max_levels aggregated price levels on one side, best price first
+    std::vector<DepthLevel> getDepth(OrderSide side, size_t max_levels) const;
 
     // Query methods
     std::vector<std::shared_ptr<Order>> getBuyOrders() const;
     std::vector<std::shared_ptr<Order>> getSellOrders() const;
-    std::shared_ptr<Order> findOrder(const std::string& order_id) const;
+    // Client order ids are chosen per user, so a resting order is addressed by both
+    std::shared_ptr<Order> findOrder(UserId user, std::string_view order_id) const;
 
     const std::string& getSymbol() const;
+    SymbolId getSymbolKey() const {
+        return symbol_key_;
+    }
 
     // JSON serialization for API endpoints
     std::string toJSON() const;
+    // The same document in any response encoding, written without an intermediate DOM
+    std::string encode(utils::BodyFormat format) const;
+
+    // Change counter for readers that cache snapshots of the book. The matching engine edits
+    // the price maps directly, so the book cannot bump it itself; the owner bumps it after each
+    // mutation.
+    uint64_t getVersion() const noexcept {
+        return version_.load(std::memory_order_acquire);
+    }
+    void bumpVersion() noexcept {
+        version_.fetch_add(1, std::memory_order_release);
+    }
 
     // Provide access to order maps for the matching engine
     std::map<double, std::vector<std::shared_ptr<Order>>, std::greater<double>>& getBuyOrdersMap();
@@ -39,8 +84,38 @@ class OrderBook {
 
   private:
     std::string symbol_;
+    SymbolId symbol_key_;
     std::map<double, std::vector<std::shared_ptr<Order>>, std::greater<double>> buy_orders_;
     std::map<double, std::vector<std::shared_ptr<Order>>> sell_orders_;
+    std::atomic<uint64_t> version_{1};
+
+    // Index node for a resting order. Nodes of an unordered_map never move, so they double as
+    // the links of the owning user's doubly linked list of resting orders.
+    struct RestingOrder {
+        std::shared_ptr<Order> order;
+        RestingOrder* user_prev = nullptr;
+        RestingOrder* user_next = nullptr;
+    };
+
+    // Resting orders by owning user and client order id. The id views the order's entry in the
+    // metadata table, which stays in place for as long as the order is alive.
+    struct OrderKey {
+        UserId user;
+        std::string_view id;
+        bool operator==(const OrderKey&) const = default;
+    };
+    struct OrderKeyHash {
+        size_t operator()(const OrderKey& key) const noexcept {
+            return std::hash<std::string_view>{}(key.id) ^ (size_t{key.user} * 0x9e3779b97f4a7c15);
+        }
+    };
+    std::unordered_map<OrderKey, RestingOrder, OrderKeyHash> index_;
+    std::unordered_map<UserId, RestingOrder*> user_heads_;
+
+    void linkOrder(const std::shared_ptr<Order>& order);
+    void unlinkOrder(const Order& order);
+    void linkUser(RestingOrder& node);
+    void unlinkUser(RestingOrder& node);
 };
 
 }  // namespace core
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "ids.hpp"
+
+namespace trading::core {
+
+// Fixed-size, trivially copyable trade record. Everything is an integer id or a number so a
+// trade can be copied through lock-free rings with memcpy; strings are resolved through the
+// registries in ids.hpp only when a trade is serialized.
+struct Trade {
+    uint64_t trade_id;
+    OrderHandle buy_order;
+    OrderHandle sell_order;
+    UserId buy_user;   // User ID of the buyer
+    UserId sell_user;  // User ID of the seller
+    SymbolId symbol;
+    double quantity;
+    double price;
+    int64_t timestamp_ns;  // Nanoseconds since the Unix epoch
+};
+
+static_assert(std::is_trivially_copyable_v<Trade>, "Trade must stay trivially copyable");
+static_assert(std::is_standard_layout_v<Trade>, "Trade must stay standard layout");
+
+// Serialization-edge helpers
+[[nodiscard]] inline std::string tradeIdString(const Trade& trade) {
+    return std::to_string(trade.trade_id);
+}
+
+}  // namespace trading::core
@@ -1,9 +1,18 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include "../core/matching_engine.hpp"
 #include "../core/order.hpp"
+#include "../utils/timer_wheel.hpp"
+#include "venue_adapter.hpp"
 
 namespace trading {
 namespace execution {
@@ -18,12 +27,31 @@ struct ExecutionResult {
     std::string error_message;
 };
 
+// Asynchronous execution pipeline.
+//
+// execute() submits the trade to the venue and returns PENDING without waiting for the round
+// trip, so throughput is bounded by the in-flight window rather than by venue latency; callers
+// block only while the window is full. Venue reports, per-attempt timeouts and retries with
+// exponential backoff are handled on a dedicated completion thread, which is also the only
+// thread that invokes the execution callback with each execution's final result.
 class Executor {
   public:
     using ExecutionCallback = std::function<void(const ExecutionResult&)>;
 
+    static constexpr size_t kDefaultMaxInFlight = 1024;
+    static constexpr int kBaseRetryDelayMs = 10;
+
+    // Without a venue, executions are filled by a zero-latency SimulatedVenue
     Executor();
-    ~Executor() = default;
+    explicit Executor(std::shared_ptr<VenueAdapter> venue,
+                      size_t max_in_flight = kDefaultMaxInFlight);
+    ~Executor();
+
+    // Lifecycle management. stop() waits up to the timeout for in-flight executions and fails
+    // whatever is still outstanding.
+    bool start();
+    void stop();
+    bool isRunning() const;
 
     // Execution methods
     ExecutionResult execute(const core::Trade& trade);
@@ -32,26 +60,74 @@ class Executor {
     // Event handling
     void setExecutionCallback(ExecutionCallback callback);
 
+    // Blocks until no execution is in flight and every callback has run
+    bool waitForIdle(std::chrono::milliseconds timeout);
+
     // Statistics
     uint64_t getTotalExecutions() const;
     double getTotalExecutedVolume() const;
+    size_t getInFlightCount() const;
+    size_t getMaxInFlight() const;
 
-    // Configuration
+    // Configuration: per-attempt venue timeout and retries after a reject or timeout
     void setTimeout(int milliseconds);
     void setMaxRetries(int max_retries);
 
   private:
+    struct InFlight {
+        core::Trade trade;
+        std::string execution_id;
+        int attempts;
+        utils::TimerWheel::TimerId timer;  // Attempt timeout, or retry backoff
+    };
+
+    enum class EventType { REPORT, TIMEOUT, RETRY };
+
+    struct Event {
+        EventType type;
+        uint64_t request_id;
+        VenueReport report;
+    };
+
+    // Work produced while handling events, carried out after the lock is released
+    struct Actions {
+        std::vector<std::pair<uint64_t, core::Trade>> submissions;
+        std::vector<ExecutionResult> completions;
+    };
+
+    std::shared_ptr<VenueAdapter> venue_;
+    size_t max_in_flight_;
     ExecutionCallback execution_callback_;
     uint64_t total_executions_;
     double total_executed_volume_;
-    uint64_t next_execution_id_;
+    std::atomic<uint64_t> next_execution_id_;
     int timeout_ms_;
     int max_retries_;
 
+    // Executions keyed by the venue request id of their current attempt
+    mutable std::mutex mutex_;
+    std::condition_variable events_cv_;
+    std::condition_variable window_cv_;
+    std::unordered_map<uint64_t, InFlight> in_flight_;
+    std::vector<Event> events_;
+    utils::TimerWheel timers_;
+    uint64_t next_request_id_;
+    bool running_;
+    bool stopping_;
+    int64_t stop_deadline_ns_;
+    bool delivering_;
+    std::thread completion_thread_;
+
     std::string generateExecutionId();
     bool validateExecution(const core::Trade& trade);
-    ExecutionResult performExecution(const core::Trade& trade);
+    void completionLoop();
+    void handleEvent(const Event& event, Actions& actions);
+    void failAttempt(uint64_t request_id, const std::string& reason, Actions& actions);
+    void finish(std::unordered_map<uint64_t, InFlight>::iterator it, ExecutionResult result,
+                Actions& actions);
+    uint64_t submitAttempt(InFlight entry, Actions& actions);
+    static int64_t steadyNanos();
 };
 
 }  // namespace execution
-}  // namespace trading
\ No newline at end of file
+}  // namespace trading
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+#include "venue_adapter.hpp"
+
+namespace trading {
+namespace execution {
+
+// Local stand-in for an exchange connection. Each request is answered after a configurable
+// latency (plus uniform jitter) from the venue's own thread, and may be rejected or silently
+// dropped with configurable probabilities. Any number of requests can be outstanding at once.
+class SimulatedVenue : public VenueAdapter {
+  public:
+    struct Config {
+        std::chrono::microseconds latency{0};
+        std::chrono::microseconds jitter{0};
+        double reject_probability{0.0};
+        double drop_probability{0.0};  // Never answered; exercises executor timeouts
+        uint64_t seed{42};
+
+        Config() = default;
+    };
+
+    SimulatedVenue();
+    explicit SimulatedVenue(const Config& config);
+    ~SimulatedVenue() override;
+
+    void setReportHandler(ReportHandler handler) override;
+
+    bool start() override;
+    void stop() override;
+
+    void submit(uint64_t request_id, const core::Trade& trade) override;
+
+    // Fault injection can be changed while running
+    void setRejectProbability(double probability);
+    void setDropProbability(double probability);
+
+    uint64_t getSubmittedCount() const;
+    size_t getOutstandingCount() const;
+
+  private:
+    struct Pending {
+        int64_t due_ns;
+        uint64_t request_id;
+        core::Trade trade;
+
+        bool operator>(const Pending& other) const {
+            return due_ns > other.due_ns;
+        }
+    };
+
+    Config config_;
+    ReportHandler report_handler_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> pending_;
+    std::mt19937_64 rng_;
+
+    std::thread venue_thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> submitted_{0};
+
+    void run();
+};
+
+}  // namespace execution
+}  // namespace trading
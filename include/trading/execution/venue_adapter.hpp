@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "../core/trade.hpp"
+
+namespace trading {
+namespace execution {
+
+// Outcome of one execution request as reported by a venue
+struct VenueReport {
+    uint64_t request_id;
+    bool accepted;
+    double filled_quantity;
+    double fill_price;
+    std::string reason;  // Set when rejected
+};
+
+// Asynchronous connection to an execution venue.
+//
+// submit() hands a request to the venue and returns without waiting for the round trip; the
+// adapter later reports the request at most once through the report handler, from any thread.
+// A request the venue never answers is timed out by the Executor.
+class VenueAdapter {
+  public:
+    using ReportHandler = std::function<void(const VenueReport&)>;
+
+    virtual ~VenueAdapter() = default;
+
+    virtual void setReportHandler(ReportHandler handler) = 0;
+
+    // Lifecycle management
+    virtual bool start() = 0;
+    virtual void stop() = 0;
+
+    virtual void submit(uint64_t request_id, const core::Trade& trade) = 0;
+};
+
+}  // namespace execution
+}  // namespace trading
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include "async_logger.hpp"
 #include "log_level.hpp"
+#include "../utils/clock.hpp"
 
 namespace trading {
 namespace logging {
@@ -17,10 +19,12 @@ class AppLogger : public AsyncLogger {
 
     void setLogLevel(LogLevel level);
     void enableConsoleOutput(bool enable);
+    void setClock(std::shared_ptr<utils::Clock> clock);
 
   private:
-    LogLevel current_log_level_;
+    std::atomic<LogLevel> current_log_level_;  // Changed at runtime by config reloads
     bool console_output_enabled_;
+    std::shared_ptr<utils::Clock> clock_;
 
     std::string formatLogEntry(LogLevel level, const std::string& message);
     std::string getCurrentTimestamp();
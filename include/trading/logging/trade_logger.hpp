@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include "../core/matching_engine.hpp"
 #include "../execution/executor.hpp"
 #include "async_logger.hpp"
 #include "log_level.hpp"
+#include "../utils/clock.hpp"
 
 namespace trading {
 namespace logging {
@@ -38,11 +40,13 @@ class TradeLogger : public AsyncLogger {
     void setLogLevel(LogLevel level);
     void setRotateSize(size_t max_size_bytes);
     void enableConsoleOutput(bool enable);
+    void setClock(std::shared_ptr<utils::Clock> clock);
 
   private:
-    LogLevel current_log_level_;
+    std::atomic<LogLevel> current_log_level_;  // Changed at runtime by config reloads
     size_t max_file_size_;
     bool console_output_enabled_;
+    std::shared_ptr<utils::Clock> clock_;
     uint64_t next_confirmation_id_;
 
     std::string formatLogEntry(LogLevel level, const std::string& message);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "transport.hpp"
+
+namespace trading {
+namespace messaging {
+
+// In-process backend: transports created with the same channel name share a bus, and every
+// subscriber gets its own lock-free inbox that publishers enqueue into directly. No broker and
+// no serialization are involved. Messages on topics nobody subscribes to are dropped, and
+// publish() fails when a subscriber's inbox is full.
+class InProcessTransport : public Transport {
+  public:
+    static constexpr size_t kDefaultCapacity = 8192;
+
+    explicit InProcessTransport(const std::string& channel = "default",
+                                size_t capacity = kDefaultCapacity);
+    ~InProcessTransport() override;
+
+    bool connect() override;
+    void disconnect() override;
+    bool publish(const Message& message) override;
+    bool subscribe(const std::vector<std::string>& topics) override;
+    bool poll(Message& message, std::chrono::milliseconds timeout) override;
+
+  private:
+    struct Bus;
+    struct Inbox;
+
+    std::string channel_;
+    size_t capacity_;
+    std::shared_ptr<Bus> bus_;
+    std::shared_ptr<Inbox> inbox_;  // Registered on the bus while connected
+
+    static std::shared_ptr<Bus> attach(const std::string& channel);
+};
+
+}  // namespace messaging
+}  // namespace trading
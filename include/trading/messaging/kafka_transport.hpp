@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <librdkafka/rdkafkacpp.h>
+
+#include "transport.hpp"
+
+namespace trading {
+namespace logging {
+class AppLogger;
+}
+namespace messaging {
+
+// Kafka/Redpanda backend: one producer and one high-level consumer (group
+// "trading-engine-consumers") against the configured brokers.
+class KafkaTransport : public Transport {
+  public:
+    KafkaTransport(const std::string& brokers, std::shared_ptr<logging::AppLogger> logger);
+    ~KafkaTransport() override;
+
+    bool connect() override;
+    void disconnect() override;
+    bool publish(const Message& message) override;
+    bool subscribe(const std::vector<std::string>& topics) override;
+    bool poll(Message& message, std::chrono::milliseconds timeout) override;
+
+  private:
+    std::string brokers_;
+    std::shared_ptr<logging::AppLogger> logger_;
+    std::unique_ptr<RdKafka::Producer> producer_;
+    std::unique_ptr<RdKafka::KafkaConsumer> consumer_;
+
+    bool validateBrokerAddress(const std::string& brokers) const;
+    bool isValidIpAddress(const std::string& ip) const;
+};
+
+}  // namespace messaging
+}  // namespace trading
@@ -4,11 +4,12 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
 
-#include <librdkafka/rdkafkacpp.h>
+#include "transport.hpp"
 
 namespace trading {
 namespace logging {
@@ -16,19 +17,13 @@ class AppLogger;
 }
 namespace messaging {
 
-struct Message {
-    std::string topic;
-    std::string key;
-    std::string value;
-    uint64_t timestamp;
-    std::map<std::string, std::string> headers;
-};
-
 class QueueClient {
   public:
     using MessageHandler = std::function<void(const Message&)>;
 
+    // Kafka-backed client for the given broker list
     explicit QueueClient(const std::string& brokers, std::shared_ptr<logging::AppLogger> logger);
+    QueueClient(std::unique_ptr<Transport> transport, std::shared_ptr<logging::AppLogger> logger);
     ~QueueClient();
 
     QueueClient(const QueueClient&) = delete;
@@ -52,23 +47,21 @@ class QueueClient {
     void setBatchSize(int batch_size);
 
   private:
-    std::string brokers_;
+    std::unique_ptr<Transport> transport_;
     bool connected_;
     int timeout_ms_;
     int batch_size_;
 
+    std::mutex handlers_mutex_;
     std::map<std::string, MessageHandler> topic_handlers_;
 
-    std::unique_ptr<RdKafka::Producer> producer_;
-    std::unique_ptr<RdKafka::KafkaConsumer> consumer_;
     std::atomic<bool> running_;
     std::thread message_thread_;
     std::shared_ptr<logging::AppLogger> logger_;
 
     void processMessages();
     bool validateTopic(const std::string& topic) const;
-    bool validateBrokerAddress(const std::string& brokers) const;
-    bool isValidIpAddress(const std::string& ip) const;
+    std::vector<std::string> subscribedTopics() const;
 };
 
 }  // namespace messaging
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "transport.hpp"
+
+namespace trading {
+namespace messaging {
+
+// Shared-memory backend for a co-located gateway and matching process.
+//
+// All transports opened with the same POSIX shared-memory name map one bounded ring of
+// fixed-size slots. Any number of processes may publish (slots are claimed with a CAS on the
+// ring's write position); exactly one process may subscribe and consume. Messages carry their
+// topic, and the consumer skips topics it has not subscribed to. publish() fails when the ring
+// is full or the encoded message does not fit in a slot.
+class SharedMemoryTransport : public Transport {
+  public:
+    static constexpr size_t kDefaultSlots = 4096;
+    static constexpr size_t kDefaultSlotSize = 4096;
+
+    // The first process to connect creates the segment with this geometry; later ones adopt it
+    explicit SharedMemoryTransport(const std::string& name, size_t slots = kDefaultSlots,
+                                   size_t slot_size = kDefaultSlotSize);
+    ~SharedMemoryTransport() override;
+
+    bool connect() override;
+    void disconnect() override;
+    bool publish(const Message& message) override;
+    bool subscribe(const std::vector<std::string>& topics) override;
+    bool poll(Message& message, std::chrono::milliseconds timeout) override;
+
+    // Removes the named segment; processes that have it mapped keep using it
+    static bool removeSegment(const std::string& name);
+
+  private:
+    struct Header;
+    struct Slot;
+
+    std::string name_;
+    size_t requested_slots_;
+    size_t requested_slot_size_;
+
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    Header* header_ = nullptr;
+    std::mutex topics_mutex_;
+    std::set<std::string> topics_;  // Consumer-side filter
+
+    bool createSegment();
+    bool attachSegment();
+    bool mapSegment(size_t size);
+    Slot* slotAt(uint64_t position) const;
+    bool tryConsume(Message& message);
+    bool isSubscribed(const std::string& topic);
+};
+
+}  // namespace messaging
+}  // namespace trading
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace trading {
+namespace messaging {
+
+struct Message {
+    std::string topic;
+    std::string key;
+    std::string value;
+    uint64_t timestamp;
+    std::map<std::string, std::string> headers;
+};
+
+// Message transport behind QueueClient. A backend moves messages from publishers to the
+// subscribed consumer; QueueClient adds topic dispatch on its own consumer thread. publish() may
+// be called from any thread, poll() from one consumer thread at a time.
+class Transport {
+  public:
+    virtual ~Transport() = default;
+
+    // Connection management
+    virtual bool connect() = 0;
+    virtual void disconnect() = 0;
+
+    virtual bool publish(const Message& message) = 0;
+
+    // Replaces the set of topics delivered to poll(); an empty set unsubscribes from everything
+    virtual bool subscribe(const std::vector<std::string>& topics) = 0;
+
+    // Waits up to timeout for the next message on a subscribed topic
+    virtual bool poll(Message& message, std::chrono::milliseconds timeout) = 0;
+};
+
+}  // namespace messaging
+}  // namespace trading
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace trading {
+namespace network {
+
+// Which budget a route draws from. Order entry and reads are budgeted separately so market-data
+// polling can never use up the capacity order entry needs; exempt routes (health, admin) are
+// never shed.
+enum class RequestClass { ORDER, READ, EXEMPT };
+
+// Decides, before a handler runs, whether the server can take on a request.
+//
+// Each class has a concurrency limit that adapts between min_in_flight and max_in_flight: it
+// grows by one for every request that finishes within target_latency and shrinks by a tenth (at
+// most once per target_latency) while the smoothed handler latency is above it. A request over
+// its class's limit is refused with 429. Independently of the limits, requests are refused with
+// 503 while the server is overloaded: when more connections are queued for a worker than the
+// class tolerates (reads give way first), or when the order pipeline backlog reported by the
+// backlog probe exceeds max_order_backlog. Both carry Retry-After.
+class AdmissionController {
+  public:
+    struct ClassBudget {
+        size_t max_in_flight = 64;
+        size_t min_in_flight = 4;
+        std::chrono::milliseconds target_latency{0};  // 0 keeps the limit at max_in_flight
+        size_t max_queued = 256;  // Connections waiting for a worker at which the class sheds
+        ClassBudget() = default;
+    };
+
+    struct Config {
+        ClassBudget orders;
+        ClassBudget reads;
+        size_t max_order_backlog = 0;  // Orders published but not yet matched; 0 disables
+        int retry_after_seconds = 1;
+        Config() {
+            reads.max_in_flight = 16;
+            reads.max_queued = 64;
+        }
+    };
+
+    struct Decision {
+        bool admitted;
+        int status_code;  // 429 or 503 when not admitted
+        const char* reason;
+    };
+
+    struct ClassMetrics {
+        uint64_t admitted;
+        uint64_t rejected_busy;        // 429: over the concurrency limit
+        uint64_t rejected_overloaded;  // 503: queue or backlog over threshold
+        size_t in_flight;
+        size_t limit;
+        int64_t latency_ewma_us;
+    };
+
+    struct Metrics {
+        ClassMetrics orders;
+        ClassMetrics reads;
+        uint64_t rejected_connections;  // Refused at accept, before the request was read
+    };
+
+    // Reports the number of orders accepted at ingress but not yet processed by the matcher
+    using BacklogProbe = std::function<size_t()>;
+
+    AdmissionController();
+    explicit AdmissionController(const Config& config);
+
+    // Set before the server starts
+    void setBacklogProbe(BacklogProbe probe);
+
+    // Called before running a handler; an admitted request must be followed by release()
+    Decision admit(RequestClass request_class, size_t queued_connections);
+    void release(RequestClass request_class, std::chrono::nanoseconds latency);
+
+    // Called as a connection is accepted, before its request is read: true if the worker queue
+    // is already past what every class tolerates, so it can be refused without queueing it
+    bool shedConnection(size_t queued_connections);
+
+    int retryAfterSeconds() const {
+        return config_.retry_after_seconds;
+    }
+
+    Metrics getMetrics() const;
+
+  private:
+    struct ClassState {
+        ClassBudget budget;
+        std::atomic<size_t> in_flight{0};
+        std::atomic<size_t> limit{0};
+        std::atomic<int64_t> latency_ewma_ns{0};
+        std::atomic<int64_t> last_decrease_ns{0};
+        std::atomic<uint64_t> admitted{0};
+        std::atomic<uint64_t> rejected_busy{0};
+        std::atomic<uint64_t> rejected_overloaded{0};
+    };
+
+    Config config_;
+    BacklogProbe backlog_probe_;
+    std::array<ClassState, 2> classes_;  // Indexed by RequestClass::ORDER / READ
+    std::atomic<uint64_t> rejected_connections_{0};
+
+    ClassState& stateFor(RequestClass request_class) {
+        return classes_[request_class == RequestClass::ORDER ? 0 : 1];
+    }
+    static ClassMetrics metricsFor(const ClassState& state);
+};
+
+}  // namespace network
+}  // namespace trading
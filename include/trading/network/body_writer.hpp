@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string_view>
+
+#include "trading/utils/body_writer.hpp"
+
+namespace trading {
+namespace network {
+
+// The writer lives in utils so that core types can encode themselves; responses name it here
+using utils::BodyFormat;
+using utils::BodyWriter;
+
+// The format the client prefers among those we serve, by q-value and then listing order.
+// JSON when Accept is missing, names none of them, or only wildcards.
+BodyFormat negotiateBodyFormat(std::string_view accept);
+
+const char* contentTypeFor(BodyFormat format);
+
+}  // namespace network
+}  // namespace trading
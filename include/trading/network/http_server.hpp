@@ -1,15 +1,25 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "trading/network/admission_controller.hpp"
+#include "trading/network/response_compressor.hpp"
+#include "trading/network/websocket_hub.hpp"
+#include "trading/utils/task.hpp"
 #include "trading/utils/thread_pool.hpp"
+#include "trading/utils/timer_wheel.hpp"
 
 namespace trading {
 namespace network {
@@ -32,6 +42,35 @@ struct HttpResponse {
 class HttpServer {
   public:
     using RequestHandler = std::function<HttpResponse(const HttpRequest&)>;
+    // A handler that can suspend: the task may co_await waitFor() and sleepFor() (or other tasks
+    // that do) without holding a thread. The request outlives the task.
+    using AsyncRequestHandler = std::function<utils::Task<HttpResponse>(const HttpRequest&)>;
+
+    // Awaitable returned by waitFor() and sleepFor(); yields true if woken by its notifier
+    // rather than by the timeout. The suspended coroutine is resumed on the worker pool.
+    class AsyncWait {
+      public:
+        bool await_ready() const noexcept {
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<> handle);
+        bool await_resume() const noexcept;
+
+      private:
+        friend class HttpServer;
+        struct State;
+        explicit AsyncWait(std::shared_ptr<State> state) : state_(std::move(state)) {}
+        std::shared_ptr<State> state_;
+    };
+
+    // BLOCKING serves each connection with blocking socket calls. IO_URING drives accept, receive,
+    // send and close through one io_uring per acceptor: multishot accept and recv, a registered
+    // provided-buffer ring for receives and fixed files, so one io_uring_enter submits and reaps a
+    // whole batch of operations. Handlers run on the worker pool in both cases.
+    enum class Backend { BLOCKING, IO_URING };
+
+    // Whether this build and the running kernel (6.0 or later) support Backend::IO_URING
+    static bool ioUringSupported();
 
     HttpServer(const std::string& host, int port, int threads = 4);
     ~HttpServer();
@@ -41,18 +80,57 @@ class HttpServer {
     void stop();
     bool isRunning() const;
 
-    // New flexible route registration
+    // New flexible route registration. request_class selects the admission budget the route
+    // draws from when an admission controller is set.
     void registerRoute(const std::string& method, const std::string& path_pattern,
-                       RequestHandler handler);
+                       RequestHandler handler, RequestClass request_class = RequestClass::READ);
+
+    // As registerRoute(), for a coroutine handler. The route's admission budget is held until
+    // the task completes.
+    void registerAsyncRoute(const std::string& method, const std::string& path_pattern,
+                            AsyncRequestHandler handler,
+                            RequestClass request_class = RequestClass::READ);
+
+    // Suspends an async handler until subscribe's notifier is called or timeout passes.
+    // subscribe runs once, on suspension, and hands the notifier to whatever will signal the
+    // event (a completion callback, a version counter); the notifier may be called from any
+    // thread, any number of times, and is a no-op after the first call or the timeout. Timeouts
+    // run on the idle reaper's 10 ms tick. Once the server is stopping, waits end immediately.
+    // Keep the wait in a local and co_await that: GCC 12 destroys temporaries created inside a
+    // co_await expression (such as the std::function here) twice.
+    AsyncWait waitFor(std::function<void(std::function<void()>)> subscribe,
+                      std::chrono::milliseconds timeout);
+    // Suspends an async handler for delay
+    AsyncWait sleepFor(std::chrono::milliseconds delay);
+
+    // Sheds load before handlers run; see AdmissionController. Set before start().
+    void setAdmissionController(std::shared_ptr<AdmissionController> admission);
+
+    // Compresses large responses for clients that send Accept-Encoding; set before start()
+    void setResponseCompressor(std::shared_ptr<ResponseCompressor> compressor);
+
+    // Upgrades GET requests for path that carry a WebSocket handshake and hands the connection
+    // to hub, which owns it from then on
+    void registerWebSocket(const std::string& path, std::shared_ptr<WebSocketHub> hub);
 
     // Legacy route handling (for backward compatibility)
     void setOrderHandler(RequestHandler handler);
     void setHealthHandler(RequestHandler handler);
 
-    // Configuration
+    // Configuration. A connection that has not been fully served within the timeout of being
+    // accepted is shut down by the idle reaper.
     void setTimeout(int seconds);
     void setMaxConnections(int max_connections);
 
+    // Listener sharding, set before start(). With one acceptor (the default) a single thread
+    // accepts and hands every connection to the shared pool. With more, each acceptor binds its
+    // own SO_REUSEPORT socket so the kernel spreads connections across them, and serves its
+    // connections start to finish on its own event loop without touching the pool.
+    void setAcceptors(int acceptors);
+
+    // Set before start(); start() fails if the backend is unsupported
+    void setBackend(Backend backend);
+
   private:
     struct Route {
         std::string method;
@@ -60,23 +138,92 @@ class HttpServer {
         std::regex path_regex;
         std::vector<std::string> param_names;
         RequestHandler handler;
+        AsyncRequestHandler async_handler;  // Set instead of handler for async routes
+        RequestClass request_class;
     };
+    // Delivers the response of a request answered asynchronously
+    using ResponseCallback = std::function<void(HttpResponse)>;
 
     std::string host_;
     int port_;
     bool running_;
     int timeout_seconds_;
     int max_connections_;
+    int num_acceptors_;
+    Backend backend_;
+
+    // One io_uring event loop per acceptor (http_server_io_uring.cpp). Declared before the pool so
+    // that workers finishing a request never outlive the loop they report back to.
+    class IoUringLoop;
+    struct IoUringLoopDeleter {
+        void operator()(IoUringLoop* loop) const;
+    };
+    std::vector<std::unique_ptr<IoUringLoop, IoUringLoopDeleter>> uring_loops_;
 
     std::unique_ptr<utils::ThreadPool> thread_pool_;
     std::vector<Route> routes_;
+    std::map<std::string, std::shared_ptr<WebSocketHub>> websocket_routes_;
+    std::shared_ptr<AdmissionController> admission_;
+    std::shared_ptr<ResponseCompressor> compressor_;
+    std::atomic<size_t> queued_connections_{0};  // Accepted, waiting for a pool worker
 
     RequestHandler order_handler_;
     RequestHandler health_handler_;
 
     void handleRequest(const HttpRequest& request);
-    void handleClientRequest(int client_fd);
-    HttpResponse routeRequest(const HttpRequest& request);
+    void handleClientRequest(int client_fd, utils::TimerWheel::TimerId idle_timer);
+    // Answers a fully read request on a blocking socket; a handler that throws gets a 500
+    void serveRequest(int client_fd, utils::TimerWheel::TimerId idle_timer,
+                      const std::string& request_raw);
+    void closeConnection(int client_fd, utils::TimerWheel::TimerId idle_timer);
+    bool upgradeToWebSocket(int client_fd, utils::TimerWheel::TimerId idle_timer,
+                            const HttpRequest& request, WebSocketHub& hub);
+    bool startIoUring();
+    void stopIoUring();
+
+    // Request/response handling shared by both backends
+    static bool requestComplete(const std::string& raw);
+    static HttpRequest parseRequest(const std::string& raw);
+    static std::string serializeResponse(HttpResponse response);
+    // 101 response for a valid WebSocket handshake
+    static std::optional<std::string> websocketHandshake(const HttpRequest& request);
+    // Hub registered for the request's path when it asks for a WebSocket upgrade
+    WebSocketHub* websocketUpgradeTarget(const HttpRequest& request) const;
+    // Response for everything except a WebSocket upgrade. A request routed to an async handler
+    // is answered through done once the handler's task completes, and nullopt returned.
+    std::optional<HttpResponse> respond(HttpRequest request, const ResponseCallback& done);
+    // Body format and content coding, applied to every response a route produces
+    void finishResponse(const HttpRequest& request, HttpResponse& response);
+    void reapIdleConnections();
+    int openListener(bool reuse_port);
+    utils::TimerWheel::TimerId scheduleIdleTimeout(int client_fd);
+    void runAcceptor(int listen_fd, int epoll_fd);
+    std::optional<HttpResponse> routeRequest(HttpRequest& request, const ResponseCallback& done);
+    std::optional<HttpResponse> invokeRoute(const Route& route, HttpRequest& request,
+                                            const ResponseCallback& done);
+    // Transcodes a JSON body the handler did not encode itself into the CBOR or MessagePack the
+    // client asked for with Accept
+    static void applyBodyFormat(const HttpRequest& request, HttpResponse& response);
+    // Compresses the body with the coding negotiated from Accept-Encoding. Responses carrying
+    // an ETag reuse the compressed body cached for that version.
+    void applyContentEncoding(const HttpRequest& request, HttpResponse& response);
+    HttpResponse invokeHandler(const RequestHandler& handler, RequestClass request_class,
+                               const HttpRequest& request);
+    // Starts the handler's task, which takes the request over; returns the response instead
+    // when admission sheds it
+    std::optional<HttpResponse> invokeAsyncHandler(const AsyncRequestHandler& handler,
+                                                   RequestClass request_class,
+                                                   HttpRequest& request,
+                                                   const ResponseCallback& done);
+    // Runs an async handler to its response, with the admission slot it holds released at the
+    // end; an exception becomes a 500
+    utils::Task<HttpResponse> serveAsync(const AsyncRequestHandler& handler,
+                                         RequestClass request_class, HttpRequest request);
+    // Ends every pending waitFor()/sleepFor() as timed out; used on stop
+    void expireAsyncWaits();
+    HttpResponse createShedResponse(int status_code, const std::string& message);
+    // Writes a canned 503 to a connection refused at accept and closes it
+    void shedConnection(int client_fd);
     HttpResponse createErrorResponse(int status_code, const std::string& message);
 
     std::regex pathPatternToRegex(const std::string& pattern,
@@ -86,6 +233,32 @@ class HttpServer {
     int server_fd_ = -1;
     std::thread server_thread_;
     std::atomic<bool> stop_flag_{false};
+
+    // Sharded acceptors (num_acceptors_ > 1): one listening socket, epoll instance and thread each.
+    // wake_fd_ is registered with every epoll instance and signalled once on stop.
+    struct Acceptor {
+        int listen_fd = -1;
+        int epoll_fd = -1;
+        std::thread thread;
+    };
+    std::vector<Acceptor> acceptors_;
+    int wake_fd_ = -1;
+
+    // Idle-connection reaping: one deadline per accepted connection, cancelled when the
+    // connection is closed. Firing and cancelling both happen under reaper_mutex_, so a reaped
+    // descriptor is always shut down before it can be closed and reused.
+    std::mutex reaper_mutex_;
+    utils::TimerWheel reaper_wheel_;
+    std::thread reaper_thread_;
+
+    // Async handlers started and not yet answered. stop() waits for them after cutting their
+    // waits short, so none is resumed into a server that is gone. Their timeouts sit on a wheel
+    // of their own, under reaper_mutex_ and advanced with the reaper's, so that they can all be
+    // fired at once on stop without touching connection deadlines.
+    std::unique_ptr<utils::TimerWheel> async_wheel_;
+    std::mutex async_mutex_;
+    std::condition_variable async_idle_;
+    size_t async_in_flight_ = 0;
 };
 
 }  // namespace network
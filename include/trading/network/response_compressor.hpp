@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace trading {
+namespace network {
+
+// Content codings a client can ask for with Accept-Encoding
+enum class ContentEncoding { IDENTITY, GZIP, ZSTD };
+
+// Whether this build can produce the coding: gzip needs zlib, zstd needs libzstd
+bool contentEncodingSupported(ContentEncoding encoding);
+
+// The supported coding the client prefers by q-value, zstd winning ties with gzip. IDENTITY when
+// Accept-Encoding is missing or accepts nothing we can produce.
+ContentEncoding negotiateContentEncoding(std::string_view accept_encoding);
+
+const char* contentEncodingToken(ContentEncoding encoding);
+
+// Compresses response bodies above a size threshold.
+//
+// Each worker thread keeps one deflate stream and one zstd context for its whole life and
+// resets them between bodies, so a response costs no allocator setup and no compressor
+// teardown. A body is compressed in a single pass into an output buffer sized to the encoder's
+// bound. Bodies of versioned snapshots (responses carrying an ETag) are also cached under their
+// version: a direct-mapped table of cache_slots entries, one mutex each, so dashboards polling
+// the same book or leaderboard version share one compression. A newer version simply replaces
+// the entry in its slot.
+class ResponseCompressor {
+  public:
+    struct Config {
+        size_t min_size = 1024;  // Smaller bodies are sent as they are
+        int gzip_level = 6;      // 1 (fastest) to 9 (smallest)
+        int zstd_level = 3;
+        size_t cache_slots = 256;  // 0 disables the cache
+        Config() = default;
+    };
+
+    struct Metrics {
+        uint64_t compressed;   // Bodies compressed, excluding cache hits
+        uint64_t cache_hits;
+        uint64_t bytes_in;     // Uncompressed bytes of every compressed response
+        uint64_t bytes_out;    // Bytes sent for them
+    };
+
+    ResponseCompressor();
+    explicit ResponseCompressor(const Config& config);
+    ~ResponseCompressor();
+
+    size_t minSize() const {
+        return config_.min_size;
+    }
+
+    // Compresses body into out with this thread's context; false if the coding is unsupported
+    // or the encoder fails
+    bool compress(ContentEncoding encoding, std::string_view body, std::string& out);
+
+    // As compress(), but returns the cached result when one was stored under cache_key, and
+    // stores a fresh one otherwise. nullptr on failure.
+    std::shared_ptr<const std::string> compressCached(ContentEncoding encoding,
+                                                      const std::string& cache_key,
+                                                      std::string_view body);
+
+    Metrics getMetrics() const;
+
+  private:
+    struct CacheSlot {
+        std::mutex mutex;
+        std::string key;
+        std::shared_ptr<const std::string> body;
+    };
+
+    Config config_;
+    std::unique_ptr<CacheSlot[]> cache_;
+
+    std::atomic<uint64_t> compressed_{0};
+    std::atomic<uint64_t> cache_hits_{0};
+    std::atomic<uint64_t> bytes_in_{0};
+    std::atomic<uint64_t> bytes_out_{0};
+
+    void recordSent(size_t bytes_in, size_t bytes_out);
+};
+
+}  // namespace network
+}  // namespace trading
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace trading {
+namespace network {
+namespace websocket {
+
+// RFC 6455 opcodes
+enum class Opcode : std::uint8_t {
+    CONTINUATION = 0x0,
+    TEXT = 0x1,
+    BINARY = 0x2,
+    CLOSE = 0x8,
+    PING = 0x9,
+    PONG = 0xA,
+};
+
+// SHA-1 digest; only used for the opening handshake
+std::array<std::uint8_t, 20> sha1(std::string_view data);
+
+std::string base64Encode(const std::uint8_t* data, size_t size);
+
+// Sec-WebSocket-Accept value for a client's Sec-WebSocket-Key
+std::string acceptKey(std::string_view client_key);
+
+// Encodes one unfragmented, unmasked server frame
+std::string encodeFrame(Opcode opcode, std::string_view payload);
+
+// Incremental decoder for client frames. Feed it whatever recv() returned and call next() until
+// it reports NEED_MORE; fragmented messages are reassembled, control frames are returned as
+// they arrive.
+class FrameParser {
+  public:
+    enum class Result { MESSAGE, NEED_MORE, ERROR };
+
+    explicit FrameParser(size_t max_message_size) : max_message_size_(max_message_size) {
+    }
+
+    void feed(const char* data, size_t size) {
+        buffer_.append(data, size);
+    }
+
+    // On MESSAGE, opcode/payload hold one complete message or control frame
+    Result next(Opcode& opcode, std::string& payload);
+
+  private:
+    size_t max_message_size_;
+    std::string buffer_;
+    std::string fragments_;
+    Opcode fragments_opcode_ = Opcode::TEXT;
+    bool in_fragmented_message_ = false;
+};
+
+}  // namespace websocket
+}  // namespace network
+}  // namespace trading
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+namespace network {
+
+// Pub/sub fan-out over upgraded WebSocket connections.
+//
+// HttpServer performs the opening handshake and hands the socket over with adopt(); from then
+// on one epoll thread owns every connection's I/O. Clients send
+// {"op": "subscribe" | "unsubscribe", "channel": "..."} and receive
+// {"type": "update" | "snapshot", "channel": "...", "data": ...} messages.
+//
+// publish() encodes a frame once and queues a reference to the same buffer on every subscriber,
+// so fan-out costs one encode per message rather than one per connection. Writes are
+// non-blocking; a subscriber that falls behind accumulates a backlog. Past
+// conflate_threshold_bytes, updates published with a conflation key replace any queued update
+// with the same key instead of queueing behind it, so a slow reader sees the latest state rather
+// than every intermediate one. Past max_backlog_bytes the connection is dropped.
+class WebSocketHub {
+  public:
+    struct Config {
+        size_t max_connections = 1024;
+        size_t max_message_size = 64 * 1024;           // Largest client message accepted
+        size_t max_subscriptions = 256;                // Channels per connection
+        size_t conflate_threshold_bytes = 256 * 1024;  // Backlog at which conflation starts
+        size_t max_backlog_bytes = 4 * 1024 * 1024;    // Backlog at which a reader is dropped
+        Config() = default;
+    };
+
+    struct Metrics {
+        uint64_t connections;
+        uint64_t published;
+        uint64_t conflated;         // Queued updates replaced by a newer one
+        uint64_t slow_disconnects;  // Connections dropped for exceeding max_backlog_bytes
+    };
+
+    // Decides whether a client may subscribe to a channel
+    using ChannelFilter = std::function<bool(const std::string& channel)>;
+    // Sends a payload to the subscribing connection only
+    using Sender = std::function<void(std::string_view payload)>;
+    // Called right after a subscription is registered, to send the channel's current state.
+    // Anything published after the snapshot is taken is queued behind it.
+    using SnapshotProvider = std::function<void(const std::string& channel, const Sender& send)>;
+
+    WebSocketHub();
+    explicit WebSocketHub(const Config& config);
+    ~WebSocketHub();
+
+    WebSocketHub(const WebSocketHub&) = delete;
+    WebSocketHub& operator=(const WebSocketHub&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const {
+        return running_.load();
+    }
+
+    // Set before start()
+    void setChannelFilter(ChannelFilter filter);
+    void setSnapshotProvider(SnapshotProvider provider);
+
+    // Takes ownership of a socket that has completed the opening handshake; closes it and
+    // returns false if the hub is full or stopped
+    bool adopt(int fd);
+
+    // Queues payload (a JSON value) for every subscriber of channel
+    void publish(const std::string& channel, std::string_view payload,
+                 std::string_view conflation_key = {});
+
+    // Cheap checks so publishers can skip building payloads nobody will receive
+    bool hasSubscribers() const {
+        return subscription_count_.load(std::memory_order_relaxed) > 0;
+    }
+    bool hasSubscribers(const std::string& channel) const;
+
+    Metrics getMetrics() const;
+
+  private:
+    struct Connection;
+    using Frame = std::shared_ptr<const std::string>;
+
+    Config config_;
+    ChannelFilter channel_filter_;
+    SnapshotProvider snapshot_provider_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_flag_{false};
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;  // eventfd that tells the I/O thread there is output to flush
+    std::thread io_thread_;
+
+    mutable std::mutex mutex_;  // Guards everything below
+    std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+    std::unordered_map<std::string, std::vector<Connection*>> channels_;
+    std::vector<Connection*> dirty_;  // Connections with output to flush
+    std::atomic<size_t> subscription_count_{0};
+
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> conflated_{0};
+    std::atomic<uint64_t> slow_disconnects_{0};
+
+    void run();
+    void handleReadable(int fd);
+    bool processFrames(Connection& connection);
+    void handleMessage(Connection& connection, const std::string& text);
+    void subscribe(Connection& connection, const std::string& channel);
+    void unsubscribe(Connection& connection, const std::string& channel);
+
+    // mutex_ held
+    bool enqueue(Connection& connection, const Frame& frame, std::string_view conflation_key);
+    void markDirty(Connection& connection);
+    void flush(Connection& connection);
+    void closeConnection(Connection& connection);
+
+    void wake();
+};
+
+}  // namespace network
+}  // namespace trading
@@ -3,6 +3,7 @@
 #include "trading/core/matching_engine.hpp"
 #include "trading/statistics/instrument_stats.hpp"
 #include "trading/utils/concurrent_queue.hpp"
+#include "trading/utils/version_counter.hpp"
 #include <atomic>
 #include <chrono>
 #include <memory>
@@ -81,6 +82,11 @@ class StatisticsCollector {
     std::optional<InstrumentStats> getStatsForSymbol(const std::string& symbol) const;
     std::unordered_map<std::string, InstrumentStats> getAllStats() const;
 
+    // Bumped whenever the statistics change; lets API readers skip unchanged snapshots
+    const utils::VersionCounter& version() const {
+        return version_;
+    }
+
     // Statistics about the collector itself
     size_t getQueueSize() const;
     uint64_t getTotalTradesProcessed() const;
@@ -96,6 +102,7 @@ class StatisticsCollector {
     // Statistics cache protected by shared_mutex for concurrent reads
     mutable std::shared_mutex stats_mutex_;
     std::unordered_map<std::string, InstrumentStats> instrument_stats_;
+    utils::VersionCounter version_;
 
     // Background processing thread
     std::thread collector_thread_;
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace trading::utils {
+
+// Fixed-size block allocator carving blocks out of large aligned slabs.
+//
+// Blocks are handed out in address order from fresh slabs and recycled LIFO, so objects that
+// are created together (e.g. the resting orders of a book) end up packed into adjacent cache
+// lines instead of scattered across the general-purpose heap. Slabs are never returned to the
+// system; the pool is sized by the peak number of live blocks.
+template <size_t BlockSize, size_t Alignment>
+class BlockPool {
+  public:
+    static constexpr size_t kBlockSize =
+        ((BlockSize < sizeof(void*) ? sizeof(void*) : BlockSize) + Alignment - 1) / Alignment *
+        Alignment;
+    static constexpr size_t kBlocksPerSlab = 4096;
+
+    // Process-wide pool for this block shape. Intentionally leaked so blocks can still be
+    // released while other statics are being destroyed.
+    static BlockPool& instance() {
+        static BlockPool* pool = new BlockPool();
+        return *pool;
+    }
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_list_) {
+            grow();
+        }
+        FreeBlock* block = free_list_;
+        free_list_ = block->next;
+        ++in_use_;
+        return block;
+    }
+
+    void deallocate(void* ptr) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = free_list_;
+        free_list_ = block;
+        --in_use_;
+    }
+
+    [[nodiscard]] size_t blocksInUse() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return in_use_;
+    }
+
+    [[nodiscard]] size_t blocksReserved() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slabs_.size() * kBlocksPerSlab;
+    }
+
+  private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    BlockPool() = default;
+
+    void grow() {
+        auto* slab = static_cast<std::byte*>(
+            ::operator new(kBlockSize * kBlocksPerSlab, std::align_val_t(Alignment)));
+        slabs_.push_back(slab);
+
+        // Thread the free list back to front so allocation walks the slab forwards
+        for (size_t i = kBlocksPerSlab; i-- > 0;) {
+            auto* block = reinterpret_cast<FreeBlock*>(slab + i * kBlockSize);
+            block->next = free_list_;
+            free_list_ = block;
+        }
+    }
+
+    mutable std::mutex mutex_;
+    FreeBlock* free_list_ = nullptr;
+    size_t in_use_ = 0;
+    std::vector<std::byte*> slabs_;
+};
+
+// Standard allocator adapter over BlockPool. Single-object allocations (the only kind made by
+// std::allocate_shared) come from the pool; anything larger falls back to operator new.
+template <typename T, size_t Alignment = alignof(T)>
+class PoolAllocator {
+  public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, Alignment>;
+    };
+
+    PoolAllocator() noexcept = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U, Alignment>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(pool().allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(kAlignment)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (n == 1) {
+            pool().deallocate(ptr);
+        } else {
+            ::operator delete(ptr, std::align_val_t(kAlignment));
+        }
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U, Alignment>&) const noexcept {
+        return true;
+    }
+
+  private:
+    static constexpr size_t kAlignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    static BlockPool<sizeof(T), kAlignment>& pool() {
+        return BlockPool<sizeof(T), kAlignment>::instance();
+    }
+};
+
+}  // namespace trading::utils
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace trading::utils {
+
+// Body encodings the engine can write
+enum class BodyFormat { JSON, CBOR, MSGPACK };
+
+// Encodes a JSON, CBOR (RFC 8949) or MessagePack body straight from engine structures, without
+// building a DOM first. CBOR and MessagePack prefix containers with their size, so callers give
+// the entry count when they open a map or array; JSON ignores it and closes the container at
+// the matching end call instead, which the binary formats treat as a no-op. Fields appear in
+// the order they are written.
+//
+// JSON numbers are formatted with std::to_chars (shortest round-trip form; integral doubles
+// keep a ".0" and non-finite ones become null, as nlohmann::json writes them) and strings are
+// escaped 16 bytes at a time with SSE2 where available. In CBOR and MessagePack, doubles that
+// are exact in single precision are written as 4-byte floats.
+//
+// Output is appended either to a string the writer owns or to a caller's buffer, which it
+// clears first; a buffer kept per thread keeps its capacity from one response to the next.
+class BodyWriter {
+  public:
+    explicit BodyWriter(BodyFormat format, size_t reserve = 256);
+    BodyWriter(BodyFormat format, std::string& buffer);
+    BodyWriter(const BodyWriter&) = delete;
+    BodyWriter& operator=(const BodyWriter&) = delete;
+
+    BodyWriter& beginMap(size_t entries);
+    BodyWriter& endMap() {
+        return close('}');
+    }
+    BodyWriter& beginArray(size_t items);
+    BodyWriter& endArray() {
+        return close(']');
+    }
+
+    BodyWriter& key(std::string_view name);
+    BodyWriter& value(std::string_view text);
+    BodyWriter& value(const char* text) {
+        return value(std::string_view(text));
+    }
+    BodyWriter& value(const std::string& text) {
+        return value(std::string_view(text));
+    }
+    BodyWriter& value(double number);
+    BodyWriter& value(int64_t number);
+    BodyWriter& value(uint64_t number);
+    BodyWriter& value(int number) {
+        return value(static_cast<int64_t>(number));
+    }
+    BodyWriter& value(bool flag);
+    BodyWriter& null();
+
+    // key(name) followed by value(v)
+    template <typename T>
+    BodyWriter& field(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+
+    BodyFormat format() const {
+        return format_;
+    }
+    std::string_view view() const {
+        return *out_;
+    }
+    // Returns the encoded body: moved out of an owned string, copied out of a caller's buffer
+    // (which keeps its capacity). The writer is empty afterwards.
+    std::string take();
+
+  private:
+    BodyFormat format_;
+    std::string owned_;
+    std::string* out_;
+    bool need_comma_ = false;  // JSON: the next key, value or container follows a sibling
+
+    BodyWriter& close(char bracket);
+    void jsonSeparator() {
+        if (need_comma_) {
+            out_->push_back(',');
+        }
+    }
+    void jsonString(std::string_view text);
+    void cborHead(uint8_t major, uint64_t argument);
+    void msgpackSized(uint8_t fix_base, size_t fix_limit, uint8_t size16, size_t size);
+    void putBigEndian(uint64_t value, int bytes);
+};
+
+}  // namespace trading::utils
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace trading::utils {
+
+// Wall-clock time source used for engine timestamps (nanoseconds since the Unix epoch).
+// Components hold a std::shared_ptr<Clock> so tests and replays can inject a SimulatedClock.
+class Clock {
+  public:
+    virtual ~Clock() = default;
+
+    [[nodiscard]] virtual int64_t nowNanos() const noexcept = 0;
+
+    // Re-anchor against the operating system wall clock (no-op for most clocks)
+    virtual void recalibrate() noexcept {
+    }
+
+    [[nodiscard]] int64_t nowMicros() const noexcept {
+        return nowNanos() / 1'000;
+    }
+    [[nodiscard]] int64_t nowMillis() const noexcept {
+        return nowNanos() / 1'000'000;
+    }
+    [[nodiscard]] int64_t nowSeconds() const noexcept {
+        return nowNanos() / 1'000'000'000;
+    }
+    [[nodiscard]] std::chrono::system_clock::time_point nowTimePoint() const noexcept {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(nowNanos())));
+    }
+};
+
+// Plain std::chrono::system_clock, used where no cycle counter is available
+class SystemClock : public Clock {
+  public:
+    [[nodiscard]] int64_t nowNanos() const noexcept override;
+};
+
+// Cycle-counter clock (RDTSC on x86-64, CNTVCT on AArch64) calibrated against the system
+// clock. Reading it costs a few nanoseconds instead of a clock_gettime call; recalibrate()
+// should be called periodically (CoarseClock does this) to absorb drift and NTP slews.
+//
+// nowNanos() never goes backwards. A re-anchor that finds the wall clock ahead steps forward
+// to it; one that finds it behind (an NTP step back, or drift) keeps the current time and runs
+// the clock up to kMaxSlew slower until the wall clock catches up.
+class TscClock : public Clock {
+  public:
+    static constexpr double kMaxSlew = 0.05;
+
+    // reference is the wall clock to calibrate against; system_clock when null
+    explicit TscClock(std::shared_ptr<Clock> reference = nullptr);
+
+    [[nodiscard]] int64_t nowNanos() const noexcept override;
+    void recalibrate() noexcept override;
+
+    // True when a constant-rate hardware counter is available (checked at run time: on x86 the
+    // CPU must report an invariant TSC); otherwise nowNanos() defers to system_clock
+    [[nodiscard]] static bool isSupported() noexcept;
+
+    [[nodiscard]] double ticksPerNanosecond() const noexcept {
+        return 1.0 / ns_per_tick_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    // Anchor published under a seqlock so readers never block. ns_per_tick_ is the measured
+    // counter rate; readers extrapolate at slewed_ns_per_tick_, which is slower while slewing.
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> tick_base_{0};
+    std::atomic<int64_t> nanos_base_{0};
+    std::atomic<double> ns_per_tick_{1.0};
+    std::atomic<double> slewed_ns_per_tick_{1.0};
+    // Last wall-clock sample, for refining the rate; only the seqlock writer touches these
+    uint64_t wall_ticks_ = 0;
+    int64_t wall_nanos_ = 0;
+    std::shared_ptr<Clock> reference_;
+};
+
+// Clock driven explicitly by the caller, for deterministic tests and replay
+class SimulatedClock : public Clock {
+  public:
+    explicit SimulatedClock(int64_t start_nanos = 0) : now_(start_nanos) {
+    }
+
+    [[nodiscard]] int64_t nowNanos() const noexcept override {
+        return now_.load(std::memory_order_acquire);
+    }
+
+    void setNanos(int64_t nanos) noexcept {
+        now_.store(nanos, std::memory_order_release);
+    }
+    void advance(std::chrono::nanoseconds delta) noexcept {
+        now_.fetch_add(delta.count(), std::memory_order_acq_rel);
+    }
+
+  private:
+    std::atomic<int64_t> now_;
+};
+
+// Cached timestamp refreshed by a background ticker. Reads are a single atomic load, at the
+// cost of being up to one resolution period stale. The ticker also recalibrates the source.
+class CoarseClock : public Clock {
+  public:
+    explicit CoarseClock(std::shared_ptr<Clock> source,
+                         std::chrono::microseconds resolution = std::chrono::milliseconds(1),
+                         std::chrono::milliseconds recalibrate_interval = std::chrono::seconds(1));
+    ~CoarseClock() override;
+
+    CoarseClock(const CoarseClock&) = delete;
+    CoarseClock& operator=(const CoarseClock&) = delete;
+
+    void start();
+    void stop();
+    [[nodiscard]] bool isRunning() const noexcept {
+        return running_.load();
+    }
+
+    [[nodiscard]] int64_t nowNanos() const noexcept override {
+        return cached_.load(std::memory_order_acquire);
+    }
+
+    // Refresh the cached value immediately (also used when the ticker is not running)
+    void tick() noexcept;
+
+  private:
+    void run();
+
+    std::shared_ptr<Clock> source_;
+    std::chrono::microseconds resolution_;
+    std::chrono::milliseconds recalibrate_interval_;
+    std::atomic<int64_t> cached_{0};
+    std::atomic<bool> running_{false};
+    std::thread ticker_thread_;
+};
+
+// Process-wide default clock (a TscClock when supported, SystemClock otherwise)
+[[nodiscard]] const std::shared_ptr<Clock>& defaultClock();
+
+}  // namespace trading::utils
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace trading::utils {
+
+// Correlates a request thread waiting for a result with the thread that produces it.
+//
+// The waiter calls expect(key) before handing work off, then wait() with a deadline; the
+// producer calls complete(key, value) when the result is known. Each pending key owns one
+// slot with a binary semaphore, so a waiter sleeps without a condition variable or a shared
+// lock, and the key map is sharded so unrelated requests rarely contend. A result delivered
+// after the waiter gave up is discarded.
+//
+// A waiter that must not block (a suspended coroutine) registers a callback with onComplete()
+// instead and collects the result with wait() once called back.
+template <typename T>
+class CompletionRegistry {
+  public:
+    class Slot {
+      private:
+        friend class CompletionRegistry;
+        std::binary_semaphore done_{0};
+        T value_{};
+        std::mutex callback_mutex_;
+        bool completed_ = false;
+        std::function<void()> on_complete_;
+    };
+    using Ticket = std::shared_ptr<Slot>;
+
+    // Registers a waiter for key; returns nullptr if one is already pending for it
+    Ticket expect(const std::string& key) {
+        auto ticket = std::make_shared<Slot>();
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.pending.emplace(key, ticket).second) {
+            return nullptr;
+        }
+        return ticket;
+    }
+
+    // Delivers the result for key; returns false if nobody is waiting for it
+    bool complete(const std::string& key, T value) {
+        Ticket ticket = take(key, nullptr);
+        if (!ticket) {
+            return false;
+        }
+        ticket->value_ = std::move(value);
+        ticket->done_.release();
+        std::function<void()> on_complete;
+        {
+            std::lock_guard<std::mutex> lock(ticket->callback_mutex_);
+            ticket->completed_ = true;
+            on_complete = std::move(ticket->on_complete_);
+        }
+        if (on_complete) {
+            on_complete();
+        }
+        return true;
+    }
+
+    // Calls callback on the completing thread once the ticket's result is delivered, or right
+    // away if it already was. Never called for a registration that times out or is abandoned,
+    // so callers pair it with a deadline of their own; wait() then returns without blocking.
+    void onComplete(const Ticket& ticket, std::function<void()> callback) {
+        {
+            std::lock_guard<std::mutex> lock(ticket->callback_mutex_);
+            if (!ticket->completed_) {
+                ticket->on_complete_ = std::move(callback);
+                return;
+            }
+        }
+        callback();
+    }
+
+    // Waits for the result; on timeout the registration is withdrawn and nullopt returned
+    std::optional<T> wait(const std::string& key, const Ticket& ticket,
+                          std::chrono::milliseconds timeout) {
+        if (!ticket->done_.try_acquire_for(timeout)) {
+            if (take(key, ticket)) {
+                return std::nullopt;
+            }
+            // A producer claimed the slot just as we timed out; its release is imminent
+            ticket->done_.acquire();
+        }
+        return std::move(ticket->value_);
+    }
+
+    // Withdraws a registration that will never be completed (e.g. the hand-off failed)
+    void abandon(const std::string& key, const Ticket& ticket) {
+        take(key, ticket);
+    }
+
+    [[nodiscard]] size_t pendingCount() const {
+        size_t count = 0;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            count += shard.pending.size();
+        }
+        return count;
+    }
+
+  private:
+    static constexpr size_t kShards = 16;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Ticket> pending;
+    };
+
+    Shard& shardFor(const std::string& key) {
+        return shards_[std::hash<std::string>{}(key) % kShards];
+    }
+
+    // Removes key's registration, only if it is `expected` when one is given
+    Ticket take(const std::string& key, const Ticket& expected) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.pending.find(key);
+        if (it == shard.pending.end() || (expected && it->second != expected)) {
+            return nullptr;
+        }
+        Ticket ticket = std::move(it->second);
+        shard.pending.erase(it);
+        return ticket;
+    }
+
+    std::array<Shard, kShards> shards_;
+};
+
+}  // namespace trading::utils
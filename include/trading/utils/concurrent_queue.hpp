@@ -73,6 +73,32 @@ class ConcurrentQueue {
         slot.sequence.notify_one();
     }
 
+    // Enqueues an item only if a slot is free right now; returns false when the queue is full
+    bool try_enqueue(T&& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &buffer_[pos & capacity_mask_];
+            const size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                // Slot is free for this lap; claim it unless another producer got there first
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // The consumer has not freed this slot yet
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (&slot->storage) T(std::move(value));
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        slot->sequence.notify_one();
+        return true;
+    }
+
     // Dequeues an item from the queue
     bool try_dequeue(T& value) {
         const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace trading::utils {
+
+// Append-only record journal with group commit.
+//
+// Records are framed as [size][checksum][payload] and buffered in memory by append(); flush()
+// writes everything buffered with one write() and, when sync_on_flush is set, an fdatasync().
+// The intended pattern is one append per event and one flush per consumer batch, so the cost
+// of the syscalls is shared by the whole batch.
+//
+// Single writer: append/flush are not synchronized. replay() reads a journal back and stops at
+// the first torn or corrupt record, which is what a crash mid-write leaves behind.
+class Journal {
+  public:
+    static constexpr uint32_t kMaxRecordSize = 1 << 20;
+
+    struct Config {
+        std::string path;
+        bool sync_on_flush = false;      // fdatasync after every flush
+        size_t buffer_size = 64 * 1024;  // Flush early once this many bytes are buffered
+        Config() = default;
+    };
+
+    explicit Journal(const Config& config);
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Opens (creating if needed) the journal for appending
+    bool open();
+    // Flushes and closes
+    void close();
+    [[nodiscard]] bool isOpen() const noexcept {
+        return fd_ >= 0;
+    }
+
+    // Buffers one record; fails if closed or the record exceeds kMaxRecordSize
+    bool append(const void* data, uint32_t size);
+
+    template <typename T>
+    bool appendRecord(const T& record) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Journal records must be trivially copyable");
+        return append(&record, sizeof(T));
+    }
+
+    bool flush();
+
+    [[nodiscard]] uint64_t getRecordCount() const noexcept {
+        return record_count_;
+    }
+
+    // Calls handler for every intact record in order; returns the number replayed
+    static size_t replay(const std::string& path,
+                         const std::function<void(std::string_view record)>& handler);
+
+  private:
+    Config config_;
+    int fd_ = -1;
+    std::vector<char> buffer_;
+    uint64_t record_count_ = 0;
+};
+
+}  // namespace trading::utils
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace trading::utils {
+
+// Append-only table of records addressed by dense integer ids.
+//
+// Writers are serialized internally; readers never lock. Records live in fixed-size segments
+// that are never moved, so a reference returned by get() stays valid for the table's lifetime.
+// Records are immutable once appended, except through update(), which is for owners that know
+// no reader still uses the record being replaced.
+template <typename T>
+class SegmentedTable {
+  public:
+    SegmentedTable() : segments_(std::make_unique<std::atomic<Segment*>[]>(kMaxSegments)) {
+        for (size_t i = 0; i < kMaxSegments; ++i) {
+            segments_[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~SegmentedTable() {
+        for (size_t i = 0; i < kMaxSegments; ++i) {
+            delete segments_[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    SegmentedTable(const SegmentedTable&) = delete;
+    SegmentedTable& operator=(const SegmentedTable&) = delete;
+
+    // Appends a record and returns its id (ids start at 1; 0 is reserved for "none")
+    template <typename U>
+    uint64_t append(U&& value) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+
+        const uint64_t id = size_.load(std::memory_order_relaxed) + 1;
+        const size_t segment_index = static_cast<size_t>(id >> kSegmentBits);
+        if (segment_index >= kMaxSegments) {
+            throw std::length_error("SegmentedTable capacity exhausted");
+        }
+
+        Segment* segment = segments_[segment_index].load(std::memory_order_relaxed);
+        if (!segment) {
+            segment = new Segment();
+            segments_[segment_index].store(segment, std::memory_order_release);
+        }
+        segment->values[id & (kSegmentSize - 1)] = std::forward<U>(value);
+
+        // Publishing the new size makes the record visible to lock-free readers
+        size_.store(id, std::memory_order_release);
+        return id;
+    }
+
+    // Modifies an appended record in place; unknown ids are ignored
+    template <typename Update>
+    void update(uint64_t id, Update&& modify) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (id == 0 || id > size_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        Segment* segment =
+            segments_[static_cast<size_t>(id >> kSegmentBits)].load(std::memory_order_relaxed);
+        std::forward<Update>(modify)(segment->values[id & (kSegmentSize - 1)]);
+    }
+
+    // Returns the record for an id, or a default-constructed record for 0 / unknown ids
+    [[nodiscard]] const T& get(uint64_t id) const noexcept {
+        if (id == 0 || id > size_.load(std::memory_order_acquire)) {
+            return kEmpty;
+        }
+        const Segment* segment =
+            segments_[static_cast<size_t>(id >> kSegmentBits)].load(std::memory_order_acquire);
+        return segment->values[id & (kSegmentSize - 1)];
+    }
+
+    [[nodiscard]] uint64_t size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr size_t kSegmentBits = 14;
+    static constexpr size_t kSegmentSize = size_t{1} << kSegmentBits;
+    static constexpr size_t kMaxSegments = size_t{1} << 14;
+
+    struct Segment {
+        T values[kSegmentSize];
+    };
+
+    static inline const T kEmpty{};
+
+    std::unique_ptr<std::atomic<Segment*>[]> segments_;
+    std::atomic<uint64_t> size_{0};
+    std::mutex write_mutex_;
+};
+
+}  // namespace trading::utils
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace trading::utils {
+
+// Disruptor-style sequenced ring buffer with independent consumers.
+//
+// Producers publish each event exactly once; every registered consumer sees every event in
+// sequence order on its own thread and advances its own cursor. A producer can only reuse a
+// slot once the slowest consumer has moved past it (gating), so a stalled consumer applies
+// backpressure to the producer instead of silently losing events.
+template <typename T>
+class SequencedRing {
+  public:
+    // Called for every event. end_of_batch is true for the last event of the batch the
+    // consumer picked up, which lets handlers defer flushes until the batch is drained.
+    using Handler = std::function<void(const T& event, int64_t sequence, bool end_of_batch)>;
+
+    struct ConsumerMetrics {
+        std::string name;
+        uint64_t processed = 0;
+        uint64_t batches = 0;
+        uint64_t max_batch = 0;
+        int64_t lag = 0;  // published events not yet processed by this consumer
+    };
+
+    struct Metrics {
+        size_t capacity = 0;
+        uint64_t published = 0;
+        uint64_t producer_stalls = 0;  // publishes that had to wait on a gating consumer
+        uint64_t dropped = 0;          // publishes refused after stop(), or full and not running
+        std::vector<ConsumerMetrics> consumers;
+    };
+
+    // Constructs the ring with a given capacity (rounded up to a power of two)
+    explicit SequencedRing(size_t capacity, size_t max_batch = 256)
+        : max_batch_(max_batch == 0 ? 1 : max_batch) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Capacity must be non-zero.");
+        }
+
+        capacity_ = roundUpToPowerOfTwo(capacity);
+        capacity_mask_ = capacity_ - 1;
+        slots_ = std::make_unique<Slot[]>(capacity_);
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(-1, std::memory_order_relaxed);
+        }
+    }
+
+    ~SequencedRing() {
+        stop();
+    }
+
+    SequencedRing(const SequencedRing&) = delete;
+    SequencedRing& operator=(const SequencedRing&) = delete;
+    SequencedRing(SequencedRing&&) = delete;
+    SequencedRing& operator=(SequencedRing&&) = delete;
+
+    // Registers a consumer. Consumers must be added before start().
+    void addConsumer(const std::string& name, Handler handler) {
+        if (running_.load()) {
+            throw std::logic_error("Cannot add consumer to a running SequencedRing");
+        }
+        auto consumer = std::make_unique<Consumer>();
+        consumer->name = name;
+        consumer->handler = std::move(handler);
+        consumer->cursor.store(next_sequence_.load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+        consumers_.push_back(std::move(consumer));
+    }
+
+    // Starts one thread per consumer
+    void start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        stop_requested_.store(false);
+        closed_.store(false);
+        for (auto& consumer : consumers_) {
+            consumer->thread = std::thread(&SequencedRing::consumerLoop, this, consumer.get());
+        }
+    }
+
+    // Refuses further publishes, drains everything already published, then joins the
+    // consumer threads
+    void stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        // A publish that got in before closing finishes writing its slot before the consumers
+        // are told to drain and exit, so an accepted event is never stranded
+        closed_.store(true, std::memory_order_seq_cst);
+        while (active_producers_.load(std::memory_order_seq_cst) > 0) {
+            std::this_thread::yield();
+        }
+        stop_requested_.store(true, std::memory_order_release);
+        for (auto& consumer : consumers_) {
+            if (consumer->thread.joinable()) {
+                consumer->thread.join();
+            }
+        }
+    }
+
+    bool isRunning() const {
+        return running_.load();
+    }
+
+    // Publishes an event, waiting for the slowest consumer if the ring is full.
+    // Returns the sequence assigned to the event, or -1 if the ring has been stopped (or is
+    // full and not running).
+    int64_t publish(const T& event) {
+        ProducerScope scope(*this);
+        if (!scope.admitted()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return -1;
+        }
+        const int64_t sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+        if (!waitForCapacity(sequence)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return -1;
+        }
+
+        Slot& slot = slots_[static_cast<size_t>(sequence) & capacity_mask_];
+        slot.value = event;
+        slot.sequence.store(sequence, std::memory_order_release);
+        published_.fetch_add(1, std::memory_order_relaxed);
+        return sequence;
+    }
+
+    // Publishes count events under consecutive sequences, so no other producer's events are
+    // interleaved with them; count must not exceed the capacity. Waits like publish(). Returns
+    // the sequence of the first event, or -1 as publish() does.
+    int64_t publishBatch(const T* events, size_t count) {
+        if (count == 0 || count > capacity_) {
+            throw std::invalid_argument("Batch size must be between 1 and the ring capacity");
+        }
+        ProducerScope scope(*this);
+        if (!scope.admitted()) {
+            dropped_.fetch_add(count, std::memory_order_relaxed);
+            return -1;
+        }
+        const int64_t first = next_sequence_.fetch_add(static_cast<int64_t>(count),
+                                                       std::memory_order_relaxed);
+        if (!waitForCapacity(first + static_cast<int64_t>(count) - 1)) {
+            dropped_.fetch_add(count, std::memory_order_relaxed);
+            return -1;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const int64_t sequence = first + static_cast<int64_t>(i);
+            Slot& slot = slots_[static_cast<size_t>(sequence) & capacity_mask_];
+            slot.value = events[i];
+            slot.sequence.store(sequence, std::memory_order_release);
+        }
+        published_.fetch_add(count, std::memory_order_relaxed);
+        return first;
+    }
+
+    // Publishes without waiting. Returns false if the ring is full or has been stopped.
+    bool tryPublish(const T& event) {
+        ProducerScope scope(*this);
+        if (!scope.admitted()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        int64_t sequence = next_sequence_.load(std::memory_order_relaxed);
+        do {
+            if (sequence - static_cast<int64_t>(capacity_) >= minimumCursor()) {
+                return false;
+            }
+        } while (!next_sequence_.compare_exchange_weak(sequence, sequence + 1,
+                                                       std::memory_order_relaxed));
+
+        Slot& slot = slots_[static_cast<size_t>(sequence) & capacity_mask_];
+        slot.value = event;
+        slot.sequence.store(sequence, std::memory_order_release);
+        published_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    Metrics getMetrics() const {
+        Metrics metrics;
+        metrics.capacity = capacity_;
+        metrics.published = published_.load(std::memory_order_relaxed);
+        metrics.producer_stalls = producer_stalls_.load(std::memory_order_relaxed);
+        metrics.dropped = dropped_.load(std::memory_order_relaxed);
+        const int64_t head = next_sequence_.load(std::memory_order_acquire);
+        for (const auto& consumer : consumers_) {
+            ConsumerMetrics cm;
+            cm.name = consumer->name;
+            cm.processed = consumer->processed.load(std::memory_order_relaxed);
+            cm.batches = consumer->batches.load(std::memory_order_relaxed);
+            cm.max_batch = consumer->max_batch.load(std::memory_order_relaxed);
+            cm.lag = std::max<int64_t>(0, head - consumer->cursor.load(std::memory_order_acquire));
+            metrics.consumers.push_back(std::move(cm));
+        }
+        return metrics;
+    }
+
+  private:
+    // Use a fixed cache line size to avoid ABI compatibility issues
+    static constexpr size_t kCacheLineSize = 64;
+
+    struct Slot {
+        std::atomic<int64_t> sequence;
+        T value{};
+    };
+
+    struct Consumer {
+        std::string name;
+        Handler handler;
+        alignas(kCacheLineSize) std::atomic<int64_t> cursor{0};  // next sequence to consume
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> max_batch{0};
+        std::thread thread;
+    };
+
+    // Counts a producer in for the length of one publish; refused once stop() has closed the
+    // ring. Publishing before start() is allowed and is drained when the consumers start.
+    class ProducerScope {
+      public:
+        explicit ProducerScope(SequencedRing& ring) : ring_(ring) {
+            ring_.active_producers_.fetch_add(1, std::memory_order_seq_cst);
+            admitted_ = !ring_.closed_.load(std::memory_order_seq_cst);
+        }
+        ~ProducerScope() {
+            ring_.active_producers_.fetch_sub(1, std::memory_order_release);
+        }
+        ProducerScope(const ProducerScope&) = delete;
+        ProducerScope& operator=(const ProducerScope&) = delete;
+
+        bool admitted() const {
+            return admitted_;
+        }
+
+      private:
+        SequencedRing& ring_;
+        bool admitted_;
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t v) {
+        v--;
+        v |= v >> 1;
+        v |= v >> 2;
+        v |= v >> 4;
+        v |= v >> 8;
+        v |= v >> 16;
+        v |= v >> 32;
+        v++;
+        return v;
+    }
+
+    int64_t minimumCursor() const {
+        int64_t minimum = std::numeric_limits<int64_t>::max();
+        for (const auto& consumer : consumers_) {
+            minimum = std::min(minimum, consumer->cursor.load(std::memory_order_acquire));
+        }
+        // With no consumers nothing gates the producer
+        return consumers_.empty() ? next_sequence_.load(std::memory_order_relaxed) : minimum;
+    }
+
+    bool waitForCapacity(int64_t sequence) {
+        const int64_t wrap_point = sequence - static_cast<int64_t>(capacity_);
+        if (wrap_point < gating_cache_.load(std::memory_order_relaxed)) {
+            return true;
+        }
+
+        bool stalled = false;
+        int64_t minimum;
+        while (wrap_point >= (minimum = minimumCursor())) {
+            // Nobody will ever free the slot once the consumers are gone
+            if (!running_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            stalled = true;
+            std::this_thread::yield();
+        }
+        gating_cache_.store(minimum, std::memory_order_relaxed);
+        if (stalled) {
+            producer_stalls_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    void consumerLoop(Consumer* consumer) {
+        int64_t next = consumer->cursor.load(std::memory_order_relaxed);
+        int idle_spins = 0;
+
+        while (true) {
+            // Collect the contiguous run of published events starting at next
+            int64_t available = next;
+            while (available - next < static_cast<int64_t>(max_batch_) &&
+                   slots_[static_cast<size_t>(available) & capacity_mask_].sequence.load(
+                       std::memory_order_acquire) == available) {
+                ++available;
+            }
+
+            if (available == next) {
+                if (stop_requested_.load(std::memory_order_acquire)) {
+                    break;  // Everything published before stop() has been drained
+                }
+                // Spin briefly, then back off to avoid burning a core while idle
+                if (++idle_spins < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                continue;
+            }
+            idle_spins = 0;
+
+            for (int64_t seq = next; seq < available; ++seq) {
+                const Slot& slot = slots_[static_cast<size_t>(seq) & capacity_mask_];
+                if (consumer->handler) {
+                    consumer->handler(slot.value, seq, seq + 1 == available);
+                }
+            }
+
+            const auto batch = static_cast<uint64_t>(available - next);
+            consumer->processed.fetch_add(batch, std::memory_order_relaxed);
+            consumer->batches.fetch_add(1, std::memory_order_relaxed);
+            if (batch > consumer->max_batch.load(std::memory_order_relaxed)) {
+                consumer->max_batch.store(batch, std::memory_order_relaxed);
+            }
+
+            next = available;
+            consumer->cursor.store(next, std::memory_order_release);
+        }
+    }
+
+    size_t capacity_;
+    size_t capacity_mask_;
+    size_t max_batch_;
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<std::unique_ptr<Consumer>> consumers_;
+
+    // Producer claim counter and cached gating sequence on their own cache lines
+    alignas(kCacheLineSize) std::atomic<int64_t> next_sequence_{0};
+    alignas(kCacheLineSize) std::atomic<int64_t> gating_cache_{0};
+
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> producer_stalls_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<bool> closed_{false};  // Set by stop(); publishes are refused
+    std::atomic<uint32_t> active_producers_{0};
+};
+
+}  // namespace trading::utils
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace trading::utils {
+
+// Immutable value of some configuration, replaced wholesale by publishing a new one.
+//
+// Readers get the current value with a single acquire load and never lock, however often it
+// changes under them. Publishers serialize on a mutex among themselves. Every value ever
+// published is kept until the Snapshot is destroyed, so a reference from get() stays valid
+// for as long as the Snapshot lives, with no reader-side reclamation protocol; publishing is
+// meant for rare reconfiguration, not for state that changes per request.
+template <typename T>
+class Snapshot {
+  public:
+    explicit Snapshot(T initial = T()) {
+        store(std::move(initial));
+    }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    [[nodiscard]] const T& get() const noexcept {
+        return *current_.load(std::memory_order_acquire);
+    }
+
+    void publish(T next) {
+        std::lock_guard<std::mutex> lock(publish_mutex_);
+        store(std::move(next));
+    }
+
+    // Publishes a modified copy of the current value; concurrent updates do not lose writes
+    template <typename Update>
+    void update(Update&& modify) {
+        std::lock_guard<std::mutex> lock(publish_mutex_);
+        T next = get();
+        std::forward<Update>(modify)(next);
+        store(std::move(next));
+    }
+
+  private:
+    std::atomic<const T*> current_{nullptr};
+    std::mutex publish_mutex_;
+    std::vector<std::unique_ptr<const T>> published_;
+
+    void store(T next) {
+        auto owned = std::make_unique<const T>(std::move(next));
+        current_.store(owned.get(), std::memory_order_release);
+        published_.push_back(std::move(owned));
+    }
+};
+
+}  // namespace trading::utils
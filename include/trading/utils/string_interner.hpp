@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "segmented_table.hpp"
+
+namespace trading::utils {
+
+// Append-only table of strings addressed by dense integer ids (see SegmentedTable)
+using StringTable = SegmentedTable<std::string>;
+
+// Deduplicating interner mapping strings to stable 32-bit ids.
+//
+// intern() takes a shared lock on the fast path (string already known) and an exclusive lock
+// only the first time a string is seen. name() is lock-free.
+class StringInterner {
+  public:
+    StringInterner() = default;
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    // Returns the id for a string, assigning a new one if needed (ids start at 1)
+    uint32_t intern(std::string_view value);
+
+    // Looks up an existing id without interning
+    [[nodiscard]] std::optional<uint32_t> find(std::string_view value) const;
+
+    // Returns the string for an id, or an empty string for 0 / unknown ids
+    [[nodiscard]] const std::string& name(uint32_t id) const noexcept {
+        return table_.get(id);
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return static_cast<size_t>(table_.size());
+    }
+
+  private:
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::string_view value) const noexcept {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    StringTable table_;
+    mutable std::shared_mutex index_mutex_;
+    std::unordered_map<std::string, uint32_t, Hash, std::equal_to<>> index_;
+};
+
+}  // namespace trading::utils
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace trading::utils {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+// State shared by every Task promise: who to resume when the body finishes, and what it threw
+class TaskPromiseBase {
+  public:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+        // Symmetric transfer into the awaiting coroutine instead of a nested resume(); in
+        // optimized builds a chain of tasks finishing synchronously runs in constant stack
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            return static_cast<TaskPromiseBase&>(handle.promise()).continuation_;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+    void unhandled_exception() noexcept {
+        error_ = std::current_exception();
+    }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept {
+        continuation_ = continuation;
+    }
+    void rethrowIfFailed() const {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+  private:
+    std::coroutine_handle<> continuation_ = std::noop_coroutine();
+    std::exception_ptr error_;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+  public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T takeResult() {
+        rethrowIfFailed();
+        return std::move(*value_);
+    }
+
+  private:
+    std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+  public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void takeResult() const {
+        rethrowIfFailed();
+    }
+};
+
+// Fire-and-forget frame that runs a Task to completion; destroys itself when done
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept {
+            return {};
+        }
+        std::suspend_never initial_suspend() const noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() const noexcept {
+            return {};
+        }
+        void return_void() const noexcept {}
+        // A spawned task has nobody to rethrow to
+        void unhandled_exception() const noexcept {
+            std::terminate();
+        }
+    };
+};
+
+}  // namespace detail
+
+// Lazily started coroutine producing a T.
+//
+// The body does not run until the task is co_awaited (or handed to spawn()); the awaiting
+// coroutine is resumed on whichever thread finishes the body, by symmetric transfer. A task is
+// move-only, awaited at most once, and owns its frame until then. Exceptions escaping the body
+// are rethrown from the co_await.
+template <typename T>
+class [[nodiscard]] Task {
+  public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task() = default;
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    [[nodiscard]] bool valid() const noexcept {
+        return static_cast<bool>(handle_);
+    }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().setContinuation(awaiting);
+                return handle;
+            }
+            T await_resume() {
+                return handle.promise().takeResult();
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+  private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+template <typename T, typename Callback>
+Detached runDetached(Task<T> task, Callback on_done) {
+    if constexpr (std::is_void_v<T>) {
+        co_await std::move(task);
+        on_done();
+    } else {
+        on_done(co_await std::move(task));
+    }
+}
+
+}  // namespace detail
+
+// Starts task on the calling thread and returns at its first suspension. on_done receives the
+// result on whichever thread finishes the task. The task must not throw.
+template <typename T, typename Callback>
+void spawn(Task<T> task, Callback&& on_done) {
+    detail::runDetached(std::move(task), std::forward<Callback>(on_done));
+}
+
+}  // namespace trading::utils
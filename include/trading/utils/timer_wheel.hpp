@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace trading::utils {
+
+// Hierarchical timing wheel (4 levels x 256 slots) with O(1) schedule and cancel.
+//
+// Time is supplied by the owner in nanoseconds from any monotonic source and quantized into
+// ticks. advance() fires every timer whose deadline has passed; timers far in the future sit
+// in coarser levels and are cascaded down as the wheel turns, so per-tick work is proportional
+// to the timers that actually expire rather than to the number pending.
+//
+// Not thread-safe: the owner serializes schedule/cancel/advance (typically one thread owns the
+// wheel, or calls are made under the owner's lock). Callbacks run inside advance() and may
+// schedule or cancel other timers; they must not throw.
+class TimerWheel {
+  public:
+    using TimerId = uint64_t;
+    using Callback = std::function<void()>;
+
+    static constexpr TimerId kInvalidTimer = 0;
+
+    explicit TimerWheel(std::chrono::nanoseconds tick = std::chrono::milliseconds(1),
+                        int64_t start_ns = 0);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Schedules a callback at an absolute time (same time base as advance()). A timer never
+    // fires early; deadlines that are already due fire on the next tick processed.
+    TimerId scheduleAt(int64_t deadline_ns, Callback callback);
+    // Relative to the time last passed to advance() (or start_ns)
+    TimerId scheduleAfter(std::chrono::nanoseconds delay, Callback callback);
+
+    // Returns false if the timer already fired, was cancelled, or never existed
+    bool cancel(TimerId id);
+
+    // Fires all timers due at or before now_ns; returns the number fired
+    size_t advance(int64_t now_ns);
+
+    [[nodiscard]] size_t size() const noexcept {
+        return pending_;
+    }
+    [[nodiscard]] int64_t nowNanos() const noexcept {
+        return now_ns_;
+    }
+    [[nodiscard]] int64_t tickNanos() const noexcept {
+        return tick_ns_;
+    }
+
+  private:
+    static constexpr size_t kLevels = 4;
+    static constexpr size_t kSlotBits = 8;
+    static constexpr size_t kSlots = size_t{1} << kSlotBits;
+    static constexpr uint32_t kNil = UINT32_MAX;
+    static constexpr uint8_t kFiring = kLevels;  // Detached into firing_ by advance()
+
+    struct Node {
+        uint64_t expiry_tick = 0;
+        Callback callback;
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+        uint32_t generation = 0;
+        uint16_t slot = 0;
+        uint8_t level = 0;
+        bool active = false;
+    };
+
+    int64_t tick_ns_;
+    int64_t origin_ns_;
+    int64_t now_ns_;
+    uint64_t current_tick_ = 0;  // Next tick to be processed
+    size_t pending_ = 0;
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_nodes_;
+    std::array<std::array<uint32_t, kSlots>, kLevels> slots_;
+    std::array<size_t, kLevels> level_counts_{};
+    uint32_t firing_ = kNil;
+
+    void place(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade(size_t level, size_t slot);
+    size_t processTick();
+};
+
+}  // namespace trading::utils
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace trading::utils {
+
+// Monotonic version of some piece of served state, bumped by whoever changes it.
+//
+// Readers compare versions with a single atomic load, which is what lets a conditional GET be
+// answered without touching the state itself. Long-poll readers can also block until the
+// version moves past one they have seen, or register a callback for it instead of blocking.
+// bump() only takes the mutex when someone is waiting, so writers on the hot path pay one
+// fetch_add and one load while nobody long-polls.
+class VersionCounter {
+  public:
+    [[nodiscard]] uint64_t current() const noexcept {
+        return version_.load(std::memory_order_acquire);
+    }
+
+    void bump() noexcept {
+        version_.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) > 0) {
+            // Taking the mutex orders the notify after a waiter's check-then-wait
+            std::vector<std::function<void()>> callbacks;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                changed_.notify_all();
+                callbacks.swap(callbacks_);
+                waiters_.fetch_sub(static_cast<uint32_t>(callbacks.size()),
+                                   std::memory_order_relaxed);
+            }
+            for (auto& callback : callbacks) {
+                callback();
+            }
+        }
+    }
+
+    // Calls callback once the version differs from seen: right away if it already does,
+    // otherwise on the thread of the next bump(). A callback is kept until that bump even if
+    // its caller stopped caring, so it should only hold on to something small.
+    void onChange(uint64_t seen, std::function<void()> callback) const {
+        {
+            // Counted before the check, as in waitForChange(), so a racing bump() sees us
+            std::lock_guard<std::mutex> lock(mutex_);
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            if (version_.load(std::memory_order_seq_cst) == seen) {
+                callbacks_.push_back(std::move(callback));
+                return;
+            }
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        callback();
+    }
+
+    // Blocks until the version differs from seen or timeout passes; returns the version then
+    uint64_t waitForChange(uint64_t seen, std::chrono::milliseconds timeout) const {
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        changed_.wait_for(lock, timeout, [&] {
+            return version_.load(std::memory_order_seq_cst) != seen;
+        });
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return current();
+    }
+
+  private:
+    std::atomic<uint64_t> version_{1};
+    mutable std::atomic<uint32_t> waiters_{0};
+    mutable std::mutex mutex_;
+    mutable std::condition_variable changed_;
+    mutable std::vector<std::function<void()>> callbacks_;
+};
+
+}  // namespace trading::utils
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include "../core/order.hpp"
+#include "../core/order_request.hpp"
+#include "../utils/snapshot.hpp"
 
 namespace trading {
 namespace validation {
@@ -25,18 +27,39 @@ struct ValidationResult {
     std::string error_message;
 };
 
+// Checks orders against the configured symbols and quantity/price bands.
+//
+// The limits are one immutable snapshot: validate() reads them with a single atomic load, and
+// setLimits() (or any setter) swaps in a new snapshot while orders are being validated.
 class OrderValidator {
   public:
+    struct Limits {
+        std::vector<std::string> valid_symbols;  // Empty: any non-empty symbol
+        double min_quantity = 0.01;
+        double max_quantity = 1000000.0;
+        double min_price = 0.01;
+        double max_price = 1000000.0;
+        bool market_open = true;
+    };
+
     OrderValidator();
     ~OrderValidator() = default;
 
     // Validation methods
     ValidationResult validate(std::shared_ptr<core::Order> order) const;
+    // Same checks on a decoded new-order request, before any Order is created
+    ValidationResult validate(const core::OrderRequest& request) const;
+    // Same checks on the order an amend would leave behind: fields the amend omits keep the
+    // resting order's values, and the symbol and type are always the resting order's
+    ValidationResult validateAmend(const core::Order& resting,
+                                   const core::OrderRequest& amend) const;
     ValidationResult validateSymbol(const std::string& symbol) const;
     ValidationResult validateQuantity(double quantity) const;
     ValidationResult validatePrice(double price, core::OrderType type) const;
 
     // Configuration
+    void setLimits(Limits limits);
+    [[nodiscard]] Limits getLimits() const;
     void addValidSymbol(const std::string& symbol);
     void removeValidSymbol(const std::string& symbol);
     void setMinQuantity(double min_quantity);
@@ -49,16 +72,13 @@ class OrderValidator {
     bool isMarketOpen() const;
 
   private:
-    std::vector<std::string> valid_symbols_;
-    double min_quantity_;
-    double max_quantity_;
-    double min_price_;
-    double max_price_;
-    bool market_open_;
+    utils::Snapshot<Limits> limits_;
 
-    bool isValidSymbol(const std::string& symbol) const;
-    bool isValidQuantity(double quantity) const;
-    bool isValidPrice(double price) const;
+    ValidationResult validateFields(const std::string& symbol, double quantity, double price,
+                                    core::OrderType type) const;
+    static bool isValidSymbol(const Limits& limits, const std::string& symbol);
+    static bool isValidQuantity(const Limits& limits, double quantity);
+    static bool isValidPrice(const Limits& limits, double price);
 };
 
 }  // namespace validation
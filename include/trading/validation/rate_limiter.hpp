@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../utils/snapshot.hpp"
+
+namespace trading {
+namespace validation {
+
+// Per-user order rate limiter: one token bucket per user, kept in a fixed-capacity
+// open-addressing table (linear probing) that is never locked.
+//
+// A bucket is a single atomic word holding the time at which it would be full again (the GCRA
+// form of a token bucket): refilling and taking tokens are one compare-and-swap on it, so
+// concurrent ingress threads never serialize on anything but a contended user's own bucket.
+// Users are added on first sight by claiming an empty slot and are never removed; once the
+// table is at its load-factor cap, users it has not seen all draw from one shared overflow
+// bucket, so flooding the table with made-up user ids cannot switch limiting off.
+//
+// Each user belongs to a tier, which sets the sustained rate and the burst. Users not listed
+// in user_tiers get default_tier. The tiers can be replaced while the limiter is in use;
+// buckets keep their state and pick up their user's new tier on next use.
+class RateLimiter {
+  public:
+    struct Tier {
+        double orders_per_second = 50.0;  // 0 or less: unlimited
+        double burst = 100.0;             // Orders that may be taken at once from a full bucket
+        Tier() = default;
+        Tier(double rate, double burst_size) : orders_per_second(rate), burst(burst_size) {
+        }
+    };
+
+    struct Config {
+        size_t capacity = 65536;  // Users tracked; rounded up to a power of two
+        std::unordered_map<std::string, Tier> tiers{{"standard", Tier()}};
+        std::string default_tier = "standard";
+        std::unordered_map<std::string, std::string> user_tiers;  // userId -> tier name
+        Config() = default;
+    };
+
+    struct Decision {
+        bool allowed;
+        int64_t retry_after_ns;  // When refused: wait until the bucket holds enough tokens
+    };
+
+    struct Metrics {
+        uint64_t allowed;
+        uint64_t limited;
+        uint64_t untracked;  // Requests charged to the shared overflow bucket
+        size_t tracked_users;
+    };
+
+    RateLimiter();
+    // Throws std::invalid_argument if default_tier or a user's tier is not defined
+    explicit RateLimiter(const Config& config);
+    ~RateLimiter();
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Replaces tiers, default_tier and user_tiers; capacity is fixed at construction. Throws
+    // std::invalid_argument as the constructor does, leaving the current tiers in place.
+    void reconfigure(const Config& config);
+
+    // Takes cost tokens from the user's bucket, all or nothing
+    Decision tryAcquire(std::string_view user_id, int64_t now_ns, uint32_t cost = 1);
+
+    // Tokens currently in the user's bucket (the overflow bucket for users the full table does
+    // not hold); the tier's burst for users not yet seen
+    [[nodiscard]] double availableTokens(std::string_view user_id, int64_t now_ns) const;
+
+    [[nodiscard]] Metrics getMetrics() const;
+
+  private:
+    struct Slot;
+    struct TierParams {
+        int64_t interval_ns;   // Time to earn one token; 0 means unlimited
+        int64_t tolerance_ns;  // burst * interval_ns
+    };
+
+    // One immutable generation of tier settings
+    struct TierTable {
+        uint32_t generation = 0;
+        std::vector<TierParams> params;
+        uint32_t default_tier = 0;
+        std::unordered_map<std::string, uint32_t> user_tiers;
+    };
+
+    size_t capacity_;
+    size_t mask_;
+    size_t max_size_;  // Load factor cap
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t> size_{0};
+    std::atomic<uint64_t> allowed_{0};
+    std::atomic<uint64_t> limited_{0};
+    std::atomic<uint64_t> untracked_{0};
+    // Bucket shared by every user the full table cannot hold
+    std::atomic<int64_t> overflow_full_at_ns_{0};
+
+    utils::Snapshot<TierTable> tiers_;
+
+    const Slot* findSlot(std::string_view user_id, uint64_t hash) const;
+    Slot* findOrClaimSlot(std::string_view user_id, uint64_t hash, const TierTable& tiers);
+    static TierTable buildTiers(const Config& config, uint32_t generation);
+    static uint32_t tierFor(const TierTable& tiers, std::string_view user_id);
+    static uint32_t slotTier(Slot& slot, std::string_view user_id, const TierTable& tiers);
+    Decision take(std::atomic<int64_t>& full_at_ns, const TierParams& tier, int64_t now_ns,
+                  uint32_t cost);
+};
+
+}  // namespace validation
+}  // namespace trading
@@ -0,0 +1,171 @@
+#include "trading/core/ids.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "trading/utils/clock.hpp"
+#include "trading/utils/segmented_table.hpp"
+#include "trading/utils/string_interner.hpp"
+
+namespace trading::core {
+
+namespace {
+utils::StringInterner& symbolRegistry() {
+    static utils::StringInterner registry;
+    return registry;
+}
+
+utils::StringInterner& userRegistry() {
+    static utils::StringInterner registry;
+    return registry;
+}
+
+// A metadata record, the generation of the handle it currently belongs to, and a sequence
+// number that is odd while the slot is being rewritten for a new order
+struct MetadataSlot {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint32_t> generation{0};
+    OrderMetadata metadata;
+
+    MetadataSlot() = default;
+    explicit MetadataSlot(const OrderMetadata& value) : metadata(value) {
+    }
+    MetadataSlot& operator=(MetadataSlot&& other) noexcept {
+        sequence.store(other.sequence.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        generation.store(other.generation.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+        metadata = other.metadata;
+        return *this;
+    }
+};
+
+OrderHandle packHandle(uint32_t generation, uint64_t slot) {
+    return static_cast<OrderHandle>(generation) << 32 | slot;
+}
+
+// Order metadata slots, recycled through a FIFO of released slots held back for
+// kOrderHandleReuseDelay releases
+class OrderRegistry {
+  public:
+    OrderHandle add(const OrderMetadata& metadata) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (released_.size() <= kOrderHandleReuseDelay) {
+            return packHandle(0, table_.append(MetadataSlot(metadata)));
+        }
+        const uint64_t slot = released_.front();
+        released_.pop_front();
+        uint32_t generation = 0;
+        table_.update(slot, [&](MetadataSlot& entry) {
+            // Readers copying the slot out retry until the rewrite is complete; stale handles
+            // fail the generation check from here on
+            const uint64_t sequence = entry.sequence.load(std::memory_order_relaxed);
+            entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            generation = entry.generation.load(std::memory_order_relaxed) + 1;
+            entry.generation.store(generation, std::memory_order_relaxed);
+            entry.metadata = metadata;
+            entry.sequence.store(sequence + 2, std::memory_order_release);
+        });
+        return packHandle(generation, slot);
+    }
+
+    void release(OrderHandle handle) noexcept {
+        const uint64_t slot = handle & 0xFFFFFFFFu;
+        if (handle == kInvalidOrderHandle || !isCurrent(handle)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_.push_back(slot);
+    }
+
+    OrderMetadata get(OrderHandle handle) const noexcept {
+        const MetadataSlot& entry = table_.get(handle & 0xFFFFFFFFu);
+        OrderMetadata metadata;
+        for (;;) {
+            const uint64_t before = entry.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            const uint32_t generation = entry.generation.load(std::memory_order_relaxed);
+            std::memcpy(&metadata, &entry.metadata, sizeof(OrderMetadata));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (entry.sequence.load(std::memory_order_relaxed) == before) {
+                return generation == handle >> 32 ? metadata : OrderMetadata{};
+            }
+        }
+    }
+
+    // Only for a handle that is still owned: its slot cannot be rewritten until released
+    std::string_view owned(OrderHandle handle) const noexcept {
+        return table_.get(handle & 0xFFFFFFFFu).metadata.getClientOrderId();
+    }
+
+  private:
+    utils::SegmentedTable<MetadataSlot> table_;
+    std::mutex mutex_;
+    std::deque<uint64_t> released_;
+
+    bool isCurrent(OrderHandle handle) const noexcept {
+        const MetadataSlot& entry = table_.get(handle & 0xFFFFFFFFu);
+        return entry.generation.load(std::memory_order_acquire) == handle >> 32;
+    }
+};
+
+OrderRegistry& orderRegistry() {
+    static OrderRegistry registry;
+    return registry;
+}
+}  // namespace
+
+SymbolId internSymbol(std::string_view symbol) {
+    return symbolRegistry().intern(symbol);
+}
+
+const std::string& symbolName(SymbolId id) noexcept {
+    return symbolRegistry().name(id);
+}
+
+UserId internUser(std::string_view user_id) {
+    return userRegistry().intern(user_id);
+}
+
+const std::string& userName(UserId id) noexcept {
+    return userRegistry().name(id);
+}
+
+OrderHandle registerOrder(std::string_view client_order_id, UserId user, SymbolId symbol) {
+    OrderMetadata metadata;
+    if (client_order_id.size() > OrderMetadata::kMaxClientOrderIdLength) {
+        throw std::invalid_argument("Client order id longer than " +
+                                    std::to_string(OrderMetadata::kMaxClientOrderIdLength) +
+                                    " characters");
+    }
+    std::memcpy(metadata.client_order_id, client_order_id.data(), client_order_id.size());
+    metadata.user = user;
+    metadata.symbol = symbol;
+    metadata.created_ns = utils::defaultClock()->nowNanos();
+    return orderRegistry().add(metadata);
+}
+
+void releaseOrder(OrderHandle handle) noexcept {
+    orderRegistry().release(handle);
+}
+
+OrderMetadata orderMetadata(OrderHandle handle) noexcept {
+    return orderRegistry().get(handle);
+}
+
+std::string clientOrderId(OrderHandle handle) {
+    return std::string(orderRegistry().get(handle).getClientOrderId());
+}
+
+std::string_view ownedOrderId(OrderHandle handle) noexcept {
+    return orderRegistry().owned(handle);
+}
+
+}  // namespace trading::core
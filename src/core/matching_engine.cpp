@@ -1,10 +1,20 @@
 #include "trading/core/matching_engine.hpp"
 #include <chrono>
+#include <utility>
 
 namespace trading {
 namespace core {
 
-MatchingEngine::MatchingEngine() : total_trades_(0), total_volume_(0.0), next_trade_id_(1) {
+namespace {
+constexpr std::chrono::milliseconds kExpiryTick{1};
+}  // namespace
+
+MatchingEngine::MatchingEngine()
+    : total_trades_(0),
+      total_volume_(0.0),
+      next_trade_id_(1),
+      clock_(utils::defaultClock()),
+      expiry_wheel_(std::make_unique<utils::TimerWheel>(kExpiryTick, clock_->nowNanos())) {
 }
 
 void MatchingEngine::addOrderBook(const std::string& symbol, std::shared_ptr<OrderBook> orderbook) {
@@ -12,22 +22,231 @@ void MatchingEngine::addOrderBook(const std::string& symbol, std::shared_ptr<Ord
 }
 
 std::vector<Trade> MatchingEngine::matchOrder(std::shared_ptr<Order> order, OrderBook& orderbook) {
+    std::vector<Trade> trades;
+    cancelled_stops_.clear();
+
     // Match market orders
     if (order->getType() == OrderType::MARKET) {
-        return matchMarketOrder(order, orderbook);
+        trades = matchMarketOrder(order, orderbook);
     }
 
     else if (order->getType() == OrderType::LIMIT) {
-        return matchLimitOrder(order, orderbook);
+        trades = matchLimitOrder(order, orderbook);
     }
 
-    return std::vector<Trade>();
+    else if (order->getType() == OrderType::STOP) {
+        StopBook& stops = stop_books_[order->getSymbolKey()];
+        if (!isStopTriggered(*order, stops)) {
+            // Park the stop until the last trade price reaches its level
+            if (order->getSide() == OrderSide::BUY) {
+                stops.buy_stops.emplace(order->getPrice(), order);
+            } else {
+                stops.sell_stops.emplace(order->getPrice(), order);
+            }
+            return trades;
+        }
+
+        // Already through its level on arrival: execute immediately
+        trades = matchMarketOrder(order, orderbook);
+        dropUnfilledStop(*order);
+    }
+
+    releaseTriggeredStops(orderbook, trades);
+    return trades;
+}
+
+AmendResult MatchingEngine::amendOrder(UserId user, const std::string& order_id,
+                                       std::optional<double> new_quantity,
+                                       std::optional<double> new_price, OrderBook& orderbook) {
+    AmendResult result{AmendStatus::NOT_FOUND, {}};
+    cancelled_stops_.clear();
+    auto order = orderbook.findOrder(user, order_id);
+    if (!order) {
+        return result;
+    }
+
+    const double previous_price = order->getPrice();
+    result.status =
+        orderbook.amendOrder(user, order_id, new_quantity.value_or(order->getQuantity()),
+                             new_price.value_or(previous_price));
+
+    if (result.status == AmendStatus::REQUEUED && order->getPrice() != previous_price) {
+        result.trades = matchLimitOrder(order, orderbook);
+        releaseTriggeredStops(orderbook, result.trades);
+    }
+    return result;
+}
+
+std::vector<std::shared_ptr<Order>> MatchingEngine::cancelUserOrders(const std::string& user_id,
+                                                                    const std::string& symbol) {
+    std::vector<std::shared_ptr<Order>> cancelled;
+    const UserId user = internUser(user_id);
+
+    for (auto& [book_symbol, orderbook] : orderbooks_) {
+        if (!symbol.empty() && book_symbol != symbol) {
+            continue;
+        }
+        auto book_cancelled = orderbook->cancelUserOrders(user);
+        cancelled.insert(cancelled.end(), book_cancelled.begin(), book_cancelled.end());
+    }
+
+    for (auto& [symbol_key, stops] : stop_books_) {
+        if (symbol.empty() || symbol_key == internSymbol(symbol)) {
+            cancelStops(stops, user, cancelled);
+        }
+    }
+    return cancelled;
+}
+
+std::vector<std::shared_ptr<Order>> MatchingEngine::cancelSymbolOrders(const std::string& symbol) {
+    std::vector<std::shared_ptr<Order>> cancelled;
+    if (auto orderbook = getOrderBook(symbol)) {
+        cancelled = orderbook->cancelAllOrders();
+    }
+
+    auto stops_it = stop_books_.find(internSymbol(symbol));
+    if (stops_it != stop_books_.end()) {
+        cancelStops(stops_it->second, kInvalidUserId, cancelled);
+    }
+    return cancelled;
+}
+
+void MatchingEngine::cancelStops(StopBook& stops, UserId user,
+                                 std::vector<std::shared_ptr<Order>>& cancelled) {
+    // Stops are indexed by price, not user, so this walks the symbol's pending stops
+    auto cancel_matching = [&](auto& side) {
+        for (auto it = side.begin(); it != side.end();) {
+            if (user == kInvalidUserId || it->second->getUserKey() == user) {
+                it->second->setStatus(OrderStatus::CANCELLED);
+                cancelled.push_back(std::move(it->second));
+                it = side.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    };
+    cancel_matching(stops.buy_stops);
+    cancel_matching(stops.sell_stops);
+}
+
+void MatchingEngine::scheduleExpiry(std::shared_ptr<Order> order, int64_t expire_at_ns) {
+    std::weak_ptr<Order> weak_order = order;
+    expiry_wheel_->scheduleAt(expire_at_ns, [this, weak_order] {
+        auto order = weak_order.lock();
+        if (!order) {
+            return;
+        }
+        // Only expire the order if it is still the one resting under its id
+        auto orderbook = getOrderBook(order->getSymbol());
+        if (orderbook && orderbook->findOrder(order->getUserKey(), order->getId()) == order) {
+            orderbook->removeOrder(order->getUserKey(), order->getId());
+            order->setStatus(OrderStatus::EXPIRED);
+            expired_.push_back(std::move(order));
+        }
+    });
+}
+
+std::vector<std::shared_ptr<Order>> MatchingEngine::expireOrders() {
+    expiry_wheel_->advance(clock_->nowNanos());
+    return std::exchange(expired_, {});
+}
+
+size_t MatchingEngine::getPendingExpiryCount() const {
+    return expiry_wheel_->size();
+}
+
+size_t MatchingEngine::getPendingStopCount(const std::string& symbol) const {
+    auto it = stop_books_.find(internSymbol(symbol));
+    if (it == stop_books_.end()) {
+        return 0;
+    }
+    return it->second.buy_stops.size() + it->second.sell_stops.size();
+}
+
+double MatchingEngine::getLastTradePrice(const std::string& symbol) const {
+    auto it = stop_books_.find(internSymbol(symbol));
+    if (it == stop_books_.end()) {
+        return 0.0;
+    }
+    return it->second.last_trade_price;
+}
+
+bool MatchingEngine::isStopTriggered(const Order& order, const StopBook& stops) {
+    if (!stops.has_last_trade) {
+        return false;
+    }
+    return order.getSide() == OrderSide::BUY ? stops.last_trade_price >= order.getPrice()
+                                             : stops.last_trade_price <= order.getPrice();
+}
+
+std::vector<std::shared_ptr<Order>> MatchingEngine::takeTriggeredStops(StopBook& stops) {
+    std::vector<std::shared_ptr<Order>> released;
+    if (!stops.has_last_trade) {
+        return released;
+    }
+
+    // Triggered stops are a prefix of each side: one O(log n) bound plus O(k) extraction
+    auto buy_end = stops.buy_stops.upper_bound(stops.last_trade_price);
+    for (auto it = stops.buy_stops.begin(); it != buy_end; ++it) {
+        released.push_back(std::move(it->second));
+    }
+    stops.buy_stops.erase(stops.buy_stops.begin(), buy_end);
+
+    auto sell_end = stops.sell_stops.upper_bound(stops.last_trade_price);
+    for (auto it = stops.sell_stops.begin(); it != sell_end; ++it) {
+        released.push_back(std::move(it->second));
+    }
+    stops.sell_stops.erase(stops.sell_stops.begin(), sell_end);
+
+    return released;
+}
+
+void MatchingEngine::releaseTriggeredStops(OrderBook& orderbook, std::vector<Trade>& trades) {
+    if (trades.empty()) {
+        return;
+    }
+
+    StopBook& stops = stop_books_[orderbook.getSymbolKey()];
+
+    // Each batch of released stops may trade and move the price further, so keep going until
+    // a batch leaves no new stops triggered
+    size_t processed = 0;
+    while (processed < trades.size()) {
+        stops.last_trade_price = trades.back().price;
+        stops.has_last_trade = true;
+        processed = trades.size();
+
+        for (auto& stop : takeTriggeredStops(stops)) {
+            auto stop_trades = matchMarketOrder(stop, orderbook);
+            trades.insert(trades.end(), stop_trades.begin(), stop_trades.end());
+            if (dropUnfilledStop(*stop)) {
+                cancelled_stops_.push_back(std::move(stop));
+            }
+        }
+    }
+}
+
+bool MatchingEngine::dropUnfilledStop(Order& stop) {
+    if (stop.getQuantity() <= 0) {
+        return false;
+    }
+    stop.setStatus(OrderStatus::CANCELLED);
+    return true;
+}
+
+std::vector<std::shared_ptr<Order>> MatchingEngine::takeCancelledStops() {
+    return std::exchange(cancelled_stops_, {});
 }
 
 void MatchingEngine::setTradeCallback(TradeCallback callback) {
     trade_callback_ = callback;
 }
 
+void MatchingEngine::setClock(std::shared_ptr<utils::Clock> clock) {
+    clock_ = clock ? std::move(clock) : utils::defaultClock();
+    expiry_wheel_ = std::make_unique<utils::TimerWheel>(kExpiryTick, clock_->nowNanos());
+}
+
 uint64_t MatchingEngine::getTotalTrades() const {
     return total_trades_;
 }
@@ -83,11 +302,13 @@ std::vector<Trade> MatchingEngine::matchMarketOrder(std::shared_ptr<Order> order
 
             // If the opposite order is fully matched, remove it from the book
             if (opposite_order->getQuantity() <= 0) {
-                orderbook.removeOrder(opposite_order->getId());
+                orderbook.removeOrder(opposite_order->getUserKey(), opposite_order->getId());
             }
         }
     }
 
+    settleIncomingOrder(order, remaining_quantity, orderbook);
+
     // Update total trades and volume and user portfolios
     total_trades_ += trades.size();
     for (const auto& trade : trades) {
@@ -149,11 +370,13 @@ std::vector<Trade> MatchingEngine::matchLimitOrder(std::shared_ptr<Order> order,
 
             // If the opposite order is fully matched, remove it from the book
             if (opposite_order->getQuantity() <= 0) {
-                orderbook.removeOrder(opposite_order->getId());
+                orderbook.removeOrder(opposite_order->getUserKey(), opposite_order->getId());
             }
         }
     }
 
+    settleIncomingOrder(order, remaining_quantity, orderbook);
+
     // Update total trades and volume
     total_trades_ += trades.size();
     for (const auto& trade : trades) {
@@ -172,24 +395,45 @@ std::vector<Trade> MatchingEngine::matchLimitOrder(std::shared_ptr<Order> order,
     return trades;
 }
 
+void MatchingEngine::settleIncomingOrder(const std::shared_ptr<Order>& order,
+                                         double remaining_quantity, OrderBook& orderbook) {
+    if (remaining_quantity >= order->getQuantity()) {
+        return;
+    }
+
+    // Reflect fills on the incoming order and drop it from the book if it was resting there
+    order->setQuantity(remaining_quantity);
+    const UserId user = order->getUserKey();
+    if (remaining_quantity <= 0 && orderbook.findOrder(user, order->getId()) == order) {
+        orderbook.removeOrder(user, order->getId());
+    }
+}
+
 Trade MatchingEngine::createTrade(std::shared_ptr<Order> buy_order,
                                   std::shared_ptr<Order> sell_order, double quantity,
                                   double price) {
     Trade trade;
-    trade.trade_id = std::to_string(next_trade_id_++);
-    trade.buy_order_id = buy_order->getId();
-    trade.sell_order_id = sell_order->getId();
-    trade.buy_user_id = buy_order->getUserId();
-    trade.sell_user_id = sell_order->getUserId();
-    trade.symbol = buy_order->getSymbol();
+    trade.trade_id = next_trade_id_++;
+    trade.buy_order = buy_order->getHandle();
+    trade.sell_order = sell_order->getHandle();
+    trade.buy_user = buy_order->getUserKey();
+    trade.sell_user = sell_order->getUserKey();
+    trade.symbol = buy_order->getSymbolKey();
     trade.quantity = quantity;
     trade.price = price;
-    trade.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                          std::chrono::system_clock::now().time_since_epoch())
-                          .count();
+    trade.timestamp_ns = clock_->nowNanos();
     return trade;
 }
 
+std::vector<std::string> MatchingEngine::getSymbols() const {
+    std::vector<std::string> symbols;
+    symbols.reserve(orderbooks_.size());
+    for (const auto& [symbol, orderbook] : orderbooks_) {
+        symbols.push_back(symbol);
+    }
+    return symbols;
+}
+
 std::shared_ptr<OrderBook> MatchingEngine::getOrderBook(const std::string& symbol) {
     auto it = orderbooks_.find(symbol);
     if (it != orderbooks_.end()) {
@@ -226,16 +470,17 @@ const std::map<std::string, std::shared_ptr<User>>& MatchingEngine::getAllUsers(
 
 bool MatchingEngine::updateUserPortfolios(const Trade& trade, double fee) {
     // Get or create users (with default starting cash if new)
-    auto buyer = getOrCreateUser(trade.buy_user_id);
-    auto seller = getOrCreateUser(trade.sell_user_id);
+    auto buyer = getOrCreateUser(userName(trade.buy_user));
+    auto seller = getOrCreateUser(userName(trade.sell_user));
+    const std::string& symbol = symbolName(trade.symbol);
 
     // Apply execution to buyer (BUY side)
     bool buyer_success =
-        buyer->applyExecution(OrderSide::BUY, trade.symbol, trade.quantity, trade.price, fee);
+        buyer->applyExecution(OrderSide::BUY, symbol, trade.quantity, trade.price, fee);
 
     // Apply execution to seller (SELL side)
     bool seller_success =
-        seller->applyExecution(OrderSide::SELL, trade.symbol, trade.quantity, trade.price, fee);
+        seller->applyExecution(OrderSide::SELL, symbol, trade.quantity, trade.price, fee);
 
     return buyer_success && seller_success;
 }
@@ -4,40 +4,45 @@
 namespace trading::core {
 
 Order::Order()
-    : id_(""),
-      userId_(""),
-      symbol_(""),
-      type_(OrderType::LIMIT),
-      side_(OrderSide::BUY),
-      quantity_(0.0),
+    : handle_(kInvalidOrderHandle),
       price_(0.0),
+      quantity_(0.0),
       filled_quantity_(0.0),
+      user_key_(kInvalidUserId),
+      symbol_key_(kInvalidSymbolId),
+      type_(OrderType::LIMIT),
+      side_(OrderSide::BUY),
       status_(OrderStatus::PENDING) {
 }
 
 Order::Order(const std::string& id, const std::string& userId, const std::string& symbol,
              OrderType type, OrderSide side, double quantity, double price)
-    : id_(id),
-      userId_(userId),
-      symbol_(symbol),
-      type_(type),
-      side_(side),
-      quantity_(quantity),
+    : handle_(kInvalidOrderHandle),
       price_(price),
+      quantity_(quantity),
       filled_quantity_(0.0),
+      user_key_(internUser(userId)),
+      symbol_key_(internSymbol(symbol)),
+      type_(type),
+      side_(side),
       status_(OrderStatus::PENDING) {
+    handle_ = registerOrder(id, user_key_, symbol_key_);
 }
 
-const std::string& Order::getId() const noexcept {
-    return id_;
+std::string_view Order::getId() const noexcept {
+    return ownedOrderId(handle_);
 }
 
 const std::string& Order::getUserId() const noexcept {
-    return userId_;
+    return userName(user_key_);
 }
 
 const std::string& Order::getSymbol() const noexcept {
-    return symbol_;
+    return symbolName(symbol_key_);
+}
+
+int64_t Order::getCreatedNanos() const noexcept {
+    return orderMetadata(handle_).created_ns;
 }
 
 void Order::setStatus(OrderStatus status) noexcept {
@@ -55,7 +60,8 @@ void Order::addFill(double quantity) noexcept {
 
 std::string Order::toString() const {
     std::ostringstream oss;
-    oss << "Order{id: " << id_ << ", symbol: " << symbol_ << ", type: " << static_cast<int>(type_)
+    oss << "Order{id: " << getId() << ", symbol: " << getSymbol()
+        << ", type: " << static_cast<int>(type_)
         << ", side: " << static_cast<int>(side_) << ", quantity: " << quantity_
         << ", price: " << price_ << ", filled: " << filled_quantity_ << "}";
     return oss.str();
@@ -0,0 +1,488 @@
+#include "trading/core/order_state_store.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace trading::core {
+
+struct OrderStateStore::Slot {
+    std::atomic<uint64_t> sequence{0};  // Odd while the record is being rewritten
+    std::atomic<uint64_t> key_hash{0};  // 0 marks an empty slot
+    std::atomic<uint64_t> user_hash{0};
+    // Links among the records sharing user_hash; readers follow user_next
+    std::atomic<uint32_t> user_prev{kNoSlot};
+    std::atomic<uint32_t> user_next{kNoSlot};
+    // Writer-only bookkeeping
+    bool terminal = false;
+    uint32_t terminal_generation = 0;
+    OrderState state{};
+};
+
+struct OrderStateStore::UserChain {
+    std::atomic<uint64_t> user_hash{0};  // 0 marks an empty entry
+    std::atomic<uint32_t> head{kNoSlot};
+};
+
+namespace {
+constexpr double kQuantityEpsilon = 1e-9;
+
+uint64_t hashKey(std::string_view key) {
+    const uint64_t hash = std::hash<std::string_view>{}(key);
+    return hash == 0 ? 1 : hash;
+}
+
+uint64_t hashKey(std::string_view user_id, std::string_view id) {
+    const uint64_t hash = std::hash<std::string_view>{}(id) ^
+                          (std::hash<std::string_view>{}(user_id) * 0x9e3779b97f4a7c15ULL);
+    return hash == 0 ? 1 : hash;
+}
+
+bool matches(const OrderState& state, std::string_view user_id, std::string_view id) {
+    return state.getId() == id && state.getUserId() == user_id;
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Entries whose home lies cyclically in (hole, next] must stay where they are
+bool staysPut(size_t hole, size_t next, size_t home) {
+    return hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+}
+
+template <size_t N>
+bool copyField(char (&field)[N], std::string_view value) {
+    if (value.size() >= N) {
+        return false;
+    }
+    std::memcpy(field, value.data(), value.size());
+    field[value.size()] = '\0';
+    return true;
+}
+}  // namespace
+
+OrderStateStore::OrderStateStore() : OrderStateStore(Config()) {
+}
+
+OrderStateStore::OrderStateStore(const Config& config)
+    : capacity_(roundUpToPowerOfTwo(std::max<size_t>(config.capacity, 16))),
+      mask_(capacity_ - 1),
+      max_size_(capacity_ / 4 * 3),
+      slots_(std::make_unique<Slot[]>(capacity_)),
+      user_chains_(std::make_unique<UserChain[]>(capacity_)),
+      generation_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(config.terminal_ttl)
+                         .count() /
+                     kGenerations) {
+    if (generation_ns_ <= 0) {
+        throw std::invalid_argument("OrderStateStore TTL must be positive");
+    }
+    if (capacity_ >= kNoSlot) {
+        throw std::invalid_argument("OrderStateStore capacity too large");
+    }
+}
+
+OrderStateStore::~OrderStateStore() = default;
+
+void OrderStateStore::publish(Slot& slot, const OrderState& state) {
+    const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.state = state;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool OrderStateStore::readSlot(const Slot& slot, OrderState& state) const {
+    for (;;) {
+        const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::memcpy(&state, &slot.state, sizeof(OrderState));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+}
+
+OrderStateStore::Slot* OrderStateStore::findSlot(std::string_view user_id, std::string_view id,
+                                                 uint64_t hash) {
+    for (size_t i = hash & mask_, probes = 0; probes < capacity_; ++probes, i = (i + 1) & mask_) {
+        Slot& slot = slots_[i];
+        const uint64_t key = slot.key_hash.load(std::memory_order_relaxed);
+        if (key == 0) {
+            return nullptr;
+        }
+        if (key == hash && matches(slot.state, user_id, id)) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+OrderStateStore::Slot* OrderStateStore::claimSlot(std::string_view user_id, std::string_view id,
+                                                  uint64_t hash) {
+    if (Slot* existing = findSlot(user_id, id, hash)) {
+        return existing;
+    }
+
+    // Under pressure, age terminal records early until the oldest of them are retired
+    for (uint32_t forced = 0;
+         size_.load(std::memory_order_relaxed) >= max_size_ && forced < kGenerations; ++forced) {
+        ++generation_;
+        evictGeneration();
+    }
+    if (size_.load(std::memory_order_relaxed) >= max_size_) {
+        return nullptr;
+    }
+
+    size_t i = hash & mask_;
+    while (slots_[i].key_hash.load(std::memory_order_relaxed) != 0) {
+        i = (i + 1) & mask_;
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return &slots_[i];
+}
+
+bool OrderStateStore::recordNew(const Order& order, int64_t now_ns) {
+    OrderState state{};
+    if (!copyField(state.id, order.getId()) || !copyField(state.user_id, order.getUserId()) ||
+        !copyField(state.symbol, order.getSymbol())) {
+        return false;
+    }
+    state.type = order.getType();
+    state.side = order.getSide();
+    state.status = OrderStatus::PENDING;
+    state.quantity = order.getQuantity();
+    state.remaining_quantity = order.getQuantity();
+    state.price = order.getPrice();
+    state.updated_ns = now_ns;
+
+    const uint64_t hash = hashKey(state.getUserId(), state.getId());
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    Slot* slot = claimSlot(state.getUserId(), state.getId(), hash);
+    if (!slot) {
+        return false;
+    }
+
+    // A reused id starts over as a live order, and is already on its user's chain
+    const bool claimed = slot->key_hash.load(std::memory_order_relaxed) == 0;
+    slot->terminal = false;
+    slot->user_hash.store(hashKey(state.getUserId()), std::memory_order_relaxed);
+    publish(*slot, state);
+    // Set last so a reader that sees the key also sees a complete record
+    slot->key_hash.store(hash, std::memory_order_release);
+    if (claimed) {
+        linkUser(static_cast<size_t>(slot - slots_.get()));
+    }
+    return true;
+}
+
+void OrderStateStore::markTerminal(Slot& slot, const OrderState& state) {
+    if (isTerminal(state.status) && !slot.terminal) {
+        slot.terminal = true;
+        slot.terminal_generation = generation_;
+    }
+}
+
+bool OrderStateStore::recordFill(std::string_view user_id, std::string_view id, double quantity,
+                                 double price, int64_t now_ns) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    Slot* slot = findSlot(user_id, id, hashKey(user_id, id));
+    if (!slot) {
+        return false;
+    }
+
+    OrderState state = slot->state;
+    const double filled = state.filled_quantity + quantity;
+    state.average_fill_price =
+        (state.average_fill_price * state.filled_quantity + price * quantity) / filled;
+    state.filled_quantity = filled;
+    state.remaining_quantity = std::max(0.0, state.remaining_quantity - quantity);
+    state.status = state.remaining_quantity <= kQuantityEpsilon ? OrderStatus::FILLED
+                                                                : OrderStatus::PARTIALLY_FILLED;
+    state.updated_ns = now_ns;
+    markTerminal(*slot, state);
+    publish(*slot, state);
+    return true;
+}
+
+bool OrderStateStore::recordStatus(std::string_view user_id, std::string_view id,
+                                   OrderStatus status, double remaining_quantity, int64_t now_ns) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    Slot* slot = findSlot(user_id, id, hashKey(user_id, id));
+    if (!slot) {
+        return false;
+    }
+
+    OrderState state = slot->state;
+    state.status = status;
+    state.remaining_quantity = isTerminal(status) ? 0.0 : remaining_quantity;
+    state.updated_ns = now_ns;
+    markTerminal(*slot, state);
+    publish(*slot, state);
+    return true;
+}
+
+bool OrderStateStore::recordAmend(std::string_view user_id, std::string_view id,
+                                  double open_quantity, double price, int64_t now_ns) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    Slot* slot = findSlot(user_id, id, hashKey(user_id, id));
+    if (!slot || slot->terminal) {
+        return false;
+    }
+
+    OrderState state = slot->state;
+    state.quantity = state.filled_quantity + open_quantity;
+    state.remaining_quantity = open_quantity;
+    state.price = price;
+    state.updated_ns = now_ns;
+    publish(*slot, state);
+    return true;
+}
+
+size_t OrderStateStore::evictExpired(int64_t now_ns) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    if (next_generation_at_ns_ == 0) {
+        next_generation_at_ns_ = now_ns + generation_ns_;
+        return 0;
+    }
+
+    bool advanced = false;
+    while (now_ns >= next_generation_at_ns_) {
+        ++generation_;
+        next_generation_at_ns_ += generation_ns_;
+        advanced = true;
+    }
+    return advanced ? evictGeneration() : 0;
+}
+
+size_t OrderStateStore::evictGeneration() {
+    // Readers retry any probe that overlaps the sweep, since erase() moves entries
+    layout_epoch_.fetch_add(1, std::memory_order_acq_rel);
+
+    size_t evicted = 0;
+    for (size_t i = 0; i < capacity_;) {
+        Slot& slot = slots_[i];
+        if (slot.key_hash.load(std::memory_order_relaxed) != 0 && slot.terminal &&
+            generation_ - slot.terminal_generation >= kGenerations) {
+            erase(i);
+            ++evicted;
+            continue;  // Another entry may have shifted into i
+        }
+        ++i;
+    }
+
+    layout_epoch_.fetch_add(1, std::memory_order_release);
+    return evicted;
+}
+
+void OrderStateStore::erase(size_t index) {
+    unlinkUser(index);
+
+    // Backward-shift deletion keeps every probe chain unbroken without tombstones
+    size_t hole = index;
+    for (size_t next = (hole + 1) & mask_;; next = (next + 1) & mask_) {
+        Slot& candidate = slots_[next];
+        const uint64_t key = candidate.key_hash.load(std::memory_order_relaxed);
+        if (key == 0) {
+            break;
+        }
+
+        if (staysPut(hole, next, key & mask_)) {
+            continue;
+        }
+
+        Slot& target = slots_[hole];
+        target.terminal = candidate.terminal;
+        target.terminal_generation = candidate.terminal_generation;
+        target.user_hash.store(candidate.user_hash.load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+        publish(target, candidate.state);
+        target.key_hash.store(key, std::memory_order_release);
+        relinkUser(next, hole);
+        hole = next;
+    }
+
+    slots_[hole].key_hash.store(0, std::memory_order_release);
+    slots_[hole].terminal = false;
+    size_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// The chain helpers below are writer-only. Readers only ever follow head and user_next, and
+// everything but linkUser runs inside an eviction sweep, where readers retry anyway.
+
+size_t OrderStateStore::findChain(uint64_t user_hash) const {
+    size_t i = user_hash & mask_;
+    while (user_chains_[i].user_hash.load(std::memory_order_relaxed) != user_hash) {
+        i = (i + 1) & mask_;
+    }
+    return i;
+}
+
+void OrderStateStore::linkUser(size_t index) {
+    Slot& slot = slots_[index];
+    const uint64_t user_hash = slot.user_hash.load(std::memory_order_relaxed);
+
+    size_t i = user_hash & mask_;
+    for (;; i = (i + 1) & mask_) {
+        const uint64_t key = user_chains_[i].user_hash.load(std::memory_order_relaxed);
+        if (key == 0 || key == user_hash) {
+            break;
+        }
+    }
+    UserChain& chain = user_chains_[i];
+    if (chain.user_hash.load(std::memory_order_relaxed) == 0) {
+        chain.head.store(kNoSlot, std::memory_order_relaxed);
+        chain.user_hash.store(user_hash, std::memory_order_release);
+    }
+
+    const uint32_t head = chain.head.load(std::memory_order_relaxed);
+    slot.user_prev.store(kNoSlot, std::memory_order_relaxed);
+    slot.user_next.store(head, std::memory_order_relaxed);
+    if (head != kNoSlot) {
+        slots_[head].user_prev.store(static_cast<uint32_t>(index), std::memory_order_relaxed);
+    }
+    chain.head.store(static_cast<uint32_t>(index), std::memory_order_release);
+}
+
+void OrderStateStore::unlinkUser(size_t index) {
+    Slot& slot = slots_[index];
+    const uint32_t prev = slot.user_prev.load(std::memory_order_relaxed);
+    const uint32_t next = slot.user_next.load(std::memory_order_relaxed);
+    if (next != kNoSlot) {
+        slots_[next].user_prev.store(prev, std::memory_order_relaxed);
+    }
+    if (prev != kNoSlot) {
+        slots_[prev].user_next.store(next, std::memory_order_release);
+        return;
+    }
+
+    const size_t chain = findChain(slot.user_hash.load(std::memory_order_relaxed));
+    if (next != kNoSlot) {
+        user_chains_[chain].head.store(next, std::memory_order_release);
+    } else {
+        eraseChain(chain);
+    }
+}
+
+void OrderStateStore::relinkUser(size_t from, size_t to) {
+    const uint32_t prev = slots_[from].user_prev.load(std::memory_order_relaxed);
+    const uint32_t next = slots_[from].user_next.load(std::memory_order_relaxed);
+    Slot& target = slots_[to];
+    target.user_prev.store(prev, std::memory_order_relaxed);
+    target.user_next.store(next, std::memory_order_release);
+
+    const auto moved = static_cast<uint32_t>(to);
+    if (next != kNoSlot) {
+        slots_[next].user_prev.store(moved, std::memory_order_relaxed);
+    }
+    if (prev != kNoSlot) {
+        slots_[prev].user_next.store(moved, std::memory_order_release);
+    } else {
+        const size_t chain = findChain(target.user_hash.load(std::memory_order_relaxed));
+        user_chains_[chain].head.store(moved, std::memory_order_release);
+    }
+}
+
+void OrderStateStore::eraseChain(size_t index) {
+    size_t hole = index;
+    for (size_t next = (hole + 1) & mask_;; next = (next + 1) & mask_) {
+        UserChain& candidate = user_chains_[next];
+        const uint64_t key = candidate.user_hash.load(std::memory_order_relaxed);
+        if (key == 0) {
+            break;
+        }
+        if (staysPut(hole, next, key & mask_)) {
+            continue;
+        }
+        user_chains_[hole].head.store(candidate.head.load(std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+        user_chains_[hole].user_hash.store(key, std::memory_order_release);
+        hole = next;
+    }
+    user_chains_[hole].user_hash.store(0, std::memory_order_release);
+}
+
+std::optional<OrderState> OrderStateStore::find(std::string_view user_id,
+                                                std::string_view id) const {
+    const uint64_t hash = hashKey(user_id, id);
+    for (;;) {
+        const uint64_t epoch = layout_epoch_.load(std::memory_order_acquire);
+        if (epoch & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::optional<OrderState> result;
+        for (size_t i = hash & mask_, probes = 0; probes < capacity_;
+             ++probes, i = (i + 1) & mask_) {
+            const Slot& slot = slots_[i];
+            const uint64_t key = slot.key_hash.load(std::memory_order_acquire);
+            if (key == 0) {
+                break;
+            }
+            OrderState state;
+            if (key == hash && readSlot(slot, state) && matches(state, user_id, id)) {
+                result = state;
+                break;
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (layout_epoch_.load(std::memory_order_relaxed) == epoch) {
+            return result;
+        }
+    }
+}
+
+std::vector<OrderState> OrderStateStore::findByUser(std::string_view user_id) const {
+    const uint64_t user_hash = hashKey(user_id);
+    for (;;) {
+        const uint64_t epoch = layout_epoch_.load(std::memory_order_acquire);
+        if (epoch & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint32_t index = kNoSlot;
+        for (size_t i = user_hash & mask_, probes = 0; probes < capacity_;
+             ++probes, i = (i + 1) & mask_) {
+            const uint64_t key = user_chains_[i].user_hash.load(std::memory_order_acquire);
+            if (key == 0) {
+                break;
+            }
+            if (key == user_hash) {
+                index = user_chains_[i].head.load(std::memory_order_acquire);
+                break;
+            }
+        }
+
+        // The step bound only matters for a walk torn by eviction, which is retried below
+        std::vector<OrderState> result;
+        for (size_t steps = 0; index != kNoSlot && steps < capacity_; ++steps) {
+            const Slot& slot = slots_[index];
+            OrderState state;
+            if (readSlot(slot, state) && state.getUserId() == user_id) {
+                result.push_back(state);
+            }
+            index = slot.user_next.load(std::memory_order_acquire);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (layout_epoch_.load(std::memory_order_relaxed) == epoch) {
+            return result;
+        }
+    }
+}
+
+}  // namespace trading::core
@@ -3,13 +3,11 @@
 #include <iomanip>
 #include <sstream>
 
-#include "../../apps/json.hpp"
-using json = nlohmann::json;
-
 namespace trading {
 namespace core {
 
-OrderBook::OrderBook(const std::string& symbol) : symbol_(symbol) {
+OrderBook::OrderBook(const std::string& symbol)
+    : symbol_(symbol), symbol_key_(internSymbol(symbol)) {
 }
 
 bool OrderBook::addOrder(std::shared_ptr<Order> order) {
@@ -18,28 +16,165 @@ bool OrderBook::addOrder(std::shared_ptr<Order> order) {
     }
 
     // Check if the order symbol matches the order book symbol
-    if (order->getSymbol() != symbol_) {
+    if (order->getSymbolKey() != symbol_key_) {
         return false;
     }
 
-    // Store order based on side
-    if (order->getSide() == OrderSide::BUY) {
-        buy_orders_[order->getPrice()].push_back(order);
-    } else if (order->getSide() == OrderSide::SELL) {
-        sell_orders_[order->getPrice()].push_back(order);
-    } else {
+    // Client order ids must be unique among a user's resting orders so they can address
+    // amends/cancels
+    auto [it, inserted] =
+        index_.try_emplace(OrderKey{order->getUserKey(), order->getId()}, RestingOrder{order});
+    if (!inserted) {
         return false;
     }
+    linkOrder(order);
+    linkUser(it->second);
 
     // Set order status
     order->setStatus(OrderStatus::PENDING);
     return true;
 }
 
-bool OrderBook::removeOrder(const std::string& order_id) {
-    (void)order_id;  // Suppress unused parameter warning
-    // TODO: Implement order removal logic
-    return false;
+bool OrderBook::removeOrder(UserId user, std::string_view order_id) {
+    auto it = index_.find(OrderKey{user, order_id});
+    if (it == index_.end()) {
+        return false;
+    }
+    unlinkOrder(*it->second.order);
+    unlinkUser(it->second);
+    index_.erase(it);
+    return true;
+}
+
+std::vector<std::shared_ptr<Order>> OrderBook::cancelUserOrders(UserId user) {
+    std::vector<std::shared_ptr<Order>> cancelled;
+    auto head = user_heads_.find(user);
+    if (head == user_heads_.end()) {
+        return cancelled;
+    }
+
+    RestingOrder* node = head->second;
+    user_heads_.erase(head);
+    while (node) {
+        RestingOrder* next = node->user_next;
+        auto order = std::move(node->order);
+        unlinkOrder(*order);
+        index_.erase(OrderKey{user, order->getId()});
+        order->setStatus(OrderStatus::CANCELLED);
+        cancelled.push_back(std::move(order));
+        node = next;
+    }
+    return cancelled;
+}
+
+std::vector<std::shared_ptr<Order>> OrderBook::cancelAllOrders() {
+    std::vector<std::shared_ptr<Order>> cancelled;
+    cancelled.reserve(index_.size());
+    for (auto& [key, node] : index_) {
+        node.order->setStatus(OrderStatus::CANCELLED);
+        cancelled.push_back(std::move(node.order));
+    }
+    index_.clear();
+    user_heads_.clear();
+    buy_orders_.clear();
+    sell_orders_.clear();
+    return cancelled;
+}
+
+std::vector<std::shared_ptr<Order>> OrderBook::getUserOrders(UserId user) const {
+    std::vector<std::shared_ptr<Order>> orders;
+    auto head = user_heads_.find(user);
+    for (const RestingOrder* node = head != user_heads_.end() ? head->second : nullptr; node;
+         node = node->user_next) {
+        orders.push_back(node->order);
+    }
+    return orders;
+}
+
+void OrderBook::linkUser(RestingOrder& node) {
+    RestingOrder*& head = user_heads_[node.order->getUserKey()];
+    node.user_prev = nullptr;
+    node.user_next = head;
+    if (head) {
+        head->user_prev = &node;
+    }
+    head = &node;
+}
+
+void OrderBook::unlinkUser(RestingOrder& node) {
+    if (node.user_next) {
+        node.user_next->user_prev = node.user_prev;
+    }
+    if (node.user_prev) {
+        node.user_prev->user_next = node.user_next;
+        return;
+    }
+
+    // Node was the head of its user's list
+    auto head = user_heads_.find(node.order->getUserKey());
+    if (node.user_next) {
+        head->second = node.user_next;
+    } else {
+        user_heads_.erase(head);
+    }
+}
+
+AmendStatus OrderBook::amendOrder(UserId user, std::string_view order_id, double new_quantity,
+                                  double new_price) {
+    auto it = index_.find(OrderKey{user, order_id});
+    if (it == index_.end()) {
+        return AmendStatus::NOT_FOUND;
+    }
+    if (new_quantity <= 0.0 || new_price <= 0.0) {
+        return AmendStatus::INVALID;
+    }
+
+    const auto& order = it->second.order;
+    if (new_price == order->getPrice() && new_quantity <= order->getQuantity()) {
+        order->setQuantity(new_quantity);
+        return AmendStatus::AMENDED_IN_PLACE;
+    }
+
+    unlinkOrder(*order);
+    order->setPrice(new_price);
+    order->setQuantity(new_quantity);
+    linkOrder(order);
+    return AmendStatus::REQUEUED;
+}
+
+void OrderBook::linkOrder(const std::shared_ptr<Order>& order) {
+    if (order->getSide() == OrderSide::BUY) {
+        buy_orders_[order->getPrice()].push_back(order);
+    } else {
+        sell_orders_[order->getPrice()].push_back(order);
+    }
+}
+
+namespace {
+template <typename SideMap>
+void unlinkFromSide(SideMap& side, const Order& order) {
+    auto level = side.find(order.getPrice());
+    if (level == side.end()) {
+        return;
+    }
+    auto& orders = level->second;
+    auto it = std::find_if(orders.begin(), orders.end(),
+                           [&](const auto& resting) { return resting.get() == &order; });
+    if (it != orders.end()) {
+        orders.erase(it);
+    }
+    if (orders.empty()) {
+        side.erase(level);
+    }
+}
+}  // namespace
+
+void OrderBook::unlinkOrder(const Order& order) {
+    if (order.getSide() == OrderSide::BUY) {
+        unlinkFromSide(buy_orders_, order);
+    } else {
+        unlinkFromSide(sell_orders_, order);
+    }
 }
 
 double OrderBook::getBestBid() const {
@@ -80,52 +215,75 @@ std::vector<std::shared_ptr<Order>> OrderBook::getSellOrders() const {
     return orders;
 }
 
-std::shared_ptr<Order> OrderBook::findOrder(const std::string& order_id) const {
-    (void)order_id;  // Suppress unused parameter warning
-    // TODO: Implement order lookup
-    return nullptr;
+std::shared_ptr<Order> OrderBook::findOrder(UserId user, std::string_view order_id) const {
+    auto it = index_.find(OrderKey{user, order_id});
+    return it != index_.end() ? it->second.order : nullptr;
 }
 
 const std::string& OrderBook::getSymbol() const {
     return symbol_;
 }
 
-std::string OrderBook::toJSON() const {
-    json orderbook_json;
-    orderbook_json["symbol"] = symbol_;
-
-    // Serialize bids (buy orders, highest price first)
-    json bids = json::array();
-    for (const auto& [price, orders] : buy_orders_) {
-        if (!orders.empty()) {
+std::vector<DepthLevel> OrderBook::getDepth(OrderSide side, size_t max_levels) const {
+    std::vector<DepthLevel> depth;
+    auto collect = [&](const auto& levels) {
+        for (const auto& [price, orders] : levels) {
+            if (depth.size() >= max_levels) {
+                break;
+            }
+            if (orders.empty()) {
+                continue;
+            }
             double total_quantity = 0.0;
             for (const auto& order : orders) {
                 total_quantity += order->getQuantity();
             }
-            bids.push_back({{"price", price}, {"quantity", total_quantity}});
+            depth.push_back({price, total_quantity});
         }
+    };
+    if (side == OrderSide::BUY) {
+        collect(buy_orders_);
+    } else {
+        collect(sell_orders_);
     }
-    orderbook_json["bids"] = bids;
+    return depth;
+}
+
+std::string OrderBook::toJSON() const {
+    return encode(utils::BodyFormat::JSON);
+}
 
-    // Serialize asks (sell orders, lowest price first)
-    json asks = json::array();
-    for (const auto& [price, orders] : sell_orders_) {
-        if (!orders.empty()) {
+std::string OrderBook::encode(utils::BodyFormat format) const {
+    // One {price, quantity} entry per non-empty level, in map order: bids highest first, asks
+    // lowest first
+    auto write_levels = [](utils::BodyWriter& writer, const auto& levels) {
+        writer.beginArray(static_cast<size_t>(
+            std::count_if(levels.begin(), levels.end(),
+                          [](const auto& level) { return !level.second.empty(); })));
+        for (const auto& [price, orders] : levels) {
+            if (orders.empty()) {
+                continue;
+            }
             double total_quantity = 0.0;
             for (const auto& order : orders) {
                 total_quantity += order->getQuantity();
             }
-            asks.push_back({{"price", price}, {"quantity", total_quantity}});
+            writer.beginMap(2).field("price", price).field("quantity", total_quantity).endMap();
         }
-    }
-    orderbook_json["asks"] = asks;
-
-    // Add market data
-    orderbook_json["best_bid"] = getBestBid();
-    orderbook_json["best_ask"] = getBestAsk();
-    orderbook_json["spread"] = getSpread();
+        writer.endArray();
+    };
 
-    return orderbook_json.dump();
+    utils::BodyWriter writer(format, 128 + 48 * (buy_orders_.size() + sell_orders_.size()));
+    writer.beginMap(6).field("symbol", symbol_);
+    writer.key("bids");
+    write_levels(writer, buy_orders_);
+    writer.key("asks");
+    write_levels(writer, sell_orders_);
+    writer.field("best_bid", getBestBid())
+        .field("best_ask", getBestAsk())
+        .field("spread", getSpread())
+        .endMap();
+    return writer.take();
 }
 
 std::map<double, std::vector<std::shared_ptr<Order>>, std::greater<double>>&
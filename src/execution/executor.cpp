@@ -1,60 +1,167 @@
 #include "trading/execution/executor.hpp"
+#include <algorithm>
 #include <chrono>
+#include "trading/execution/simulated_venue.hpp"
 
 namespace trading {
 namespace execution {
 
-Executor::Executor()
-    : total_executions_(0),
+namespace {
+constexpr std::chrono::milliseconds kTimerTick{1};
+
+ExecutionResult failedResult(std::string execution_id, std::string reason) {
+    ExecutionResult result;
+    result.status = ExecutionStatus::FAILED;
+    result.execution_id = std::move(execution_id);
+    result.executed_quantity = 0.0;
+    result.executed_price = 0.0;
+    result.error_message = std::move(reason);
+    return result;
+}
+}  // namespace
+
+Executor::Executor() : Executor(nullptr) {
+}
+
+Executor::Executor(std::shared_ptr<VenueAdapter> venue, size_t max_in_flight)
+    : venue_(venue ? std::move(venue) : std::make_shared<SimulatedVenue>()),
+      max_in_flight_(std::max<size_t>(max_in_flight, 1)),
+      total_executions_(0),
       total_executed_volume_(0.0),
       next_execution_id_(1),
       timeout_ms_(5000),
-      max_retries_(3) {
+      max_retries_(3),
+      timers_(kTimerTick, steadyNanos()),
+      next_request_id_(1),
+      running_(false),
+      stopping_(false),
+      stop_deadline_ns_(0),
+      delivering_(false) {
+    venue_->setReportHandler([this](const VenueReport& report) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            events_.push_back(Event{EventType::REPORT, report.request_id, report});
+        }
+        events_cv_.notify_one();
+    });
+}
+
+Executor::~Executor() {
+    stop();
+}
+
+bool Executor::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || completion_thread_.joinable()) {
+        return false;
+    }
+    venue_->start();  // A shared venue may already be running
+    running_ = true;
+    stopping_ = false;
+    completion_thread_ = std::thread([this] { completionLoop(); });
+    return true;
+}
+
+void Executor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        stopping_ = true;
+        stop_deadline_ns_ = steadyNanos() + static_cast<int64_t>(timeout_ms_) * 1'000'000;
+    }
+    events_cv_.notify_all();
+    window_cv_.notify_all();
+
+    if (completion_thread_.joinable()) {
+        completion_thread_.join();
+    }
+    venue_->stop();
+}
+
+bool Executor::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
 }
 
 ExecutionResult Executor::execute(const core::Trade& trade) {
-    (void)trade;  // Suppress unused parameter warning
-    // TODO: Implement trade execution
+    if (!validateExecution(trade)) {
+        return failedResult(generateExecutionId(), "Invalid trade");
+    }
+
+    Actions actions;
     ExecutionResult result;
-    result.status = ExecutionStatus::PENDING;
-    result.execution_id = generateExecutionId();
-    result.executed_quantity = 0.0;
-    result.executed_price = 0.0;
-    result.error_message = "";
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // Backpressure: wait for a slot in the in-flight window
+        window_cv_.wait(lock, [this] { return !running_ || in_flight_.size() < max_in_flight_; });
+        if (!running_) {
+            return failedResult(generateExecutionId(), "Executor not running");
+        }
+
+        InFlight entry{trade, generateExecutionId(), 0, utils::TimerWheel::kInvalidTimer};
+        result.status = ExecutionStatus::PENDING;
+        result.execution_id = entry.execution_id;
+        result.executed_quantity = 0.0;
+        result.executed_price = 0.0;
+        submitAttempt(std::move(entry), actions);
+    }
+    events_cv_.notify_one();  // Arms the completion thread's timeout handling
+
+    for (const auto& [request_id, request_trade] : actions.submissions) {
+        venue_->submit(request_id, request_trade);
+    }
     return result;
 }
 
 ExecutionResult Executor::executeTrade(const std::string& symbol, double quantity, double price) {
-    (void)symbol;    // Suppress unused parameter warning
-    (void)quantity;  // Suppress unused parameter warning
-    (void)price;     // Suppress unused parameter warning
-    // TODO: Implement direct trade execution
-    ExecutionResult result;
-    result.status = ExecutionStatus::PENDING;
-    result.execution_id = generateExecutionId();
-    result.executed_quantity = 0.0;
-    result.executed_price = 0.0;
-    result.error_message = "";
-    return result;
+    core::Trade trade{};
+    trade.symbol = core::internSymbol(symbol);
+    trade.quantity = quantity;
+    trade.price = price;
+    trade.timestamp_ns = utils::defaultClock()->nowNanos();
+    return execute(trade);
 }
 
 void Executor::setExecutionCallback(ExecutionCallback callback) {
     execution_callback_ = callback;
 }
 
+bool Executor::waitForIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return window_cv_.wait_for(lock, timeout, [this] {
+        return in_flight_.empty() && events_.empty() && !delivering_;
+    });
+}
+
 uint64_t Executor::getTotalExecutions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return total_executions_;
 }
 
 double Executor::getTotalExecutedVolume() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return total_executed_volume_;
 }
 
+size_t Executor::getInFlightCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_.size();
+}
+
+size_t Executor::getMaxInFlight() const {
+    return max_in_flight_;
+}
+
 void Executor::setTimeout(int milliseconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
     timeout_ms_ = milliseconds;
 }
 
 void Executor::setMaxRetries(int max_retries) {
+    std::lock_guard<std::mutex> lock(mutex_);
     max_retries_ = max_retries;
 }
 
@@ -63,20 +170,138 @@ std::string Executor::generateExecutionId() {
 }
 
 bool Executor::validateExecution(const core::Trade& trade) {
-    (void)trade;  // Suppress unused parameter warning
-    // TODO: Implement execution validation
-    return true;
+    return trade.quantity > 0.0 && trade.price > 0.0;
 }
 
-ExecutionResult Executor::performExecution(const core::Trade& trade) {
-    // TODO: Implement actual execution logic
-    ExecutionResult result;
-    result.status = ExecutionStatus::SUCCESS;
-    result.execution_id = generateExecutionId();
-    result.executed_quantity = trade.quantity;
-    result.executed_price = trade.price;
-    return result;
+void Executor::completionLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::vector<Event> events;
+
+    while (true) {
+        if (in_flight_.empty() && !stopping_) {
+            events_cv_.wait(lock, [this] {
+                return !events_.empty() || stopping_ || !in_flight_.empty();
+            });
+        } else {
+            // Something is outstanding: wake at least once per tick to run timeouts and retries
+            events_cv_.wait_for(lock, kTimerTick, [this] { return !events_.empty(); });
+        }
+
+        timers_.advance(steadyNanos());
+        events.swap(events_);
+        Actions actions;
+        for (const auto& event : events) {
+            handleEvent(event, actions);
+        }
+        events.clear();
+
+        const bool done =
+            stopping_ && (in_flight_.empty() || steadyNanos() >= stop_deadline_ns_);
+        if (done) {
+            while (!in_flight_.empty()) {
+                auto it = in_flight_.begin();
+                timers_.cancel(it->second.timer);
+                finish(it, failedResult(it->second.execution_id, "Executor stopped"), actions);
+            }
+        }
+
+        delivering_ = true;
+        lock.unlock();
+        for (const auto& [request_id, trade] : actions.submissions) {
+            venue_->submit(request_id, trade);
+        }
+        if (execution_callback_) {
+            for (const auto& result : actions.completions) {
+                execution_callback_(result);
+            }
+        }
+        lock.lock();
+        delivering_ = false;
+        window_cv_.notify_all();
+
+        if (done) {
+            break;
+        }
+    }
+}
+
+void Executor::handleEvent(const Event& event, Actions& actions) {
+    auto it = in_flight_.find(event.request_id);
+    if (it == in_flight_.end()) {
+        return;  // Late report for an attempt that already timed out
+    }
+
+    switch (event.type) {
+        case EventType::REPORT: {
+            timers_.cancel(it->second.timer);
+            const VenueReport& report = event.report;
+            if (!report.accepted) {
+                failAttempt(event.request_id, report.reason, actions);
+                return;
+            }
+
+            ExecutionResult result;
+            result.status = report.filled_quantity < it->second.trade.quantity
+                                ? ExecutionStatus::PARTIAL
+                                : ExecutionStatus::SUCCESS;
+            result.execution_id = it->second.execution_id;
+            result.executed_quantity = report.filled_quantity;
+            result.executed_price = report.fill_price;
+            ++total_executions_;
+            total_executed_volume_ += report.filled_quantity;
+            finish(it, std::move(result), actions);
+            break;
+        }
+        case EventType::TIMEOUT:
+            failAttempt(event.request_id, "Venue timed out", actions);
+            break;
+        case EventType::RETRY: {
+            InFlight entry = std::move(it->second);
+            in_flight_.erase(it);
+            submitAttempt(std::move(entry), actions);
+            break;
+        }
+    }
+}
+
+void Executor::failAttempt(uint64_t request_id, const std::string& reason, Actions& actions) {
+    auto it = in_flight_.find(request_id);
+    InFlight& entry = it->second;
+    if (++entry.attempts > max_retries_ || stopping_) {
+        finish(it, failedResult(entry.execution_id, reason), actions);
+        return;
+    }
+
+    // Exponential backoff before the next attempt; the execution keeps its window slot
+    const int shift = std::min(entry.attempts - 1, 16);
+    const int64_t delay_ns = static_cast<int64_t>(kBaseRetryDelayMs) * 1'000'000 << shift;
+    entry.timer = timers_.scheduleAt(steadyNanos() + delay_ns, [this, request_id] {
+        events_.push_back(Event{EventType::RETRY, request_id, {}});
+    });
+}
+
+void Executor::finish(std::unordered_map<uint64_t, InFlight>::iterator it,
+                      ExecutionResult result, Actions& actions) {
+    actions.completions.push_back(std::move(result));
+    in_flight_.erase(it);
+}
+
+uint64_t Executor::submitAttempt(InFlight entry, Actions& actions) {
+    const uint64_t request_id = next_request_id_++;
+    entry.timer = timers_.scheduleAt(
+        steadyNanos() + static_cast<int64_t>(timeout_ms_) * 1'000'000, [this, request_id] {
+            events_.push_back(Event{EventType::TIMEOUT, request_id, {}});
+        });
+    actions.submissions.emplace_back(request_id, entry.trade);
+    in_flight_.emplace(request_id, std::move(entry));
+    return request_id;
+}
+
+int64_t Executor::steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
 }
 
 }  // namespace execution
-}  // namespace trading
\ No newline at end of file
+}  // namespace trading
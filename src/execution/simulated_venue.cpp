@@ -0,0 +1,129 @@
+#include "trading/execution/simulated_venue.hpp"
+
+namespace trading {
+namespace execution {
+
+namespace {
+int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
+SimulatedVenue::SimulatedVenue() : SimulatedVenue(Config()) {
+}
+
+SimulatedVenue::SimulatedVenue(const Config& config) : config_(config), rng_(config.seed) {
+}
+
+SimulatedVenue::~SimulatedVenue() {
+    stop();
+}
+
+void SimulatedVenue::setReportHandler(ReportHandler handler) {
+    report_handler_ = std::move(handler);
+}
+
+bool SimulatedVenue::start() {
+    if (running_.exchange(true)) {
+        return false;
+    }
+    venue_thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void SimulatedVenue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+    }
+    cv_.notify_all();
+    if (venue_thread_.joinable()) {
+        venue_thread_.join();
+    }
+}
+
+void SimulatedVenue::submit(uint64_t request_id, const core::Trade& trade) {
+    ++submitted_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int64_t delay_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(config_.latency).count();
+        if (config_.jitter.count() > 0) {
+            std::uniform_int_distribution<int64_t> jitter(
+                0, std::chrono::duration_cast<std::chrono::nanoseconds>(config_.jitter).count());
+            delay_ns += jitter(rng_);
+        }
+        pending_.push(Pending{steadyNanos() + delay_ns, request_id, trade});
+    }
+    cv_.notify_one();
+}
+
+void SimulatedVenue::setRejectProbability(double probability) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_.reject_probability = probability;
+}
+
+void SimulatedVenue::setDropProbability(double probability) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_.drop_probability = probability;
+}
+
+uint64_t SimulatedVenue::getSubmittedCount() const {
+    return submitted_.load();
+}
+
+size_t SimulatedVenue::getOutstandingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+void SimulatedVenue::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::vector<VenueReport> due;
+
+    while (running_) {
+        if (pending_.empty()) {
+            cv_.wait(lock, [this] { return !running_ || !pending_.empty(); });
+            continue;
+        }
+
+        const int64_t now = steadyNanos();
+        if (pending_.top().due_ns > now) {
+            cv_.wait_for(lock, std::chrono::nanoseconds(pending_.top().due_ns - now));
+            continue;
+        }
+
+        // Answer everything that has come due in one batch, outside the lock
+        while (!pending_.empty() && pending_.top().due_ns <= now) {
+            const Pending request = pending_.top();
+            pending_.pop();
+            if (chance(rng_) < config_.drop_probability) {
+                continue;
+            }
+            if (chance(rng_) < config_.reject_probability) {
+                due.push_back(
+                    VenueReport{request.request_id, false, 0.0, 0.0, "Rejected by venue"});
+            } else {
+                due.push_back(VenueReport{request.request_id, true, request.trade.quantity,
+                                          request.trade.price, ""});
+            }
+        }
+
+        lock.unlock();
+        for (const auto& report : due) {
+            if (report_handler_) {
+                report_handler_(report);
+            }
+        }
+        due.clear();
+        lock.lock();
+    }
+}
+
+}  // namespace execution
+}  // namespace trading
@@ -1,6 +1,6 @@
 #include "trading/logging/app_logger.hpp"
 #include "trading/logging/log_level.hpp"
-#include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -11,11 +11,12 @@ namespace logging {
 AppLogger::AppLogger(const std::string& log_file_path)
     : AsyncLogger(log_file_path),
       current_log_level_(LogLevel::INFO),
-      console_output_enabled_(true) {
+      console_output_enabled_(true),
+      clock_(utils::defaultClock()) {
 }
 
 void AppLogger::log(LogLevel level, const std::string& message) {
-    if (level < current_log_level_) {
+    if (level < current_log_level_.load(std::memory_order_relaxed)) {
         return;
     }
 
@@ -36,7 +37,7 @@ void AppLogger::log(LogLevel level, const std::string& message) {
 }
 
 void AppLogger::setLogLevel(LogLevel level) {
-    current_log_level_ = level;
+    current_log_level_.store(level, std::memory_order_relaxed);
 }
 
 void AppLogger::enableConsoleOutput(bool enable) {
@@ -66,14 +67,21 @@ std::string AppLogger::formatLogEntry(LogLevel level, const std::string& message
     return oss.str();
 }
 
+void AppLogger::setClock(std::shared_ptr<utils::Clock> clock) {
+    clock_ = clock ? std::move(clock) : utils::defaultClock();
+}
+
 std::string AppLogger::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+    const int64_t now_ns = clock_->nowNanos();
+    const std::time_t time_t = static_cast<std::time_t>(now_ns / 1'000'000'000);
+    const int64_t ms = (now_ns / 1'000'000) % 1000;
+
+    std::tm local_tm{};
+    localtime_r(&time_t, &local_tm);
 
     std::ostringstream oss;
-    oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
+    oss << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S");
+    oss << '.' << std::setfill('0') << std::setw(3) << ms;
     return oss.str();
 }
 
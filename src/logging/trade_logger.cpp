@@ -1,6 +1,6 @@
 #include "trading/logging/trade_logger.hpp"
 #include "trading/logging/log_level.hpp"
-#include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -13,14 +13,16 @@ TradeLogger::TradeLogger(const std::string& log_file_path)
       current_log_level_(LogLevel::INFO),
       max_file_size_(100 * 1024 * 1024),
       console_output_enabled_(true),
+      clock_(utils::defaultClock()),
       next_confirmation_id_(1) {
 }
 
 void TradeLogger::logTrade(const core::Trade& trade) {
     std::ostringstream oss;
-    oss << "TRADE: " << trade.trade_id << " Symbol: " << trade.symbol
+    oss << "TRADE: " << trade.trade_id << " Symbol: " << core::symbolName(trade.symbol)
         << " Quantity: " << trade.quantity << " Price: " << trade.price
-        << " Buy Order: " << trade.buy_order_id << " Sell Order: " << trade.sell_order_id;
+        << " Buy Order: " << core::clientOrderId(trade.buy_order)
+        << " Sell Order: " << core::clientOrderId(trade.sell_order);
 
     std::string formatted_message = formatLogEntry(LogLevel::INFO, oss.str());
 
@@ -53,7 +55,7 @@ void TradeLogger::logExecution(const execution::ExecutionResult& result) {
 }
 
 void TradeLogger::logMessage(LogLevel level, const std::string& message) {
-    if (level < current_log_level_) {
+    if (level < current_log_level_.load(std::memory_order_relaxed)) {
         return;
     }
 
@@ -71,11 +73,11 @@ void TradeLogger::logMessage(LogLevel level, const std::string& message) {
 TradeConfirmation TradeLogger::createConfirmation(const core::Trade& trade) {
     TradeConfirmation confirmation;
     confirmation.confirmation_id = generateConfirmationId();
-    confirmation.trade_id = trade.trade_id;
-    confirmation.symbol = trade.symbol;
+    confirmation.trade_id = core::tradeIdString(trade);
+    confirmation.symbol = core::symbolName(trade.symbol);
     confirmation.quantity = trade.quantity;
     confirmation.price = trade.price;
-    confirmation.timestamp = trade.timestamp;
+    confirmation.timestamp = static_cast<uint64_t>(trade.timestamp_ns / 1'000'000);  // ms
     confirmation.status = "CONFIRMED";
     return confirmation;
 }
@@ -100,7 +102,7 @@ bool TradeLogger::sendConfirmation(const TradeConfirmation& confirmation) {
 }
 
 void TradeLogger::setLogLevel(LogLevel level) {
-    current_log_level_ = level;
+    current_log_level_.store(level, std::memory_order_relaxed);
 }
 
 void TradeLogger::setRotateSize(size_t max_size_bytes) {
@@ -134,14 +136,21 @@ std::string TradeLogger::formatLogEntry(LogLevel level, const std::string& messa
     return oss.str();
 }
 
+void TradeLogger::setClock(std::shared_ptr<utils::Clock> clock) {
+    clock_ = clock ? std::move(clock) : utils::defaultClock();
+}
+
 std::string TradeLogger::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+    const int64_t now_ns = clock_->nowNanos();
+    const std::time_t time_t = static_cast<std::time_t>(now_ns / 1'000'000'000);
+    const int64_t ms = (now_ns / 1'000'000) % 1000;
+
+    std::tm local_tm{};
+    localtime_r(&time_t, &local_tm);
 
     std::ostringstream oss;
-    oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
+    oss << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S");
+    oss << '.' << std::setfill('0') << std::setw(3) << ms;
     return oss.str();
 }
 
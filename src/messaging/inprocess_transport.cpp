@@ -0,0 +1,125 @@
+#include "trading/messaging/inprocess_transport.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <thread>
+
+#include "trading/utils/concurrent_queue.hpp"
+
+namespace trading {
+namespace messaging {
+
+struct InProcessTransport::Inbox {
+    explicit Inbox(size_t capacity) : queue(capacity) {
+    }
+
+    utils::ConcurrentQueue<Message> queue;
+    std::set<std::string> topics;  // Guarded by the bus mutex
+};
+
+struct InProcessTransport::Bus {
+    std::shared_mutex mutex;
+    std::vector<std::shared_ptr<Inbox>> inboxes;
+};
+
+InProcessTransport::InProcessTransport(const std::string& channel, size_t capacity)
+    : channel_(channel), capacity_(capacity) {
+}
+
+InProcessTransport::~InProcessTransport() {
+    disconnect();
+}
+
+std::shared_ptr<InProcessTransport::Bus> InProcessTransport::attach(const std::string& channel) {
+    // A bus lives as long as some transport is connected to it
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Bus>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& entry = registry[channel];
+    auto bus = entry.lock();
+    if (!bus) {
+        bus = std::make_shared<Bus>();
+        entry = bus;
+    }
+    return bus;
+}
+
+bool InProcessTransport::connect() {
+    if (bus_) {
+        return true;
+    }
+    bus_ = attach(channel_);
+
+    // The inbox exists for the whole connection so poll() never races with subscribe()
+    inbox_ = std::make_shared<Inbox>(capacity_);
+    std::unique_lock<std::shared_mutex> lock(bus_->mutex);
+    bus_->inboxes.push_back(inbox_);
+    return true;
+}
+
+void InProcessTransport::disconnect() {
+    if (!bus_) {
+        return;
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(bus_->mutex);
+        std::erase(bus_->inboxes, inbox_);
+    }
+    inbox_.reset();
+    bus_.reset();
+}
+
+bool InProcessTransport::publish(const Message& message) {
+    if (!bus_) {
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(bus_->mutex);
+    bool delivered = true;
+    for (const auto& inbox : bus_->inboxes) {
+        if (inbox->topics.count(message.topic) != 0) {
+            Message copy = message;
+            delivered = inbox->queue.try_enqueue(std::move(copy)) && delivered;
+        }
+    }
+    return delivered;
+}
+
+bool InProcessTransport::subscribe(const std::vector<std::string>& topics) {
+    if (!bus_) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(bus_->mutex);
+    inbox_->topics = std::set<std::string>(topics.begin(), topics.end());
+    return true;
+}
+
+bool InProcessTransport::poll(Message& message, std::chrono::milliseconds timeout) {
+    if (!inbox_) {
+        return false;
+    }
+
+    // Spin briefly for low latency, then back off to short sleeps until the timeout
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (int spins = 0;; ++spins) {
+        if (inbox_->queue.try_dequeue(message)) {
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        if (spins < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+}  // namespace messaging
+}  // namespace trading
@@ -0,0 +1,289 @@
+#include "trading/messaging/shm_transport.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+namespace trading {
+namespace messaging {
+
+namespace {
+// Segment layout: a RingHeader padded to kHeaderBytes, then `slots` slots of `slot_size` bytes.
+// Shared fields are plain integers accessed through std::atomic_ref so the layout does not
+// depend on std::atomic's object representation.
+struct RingHeader {
+    uint64_t magic;
+    uint64_t slots;
+    uint64_t slot_size;
+    alignas(64) uint64_t write_pos;
+    alignas(64) uint64_t read_pos;
+};
+
+struct SlotHeader {
+    uint64_t sequence;  // == position when free, position + 1 once written
+    uint64_t timestamp;
+    uint32_t topic_size;
+    uint32_t key_size;
+    uint32_t value_size;
+    uint32_t reserved;
+    // Followed by topic, key and value bytes
+};
+
+constexpr uint64_t kMagic = 0x31474e4944415254;  // "TRADING1"
+constexpr size_t kCacheLine = 64;
+constexpr size_t kMinSlotSize = 256;
+constexpr std::chrono::seconds kAttachTimeout{1};
+constexpr size_t kHeaderBytes = (sizeof(RingHeader) + kCacheLine - 1) / kCacheLine * kCacheLine;
+
+static_assert(std::atomic_ref<uint64_t>::is_always_lock_free,
+              "Shared-memory ring needs lock-free 64-bit atomics");
+
+template <typename T>
+constexpr T roundUp(T value, T multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+std::atomic_ref<uint64_t> shared(uint64_t& field) {
+    return std::atomic_ref<uint64_t>(field);
+}
+}  // namespace
+
+struct SharedMemoryTransport::Header : RingHeader {};
+struct SharedMemoryTransport::Slot : SlotHeader {};
+
+SharedMemoryTransport::SharedMemoryTransport(const std::string& name, size_t slots,
+                                             size_t slot_size)
+    : name_(!name.empty() && name.front() == '/' ? name : "/" + name),
+      requested_slots_(slots),
+      requested_slot_size_(slot_size) {
+}
+
+SharedMemoryTransport::~SharedMemoryTransport() {
+    disconnect();
+}
+
+bool SharedMemoryTransport::connect() {
+    if (header_) {
+        return true;
+    }
+
+    fd_ = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    const bool ok = fd_ >= 0 ? createSegment() : errno == EEXIST && attachSegment();
+    if (!ok) {
+        disconnect();
+    }
+    return ok;
+}
+
+bool SharedMemoryTransport::createSegment() {
+    const uint64_t slots = roundUpToPowerOfTwo(std::max<size_t>(requested_slots_, 2));
+    const uint64_t slot_size =
+        roundUp(std::max(requested_slot_size_, kMinSlotSize), kCacheLine);
+    const size_t size = kHeaderBytes + slots * slot_size;
+
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0 || !mapSegment(size)) {
+        ::shm_unlink(name_.c_str());
+        return false;
+    }
+
+    // The segment starts zeroed; seed each slot's sequence with its position
+    header_->slots = slots;
+    header_->slot_size = slot_size;
+    for (uint64_t i = 0; i < slots; ++i) {
+        slotAt(i)->sequence = i;
+    }
+    shared(header_->magic).store(kMagic, std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryTransport::attachSegment() {
+    fd_ = ::shm_open(name_.c_str(), O_RDWR, 0600);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    // The creator may still be sizing and initializing the segment
+    const auto deadline = std::chrono::steady_clock::now() + kAttachTimeout;
+    while (true) {
+        struct stat st {};
+        if (::fstat(fd_, &st) == 0 && static_cast<size_t>(st.st_size) > kHeaderBytes) {
+            if (!header_ && !mapSegment(static_cast<size_t>(st.st_size))) {
+                return false;
+            }
+            if (shared(header_->magic).load(std::memory_order_acquire) == kMagic) {
+                return true;
+            }
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+bool SharedMemoryTransport::mapSegment(size_t size) {
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = mapping;
+    mapping_size_ = size;
+    header_ = static_cast<Header*>(mapping);
+    return true;
+}
+
+void SharedMemoryTransport::disconnect() {
+    if (mapping_) {
+        ::munmap(mapping_, mapping_size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    header_ = nullptr;
+    fd_ = -1;
+}
+
+bool SharedMemoryTransport::removeSegment(const std::string& name) {
+    const std::string path = !name.empty() && name.front() == '/' ? name : "/" + name;
+    return ::shm_unlink(path.c_str()) == 0;
+}
+
+SharedMemoryTransport::Slot* SharedMemoryTransport::slotAt(uint64_t position) const {
+    auto* base = static_cast<std::byte*>(mapping_) + kHeaderBytes;
+    const uint64_t index = position & (header_->slots - 1);
+    return reinterpret_cast<Slot*>(base + index * header_->slot_size);
+}
+
+bool SharedMemoryTransport::publish(const Message& message) {
+    if (!header_) {
+        return false;
+    }
+    const size_t payload = message.topic.size() + message.key.size() + message.value.size();
+    if (payload > header_->slot_size - sizeof(Slot)) {
+        return false;
+    }
+
+    // Claim a slot: free slots carry sequence == position for the current lap
+    uint64_t pos = shared(header_->write_pos).load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = slotAt(pos);
+        const uint64_t seq = shared(slot->sequence).load(std::memory_order_acquire);
+        const auto diff = static_cast<int64_t>(seq - pos);
+        if (diff == 0) {
+            if (shared(header_->write_pos)
+                    .compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Ring is full
+        } else {
+            pos = shared(header_->write_pos).load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->timestamp = message.timestamp;
+    slot->topic_size = static_cast<uint32_t>(message.topic.size());
+    slot->key_size = static_cast<uint32_t>(message.key.size());
+    slot->value_size = static_cast<uint32_t>(message.value.size());
+    char* data = reinterpret_cast<char*>(slot + 1);
+    std::memcpy(data, message.topic.data(), message.topic.size());
+    data += message.topic.size();
+    std::memcpy(data, message.key.data(), message.key.size());
+    data += message.key.size();
+    std::memcpy(data, message.value.data(), message.value.size());
+
+    shared(slot->sequence).store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryTransport::subscribe(const std::vector<std::string>& topics) {
+    if (!header_) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    topics_ = std::set<std::string>(topics.begin(), topics.end());
+    return true;
+}
+
+bool SharedMemoryTransport::tryConsume(Message& message) {
+    const uint64_t pos = shared(header_->read_pos).load(std::memory_order_relaxed);
+    Slot* slot = slotAt(pos);
+    if (shared(slot->sequence).load(std::memory_order_acquire) != pos + 1) {
+        return false;
+    }
+
+    const char* data = reinterpret_cast<const char*>(slot + 1);
+    message.topic.assign(data, slot->topic_size);
+    data += slot->topic_size;
+    message.key.assign(data, slot->key_size);
+    data += slot->key_size;
+    message.value.assign(data, slot->value_size);
+    message.timestamp = slot->timestamp;
+    message.headers.clear();
+
+    // Hand the slot back to producers for the next lap
+    shared(slot->sequence).store(pos + header_->slots, std::memory_order_release);
+    shared(header_->read_pos).store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+bool SharedMemoryTransport::isSubscribed(const std::string& topic) {
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    return topics_.count(topic) != 0;
+}
+
+bool SharedMemoryTransport::poll(Message& message, std::chrono::milliseconds timeout) {
+    if (!header_) {
+        return false;
+    }
+
+    // Publish-only processes never consume, so they cannot steal the consumer's messages
+    bool consuming;
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        consuming = !topics_.empty();
+    }
+    if (!consuming) {
+        std::this_thread::sleep_for(timeout);
+        return false;
+    }
+
+    // Spin briefly for low latency, then back off to short sleeps until the timeout
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (int spins = 0;; ++spins) {
+        while (tryConsume(message)) {
+            if (isSubscribed(message.topic)) {
+                return true;
+            }
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        if (spins < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+}  // namespace messaging
+}  // namespace trading
@@ -0,0 +1,127 @@
+#include "trading/network/admission_controller.hpp"
+
+#include <algorithm>
+
+namespace trading {
+namespace network {
+
+namespace {
+constexpr int kEwmaShift = 3;  // Smoothing factor 1/8
+
+int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
+AdmissionController::AdmissionController() : AdmissionController(Config{}) {
+}
+
+AdmissionController::AdmissionController(const Config& config) : config_(config) {
+    classes_[0].budget = config_.orders;
+    classes_[1].budget = config_.reads;
+    for (auto& state : classes_) {
+        state.budget.max_in_flight = std::max<size_t>(state.budget.max_in_flight, 1);
+        state.budget.min_in_flight =
+            std::clamp<size_t>(state.budget.min_in_flight, 1, state.budget.max_in_flight);
+        state.limit.store(state.budget.max_in_flight);
+    }
+}
+
+void AdmissionController::setBacklogProbe(BacklogProbe probe) {
+    backlog_probe_ = std::move(probe);
+}
+
+AdmissionController::Decision AdmissionController::admit(RequestClass request_class,
+                                                         size_t queued_connections) {
+    if (request_class == RequestClass::EXEMPT) {
+        return {true, 200, ""};
+    }
+    ClassState& state = stateFor(request_class);
+
+    if (queued_connections >= state.budget.max_queued) {
+        state.rejected_overloaded.fetch_add(1, std::memory_order_relaxed);
+        return {false, 503, "Server overloaded"};
+    }
+    if (request_class == RequestClass::ORDER && config_.max_order_backlog > 0 && backlog_probe_ &&
+        backlog_probe_() >= config_.max_order_backlog) {
+        state.rejected_overloaded.fetch_add(1, std::memory_order_relaxed);
+        return {false, 503, "Order pipeline backlogged"};
+    }
+
+    size_t in_flight = state.in_flight.load(std::memory_order_relaxed);
+    do {
+        if (in_flight >= state.limit.load(std::memory_order_relaxed)) {
+            state.rejected_busy.fetch_add(1, std::memory_order_relaxed);
+            return {false, 429, "Too many concurrent requests"};
+        }
+    } while (!state.in_flight.compare_exchange_weak(in_flight, in_flight + 1,
+                                                    std::memory_order_acq_rel));
+    state.admitted.fetch_add(1, std::memory_order_relaxed);
+    return {true, 200, ""};
+}
+
+void AdmissionController::release(RequestClass request_class, std::chrono::nanoseconds latency) {
+    if (request_class == RequestClass::EXEMPT) {
+        return;
+    }
+    ClassState& state = stateFor(request_class);
+    state.in_flight.fetch_sub(1, std::memory_order_acq_rel);
+
+    const int64_t target_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(state.budget.target_latency).count();
+    if (target_ns <= 0) {
+        return;
+    }
+
+    // Racing updates may lose a sample; the average only needs to be approximately right
+    const int64_t previous = state.latency_ewma_ns.load(std::memory_order_relaxed);
+    const int64_t ewma = previous + ((latency.count() - previous) >> kEwmaShift);
+    state.latency_ewma_ns.store(ewma, std::memory_order_relaxed);
+
+    size_t limit = state.limit.load(std::memory_order_relaxed);
+    if (ewma > target_ns) {
+        // Multiplicative decrease, at most once per target interval so one slow burst does not
+        // collapse the limit before the smaller limit has had an effect
+        const int64_t now = steadyNanos();
+        int64_t last = state.last_decrease_ns.load(std::memory_order_relaxed);
+        if (now - last >= target_ns &&
+            state.last_decrease_ns.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            const size_t reduced = limit - std::max<size_t>(1, limit / 10);
+            state.limit.store(std::max(reduced, state.budget.min_in_flight),
+                              std::memory_order_relaxed);
+        }
+    } else if (latency.count() <= target_ns && limit < state.budget.max_in_flight) {
+        state.limit.compare_exchange_strong(limit, limit + 1, std::memory_order_relaxed);
+    }
+}
+
+bool AdmissionController::shedConnection(size_t queued_connections) {
+    const size_t max_queued =
+        std::max(classes_[0].budget.max_queued, classes_[1].budget.max_queued);
+    if (queued_connections < max_queued) {
+        return false;
+    }
+    rejected_connections_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+AdmissionController::ClassMetrics AdmissionController::metricsFor(const ClassState& state) {
+    ClassMetrics metrics;
+    metrics.admitted = state.admitted.load(std::memory_order_relaxed);
+    metrics.rejected_busy = state.rejected_busy.load(std::memory_order_relaxed);
+    metrics.rejected_overloaded = state.rejected_overloaded.load(std::memory_order_relaxed);
+    metrics.in_flight = state.in_flight.load(std::memory_order_relaxed);
+    metrics.limit = state.limit.load(std::memory_order_relaxed);
+    metrics.latency_ewma_us = state.latency_ewma_ns.load(std::memory_order_relaxed) / 1000;
+    return metrics;
+}
+
+AdmissionController::Metrics AdmissionController::getMetrics() const {
+    return Metrics{metricsFor(classes_[0]), metricsFor(classes_[1]),
+                   rejected_connections_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace network
+}  // namespace trading
@@ -0,0 +1,94 @@
+#include "trading/network/body_writer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+namespace trading {
+namespace network {
+
+namespace {
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) ==
+                      std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+// Formats we serve, by media type; wildcards select JSON
+bool formatForMediaType(std::string_view type, BodyFormat& format) {
+    if (equalsIgnoreCase(type, "application/json") || type == "*/*" ||
+        equalsIgnoreCase(type, "application/*")) {
+        format = BodyFormat::JSON;
+    } else if (equalsIgnoreCase(type, "application/cbor")) {
+        format = BodyFormat::CBOR;
+    } else if (equalsIgnoreCase(type, "application/msgpack") ||
+               equalsIgnoreCase(type, "application/x-msgpack") ||
+               equalsIgnoreCase(type, "application/vnd.msgpack")) {
+        format = BodyFormat::MSGPACK;
+    } else {
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+BodyFormat negotiateBodyFormat(std::string_view accept) {
+    BodyFormat best = BodyFormat::JSON;
+    double best_q = 0.0;
+    while (!accept.empty()) {
+        const size_t comma = accept.find(',');
+        std::string_view range = accept.substr(0, comma);
+        accept = comma == std::string_view::npos ? std::string_view() : accept.substr(comma + 1);
+
+        // media-type *( ";" parameter ), of which only q matters here
+        const size_t semicolon = range.find(';');
+        BodyFormat format;
+        if (!formatForMediaType(trim(range.substr(0, semicolon)), format)) {
+            continue;
+        }
+        double q = 1.0;
+        for (std::string_view params = semicolon == std::string_view::npos
+                                           ? std::string_view()
+                                           : range.substr(semicolon + 1);
+             !params.empty();) {
+            const size_t next = params.find(';');
+            const std::string_view param = trim(params.substr(0, next));
+            if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+                q = std::strtod(std::string(param.substr(2)).c_str(), nullptr);
+            }
+            params = next == std::string_view::npos ? std::string_view() : params.substr(next + 1);
+        }
+        if (q > best_q) {
+            best = format;
+            best_q = q;
+        }
+    }
+    return best;
+}
+
+const char* contentTypeFor(BodyFormat format) {
+    switch (format) {
+        case BodyFormat::CBOR:
+            return "application/cbor";
+        case BodyFormat::MSGPACK:
+            return "application/msgpack";
+        case BodyFormat::JSON:
+        default:
+            return "application/json";
+    }
+}
+
+}  // namespace network
+}  // namespace trading
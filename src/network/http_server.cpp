@@ -4,13 +4,25 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <netdb.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cstring>
+#include <limits>
 #include <regex>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
+
+#include "trading/network/body_writer.hpp"
+#include "trading/network/websocket.hpp"
+#include "../../apps/json.hpp"
 
 namespace trading {
 namespace network {
@@ -24,17 +36,33 @@ std::string reasonPhrase(int status) {
             return "Created";
         case 202:
             return "Accepted";
+        case 304:
+            return "Not Modified";
+        case 426:
+            return "Upgrade Required";
         case 400:
             return "Bad Request";
         case 404:
             return "Not Found";
+        case 429:
+            return "Too Many Requests";
         case 500:
             return "Internal Server Error";
+        case 503:
+            return "Service Unavailable";
         default:
             return "OK";
     }
 }
 
+constexpr std::chrono::milliseconds kReapInterval{10};
+
+int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 static void setSocketTimeout(int fd, int seconds) {
     timeval tv{};
     tv.tv_sec = seconds;
@@ -43,6 +71,66 @@ static void setSocketTimeout(int fd, int seconds) {
     setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
 }
 
+// Parses a Content-Length value; false unless it is a plain decimal number
+bool parseContentLength(std::string_view value, size_t& length) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() &&
+           (value.back() == ' ' || value.back() == '\t' || value.back() == '\r')) {
+        value.remove_suffix(1);
+    }
+    const char* end = value.data() + value.size();
+    const auto [parsed_to, error] = std::from_chars(value.data(), end, length);
+    return error == std::errc() && parsed_to == end;
+}
+
+// Appends whatever a non-blocking socket has buffered; false once the peer has closed or the
+// socket failed
+bool readAvailable(int fd, std::string& out) {
+    char buf[4096];
+    for (;;) {
+        const ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            out.append(buf, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+}
+
+// Header names keep the client's casing; HTTP compares them case-insensitively
+const std::string* findHeader(const HttpRequest& request, std::string_view name) {
+    for (const auto& [key, value] : request.headers) {
+        if (key.size() == name.size() && strncasecmp(key.c_str(), name.data(), name.size()) == 0) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+bool headerContainsToken(const HttpRequest& request, std::string_view name,
+                         std::string_view token) {
+    const std::string* value = findHeader(request, name);
+    if (!value) {
+        return false;
+    }
+    std::istringstream tokens(*value);
+    std::string item;
+    while (std::getline(tokens, item, ',')) {
+        const size_t begin = item.find_first_not_of(' ');
+        const size_t end = item.find_last_not_of(' ');
+        if (begin != std::string::npos && end - begin + 1 == token.size() &&
+            strncasecmp(item.c_str() + begin, token.data(), token.size()) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Helper function to URL decode a string
 std::string urlDecode(const std::string& str) {
     std::string result;
@@ -91,7 +179,15 @@ std::map<std::string, std::string> parseQueryParameters(const std::string& query
 }  // namespace
 
 HttpServer::HttpServer(const std::string& host, int port, int threads)
-    : host_(host), port_(port), running_(false), timeout_seconds_(30), max_connections_(100) {
+    : host_(host),
+      port_(port),
+      running_(false),
+      timeout_seconds_(30),
+      max_connections_(100),
+      num_acceptors_(1),
+      backend_(Backend::BLOCKING),
+      reaper_wheel_(kReapInterval, steadyNanos()),
+      async_wheel_(std::make_unique<utils::TimerWheel>(kReapInterval, steadyNanos())) {
     // Initialize thread pool with configurable number of threads
     thread_pool_ = std::make_unique<utils::ThreadPool>(threads);
 }
@@ -102,10 +198,7 @@ HttpServer::~HttpServer() {
     }
 }
 
-bool HttpServer::start() {
-    if (running_)
-        return true;
-
+int HttpServer::openListener(bool reuse_port) {
     // Resolve host and bind
     struct addrinfo hints {};
     struct addrinfo* res = nullptr;
@@ -118,33 +211,106 @@ bool HttpServer::start() {
     int rc =
         getaddrinfo(host_ == "0.0.0.0" ? nullptr : host_.c_str(), port_str.c_str(), &hints, &res);
     if (rc != 0 || !res) {
-        return false;
+        return -1;
     }
 
-    server_fd_ = ::socket(res->ai_family, res->ai_socktype, res->ai_protocol);
-    if (server_fd_ < 0) {
+    int fd = ::socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd < 0) {
         freeaddrinfo(res);
-        return false;
+        return -1;
     }
 
     int yes = 1;
-    setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    if (reuse_port && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes)) < 0) {
+        ::close(fd);
+        freeaddrinfo(res);
+        return -1;
+    }
 
-    if (::bind(server_fd_, res->ai_addr, res->ai_addrlen) < 0) {
-        ::close(server_fd_);
-        server_fd_ = -1;
+    if (::bind(fd, res->ai_addr, res->ai_addrlen) < 0) {
+        ::close(fd);
         freeaddrinfo(res);
-        return false;
+        return -1;
     }
     freeaddrinfo(res);
 
-    if (::listen(server_fd_, max_connections_ > 0 ? max_connections_ : 100) < 0) {
-        ::close(server_fd_);
-        server_fd_ = -1;
-        return false;
+    if (::listen(fd, max_connections_ > 0 ? max_connections_ : 100) < 0) {
+        ::close(fd);
+        return -1;
     }
+    return fd;
+}
+
+utils::TimerWheel::TimerId HttpServer::scheduleIdleTimeout(int client_fd) {
+    // The idle deadline also covers time spent waiting for a worker
+    std::lock_guard<std::mutex> lock(reaper_mutex_);
+    return reaper_wheel_.scheduleAt(
+        steadyNanos() + static_cast<int64_t>(timeout_seconds_) * 1'000'000'000,
+        [client_fd]() { ::shutdown(client_fd, SHUT_RDWR); });
+}
+
+bool HttpServer::start() {
+    if (running_)
+        return true;
 
     stop_flag_ = false;
+
+    if (backend_ == Backend::IO_URING) {
+        if (!startIoUring()) {
+            return false;
+        }
+        running_ = true;
+        reaper_thread_ = std::thread([this]() { reapIdleConnections(); });
+        return true;
+    }
+
+    if (num_acceptors_ > 1) {
+        wake_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (wake_fd_ < 0) {
+            return false;
+        }
+        acceptors_.resize(num_acceptors_);
+        for (auto& acceptor : acceptors_) {
+            acceptor.listen_fd = openListener(true);
+            acceptor.epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+            bool ok = acceptor.listen_fd >= 0 && acceptor.epoll_fd >= 0 &&
+                      ::fcntl(acceptor.listen_fd, F_SETFL, O_NONBLOCK) == 0;
+            for (int fd : {acceptor.listen_fd, wake_fd_}) {
+                epoll_event event{};
+                event.events = EPOLLIN;
+                event.data.fd = fd;
+                ok = ok && ::epoll_ctl(acceptor.epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+            }
+            if (!ok) {
+                for (auto& opened : acceptors_) {
+                    if (opened.listen_fd >= 0)
+                        ::close(opened.listen_fd);
+                    if (opened.epoll_fd >= 0)
+                        ::close(opened.epoll_fd);
+                }
+                acceptors_.clear();
+                ::close(wake_fd_);
+                wake_fd_ = -1;
+                return false;
+            }
+        }
+
+        running_ = true;
+        for (auto& acceptor : acceptors_) {
+            setSocketTimeout(acceptor.listen_fd, timeout_seconds_);
+            acceptor.thread = std::thread(
+                [this, &acceptor]() { runAcceptor(acceptor.listen_fd, acceptor.epoll_fd); });
+        }
+        reaper_thread_ = std::thread([this]() { reapIdleConnections(); });
+        return true;
+    }
+
+    server_fd_ = openListener(false);
+    if (server_fd_ < 0) {
+        return false;
+    }
+
     running_ = true;
 
     server_thread_ = std::thread([this]() {
@@ -161,17 +327,123 @@ bool HttpServer::start() {
                 continue;
             }
 
+            // Refused before queueing when the pool is already too far behind
+            if (admission_ && admission_->shedConnection(queued_connections_.load())) {
+                shedConnection(client_fd);
+                continue;
+            }
+
+            utils::TimerWheel::TimerId idle_timer = scheduleIdleTimeout(client_fd);
+
             // Enqueue client handling to thread pool instead of processing synchronously
-            thread_pool_->enqueue([this, client_fd]() { handleClientRequest(client_fd); });
+            queued_connections_.fetch_add(1);
+            thread_pool_->enqueue([this, client_fd, idle_timer]() {
+                queued_connections_.fetch_sub(1);
+                handleClientRequest(client_fd, idle_timer);
+            });
         }
     });
 
+    reaper_thread_ = std::thread([this]() { reapIdleConnections(); });
+
     return true;
 }
 
-void HttpServer::handleClientRequest(int client_fd) {
-    setSocketTimeout(client_fd, timeout_seconds_);
+void HttpServer::runAcceptor(int listen_fd, int epoll_fd) {
+    // Accepted connections stay non-blocking in the epoll set until their whole request has
+    // arrived, so a slow or silent client never holds up the loop; the idle reaper bounds how
+    // long they may take.
+    struct PendingRequest {
+        utils::TimerWheel::TimerId idle_timer;
+        std::string raw;
+    };
+    std::unordered_map<int, PendingRequest> pending;
+    epoll_event events[64];
+
+    while (!stop_flag_) {
+        int ready = ::epoll_wait(epoll_fd, events, 64, -1);
+        if (ready < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        for (int i = 0; i < ready && !stop_flag_; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wake_fd_) {
+                continue;
+            }
+
+            if (fd == listen_fd) {
+                for (;;) {
+                    int client_fd =
+                        ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+                    if (client_fd < 0) {
+                        // EAGAIN: backlog drained. Anything else (EMFILE, aborted handshakes)
+                        // is retried on the next readiness notification.
+                        break;
+                    }
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLRDHUP;
+                    event.data.fd = client_fd;
+                    if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_fd, &event) < 0) {
+                        ::close(client_fd);
+                        continue;
+                    }
+                    pending[client_fd] = PendingRequest{scheduleIdleTimeout(client_fd), {}};
+                }
+                continue;
+            }
 
+            auto it = pending.find(fd);
+            if (it == pending.end()) {
+                continue;
+            }
+            const bool open = readAvailable(fd, it->second.raw);
+            if (!requestComplete(it->second.raw)) {
+                if (!open) {
+                    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+                    closeConnection(fd, it->second.idle_timer);
+                    pending.erase(it);
+                }
+                continue;
+            }
+
+            PendingRequest request = std::move(it->second);
+            pending.erase(it);
+            ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            // The response goes out with blocking sends, bounded by the socket timeout
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+            // Served to completion on this thread; the connection never changes cores
+            serveRequest(fd, request.idle_timer, request.raw);
+        }
+    }
+
+    for (const auto& [client_fd, request] : pending) {
+        closeConnection(client_fd, request.idle_timer);
+    }
+}
+
+void HttpServer::reapIdleConnections() {
+    while (!stop_flag_) {
+        std::this_thread::sleep_for(kReapInterval);
+        std::lock_guard<std::mutex> lock(reaper_mutex_);
+        // Shutting a socket down wakes its worker out of recv/send with EOF
+        const int64_t now = steadyNanos();
+        reaper_wheel_.advance(now);
+        async_wheel_->advance(now);
+    }
+}
+
+void HttpServer::closeConnection(int client_fd, utils::TimerWheel::TimerId idle_timer) {
+    {
+        std::lock_guard<std::mutex> lock(reaper_mutex_);
+        reaper_wheel_.cancel(idle_timer);
+    }
+    ::close(client_fd);
+}
+
+void HttpServer::handleClientRequest(int client_fd, utils::TimerWheel::TimerId idle_timer) {
     // Read request into buffer
     std::string request_raw;
     char buf[4096];
@@ -205,9 +477,9 @@ void HttpServer::handleClientRequest(int client_fd) {
                             value.pop_back();
                         for (auto& c : key)
                             c = std::tolower(c);
+                        // A malformed length ends the read; respond() answers it with a 400
                         if (key == "content-length") {
-                            content_length = static_cast<size_t>(std::stoul(value));
-                            has_content_length = true;
+                            has_content_length = parseContentLength(value, content_length);
                         }
                     }
                 }
@@ -225,7 +497,7 @@ void HttpServer::handleClientRequest(int client_fd) {
                             } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK ||
                                                  errno == ETIMEDOUT)) {
                                 // Timeout occurred - close connection and skip processing
-                                ::close(client_fd);
+                                closeConnection(client_fd, idle_timer);
                                 n = -1;  // Mark for skipping
                                 break;
                             } else {
@@ -251,16 +523,16 @@ void HttpServer::handleClientRequest(int client_fd) {
     if (n <= 0) {
         if (n == 0) {
             // Connection closed cleanly
-            ::close(client_fd);
+            closeConnection(client_fd, idle_timer);
             return;
         } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ETIMEDOUT) {
             // Timeout occurred
-            ::close(client_fd);
+            closeConnection(client_fd, idle_timer);
             return;
         }
         // For other errors, try to process what we have (if any)
         if (request_raw.empty()) {
-            ::close(client_fd);
+            closeConnection(client_fd, idle_timer);
             return;
         }
     }
@@ -270,6 +542,64 @@ void HttpServer::handleClientRequest(int client_fd) {
         return;
     }
 
+    serveRequest(client_fd, idle_timer, request_raw);
+}
+
+void HttpServer::serveRequest(int client_fd, utils::TimerWheel::TimerId idle_timer,
+                              const std::string& request_raw) {
+    const auto reply = [this, client_fd, idle_timer](HttpResponse resp) {
+        auto out_str = serializeResponse(std::move(resp));
+        ::send(client_fd, out_str.data(), out_str.size(), 0);
+        closeConnection(client_fd, idle_timer);
+    };
+
+    std::optional<HttpResponse> response;
+    try {
+        HttpRequest req = parseRequest(request_raw);
+
+        // WebSocket upgrades leave the request/response cycle here
+        if (WebSocketHub* hub = websocketUpgradeTarget(req)) {
+            if (upgradeToWebSocket(client_fd, idle_timer, req, *hub)) {
+                return;
+            }
+            response = createErrorResponse(400, "Invalid WebSocket handshake");
+        } else {
+            // An async handler replies from whichever pool thread finishes its task
+            response = respond(std::move(req), reply);
+            if (!response) {
+                return;
+            }
+        }
+    } catch (...) {
+        // A throwing handler must not take the serving thread down with it
+        response = createErrorResponse(500, "Internal server error");
+    }
+    reply(std::move(*response));
+}
+
+bool HttpServer::requestComplete(const std::string& raw) {
+    const size_t header_end = raw.find("\r\n\r\n");
+    if (header_end == std::string::npos) {
+        return false;
+    }
+    // Without a Content-Length the request ends with its headers
+    std::istringstream hs(raw.substr(0, header_end));
+    std::string line;
+    std::getline(hs, line);  // request line
+    while (std::getline(hs, line)) {
+        if (line.size() < 15 || line[14] != ':' ||
+            strncasecmp(line.c_str(), "content-length", 14) != 0) {
+            continue;
+        }
+        // A malformed length is complete as it stands: waiting cannot fix it, respond() rejects it
+        size_t content_length = 0;
+        return !parseContentLength(std::string_view(line).substr(15), content_length) ||
+               raw.size() - (header_end + 4) >= content_length;
+    }
+    return true;
+}
+
+HttpRequest HttpServer::parseRequest(const std::string& request_raw) {
     // Parse request line and headers
     HttpRequest req;
     req.method = "GET";
@@ -314,34 +644,189 @@ void HttpServer::handleClientRequest(int client_fd) {
         }
         req.body = request_raw.substr(header_end + 4);
     }
+    return req;
+}
 
-    // Route
-    HttpResponse resp = routeRequest(req);
-
+std::string HttpServer::serializeResponse(HttpResponse resp) {
+    // A 304 has no body, so it describes none
+    const bool has_body = resp.status_code != 304;
     // Ensure Content-Type header
-    if (resp.headers.find("Content-Type") == resp.headers.end()) {
+    if (has_body && resp.headers.find("Content-Type") == resp.headers.end()) {
         resp.headers["Content-Type"] = "application/json";
     }
 
     // Write response
     std::ostringstream out;
     out << "HTTP/1.1 " << resp.status_code << ' ' << reasonPhrase(resp.status_code) << "\r\n";
-    out << "Content-Length: " << resp.body.size() << "\r\n";
+    if (has_body) {
+        out << "Content-Length: " << resp.body.size() << "\r\n";
+    }
     for (const auto& kv : resp.headers) {
         out << kv.first << ": " << kv.second << "\r\n";
     }
     out << "\r\n";
     out << resp.body;
-    auto out_str = out.str();
-    ::send(client_fd, out_str.data(), out_str.size(), 0);
+    return out.str();
+}
 
-    ::close(client_fd);
+WebSocketHub* HttpServer::websocketUpgradeTarget(const HttpRequest& request) const {
+    auto websocket_route = websocket_routes_.find(request.path);
+    if (websocket_route == websocket_routes_.end() ||
+        !headerContainsToken(request, "Upgrade", "websocket")) {
+        return nullptr;
+    }
+    return websocket_route->second.get();
+}
+
+std::optional<HttpResponse> HttpServer::respond(HttpRequest request,
+                                                const ResponseCallback& done) {
+    if (const std::string* length = findHeader(request, "Content-Length")) {
+        size_t content_length = 0;
+        if (!parseContentLength(*length, content_length)) {
+            return createErrorResponse(400, "Invalid Content-Length");
+        }
+    }
+    if (websocket_routes_.count(request.path)) {
+        return createErrorResponse(426, "WebSocket upgrade required");
+    }
+    std::optional<HttpResponse> response = routeRequest(request, done);
+    if (response) {
+        finishResponse(request, *response);
+    }
+    return response;
+}
+
+void HttpServer::finishResponse(const HttpRequest& request, HttpResponse& response) {
+    applyBodyFormat(request, response);
+    if (compressor_) {
+        applyContentEncoding(request, response);
+    }
+}
+
+void HttpServer::applyBodyFormat(const HttpRequest& request, HttpResponse& response) {
+    // Representations differ by Accept, so caches must key on it
+    response.headers["Vary"] = "Accept";
+    const std::string* accept = findHeader(request, "Accept");
+    if (!accept || response.body.empty()) {
+        return;
+    }
+    const BodyFormat format = negotiateBodyFormat(*accept);
+    auto content_type = response.headers.find("Content-Type");
+    if (format == BodyFormat::JSON ||
+        (content_type != response.headers.end() && content_type->second != "application/json")) {
+        return;  // Wanted as JSON, already encoded by the handler, or not JSON at all
+    }
+    try {
+        const auto document = nlohmann::json::parse(response.body);
+        const std::vector<uint8_t> encoded = format == BodyFormat::CBOR
+                                                 ? nlohmann::json::to_cbor(document)
+                                                 : nlohmann::json::to_msgpack(document);
+        response.body.assign(encoded.begin(), encoded.end());
+        response.headers["Content-Type"] = contentTypeFor(format);
+    } catch (const nlohmann::json::exception&) {
+        // Not actually JSON; send it as it is
+    }
+}
+
+void HttpServer::applyContentEncoding(const HttpRequest& request, HttpResponse& response) {
+    response.headers["Vary"] = "Accept, Accept-Encoding";
+    const std::string* accept_encoding = findHeader(request, "Accept-Encoding");
+    if (!accept_encoding || response.status_code == 304 ||
+        response.body.size() < compressor_->minSize() ||
+        response.headers.count("Content-Encoding")) {
+        return;
+    }
+    const ContentEncoding encoding = negotiateContentEncoding(*accept_encoding);
+    if (encoding == ContentEncoding::IDENTITY) {
+        return;
+    }
+
+    std::shared_ptr<const std::string> compressed;
+    auto etag = response.headers.find("ETag");
+    if (etag != response.headers.end()) {
+        // The ETag names the version; the path, query and content type name the resource
+        std::string cache_key = request.method + ' ' + request.path;
+        for (const auto& [name, value] : request.query_params) {
+            cache_key += '&' + name + '=' + value;
+        }
+        auto content_type = response.headers.find("Content-Type");
+        if (content_type != response.headers.end()) {
+            cache_key += ' ' + content_type->second;
+        }
+        cache_key += ' ' + etag->second + ' ' + contentEncodingToken(encoding);
+        compressed = compressor_->compressCached(encoding, cache_key, response.body);
+    } else {
+        auto body = std::make_shared<std::string>();
+        if (compressor_->compress(encoding, response.body, *body)) {
+            compressed = std::move(body);
+        }
+    }
+    if (!compressed || compressed->size() >= response.body.size()) {
+        return;
+    }
+    response.body = *compressed;
+    response.headers["Content-Encoding"] = contentEncodingToken(encoding);
+}
+
+std::optional<std::string> HttpServer::websocketHandshake(const HttpRequest& request) {
+    const std::string* key = findHeader(request, "Sec-WebSocket-Key");
+    const std::string* version = findHeader(request, "Sec-WebSocket-Version");
+    if (request.method != "GET" || !key || key->empty() || !version || *version != "13" ||
+        !headerContainsToken(request, "Connection", "upgrade")) {
+        return std::nullopt;
+    }
+    return "HTTP/1.1 101 Switching Protocols\r\n"
+           "Upgrade: websocket\r\n"
+           "Connection: Upgrade\r\n"
+           "Sec-WebSocket-Accept: " +
+           websocket::acceptKey(*key) + "\r\n\r\n";
+}
+
+bool HttpServer::upgradeToWebSocket(int client_fd, utils::TimerWheel::TimerId idle_timer,
+                                    const HttpRequest& request, WebSocketHub& hub) {
+    const std::optional<std::string> response = websocketHandshake(request);
+    if (!response) {
+        return false;
+    }
+    if (::send(client_fd, response->data(), response->size(), MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(response->size())) {
+        closeConnection(client_fd, idle_timer);
+        return true;
+    }
+
+    // The connection is long-lived from here on, so it leaves the idle reaper
+    {
+        std::lock_guard<std::mutex> lock(reaper_mutex_);
+        reaper_wheel_.cancel(idle_timer);
+    }
+    hub.adopt(client_fd);
+    return true;
 }
 
 void HttpServer::stop() {
     if (!running_)
         return;
     stop_flag_ = true;
+    // Parked async handlers answer now, before the loops that would send their responses stop
+    expireAsyncWaits();
+    stopIoUring();
+    if (wake_fd_ >= 0) {
+        // Never read, so it stays readable and wakes every acceptor
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+    }
+    for (auto& acceptor : acceptors_) {
+        if (acceptor.thread.joinable()) {
+            acceptor.thread.join();
+        }
+        ::close(acceptor.listen_fd);
+        ::close(acceptor.epoll_fd);
+    }
+    acceptors_.clear();
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
     if (server_fd_ >= 0) {
         ::shutdown(server_fd_, SHUT_RDWR);
         ::close(server_fd_);
@@ -350,9 +835,97 @@ void HttpServer::stop() {
     if (server_thread_.joinable()) {
         server_thread_.join();
     }
+    if (reaper_thread_.joinable()) {
+        reaper_thread_.join();
+    }
+    {
+        std::unique_lock<std::mutex> lock(async_mutex_);
+        async_idle_.wait(lock, [this]() { return async_in_flight_ == 0; });
+    }
     running_ = false;
 }
 
+void HttpServer::expireAsyncWaits() {
+    std::lock_guard<std::mutex> lock(reaper_mutex_);
+    // Fires every pending timeout; waits started from here on see stop_flag_ and return at
+    // once. A fresh wheel keeps a later start() on real time.
+    async_wheel_->advance(std::numeric_limits<int64_t>::max() / 2);
+    async_wheel_ = std::make_unique<utils::TimerWheel>(kReapInterval, steadyNanos());
+}
+
+struct HttpServer::AsyncWait::State {
+    HttpServer* server;
+    std::function<void(std::function<void()>)> subscribe;
+    std::chrono::milliseconds timeout;
+    std::coroutine_handle<> handle;
+    utils::TimerWheel::TimerId timer = utils::TimerWheel::kInvalidTimer;
+    std::atomic<bool> fired{false};
+    bool notified = false;
+    // Held by the event that ends the wait and by await_suspend() until it returns; whichever
+    // lets go last resumes the coroutine, so it never runs while await_suspend() still is
+    std::atomic<int> holds{2};
+
+    // Ends the wait once, by notifier or by timeout
+    void fire(bool by_notifier) {
+        if (fired.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        notified = by_notifier;
+        if (by_notifier) {
+            // Timeouts fire under the same mutex, so only a notifier cancels
+            std::lock_guard<std::mutex> lock(server->reaper_mutex_);
+            server->async_wheel_->cancel(timer);
+        }
+        if (holds.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            server->thread_pool_->enqueue([resume = handle]() { resume.resume(); });
+        }
+    }
+};
+
+bool HttpServer::AsyncWait::await_suspend(std::coroutine_handle<> handle) {
+    // The coroutine, and this awaiter with it, may be resumed elsewhere as soon as an event
+    // fires, so only the state is touched from here on
+    std::shared_ptr<State> state = state_;
+    state->handle = handle;
+    HttpServer& server = *state->server;
+    if (state->timeout.count() <= 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(server.reaper_mutex_);
+        if (server.stop_flag_) {
+            return false;
+        }
+        state->timer = server.async_wheel_->scheduleAt(
+            steadyNanos() +
+                std::chrono::duration_cast<std::chrono::nanoseconds>(state->timeout).count(),
+            [state]() { state->fire(false); });
+    }
+    if (state->subscribe) {
+        auto subscribe = std::move(state->subscribe);
+        subscribe([state]() { state->fire(true); });
+    }
+    // Already over: carry straight on instead of a trip through the pool
+    return state->holds.fetch_sub(1, std::memory_order_acq_rel) != 1;
+}
+
+bool HttpServer::AsyncWait::await_resume() const noexcept {
+    return state_->notified;
+}
+
+HttpServer::AsyncWait HttpServer::waitFor(std::function<void(std::function<void()>)> subscribe,
+                                          std::chrono::milliseconds timeout) {
+    auto state = std::make_shared<AsyncWait::State>();
+    state->server = this;
+    state->subscribe = std::move(subscribe);
+    state->timeout = timeout;
+    return AsyncWait(std::move(state));
+}
+
+HttpServer::AsyncWait HttpServer::sleepFor(std::chrono::milliseconds delay) {
+    return waitFor(nullptr, delay);
+}
+
 bool HttpServer::isRunning() const {
     return running_;
 }
@@ -365,16 +938,40 @@ void HttpServer::setHealthHandler(RequestHandler handler) {
     health_handler_ = handler;
 }
 
+void HttpServer::registerWebSocket(const std::string& path, std::shared_ptr<WebSocketHub> hub) {
+    websocket_routes_[path] = std::move(hub);
+}
+
 void HttpServer::registerRoute(const std::string& method, const std::string& path_pattern,
-                               RequestHandler handler) {
+                               RequestHandler handler, RequestClass request_class) {
     Route route;
     route.method = method;
     route.path_pattern = path_pattern;
     route.path_regex = pathPatternToRegex(path_pattern, route.param_names);
     route.handler = handler;
+    route.request_class = request_class;
     routes_.push_back(route);
 }
 
+void HttpServer::registerAsyncRoute(const std::string& method, const std::string& path_pattern,
+                                    AsyncRequestHandler handler, RequestClass request_class) {
+    Route route;
+    route.method = method;
+    route.path_pattern = path_pattern;
+    route.path_regex = pathPatternToRegex(path_pattern, route.param_names);
+    route.async_handler = std::move(handler);
+    route.request_class = request_class;
+    routes_.push_back(std::move(route));
+}
+
+void HttpServer::setAdmissionController(std::shared_ptr<AdmissionController> admission) {
+    admission_ = std::move(admission);
+}
+
+void HttpServer::setResponseCompressor(std::shared_ptr<ResponseCompressor> compressor) {
+    compressor_ = std::move(compressor);
+}
+
 std::regex HttpServer::pathPatternToRegex(const std::string& pattern,
                                           std::vector<std::string>& param_names) {
     param_names.clear();
@@ -398,13 +995,14 @@ std::regex HttpServer::pathPatternToRegex(const std::string& pattern,
     return std::regex("^" + result + "$");
 }
 
-HttpResponse HttpServer::routeRequest(const HttpRequest& request) {
+std::optional<HttpResponse> HttpServer::routeRequest(HttpRequest& request,
+                                                     const ResponseCallback& done) {
     // Fast path for high-frequency endpoints - avoid regex overhead
     if (request.method == "POST" && request.path == "/order" && !routes_.empty()) {
         // Find the /order route directly
         for (const auto& route : routes_) {
             if (route.method == "POST" && route.path_pattern == "/order") {
-                return route.handler(request);
+                return invokeRoute(route, request, done);
             }
         }
     }
@@ -413,7 +1011,7 @@ HttpResponse HttpServer::routeRequest(const HttpRequest& request) {
         // Find the /health route directly
         for (const auto& route : routes_) {
             if (route.method == "GET" && route.path_pattern == "/health") {
-                return route.handler(request);
+                return invokeRoute(route, request, done);
             }
         }
     }
@@ -430,29 +1028,100 @@ HttpResponse HttpServer::routeRequest(const HttpRequest& request) {
             std::smatch match;
             if (std::regex_match(request.path, match, route.path_regex)) {
                 // Extract path parameters only for parameterized routes
-                if (!route.param_names.empty()) {
-                    HttpRequest modified_request = request;
-                    for (size_t i = 0; i < route.param_names.size() && i + 1 < match.size(); ++i) {
-                        modified_request.path_params[route.param_names[i]] = match[i + 1].str();
-                    }
-                    return route.handler(modified_request);
-                } else {
-                    return route.handler(request);
+                for (size_t i = 0; i < route.param_names.size() && i + 1 < match.size(); ++i) {
+                    request.path_params[route.param_names[i]] = match[i + 1].str();
                 }
+                return invokeRoute(route, request, done);
             }
         }
     }
 
     // Fall back to legacy handlers for backward compatibility
     if (request.path == "/health" && health_handler_) {
-        return health_handler_(request);
+        return invokeHandler(health_handler_, RequestClass::EXEMPT, request);
     } else if (request.path == "/orders" && order_handler_) {
-        return order_handler_(request);
+        return invokeHandler(order_handler_, RequestClass::ORDER, request);
     }
 
     return createErrorResponse(404, "Not Found");
 }
 
+std::optional<HttpResponse> HttpServer::invokeRoute(const Route& route, HttpRequest& request,
+                                                    const ResponseCallback& done) {
+    if (route.async_handler) {
+        return invokeAsyncHandler(route.async_handler, route.request_class, request, done);
+    }
+    return invokeHandler(route.handler, route.request_class, request);
+}
+
+HttpResponse HttpServer::invokeHandler(const RequestHandler& handler, RequestClass request_class,
+                                       const HttpRequest& request) {
+    if (!admission_) {
+        return handler(request);
+    }
+    const AdmissionController::Decision decision =
+        admission_->admit(request_class, queued_connections_.load());
+    if (!decision.admitted) {
+        return createShedResponse(decision.status_code, decision.reason);
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    struct Release {
+        AdmissionController& admission;
+        RequestClass request_class;
+        std::chrono::steady_clock::time_point started;
+        ~Release() {
+            admission.release(request_class, std::chrono::steady_clock::now() - started);
+        }
+    } release{*admission_, request_class, started};
+    return handler(request);
+}
+
+std::optional<HttpResponse> HttpServer::invokeAsyncHandler(const AsyncRequestHandler& handler,
+                                                           RequestClass request_class,
+                                                           HttpRequest& request,
+                                                           const ResponseCallback& done) {
+    if (admission_) {
+        const AdmissionController::Decision decision =
+            admission_->admit(request_class, queued_connections_.load());
+        if (!decision.admitted) {
+            return createShedResponse(decision.status_code, decision.reason);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        ++async_in_flight_;
+    }
+    utils::spawn(serveAsync(handler, request_class, std::move(request)),
+                 [this, done](HttpResponse response) {
+                     done(std::move(response));
+                     std::lock_guard<std::mutex> lock(async_mutex_);
+                     if (--async_in_flight_ == 0) {
+                         async_idle_.notify_all();
+                     }
+                 });
+    return std::nullopt;
+}
+
+utils::Task<HttpResponse> HttpServer::serveAsync(const AsyncRequestHandler& handler,
+                                                 RequestClass request_class,
+                                                 HttpRequest request) {
+    const auto started = std::chrono::steady_clock::now();
+    HttpResponse response;
+    try {
+        response = co_await handler(request);
+    } catch (...) {
+        // Nobody above the task could catch it, and the client still needs an answer
+        response = createErrorResponse(500, "Internal server error");
+    }
+    if (admission_) {
+        admission_->release(request_class, std::chrono::steady_clock::now() - started);
+    }
+    finishResponse(request, response);
+    co_return response;
+}
+
 void HttpServer::setTimeout(int seconds) {
     timeout_seconds_ = seconds;
 }
@@ -461,10 +1130,32 @@ void HttpServer::setMaxConnections(int max_connections) {
     max_connections_ = max_connections;
 }
 
+void HttpServer::setAcceptors(int acceptors) {
+    num_acceptors_ = std::max(acceptors, 1);
+}
+
+void HttpServer::setBackend(Backend backend) {
+    backend_ = backend;
+}
+
 void HttpServer::handleRequest(const HttpRequest& request) {
     (void)request;  // Unused in this minimal implementation
 }
 
+HttpResponse HttpServer::createShedResponse(int status_code, const std::string& message) {
+    HttpResponse response = createErrorResponse(status_code, message);
+    response.headers["Retry-After"] = std::to_string(admission_->retryAfterSeconds());
+    return response;
+}
+
+void HttpServer::shedConnection(int client_fd) {
+    // Best effort and never blocking: the point is to spend as little as possible on it
+    const std::string response =
+        serializeResponse(createShedResponse(503, "Server overloaded"));
+    ::send(client_fd, response.data(), response.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    ::close(client_fd);
+}
+
 HttpResponse HttpServer::createErrorResponse(int status_code, const std::string& message) {
     HttpResponse response;
     response.status_code = status_code;
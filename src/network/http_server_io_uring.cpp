@@ -0,0 +1,723 @@
+#include "trading/network/http_server.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define TRADING_HAS_IO_URING 1
+#endif
+
+#ifdef TRADING_HAS_IO_URING
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+
+namespace trading {
+namespace network {
+
+namespace {
+constexpr unsigned kRingEntries = 1024;
+constexpr unsigned kRecvBuffers = 256;  // Power of two, as the kernel requires
+constexpr unsigned kRecvBufferSize = 4096;
+constexpr uint16_t kRecvBufferGroup = 0;
+
+// liburing is not a dependency; these are the three io_uring system calls it wraps
+int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int ring_fd, unsigned opcode, const void* arg, unsigned nr_args) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+// user_data layout: operation in the top byte, connection slot in the low 32 bits
+enum class Op : uint8_t { ACCEPT = 1, WAKE, STOP, INSTALL, RECV, SEND, CANCEL, CLOSE };
+
+uint64_t userData(Op op, uint32_t slot = 0) {
+    return (static_cast<uint64_t>(op) << 56) | slot;
+}
+
+Op opOf(uint64_t user_data) {
+    return static_cast<Op>(user_data >> 56);
+}
+
+uint32_t slotOf(uint64_t user_data) {
+    return static_cast<uint32_t>(user_data);
+}
+
+// Provided-buffer rings (5.19) are the newest feature used at setup time
+bool probeIoUring() {
+    io_uring_params params{};
+    const int ring_fd = ioUringSetup(8, &params);
+    if (ring_fd < 0) {
+        return false;
+    }
+    void* memory = ::mmap(nullptr, 8 * sizeof(io_uring_buf), PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    bool supported = false;
+    if (memory != MAP_FAILED) {
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(memory);
+        reg.ring_entries = 8;
+        supported = ioUringRegister(ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) == 0;
+        ::munmap(memory, 8 * sizeof(io_uring_buf));
+    }
+    ::close(ring_fd);
+    return supported;
+}
+}  // namespace
+
+class HttpServer::IoUringLoop {
+  public:
+    // Takes ownership of listen_fd
+    IoUringLoop(HttpServer& server, int listen_fd, unsigned max_connections)
+        : server_(server), listen_fd_(listen_fd), connections_(max_connections) {
+    }
+
+    ~IoUringLoop() {
+        ::close(listen_fd_);
+        if (sqes_) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ptr_ && cq_ptr_ != sq_ptr_) {
+            ::munmap(cq_ptr_, cq_size_);
+        }
+        if (sq_ptr_) {
+            ::munmap(sq_ptr_, sq_size_);
+        }
+        if (buf_ring_) {
+            ::munmap(buf_ring_, kRecvBuffers * sizeof(io_uring_buf));
+        }
+        if (ring_fd_ >= 0) {
+            ::close(ring_fd_);
+        }
+        if (wake_fd_ >= 0) {
+            ::close(wake_fd_);
+        }
+    }
+
+    // Sets up the ring, the fixed-file table and the receive buffer ring
+    bool init() {
+        io_uring_params params{};
+        ring_fd_ = ioUringSetup(kRingEntries, &params);
+        if (ring_fd_ < 0) {
+            return false;
+        }
+        if (!mapRings(params)) {
+            return false;
+        }
+
+        // Every slot starts empty; accepted sockets are installed into them asynchronously
+        std::vector<int> files(connections_.size(), -1);
+        if (ioUringRegister(ring_fd_, IORING_REGISTER_FILES, files.data(),
+                            static_cast<unsigned>(files.size())) < 0) {
+            return false;
+        }
+
+        void* ring_memory = ::mmap(nullptr, kRecvBuffers * sizeof(io_uring_buf),
+                                   PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ring_memory == MAP_FAILED) {
+            return false;
+        }
+        buf_ring_ = static_cast<io_uring_buf_ring*>(ring_memory);
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+        reg.ring_entries = kRecvBuffers;
+        reg.bgid = kRecvBufferGroup;
+        if (ioUringRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+            return false;
+        }
+        recv_buffers_.resize(static_cast<size_t>(kRecvBuffers) * kRecvBufferSize);
+        for (uint16_t bid = 0; bid < kRecvBuffers; ++bid) {
+            provideBuffer(bid);
+        }
+
+        wake_fd_ = ::eventfd(0, EFD_CLOEXEC);
+        if (wake_fd_ < 0) {
+            return false;
+        }
+
+        free_slots_.reserve(connections_.size());
+        for (size_t slot = connections_.size(); slot-- > 0;) {
+            free_slots_.push_back(static_cast<uint32_t>(slot));
+        }
+        return true;
+    }
+
+    void start() {
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    // Stops the loop and waits for handlers still running on the pool to report back
+    void stop() {
+        stopping_ = true;
+        wake();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        std::unique_lock<std::mutex> lock(completions_mutex_);
+        idle_.wait(lock, [this]() { return in_flight_ == 0; });
+    }
+
+  private:
+    struct Connection {
+        int fd = -1;  // Also the source array of the INSTALL operation
+        bool in_use = false;
+        bool installed = false;  // Present in the fixed-file table
+        bool recv_armed = false;
+        bool dispatched = false;
+        bool closing = false;
+        bool hand_off = false;  // Passed to upgrade_hub instead of being closed
+        int pending = 0;  // Submitted operations whose final completion has not arrived
+        uint32_t generation = 0;
+        utils::TimerWheel::TimerId idle_timer{};
+        std::string request;
+        std::string response;
+        size_t sent = 0;
+        WebSocketHub* upgrade_hub = nullptr;
+    };
+
+    struct Completion {
+        uint32_t slot;
+        uint32_t generation;
+        std::string response;
+    };
+
+    HttpServer& server_;
+    int listen_fd_;
+    int ring_fd_ = -1;
+    int wake_fd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> stopping_{false};
+
+    // Submission and completion rings shared with the kernel
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    size_t sq_size_ = 0;
+    size_t cq_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_mask_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_entries_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned* cq_mask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned sqe_tail_ = 0;  // Next free SQE, published to the kernel on submit
+    unsigned submitted_ = 0;  // SQEs already handed to io_uring_enter
+
+    // Receive buffers the kernel picks from for multishot recv
+    io_uring_buf_ring* buf_ring_ = nullptr;
+    uint16_t buf_ring_tail_ = 0;
+    std::vector<char> recv_buffers_;
+
+    std::vector<Connection> connections_;  // Indexed by fixed-file slot; never resized
+    std::vector<uint32_t> free_slots_;
+    uint32_t generation_ = 0;
+    uint64_t wake_value_ = 0;
+    bool accept_armed_ = false;
+
+    // Responses produced on the worker pool, handed back to the loop thread
+    std::mutex completions_mutex_;
+    std::condition_variable idle_;
+    std::vector<Completion> completions_;
+    size_t in_flight_ = 0;
+
+    bool mapRings(const io_uring_params& params) {
+        sq_entries_ = params.sq_entries;
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        }
+
+        sq_ptr_ = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) {
+            sq_ptr_ = nullptr;
+            return false;
+        }
+        cq_ptr_ = single_mmap ? sq_ptr_
+                              : ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ptr_ == MAP_FAILED) {
+            cq_ptr_ = nullptr;
+            return false;
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return false;
+        }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(sq_ptr_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        auto* cq = static_cast<char*>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        sqe_tail_ = submitted_ = *sq_tail_;
+        return true;
+    }
+
+    void provideBuffer(uint16_t bid) {
+        // Indexed by hand: in C++ the header's flexible bufs[] member does not start at offset 0
+        io_uring_buf& buf = reinterpret_cast<io_uring_buf*>(
+            buf_ring_)[buf_ring_tail_ & (kRecvBuffers - 1)];
+        buf.addr = reinterpret_cast<uint64_t>(recv_buffers_.data() +
+                                              static_cast<size_t>(bid) * kRecvBufferSize);
+        buf.len = kRecvBufferSize;
+        buf.bid = bid;
+        ++buf_ring_tail_;
+        __atomic_store_n(&buf_ring_->tail, buf_ring_tail_, __ATOMIC_RELEASE);
+    }
+
+    // Publishes queued SQEs and, when wait is set, blocks for at least one completion
+    int submit(bool wait) {
+        __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+        const unsigned to_submit = sqe_tail_ - submitted_;
+        const int rc = ioUringEnter(ring_fd_, to_submit, wait ? 1 : 0,
+                                    wait ? IORING_ENTER_GETEVENTS : 0);
+        if (rc > 0) {
+            submitted_ += static_cast<unsigned>(rc);
+        }
+        return rc;
+    }
+
+    io_uring_sqe* nextSqe(Op op, uint32_t slot = 0) {
+        while (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+            submit(false);
+        }
+        const unsigned index = sqe_tail_ & *sq_mask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->user_data = userData(op, slot);
+        sq_array_[index] = index;
+        ++sqe_tail_;
+        if (op != Op::ACCEPT && op != Op::WAKE && op != Op::STOP) {
+            ++connections_[slot].pending;
+        }
+        return sqe;
+    }
+
+    void armAccept() {
+        io_uring_sqe* sqe = nextSqe(Op::ACCEPT);
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = listen_fd_;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags = SOCK_CLOEXEC;
+        accept_armed_ = true;
+    }
+
+    void armWake() {
+        io_uring_sqe* sqe = nextSqe(Op::WAKE);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = wake_fd_;
+        sqe->addr = reinterpret_cast<uint64_t>(&wake_value_);
+        sqe->len = sizeof(wake_value_);
+    }
+
+    void armRecv(uint32_t slot) {
+        io_uring_sqe* sqe = nextSqe(Op::RECV, slot);
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = static_cast<int>(slot);
+        sqe->flags = IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->buf_group = kRecvBufferGroup;
+        connections_[slot].recv_armed = true;
+    }
+
+    void sendResponse(uint32_t slot) {
+        Connection& connection = connections_[slot];
+        io_uring_sqe* sqe = nextSqe(Op::SEND, slot);
+        sqe->opcode = IORING_OP_SEND;
+        sqe->fd = static_cast<int>(slot);
+        sqe->flags = IOSQE_FIXED_FILE;
+        sqe->addr = reinterpret_cast<uint64_t>(connection.response.data() + connection.sent);
+        sqe->len = static_cast<uint32_t>(connection.response.size() - connection.sent);
+        sqe->msg_flags = MSG_NOSIGNAL;
+    }
+
+    void wake() {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+    }
+
+    void run() {
+        armAccept();
+        armWake();
+        while (!stopping_ && submitAndReap()) {
+        }
+
+        // The kernel tears a ring down asynchronously, which would keep the listening socket and
+        // open connections alive after stop() returns; release them explicitly first
+        io_uring_sqe* sqe = nextSqe(Op::STOP);
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = userData(Op::ACCEPT);
+        for (uint32_t slot = 0; slot < connections_.size(); ++slot) {
+            if (connections_[slot].in_use) {
+                beginClose(slot);
+            }
+        }
+        while ((accept_armed_ || free_slots_.size() < connections_.size()) && submitAndReap()) {
+        }
+    }
+
+    // One io_uring_enter: submits everything queued and waits for at least one completion
+    bool submitAndReap() {
+        if (submit(true) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            return false;
+        }
+        unsigned head = *cq_head_;
+        const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe cqe = cqes_[head & *cq_mask_];
+            handleCompletion(cqe);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    void handleCompletion(const io_uring_cqe& cqe) {
+        const Op op = opOf(cqe.user_data);
+        if (op == Op::ACCEPT) {
+            if (cqe.res >= 0) {
+                accepted(cqe.res);
+            }
+            if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                accept_armed_ = false;
+                if (!stopping_) {
+                    armAccept();
+                }
+            }
+            return;
+        }
+        if (op == Op::STOP) {
+            return;
+        }
+        if (op == Op::WAKE) {
+            drainCompletions();
+            if (!stopping_) {
+                armWake();
+            }
+            return;
+        }
+
+        const uint32_t slot = slotOf(cqe.user_data);
+        Connection& connection = connections_[slot];
+        if (!(cqe.flags & IORING_CQE_F_MORE)) {
+            --connection.pending;
+        }
+
+        switch (op) {
+            case Op::INSTALL:
+                if (cqe.res < 0) {
+                    beginClose(slot);
+                } else {
+                    connection.installed = true;
+                    armRecv(slot);
+                }
+                break;
+            case Op::RECV:
+                received(slot, cqe);
+                break;
+            case Op::SEND:
+                if (cqe.res <= 0) {
+                    beginClose(slot);
+                    break;
+                }
+                connection.sent += static_cast<size_t>(cqe.res);
+                if (connection.sent < connection.response.size()) {
+                    sendResponse(slot);
+                } else {
+                    beginClose(slot);
+                }
+                break;
+            default:
+                break;
+        }
+
+        if (connection.closing && connection.pending == 0) {
+            release(slot);
+        }
+    }
+
+    void accepted(int fd) {
+        if (free_slots_.empty() || stopping_) {
+            ::close(fd);
+            return;
+        }
+        const uint32_t slot = free_slots_.back();
+        free_slots_.pop_back();
+
+        Connection& connection = connections_[slot];
+        connection = Connection{};
+        connection.fd = fd;
+        connection.in_use = true;
+        connection.generation = ++generation_;
+        connection.idle_timer = server_.scheduleIdleTimeout(fd);
+
+        // Installs the socket into the fixed-file table; the receive is armed on completion
+        io_uring_sqe* sqe = nextSqe(Op::INSTALL, slot);
+        sqe->opcode = IORING_OP_FILES_UPDATE;
+        sqe->fd = -1;
+        sqe->addr = reinterpret_cast<uint64_t>(&connection.fd);
+        sqe->len = 1;
+        sqe->off = slot;
+    }
+
+    void received(uint32_t slot, const io_uring_cqe& cqe) {
+        Connection& connection = connections_[slot];
+        if (cqe.flags & IORING_CQE_F_BUFFER) {
+            const auto bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            if (cqe.res > 0 && !connection.dispatched && !connection.closing) {
+                connection.request.append(
+                    recv_buffers_.data() + static_cast<size_t>(bid) * kRecvBufferSize,
+                    static_cast<size_t>(cqe.res));
+            }
+            provideBuffer(bid);
+        }
+
+        if (cqe.res > 0 && !connection.dispatched && !connection.closing &&
+            requestComplete(connection.request)) {
+            dispatch(slot);
+        }
+
+        if (!(cqe.flags & IORING_CQE_F_MORE)) {
+            connection.recv_armed = false;
+            if (connection.closing || connection.dispatched) {
+                return;
+            }
+            // Out of buffers or the kernel ended the multishot early: keep reading
+            if (cqe.res > 0 || cqe.res == -ENOBUFS) {
+                armRecv(slot);
+            } else {
+                beginClose(slot);
+            }
+        } else if (cqe.res <= 0 && !connection.dispatched) {
+            beginClose(slot);
+        }
+    }
+
+    void dispatch(uint32_t slot) {
+        Connection& connection = connections_[slot];
+        connection.dispatched = true;
+        HttpRequest request = parseRequest(connection.request);
+        connection.request.clear();
+
+        // WebSocket upgrades are answered here and handed to the hub once the ring lets go
+        if (WebSocketHub* hub = server_.websocketUpgradeTarget(request)) {
+            if (auto handshake = websocketHandshake(request)) {
+                connection.upgrade_hub = hub;
+                connection.response = std::move(*handshake);
+            } else {
+                connection.response = serializeResponse(
+                    server_.createErrorResponse(400, "Invalid WebSocket handshake"));
+            }
+            sendResponse(slot);
+            return;
+        }
+
+        // Refused on the ring, without a trip through the already backed-up pool
+        if (server_.admission_ &&
+            server_.admission_->shedConnection(server_.queued_connections_.load())) {
+            connection.response =
+                serializeResponse(server_.createShedResponse(503, "Server overloaded"));
+            sendResponse(slot);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(completions_mutex_);
+            ++in_flight_;
+        }
+        const uint32_t generation = connection.generation;
+        server_.queued_connections_.fetch_add(1);
+        server_.thread_pool_->enqueue(
+            [this, slot, generation, request = std::move(request)]() mutable {
+                server_.queued_connections_.fetch_sub(1);
+                // An async handler reports back from whichever pool thread finishes its task.
+                // Every path ends in complete(), or stop() would wait on in_flight_ forever.
+                const auto reply = [this, slot, generation](HttpResponse response) {
+                    std::string serialized;
+                    try {
+                        serialized = serializeResponse(std::move(response));
+                    } catch (...) {
+                        // Sent empty, which just closes the connection
+                    }
+                    complete(slot, generation, std::move(serialized));
+                };
+                std::optional<HttpResponse> response;
+                try {
+                    response = server_.respond(std::move(request), reply);
+                    if (!response) {
+                        return;
+                    }
+                } catch (...) {
+                    response = server_.createErrorResponse(500, "Internal server error");
+                }
+                reply(std::move(*response));
+            });
+    }
+
+    // Hands a response produced off the loop back to it
+    void complete(uint32_t slot, uint32_t generation, std::string response) {
+        {
+            std::lock_guard<std::mutex> lock(completions_mutex_);
+            completions_.push_back(Completion{slot, generation, std::move(response)});
+            --in_flight_;
+        }
+        idle_.notify_all();
+        wake();
+    }
+
+    void drainCompletions() {
+        std::vector<Completion> completions;
+        {
+            std::lock_guard<std::mutex> lock(completions_mutex_);
+            completions.swap(completions_);
+        }
+        for (Completion& completion : completions) {
+            Connection& connection = connections_[completion.slot];
+            if (!connection.in_use || connection.generation != completion.generation ||
+                connection.closing) {
+                continue;
+            }
+            connection.response = std::move(completion.response);
+            sendResponse(completion.slot);
+        }
+    }
+
+    // Stops receiving, drops the fixed-file entry and closes the descriptor, all through the
+    // ring. An upgraded connection keeps its descriptor and is handed to the WebSocket hub once
+    // every operation on it has completed.
+    void beginClose(uint32_t slot) {
+        Connection& connection = connections_[slot];
+        if (connection.closing) {
+            return;
+        }
+        connection.closing = true;
+        {
+            std::lock_guard<std::mutex> lock(server_.reaper_mutex_);
+            server_.reaper_wheel_.cancel(connection.idle_timer);
+        }
+        if (connection.recv_armed) {
+            io_uring_sqe* sqe = nextSqe(Op::CANCEL, slot);
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = userData(Op::RECV, slot);
+        }
+        if (connection.installed) {
+            io_uring_sqe* sqe = nextSqe(Op::CLOSE, slot);
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->file_index = slot + 1;
+        }
+        connection.hand_off = connection.upgrade_hub && connection.sent > 0 &&
+                              connection.sent == connection.response.size();
+        if (!connection.hand_off) {
+            io_uring_sqe* sqe = nextSqe(Op::CLOSE, slot);
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->fd = connection.fd;
+        }
+    }
+
+    void release(uint32_t slot) {
+        Connection& connection = connections_[slot];
+        if (connection.hand_off) {
+            connection.upgrade_hub->adopt(connection.fd);
+        }
+        connection.in_use = false;
+        connection.request = std::string();
+        connection.response = std::string();
+        free_slots_.push_back(slot);
+    }
+};
+
+void HttpServer::IoUringLoopDeleter::operator()(IoUringLoop* loop) const {
+    delete loop;
+}
+
+bool HttpServer::ioUringSupported() {
+    return probeIoUring();
+}
+
+bool HttpServer::startIoUring() {
+    const unsigned slots = static_cast<unsigned>(max_connections_ > 0 ? max_connections_ : 100);
+    for (int i = 0; i < num_acceptors_; ++i) {
+        const int listen_fd = openListener(num_acceptors_ > 1);
+        if (listen_fd < 0) {
+            uring_loops_.clear();
+            return false;
+        }
+        std::unique_ptr<IoUringLoop, IoUringLoopDeleter> loop(
+            new IoUringLoop(*this, listen_fd, slots));
+        if (!loop->init()) {
+            uring_loops_.clear();
+            return false;
+        }
+        uring_loops_.push_back(std::move(loop));
+    }
+    for (auto& loop : uring_loops_) {
+        loop->start();
+    }
+    return true;
+}
+
+void HttpServer::stopIoUring() {
+    for (auto& loop : uring_loops_) {
+        loop->stop();
+    }
+    uring_loops_.clear();
+}
+
+}  // namespace network
+}  // namespace trading
+
+#else
+
+namespace trading {
+namespace network {
+
+class HttpServer::IoUringLoop {};
+
+void HttpServer::IoUringLoopDeleter::operator()(IoUringLoop* loop) const {
+    delete loop;
+}
+
+bool HttpServer::ioUringSupported() {
+    return false;
+}
+
+bool HttpServer::startIoUring() {
+    return false;
+}
+
+void HttpServer::stopIoUring() {
+}
+
+}  // namespace network
+}  // namespace trading
+
+#endif
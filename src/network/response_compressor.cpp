@@ -0,0 +1,276 @@
+#include "trading/network/response_compressor.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+
+#if defined(TRADING_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(TRADING_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace trading {
+namespace network {
+
+namespace {
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) ==
+                      std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+// One worker thread's encoder state, created on first use and kept until the thread exits
+struct ThreadCompressors {
+#if defined(TRADING_HAVE_ZLIB)
+    z_stream deflate{};
+    bool deflate_ready = false;
+    int deflate_level = 0;
+#endif
+#if defined(TRADING_HAVE_ZSTD)
+    ZSTD_CCtx* zstd = nullptr;
+#endif
+
+    ThreadCompressors() = default;
+    ThreadCompressors(const ThreadCompressors&) = delete;
+    ThreadCompressors& operator=(const ThreadCompressors&) = delete;
+
+    ~ThreadCompressors() {
+#if defined(TRADING_HAVE_ZLIB)
+        if (deflate_ready) {
+            deflateEnd(&deflate);
+        }
+#endif
+#if defined(TRADING_HAVE_ZSTD)
+        ZSTD_freeCCtx(zstd);
+#endif
+    }
+};
+
+ThreadCompressors& threadCompressors() {
+    thread_local ThreadCompressors compressors;
+    return compressors;
+}
+
+#if defined(TRADING_HAVE_ZLIB)
+bool gzipCompress(int level, std::string_view body, std::string& out) {
+    ThreadCompressors& compressors = threadCompressors();
+    z_stream& stream = compressors.deflate;
+    if (compressors.deflate_ready && compressors.deflate_level != level) {
+        deflateEnd(&stream);
+        compressors.deflate_ready = false;
+    }
+    if (!compressors.deflate_ready) {
+        stream = z_stream{};
+        // 15 window bits plus 16 selects the gzip wrapper rather than zlib's
+        if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        compressors.deflate_ready = true;
+        compressors.deflate_level = level;
+    }
+
+    out.resize(deflateBound(&stream, static_cast<uLong>(body.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+    stream.avail_in = static_cast<uInt>(body.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    const bool finished = deflate(&stream, Z_FINISH) == Z_STREAM_END;
+    out.resize(stream.total_out);
+    deflateReset(&stream);
+    return finished;
+}
+#endif
+
+#if defined(TRADING_HAVE_ZSTD)
+bool zstdCompress(int level, std::string_view body, std::string& out) {
+    ThreadCompressors& compressors = threadCompressors();
+    if (!compressors.zstd) {
+        compressors.zstd = ZSTD_createCCtx();
+        if (!compressors.zstd) {
+            return false;
+        }
+    }
+    out.resize(ZSTD_compressBound(body.size()));
+    const size_t written = ZSTD_compressCCtx(compressors.zstd, out.data(), out.size(),
+                                             body.data(), body.size(), level);
+    if (ZSTD_isError(written)) {
+        out.clear();
+        return false;
+    }
+    out.resize(written);
+    return true;
+}
+#endif
+}  // namespace
+
+bool contentEncodingSupported(ContentEncoding encoding) {
+    switch (encoding) {
+        case ContentEncoding::IDENTITY:
+            return true;
+        case ContentEncoding::GZIP:
+#if defined(TRADING_HAVE_ZLIB)
+            return true;
+#else
+            return false;
+#endif
+        case ContentEncoding::ZSTD:
+#if defined(TRADING_HAVE_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+ContentEncoding negotiateContentEncoding(std::string_view accept_encoding) {
+    double gzip_q = -1.0;  // -1 until the header mentions the coding
+    double zstd_q = -1.0;
+    double wildcard_q = -1.0;
+    while (!accept_encoding.empty()) {
+        const size_t comma = accept_encoding.find(',');
+        std::string_view item = accept_encoding.substr(0, comma);
+        accept_encoding = comma == std::string_view::npos ? std::string_view()
+                                                          : accept_encoding.substr(comma + 1);
+
+        // coding [ ";" "q=" qvalue ]
+        const size_t semicolon = item.find(';');
+        const std::string_view coding = trim(item.substr(0, semicolon));
+        double q = 1.0;
+        if (semicolon != std::string_view::npos) {
+            const std::string_view param = trim(item.substr(semicolon + 1));
+            if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+                q = std::strtod(std::string(param.substr(2)).c_str(), nullptr);
+            }
+        }
+        if (equalsIgnoreCase(coding, "gzip") || equalsIgnoreCase(coding, "x-gzip")) {
+            gzip_q = q;
+        } else if (equalsIgnoreCase(coding, "zstd")) {
+            zstd_q = q;
+        } else if (coding == "*") {
+            wildcard_q = q;
+        }
+    }
+    // Codings not listed by name are covered by the wildcard, if any
+    if (gzip_q < 0.0) {
+        gzip_q = wildcard_q;
+    }
+    if (zstd_q < 0.0) {
+        zstd_q = wildcard_q;
+    }
+    if (!contentEncodingSupported(ContentEncoding::GZIP)) {
+        gzip_q = 0.0;
+    }
+    if (!contentEncodingSupported(ContentEncoding::ZSTD)) {
+        zstd_q = 0.0;
+    }
+
+    if (zstd_q > 0.0 && zstd_q >= gzip_q) {
+        return ContentEncoding::ZSTD;
+    }
+    if (gzip_q > 0.0) {
+        return ContentEncoding::GZIP;
+    }
+    return ContentEncoding::IDENTITY;
+}
+
+const char* contentEncodingToken(ContentEncoding encoding) {
+    switch (encoding) {
+        case ContentEncoding::GZIP:
+            return "gzip";
+        case ContentEncoding::ZSTD:
+            return "zstd";
+        case ContentEncoding::IDENTITY:
+        default:
+            return "identity";
+    }
+}
+
+ResponseCompressor::ResponseCompressor() : ResponseCompressor(Config()) {}
+
+ResponseCompressor::ResponseCompressor(const Config& config) : config_(config) {
+    if (config_.cache_slots > 0) {
+        cache_ = std::make_unique<CacheSlot[]>(config_.cache_slots);
+    }
+}
+
+ResponseCompressor::~ResponseCompressor() = default;
+
+bool ResponseCompressor::compress(ContentEncoding encoding, std::string_view body,
+                                  std::string& out) {
+    bool compressed = false;
+    switch (encoding) {
+        case ContentEncoding::GZIP:
+#if defined(TRADING_HAVE_ZLIB)
+            compressed = gzipCompress(config_.gzip_level, body, out);
+#endif
+            break;
+        case ContentEncoding::ZSTD:
+#if defined(TRADING_HAVE_ZSTD)
+            compressed = zstdCompress(config_.zstd_level, body, out);
+#endif
+            break;
+        case ContentEncoding::IDENTITY:
+            break;
+    }
+    if (compressed) {
+        compressed_.fetch_add(1, std::memory_order_relaxed);
+        recordSent(body.size(), out.size());
+    }
+    return compressed;
+}
+
+std::shared_ptr<const std::string> ResponseCompressor::compressCached(
+    ContentEncoding encoding, const std::string& cache_key, std::string_view body) {
+    CacheSlot* slot = nullptr;
+    if (cache_) {
+        slot = &cache_[std::hash<std::string>{}(cache_key) % config_.cache_slots];
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if (slot->body && slot->key == cache_key) {
+            cache_hits_.fetch_add(1, std::memory_order_relaxed);
+            recordSent(body.size(), slot->body->size());
+            return slot->body;
+        }
+    }
+
+    // Compressed outside the slot lock; concurrent misses on one key each compress once
+    auto compressed = std::make_shared<std::string>();
+    if (!compress(encoding, body, *compressed)) {
+        return nullptr;
+    }
+    if (slot) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->key = cache_key;
+        slot->body = compressed;
+    }
+    return compressed;
+}
+
+void ResponseCompressor::recordSent(size_t bytes_in, size_t bytes_out) {
+    bytes_in_.fetch_add(bytes_in, std::memory_order_relaxed);
+    bytes_out_.fetch_add(bytes_out, std::memory_order_relaxed);
+}
+
+ResponseCompressor::Metrics ResponseCompressor::getMetrics() const {
+    return Metrics{compressed_.load(std::memory_order_relaxed),
+                   cache_hits_.load(std::memory_order_relaxed),
+                   bytes_in_.load(std::memory_order_relaxed),
+                   bytes_out_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace network
+}  // namespace trading
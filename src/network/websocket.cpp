@@ -0,0 +1,218 @@
+#include "trading/network/websocket.hpp"
+
+#include <cstring>
+
+namespace trading {
+namespace network {
+namespace websocket {
+
+namespace {
+constexpr std::string_view kHandshakeGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+constexpr size_t kMaxControlPayload = 125;
+
+uint32_t rotateLeft(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+bool isControl(Opcode opcode) {
+    return static_cast<uint8_t>(opcode) >= 0x8;
+}
+
+bool isKnown(uint8_t opcode) {
+    return opcode <= 0x2 || (opcode >= 0x8 && opcode <= 0xA);
+}
+}  // namespace
+
+std::array<uint8_t, 20> sha1(std::string_view data) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+    // Message padded with 0x80, zeros and the 64-bit big-endian bit length to a 64-byte multiple
+    std::string message(data);
+    const uint64_t bit_length = static_cast<uint64_t>(data.size()) * 8;
+    message.push_back(static_cast<char>(0x80));
+    while (message.size() % 64 != 56) {
+        message.push_back('\0');
+    }
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        message.push_back(static_cast<char>((bit_length >> shift) & 0xFF));
+    }
+
+    for (size_t chunk = 0; chunk < message.size(); chunk += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const auto* p = reinterpret_cast<const uint8_t*>(message.data() + chunk + i * 4);
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f;
+            uint32_t k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            const uint32_t temp = rotateLeft(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    std::array<uint8_t, 20> digest;
+    for (int i = 0; i < 5; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(h[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+    }
+    return digest;
+}
+
+std::string base64Encode(const uint8_t* data, size_t size) {
+    static constexpr char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string encoded;
+    encoded.reserve((size + 2) / 3 * 4);
+    for (size_t i = 0; i < size; i += 3) {
+        const uint32_t triple = (uint32_t(data[i]) << 16) |
+                                (i + 1 < size ? uint32_t(data[i + 1]) << 8 : 0) |
+                                (i + 2 < size ? uint32_t(data[i + 2]) : 0);
+        encoded.push_back(kAlphabet[(triple >> 18) & 0x3F]);
+        encoded.push_back(kAlphabet[(triple >> 12) & 0x3F]);
+        encoded.push_back(i + 1 < size ? kAlphabet[(triple >> 6) & 0x3F] : '=');
+        encoded.push_back(i + 2 < size ? kAlphabet[triple & 0x3F] : '=');
+    }
+    return encoded;
+}
+
+std::string acceptKey(std::string_view client_key) {
+    std::string input(client_key);
+    input.append(kHandshakeGuid);
+    const auto digest = sha1(input);
+    return base64Encode(digest.data(), digest.size());
+}
+
+std::string encodeFrame(Opcode opcode, std::string_view payload) {
+    std::string frame;
+    frame.reserve(payload.size() + 10);
+    frame.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));  // FIN
+
+    const uint64_t size = payload.size();
+    if (size < 126) {
+        frame.push_back(static_cast<char>(size));
+    } else if (size <= 0xFFFF) {
+        frame.push_back(static_cast<char>(126));
+        frame.push_back(static_cast<char>(size >> 8));
+        frame.push_back(static_cast<char>(size & 0xFF));
+    } else {
+        frame.push_back(static_cast<char>(127));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame.push_back(static_cast<char>((size >> shift) & 0xFF));
+        }
+    }
+    frame.append(payload);
+    return frame;
+}
+
+FrameParser::Result FrameParser::next(Opcode& opcode, std::string& payload) {
+    for (;;) {
+        if (buffer_.size() < 2) {
+            return Result::NEED_MORE;
+        }
+        const auto* bytes = reinterpret_cast<const uint8_t*>(buffer_.data());
+        const bool fin = bytes[0] & 0x80;
+        const uint8_t raw_opcode = bytes[0] & 0x0F;
+        // Clients must mask, and no extensions are negotiated so RSV bits must be clear
+        if ((bytes[0] & 0x70) || !(bytes[1] & 0x80) || !isKnown(raw_opcode)) {
+            return Result::ERROR;
+        }
+
+        size_t header = 2;
+        uint64_t length = bytes[1] & 0x7F;
+        if (length == 126) {
+            header += 2;
+            if (buffer_.size() < header) {
+                return Result::NEED_MORE;
+            }
+            length = (uint64_t(bytes[2]) << 8) | bytes[3];
+        } else if (length == 127) {
+            header += 8;
+            if (buffer_.size() < header) {
+                return Result::NEED_MORE;
+            }
+            length = 0;
+            for (int i = 0; i < 8; ++i) {
+                length = (length << 8) | bytes[2 + i];
+            }
+        }
+        const Opcode frame_opcode = static_cast<Opcode>(raw_opcode);
+        if (length > max_message_size_ ||
+            (isControl(frame_opcode) && (!fin || length > kMaxControlPayload))) {
+            return Result::ERROR;
+        }
+
+        const size_t mask_offset = header;
+        header += 4;
+        if (buffer_.size() < header + length) {
+            return Result::NEED_MORE;
+        }
+
+        std::string data = buffer_.substr(header, length);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] ^= buffer_[mask_offset + (i & 3)];
+        }
+        buffer_.erase(0, header + length);
+
+        if (isControl(frame_opcode)) {
+            opcode = frame_opcode;
+            payload = std::move(data);
+            return Result::MESSAGE;
+        }
+
+        if (frame_opcode == Opcode::CONTINUATION) {
+            if (!in_fragmented_message_ || fragments_.size() + data.size() > max_message_size_) {
+                return Result::ERROR;
+            }
+            fragments_.append(data);
+        } else {
+            if (in_fragmented_message_) {
+                return Result::ERROR;
+            }
+            fragments_opcode_ = frame_opcode;
+            fragments_ = std::move(data);
+        }
+
+        in_fragmented_message_ = !fin;
+        if (fin) {
+            opcode = fragments_opcode_;
+            payload = std::move(fragments_);
+            fragments_.clear();
+            return Result::MESSAGE;
+        }
+    }
+}
+
+}  // namespace websocket
+}  // namespace network
+}  // namespace trading
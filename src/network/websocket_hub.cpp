@@ -0,0 +1,530 @@
+#include "trading/network/websocket_hub.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
+#include "../../apps/json.hpp"
+#include "trading/network/websocket.hpp"
+
+using json = nlohmann::json;
+
+namespace trading {
+namespace network {
+
+struct WebSocketHub::Connection {
+    Connection(int socket_fd, size_t max_message_size)
+        : fd(socket_fd), parser(max_message_size) {
+    }
+
+    int fd;
+    websocket::FrameParser parser;  // I/O thread only
+    std::unordered_set<std::string> channels;
+    std::deque<Frame> queue;
+    size_t front_offset = 0;  // Bytes of queue.front() already written
+    std::unordered_map<std::string, Frame> conflated;
+    size_t backlog_bytes = 0;  // Queued plus conflated frame bytes
+    bool dirty = false;
+    bool want_write = false;  // EPOLLOUT registered
+    bool closing = false;     // Fell too far behind; dropped without flushing
+    bool close_after_flush = false;
+};
+
+namespace {
+constexpr int kMaxEvents = 64;
+constexpr int kPollTimeoutMs = 100;
+constexpr size_t kMaxIov = 64;
+constexpr uint16_t kCloseProtocolError = 1002;
+
+using Frame = std::shared_ptr<const std::string>;
+
+Frame makeFrame(websocket::Opcode opcode, std::string_view payload) {
+    return std::make_shared<const std::string>(websocket::encodeFrame(opcode, payload));
+}
+
+Frame makeTextFrame(std::string_view payload) {
+    return makeFrame(websocket::Opcode::TEXT, payload);
+}
+
+Frame makeCloseFrame(uint16_t code) {
+    const char payload[2] = {static_cast<char>(code >> 8), static_cast<char>(code & 0xFF)};
+    return makeFrame(websocket::Opcode::CLOSE, std::string_view(payload, sizeof(payload)));
+}
+
+std::string envelope(std::string_view type, const std::string& channel, std::string_view data) {
+    const std::string quoted_channel = json(channel).dump();
+    std::string message;
+    message.reserve(type.size() + quoted_channel.size() + data.size() + 32);
+    message.append("{\"type\":\"").append(type).append("\",\"channel\":");
+    message.append(quoted_channel).append(",\"data\":").append(data).append("}");
+    return message;
+}
+
+Frame controlFrame(std::string_view type, const std::string& channel) {
+    return makeTextFrame(json{{"type", type}, {"channel", channel}}.dump());
+}
+
+Frame errorFrame(const std::string& message) {
+    return makeTextFrame(json{{"type", "error"}, {"message", message}}.dump());
+}
+}  // namespace
+
+WebSocketHub::WebSocketHub() : WebSocketHub(Config()) {
+}
+
+WebSocketHub::WebSocketHub(const Config& config) : config_(config) {
+}
+
+WebSocketHub::~WebSocketHub() {
+    stop();
+}
+
+void WebSocketHub::setChannelFilter(ChannelFilter filter) {
+    channel_filter_ = std::move(filter);
+}
+
+void WebSocketHub::setSnapshotProvider(SnapshotProvider provider) {
+    snapshot_provider_ = std::move(provider);
+}
+
+bool WebSocketHub::start() {
+    if (running_) {
+        return true;
+    }
+
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        stop();
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wake_fd_;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) < 0) {
+        stop();
+        return false;
+    }
+
+    stop_flag_ = false;
+    running_ = true;
+    io_thread_ = std::thread([this]() { run(); });
+    return true;
+}
+
+void WebSocketHub::stop() {
+    stop_flag_ = true;
+    if (io_thread_.joinable()) {
+        wake();
+        io_thread_.join();
+    }
+    running_ = false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [fd, connection] : connections_) {
+        ::close(fd);
+    }
+    connections_.clear();
+    channels_.clear();
+    dirty_.clear();
+    subscription_count_ = 0;
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+}
+
+bool WebSocketHub::adopt(int fd) {
+    if (!running_) {
+        ::close(fd);
+        return false;
+    }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (connections_.size() >= config_.max_connections) {
+        ::close(fd);
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = fd;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        ::close(fd);
+        return false;
+    }
+    connections_.emplace(fd, std::make_unique<Connection>(fd, config_.max_message_size));
+    return true;
+}
+
+void WebSocketHub::publish(const std::string& channel, std::string_view payload,
+                           std::string_view conflation_key) {
+    if (subscription_count_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = channels_.find(channel);
+        if (it == channels_.end()) {
+            return;
+        }
+        // Encoded once; every subscriber's queue references the same buffer
+        const Frame frame = makeTextFrame(envelope("update", channel, payload));
+        for (Connection* connection : it->second) {
+            queued |= enqueue(*connection, frame, conflation_key);
+        }
+    }
+    published_.fetch_add(1, std::memory_order_relaxed);
+    if (queued) {
+        wake();
+    }
+}
+
+bool WebSocketHub::hasSubscribers(const std::string& channel) const {
+    if (subscription_count_.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return channels_.contains(channel);
+}
+
+WebSocketHub::Metrics WebSocketHub::getMetrics() const {
+    Metrics metrics;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        metrics.connections = connections_.size();
+    }
+    metrics.published = published_.load(std::memory_order_relaxed);
+    metrics.conflated = conflated_.load(std::memory_order_relaxed);
+    metrics.slow_disconnects = slow_disconnects_.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+void WebSocketHub::wake() {
+    const uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+}
+
+void WebSocketHub::run() {
+    epoll_event events[kMaxEvents];
+    while (!stop_flag_) {
+        const int count = ::epoll_wait(epoll_fd_, events, kMaxEvents, kPollTimeoutMs);
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wake_fd_) {
+                uint64_t value;
+                [[maybe_unused]] ssize_t read_bytes = ::read(wake_fd_, &value, sizeof(value));
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                handleReadable(fd);
+            }
+            if (events[i].events & EPOLLOUT) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = connections_.find(fd);
+                if (it != connections_.end()) {
+                    markDirty(*it->second);
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Connection*> dirty;
+        dirty.swap(dirty_);
+        for (Connection* connection : dirty) {
+            connection->dirty = false;
+            if (connection->closing) {
+                closeConnection(*connection);
+            } else {
+                flush(*connection);
+            }
+        }
+    }
+}
+
+void WebSocketHub::handleReadable(int fd) {
+    Connection* connection;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = connections_.find(fd);
+        if (it == connections_.end()) {
+            return;
+        }
+        // Only this thread destroys connections, so the pointer outlives the lock
+        connection = it->second.get();
+    }
+
+    char buffer[4096];
+    for (;;) {
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            // Parse as we go so a flooding client cannot grow the buffer past one message
+            connection->parser.feed(buffer, static_cast<size_t>(n));
+            if (!processFrames(*connection)) {
+                return;
+            }
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);  // Peer closed or the socket failed
+        closeConnection(*connection);
+        return;
+    }
+}
+
+bool WebSocketHub::processFrames(Connection& connection) {
+    websocket::Opcode opcode;
+    std::string payload;
+    while (!connection.close_after_flush) {
+        const auto result = connection.parser.next(opcode, payload);
+        if (result == websocket::FrameParser::Result::NEED_MORE) {
+            return true;
+        }
+        if (result == websocket::FrameParser::Result::ERROR) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            enqueue(connection, makeCloseFrame(kCloseProtocolError), {});
+            connection.close_after_flush = true;
+            break;
+        }
+
+        switch (opcode) {
+            case websocket::Opcode::TEXT:
+                handleMessage(connection, payload);
+                break;
+            case websocket::Opcode::PING: {
+                std::lock_guard<std::mutex> lock(mutex_);
+                enqueue(connection, makeFrame(websocket::Opcode::PONG, payload), {});
+                break;
+            }
+            case websocket::Opcode::CLOSE: {
+                // Echo the close and hang up once it is written
+                std::lock_guard<std::mutex> lock(mutex_);
+                enqueue(connection, makeFrame(websocket::Opcode::CLOSE, payload), {});
+                connection.close_after_flush = true;
+                break;
+            }
+            case websocket::Opcode::BINARY: {
+                std::lock_guard<std::mutex> lock(mutex_);
+                enqueue(connection, errorFrame("Binary messages are not supported"), {});
+                break;
+            }
+            default:
+                break;  // Unsolicited pongs
+        }
+    }
+    return false;  // Closing; anything further from this client is ignored
+}
+
+void WebSocketHub::handleMessage(Connection& connection, const std::string& text) {
+    const json message = json::parse(text, nullptr, false);
+    if (message.is_discarded() || !message.is_object() || !message.contains("op") ||
+        !message["op"].is_string() || !message.contains("channel") ||
+        !message["channel"].is_string()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enqueue(connection, errorFrame("Expected {\"op\": ..., \"channel\": ...}"), {});
+        return;
+    }
+
+    const std::string op = message["op"];
+    const std::string channel = message["channel"];
+    if (op == "subscribe") {
+        subscribe(connection, channel);
+    } else if (op == "unsubscribe") {
+        unsubscribe(connection, channel);
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enqueue(connection, errorFrame("Unknown op: " + op), {});
+    }
+}
+
+void WebSocketHub::subscribe(Connection& connection, const std::string& channel) {
+    if (channel_filter_ && !channel_filter_(channel)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enqueue(connection, errorFrame("Unknown channel: " + channel), {});
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connection.channels.contains(channel)) {
+            if (connection.channels.size() >= config_.max_subscriptions) {
+                enqueue(connection, errorFrame("Too many subscriptions"), {});
+                return;
+            }
+            connection.channels.insert(channel);
+            channels_[channel].push_back(&connection);
+            subscription_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        enqueue(connection, controlFrame("subscribed", channel), {});
+    }
+
+    // Registered first, so an update published while the snapshot is built is not lost; the
+    // provider serializes against its publishers so nothing older lands after the snapshot
+    if (snapshot_provider_) {
+        snapshot_provider_(channel, [this, &connection, &channel](std::string_view payload) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            enqueue(connection, makeTextFrame(envelope("snapshot", channel, payload)), {});
+        });
+    }
+}
+
+void WebSocketHub::unsubscribe(Connection& connection, const std::string& channel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (connection.channels.erase(channel) > 0) {
+        auto it = channels_.find(channel);
+        auto& subscribers = it->second;
+        subscribers.erase(std::find(subscribers.begin(), subscribers.end(), &connection));
+        if (subscribers.empty()) {
+            channels_.erase(it);
+        }
+        subscription_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    enqueue(connection, controlFrame("unsubscribed", channel), {});
+}
+
+bool WebSocketHub::enqueue(Connection& connection, const Frame& frame,
+                           std::string_view conflation_key) {
+    if (connection.closing) {
+        return false;
+    }
+
+    if (!conflation_key.empty() &&
+        (connection.backlog_bytes >= config_.conflate_threshold_bytes ||
+         (!connection.conflated.empty() &&
+          connection.conflated.contains(std::string(conflation_key))))) {
+        auto [it, inserted] = connection.conflated.try_emplace(std::string(conflation_key), frame);
+        if (!inserted) {
+            connection.backlog_bytes -= it->second->size();
+            it->second = frame;
+            conflated_.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else {
+        connection.queue.push_back(frame);
+    }
+    connection.backlog_bytes += frame->size();
+
+    if (connection.backlog_bytes > config_.max_backlog_bytes) {
+        connection.closing = true;
+        slow_disconnects_.fetch_add(1, std::memory_order_relaxed);
+    }
+    markDirty(connection);
+    return true;
+}
+
+void WebSocketHub::markDirty(Connection& connection) {
+    if (!connection.dirty) {
+        connection.dirty = true;
+        dirty_.push_back(&connection);
+    }
+}
+
+void WebSocketHub::flush(Connection& connection) {
+    for (;;) {
+        if (connection.queue.empty()) {
+            if (connection.conflated.empty()) {
+                break;
+            }
+            // Conflated updates go out once everything queued ahead of them has
+            for (auto& [key, frame] : connection.conflated) {
+                connection.queue.push_back(std::move(frame));
+            }
+            connection.conflated.clear();
+        }
+
+        iovec iov[kMaxIov];
+        size_t count = 0;
+        for (auto it = connection.queue.begin(); it != connection.queue.end() && count < kMaxIov;
+             ++it, ++count) {
+            const size_t offset = count == 0 ? connection.front_offset : 0;
+            iov[count].iov_base = const_cast<char*>((*it)->data() + offset);
+            iov[count].iov_len = (*it)->size() - offset;
+        }
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = count;
+        ssize_t written = ::sendmsg(connection.fd, &message, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (!connection.want_write) {
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLRDHUP | EPOLLOUT;
+                    event.data.fd = connection.fd;
+                    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event);
+                    connection.want_write = true;
+                }
+                return;
+            }
+            closeConnection(connection);
+            return;
+        }
+
+        while (written > 0) {
+            const size_t frame_size = connection.queue.front()->size();
+            const size_t remaining = frame_size - connection.front_offset;
+            if (static_cast<size_t>(written) < remaining) {
+                connection.front_offset += static_cast<size_t>(written);
+                break;
+            }
+            written -= static_cast<ssize_t>(remaining);
+            connection.backlog_bytes -= frame_size;
+            connection.front_offset = 0;
+            connection.queue.pop_front();
+        }
+    }
+
+    if (connection.want_write) {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = connection.fd;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.want_write = false;
+    }
+    if (connection.close_after_flush) {
+        closeConnection(connection);
+    }
+}
+
+void WebSocketHub::closeConnection(Connection& connection) {
+    const int fd = connection.fd;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+
+    for (const auto& channel : connection.channels) {
+        auto it = channels_.find(channel);
+        auto& subscribers = it->second;
+        subscribers.erase(std::find(subscribers.begin(), subscribers.end(), &connection));
+        if (subscribers.empty()) {
+            channels_.erase(it);
+        }
+    }
+    subscription_count_.fetch_sub(connection.channels.size(), std::memory_order_relaxed);
+    if (connection.dirty) {
+        dirty_.erase(std::find(dirty_.begin(), dirty_.end(), &connection));
+    }
+    connections_.erase(fd);
+}
+
+}  // namespace network
+}  // namespace trading
@@ -149,6 +149,7 @@ void StatisticsCollector::collectorLoop() {
 
 void StatisticsCollector::processTradeEvent(const TradeEvent& event) {
     updateStatistics(event.symbol, event.price, event.quantity, event.timestamp);
+    version_.bump();
 }
 
 void StatisticsCollector::updateStatistics(const std::string& symbol, double price, double quantity,
@@ -306,10 +307,12 @@ void StatisticsCollector::cleanupOldStats() {
 }
 
 TradeEvent StatisticsCollector::tradeToEvent(const core::Trade& trade) const {
-    // Convert Unix timestamp (uint64_t) to chrono time_point
-    auto timestamp = std::chrono::system_clock::from_time_t(static_cast<time_t>(trade.timestamp));
+    // Convert nanoseconds since the epoch to chrono time_point
+    auto timestamp = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(trade.timestamp_ns)));
 
-    return TradeEvent(trade.symbol, trade.price, trade.quantity, timestamp);
+    return TradeEvent(core::symbolName(trade.symbol), trade.price, trade.quantity, timestamp);
 }
 
 }  // namespace statistics
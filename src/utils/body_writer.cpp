@@ -0,0 +1,334 @@
+#include "trading/utils/body_writer.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace trading::utils {
+
+namespace {
+// CBOR major types
+constexpr uint8_t kCborUnsigned = 0;
+constexpr uint8_t kCborNegative = 1;
+constexpr uint8_t kCborText = 3;
+constexpr uint8_t kCborArray = 4;
+constexpr uint8_t kCborMap = 5;
+
+template <typename Integer>
+void appendInteger(std::string& out, Integer number) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out.append(buffer, result.ptr);
+}
+
+// Index of the first byte at or after from that JSON requires escaping: '"', '\\' or a control
+// character. text.size() if there is none.
+size_t nextJsonEscape(std::string_view text, size_t from) {
+    size_t i = from;
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i last_control = _mm_set1_epi8(0x1f);
+    for (; i + 16 <= text.size(); i += 16) {
+        const __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        // Unsigned byte <= 0x1f exactly when min(byte, 0x1f) == byte
+        const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, last_control), chunk);
+        const __m128i special = _mm_or_si128(
+            control, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+        const int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#endif
+    for (; i < text.size(); ++i) {
+        const auto byte = static_cast<unsigned char>(text[i]);
+        if (byte < 0x20 || byte == '"' || byte == '\\') {
+            return i;
+        }
+    }
+    return text.size();
+}
+}  // namespace
+
+BodyWriter::BodyWriter(BodyFormat format, size_t reserve) : format_(format), out_(&owned_) {
+    owned_.reserve(reserve);
+}
+
+BodyWriter::BodyWriter(BodyFormat format, std::string& buffer) : format_(format), out_(&buffer) {
+    buffer.clear();
+}
+
+BodyWriter& BodyWriter::close(char bracket) {
+    if (format_ == BodyFormat::JSON) {
+        out_->push_back(bracket);
+        need_comma_ = true;
+    }
+    return *this;
+}
+
+void BodyWriter::jsonString(std::string_view text) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    out_->push_back('"');
+    size_t clean = 0;  // Start of the run not yet copied
+    for (size_t i = nextJsonEscape(text, 0); i < text.size(); i = nextJsonEscape(text, clean)) {
+        out_->append(text.substr(clean, i - clean));
+        const auto byte = static_cast<unsigned char>(text[i]);
+        switch (byte) {
+            case '"':
+                out_->append("\\\"");
+                break;
+            case '\\':
+                out_->append("\\\\");
+                break;
+            case '\b':
+                out_->append("\\b");
+                break;
+            case '\f':
+                out_->append("\\f");
+                break;
+            case '\n':
+                out_->append("\\n");
+                break;
+            case '\r':
+                out_->append("\\r");
+                break;
+            case '\t':
+                out_->append("\\t");
+                break;
+            default: {
+                const char escaped[] = {'\\', 'u', '0', '0', kHex[byte >> 4], kHex[byte & 0xF]};
+                out_->append(escaped, sizeof(escaped));
+            }
+        }
+        clean = i + 1;
+    }
+    out_->append(text.substr(clean));
+    out_->push_back('"');
+}
+
+void BodyWriter::putBigEndian(uint64_t value, int bytes) {
+    for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+        out_->push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+// Major type in the top three bits; the argument inline below 24, else in 1, 2, 4 or 8 bytes
+void BodyWriter::cborHead(uint8_t major, uint64_t argument) {
+    const uint8_t type = static_cast<uint8_t>(major << 5);
+    if (argument < 24) {
+        out_->push_back(static_cast<char>(type | argument));
+    } else if (argument <= 0xFF) {
+        out_->push_back(static_cast<char>(type | 24));
+        putBigEndian(argument, 1);
+    } else if (argument <= 0xFFFF) {
+        out_->push_back(static_cast<char>(type | 25));
+        putBigEndian(argument, 2);
+    } else if (argument <= 0xFFFFFFFF) {
+        out_->push_back(static_cast<char>(type | 26));
+        putBigEndian(argument, 4);
+    } else {
+        out_->push_back(static_cast<char>(type | 27));
+        putBigEndian(argument, 8);
+    }
+}
+
+// Maps and arrays: a fix form carrying the size in its low bits, else a 16- or 32-bit size
+void BodyWriter::msgpackSized(uint8_t fix_base, size_t fix_limit, uint8_t size16, size_t size) {
+    if (size < fix_limit) {
+        out_->push_back(static_cast<char>(fix_base | size));
+    } else if (size <= 0xFFFF) {
+        out_->push_back(static_cast<char>(size16));
+        putBigEndian(size, 2);
+    } else {
+        out_->push_back(static_cast<char>(size16 + 1));
+        putBigEndian(size, 4);
+    }
+}
+
+BodyWriter& BodyWriter::beginMap(size_t entries) {
+    if (format_ == BodyFormat::JSON) {
+        jsonSeparator();
+        out_->push_back('{');
+        need_comma_ = false;
+    } else if (format_ == BodyFormat::CBOR) {
+        cborHead(kCborMap, entries);
+    } else {
+        msgpackSized(0x80, 16, 0xde, entries);
+    }
+    return *this;
+}
+
+BodyWriter& BodyWriter::beginArray(size_t items) {
+    if (format_ == BodyFormat::JSON) {
+        jsonSeparator();
+        out_->push_back('[');
+        need_comma_ = false;
+    } else if (format_ == BodyFormat::CBOR) {
+        cborHead(kCborArray, items);
+    } else {
+        msgpackSized(0x90, 16, 0xdc, items);
+    }
+    return *this;
+}
+
+BodyWriter& BodyWriter::key(std::string_view name) {
+    if (format_ != BodyFormat::JSON) {
+        return value(name);
+    }
+    jsonSeparator();
+    jsonString(name);
+    out_->push_back(':');
+    need_comma_ = false;
+    return *this;
+}
+
+BodyWriter& BodyWriter::value(std::string_view text) {
+    if (format_ == BodyFormat::JSON) {
+        jsonSeparator();
+        jsonString(text);
+        need_comma_ = true;
+        return *this;
+    }
+    if (format_ == BodyFormat::CBOR) {
+        cborHead(kCborText, text.size());
+    } else if (text.size() < 32) {
+        out_->push_back(static_cast<char>(0xa0 | text.size()));
+    } else if (text.size() <= 0xFF) {
+        out_->push_back(static_cast<char>(0xd9));
+        putBigEndian(text.size(), 1);
+    } else {
+        msgpackSized(0, 0, 0xda, text.size());
+    }
+    out_->append(text);
+    return *this;
+}
+
+BodyWriter& BodyWriter::value(double number) {
+    if (format_ == BodyFormat::JSON) {
+        jsonSeparator();
+        need_comma_ = true;
+        if (!std::isfinite(number)) {
+            out_->append("null");
+            return *this;
+        }
+        char buffer[32];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        const std::string_view digits(buffer, static_cast<size_t>(result.ptr - buffer));
+        out_->append(digits);
+        if (digits.find_first_of(".e") == std::string_view::npos) {
+            out_->append(".0");  // Still reads back as a floating-point number
+        }
+        return *this;
+    }
+    // Most prices and sizes survive a round trip through float; those take half the bytes
+    const float narrow = static_cast<float>(number);
+    if (static_cast<double>(narrow) == number) {
+        uint32_t bits;
+        std::memcpy(&bits, &narrow, sizeof(bits));
+        out_->push_back(static_cast<char>(format_ == BodyFormat::CBOR ? 0xfa : 0xca));
+        putBigEndian(bits, 4);
+        return *this;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+    out_->push_back(static_cast<char>(format_ == BodyFormat::CBOR ? 0xfb : 0xcb));
+    putBigEndian(bits, 8);
+    return *this;
+}
+
+BodyWriter& BodyWriter::value(uint64_t number) {
+    if (format_ == BodyFormat::JSON) {
+        jsonSeparator();
+        need_comma_ = true;
+        appendInteger(*out_, number);
+        return *this;
+    }
+    if (format_ == BodyFormat::CBOR) {
+        cborHead(kCborUnsigned, number);
+    } else if (number < 0x80) {
+        out_->push_back(static_cast<char>(number));
+    } else if (number <= 0xFF) {
+        out_->push_back(static_cast<char>(0xcc));
+        putBigEndian(number, 1);
+    } else if (number <= 0xFFFF) {
+        out_->push_back(static_cast<char>(0xcd));
+        putBigEndian(number, 2);
+    } else if (number <= 0xFFFFFFFF) {
+        out_->push_back(static_cast<char>(0xce));
+        putBigEndian(number, 4);
+    } else {
+        out_->push_back(static_cast<char>(0xcf));
+        putBigEndian(number, 8);
+    }
+    return *this;
+}
+
+BodyWriter& BodyWriter::value(int64_t number) {
+    if (number >= 0) {
+        return value(static_cast<uint64_t>(number));
+    }
+    if (format_ == BodyFormat::JSON) {
+        jsonSeparator();
+        need_comma_ = true;
+        appendInteger(*out_, number);
+        return *this;
+    }
+    if (format_ == BodyFormat::CBOR) {
+        // Negative n is encoded as -1 - n
+        cborHead(kCborNegative, static_cast<uint64_t>(-(number + 1)));
+    } else if (number >= -32) {
+        out_->push_back(static_cast<char>(number));  // Negative fixint
+    } else if (number >= INT8_MIN) {
+        out_->push_back(static_cast<char>(0xd0));
+        putBigEndian(static_cast<uint64_t>(number), 1);
+    } else if (number >= INT16_MIN) {
+        out_->push_back(static_cast<char>(0xd1));
+        putBigEndian(static_cast<uint64_t>(number), 2);
+    } else if (number >= INT32_MIN) {
+        out_->push_back(static_cast<char>(0xd2));
+        putBigEndian(static_cast<uint64_t>(number), 4);
+    } else {
+        out_->push_back(static_cast<char>(0xd3));
+        putBigEndian(static_cast<uint64_t>(number), 8);
+    }
+    return *this;
+}
+
+BodyWriter& BodyWriter::value(bool flag) {
+    if (format_ == BodyFormat::JSON) {
+        jsonSeparator();
+        need_comma_ = true;
+        out_->append(flag ? "true" : "false");
+    } else if (format_ == BodyFormat::CBOR) {
+        out_->push_back(static_cast<char>(flag ? 0xf5 : 0xf4));
+    } else {
+        out_->push_back(static_cast<char>(flag ? 0xc3 : 0xc2));
+    }
+    return *this;
+}
+
+BodyWriter& BodyWriter::null() {
+    if (format_ == BodyFormat::JSON) {
+        jsonSeparator();
+        need_comma_ = true;
+        out_->append("null");
+    } else {
+        out_->push_back(static_cast<char>(format_ == BodyFormat::CBOR ? 0xf6 : 0xc0));
+    }
+    return *this;
+}
+
+std::string BodyWriter::take() {
+    std::string body = out_ == &owned_ ? std::move(owned_) : *out_;
+    out_->clear();
+    need_comma_ = false;
+    return body;
+}
+
+}  // namespace trading::utils
@@ -0,0 +1,252 @@
+#include "trading/utils/clock.hpp"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define TRADING_HAS_CYCLE_COUNTER 1
+#elif defined(__aarch64__)
+#define TRADING_HAS_CYCLE_COUNTER 1
+#endif
+
+namespace trading::utils {
+
+namespace {
+
+int64_t systemNanos() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+uint64_t readCycleCounter() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return 0;
+#endif
+}
+
+// Only a counter that ticks at a constant rate through frequency and power-state changes can
+// be extrapolated from a calibration. The AArch64 generic timer always does; on x86 that is
+// the invariant TSC, which hypervisors and older parts may not provide.
+bool hasInvariantCounter() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    // Advanced power management leaf: EDX bit 8 is the invariant TSC flag
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#elif defined(TRADING_HAS_CYCLE_COUNTER)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Sample the counter and the wall clock (reference, or system_clock when null) as close
+// together as possible: take the reading whose bracketing counter window is the narrowest.
+void sampleAnchor(const Clock* reference, uint64_t& ticks, int64_t& nanos) noexcept {
+    uint64_t best_window = UINT64_MAX;
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        const uint64_t before = readCycleCounter();
+        const int64_t wall = reference ? reference->nowNanos() : systemNanos();
+        const uint64_t after = readCycleCounter();
+        if (after - before < best_window) {
+            best_window = after - before;
+            ticks = before + (after - before) / 2;
+            nanos = wall;
+        }
+    }
+}
+
+}  // namespace
+
+int64_t SystemClock::nowNanos() const noexcept {
+    return systemNanos();
+}
+
+bool TscClock::isSupported() noexcept {
+    static const bool supported = hasInvariantCounter();
+    return supported;
+}
+
+TscClock::TscClock(std::shared_ptr<Clock> reference) : reference_(std::move(reference)) {
+    if (!isSupported()) {
+        return;
+    }
+
+    // Initial frequency estimate over a short window; later recalibrations refine it
+    uint64_t start_ticks = 0;
+    int64_t start_nanos = 0;
+    sampleAnchor(reference_.get(), start_ticks, start_nanos);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    uint64_t end_ticks = 0;
+    int64_t end_nanos = 0;
+    sampleAnchor(reference_.get(), end_ticks, end_nanos);
+
+    double ns_per_tick = 1.0;
+    if (end_ticks > start_ticks && end_nanos > start_nanos) {
+        ns_per_tick = static_cast<double>(end_nanos - start_nanos) /
+                      static_cast<double>(end_ticks - start_ticks);
+    }
+
+    wall_ticks_ = end_ticks;
+    wall_nanos_ = end_nanos;
+    tick_base_.store(end_ticks, std::memory_order_relaxed);
+    nanos_base_.store(end_nanos, std::memory_order_relaxed);
+    ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+    slewed_ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+}
+
+int64_t TscClock::nowNanos() const noexcept {
+    if (!isSupported()) {
+        return systemNanos();
+    }
+
+    // The counter is read inside the seqlock too, so a reading is never extrapolated from an
+    // anchor that was replaced before it was taken
+    uint64_t seq;
+    uint64_t tick_base;
+    int64_t nanos_base;
+    double ns_per_tick;
+    uint64_t ticks;
+    do {
+        seq = sequence_.load(std::memory_order_acquire);
+        tick_base = tick_base_.load(std::memory_order_relaxed);
+        nanos_base = nanos_base_.load(std::memory_order_relaxed);
+        ns_per_tick = slewed_ns_per_tick_.load(std::memory_order_relaxed);
+        ticks = readCycleCounter();
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1) != 0 || seq != sequence_.load(std::memory_order_relaxed));
+
+    const int64_t delta_ticks = static_cast<int64_t>(ticks - tick_base);
+    return nanos_base + static_cast<int64_t>(static_cast<double>(delta_ticks) * ns_per_tick);
+}
+
+void TscClock::recalibrate() noexcept {
+    if (!isSupported()) {
+        return;
+    }
+
+    // Claim the writer side of the seqlock; if another thread is already re-anchoring, its
+    // result is as good as ours
+    uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    do {
+        if ((seq & 1) != 0) {
+            return;
+        }
+    } while (!sequence_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t ticks = 0;
+    int64_t nanos = 0;
+    sampleAnchor(reference_.get(), ticks, nanos);
+
+    const uint64_t prev_ticks = tick_base_.load(std::memory_order_relaxed);
+    const int64_t prev_nanos = nanos_base_.load(std::memory_order_relaxed);
+    const double prev_slewed = slewed_ns_per_tick_.load(std::memory_order_relaxed);
+    double ns_per_tick = ns_per_tick_.load(std::memory_order_relaxed);
+
+    // Refine the frequency from the span since the last wall sample, ignoring wall-clock steps
+    // (negative spans or rates more than 1% off the current estimate)
+    if (ticks > wall_ticks_ && nanos > wall_nanos_) {
+        const double measured = static_cast<double>(nanos - wall_nanos_) /
+                                static_cast<double>(ticks - wall_ticks_);
+        if (measured > ns_per_tick * 0.99 && measured < ns_per_tick * 1.01) {
+            ns_per_tick = measured;
+        }
+    }
+
+    // The time the current anchor gives for this instant, which readers may already have seen
+    const int64_t current =
+        prev_nanos +
+        static_cast<int64_t>(static_cast<double>(ticks - prev_ticks) * prev_slewed);
+    int64_t nanos_base = nanos;
+    double slewed = ns_per_tick;
+    if (nanos < current) {
+        // Behind: hold the current time and run slow enough to close the gap over about one
+        // more recalibration interval
+        nanos_base = current;
+        const double interval_ns = static_cast<double>(ticks - wall_ticks_) * ns_per_tick;
+        const double gap_ns = static_cast<double>(current - nanos);
+        const double slew =
+            interval_ns > 0.0 ? std::min(kMaxSlew, gap_ns / interval_ns) : kMaxSlew;
+        slewed = ns_per_tick * (1.0 - slew);
+    }
+
+    wall_ticks_ = ticks;
+    wall_nanos_ = nanos;
+    tick_base_.store(ticks, std::memory_order_relaxed);
+    nanos_base_.store(nanos_base, std::memory_order_relaxed);
+    ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+    slewed_ns_per_tick_.store(slewed, std::memory_order_relaxed);
+    sequence_.store(seq + 2, std::memory_order_release);
+}
+
+CoarseClock::CoarseClock(std::shared_ptr<Clock> source, std::chrono::microseconds resolution,
+                         std::chrono::milliseconds recalibrate_interval)
+    : source_(source ? std::move(source) : defaultClock()),
+      resolution_(resolution),
+      recalibrate_interval_(recalibrate_interval) {
+    tick();
+}
+
+CoarseClock::~CoarseClock() {
+    stop();
+}
+
+void CoarseClock::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    tick();
+    ticker_thread_ = std::thread(&CoarseClock::run, this);
+}
+
+void CoarseClock::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (ticker_thread_.joinable()) {
+        ticker_thread_.join();
+    }
+}
+
+void CoarseClock::tick() noexcept {
+    cached_.store(source_->nowNanos(), std::memory_order_release);
+}
+
+void CoarseClock::run() {
+    auto last_recalibration = std::chrono::steady_clock::now();
+    while (running_.load()) {
+        tick();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_recalibration >= recalibrate_interval_) {
+            source_->recalibrate();
+            last_recalibration = now;
+        }
+
+        std::this_thread::sleep_for(resolution_);
+    }
+}
+
+const std::shared_ptr<Clock>& defaultClock() {
+    static const std::shared_ptr<Clock> clock =
+        TscClock::isSupported() ? std::shared_ptr<Clock>(std::make_shared<TscClock>())
+                                : std::shared_ptr<Clock>(std::make_shared<SystemClock>());
+    return clock;
+}
+
+}  // namespace trading::utils
@@ -2,6 +2,8 @@
 #include <fstream>
 #include <sstream>
 
+#include "../../apps/json.hpp"
+
 namespace trading::utils {
 
 Expected<void, ConfigError> Config::loadFromFile(const std::string& config_file) {
@@ -16,7 +18,6 @@ Expected<void, ConfigError> Config::loadFromFile(const std::string& config_file)
 }
 
 Expected<void, ConfigError> Config::loadFromJson(std::string_view json_string) {
-    // TODO: Implement JSON parsing (would use nlohmann/json in real implementation)
     return parseJsonObject(json_string);
 }
 
@@ -154,9 +155,31 @@ Expected<std::string, ConfigError> Config::getValue(std::string_view key) const
 }
 
 Expected<void, ConfigError> Config::parseJsonObject(std::string_view json_string) {
-    // TODO: Implement JSON object parsing with proper error handling
-    (void)json_string;  // Suppress unused parameter warning
-    return {};          // Success for now
+    nlohmann::json object;
+    try {
+        object = nlohmann::json::parse(json_string);
+    } catch (const nlohmann::json::exception&) {
+        return ConfigError::INVALID_JSON;
+    }
+    if (!object.is_object()) {
+        return ConfigError::INVALID_JSON;
+    }
+
+    // Nested objects become sections; arrays are kept as their JSON text
+    for (const auto& [key, value] : object.items()) {
+        if (value.is_object()) {
+            auto section = std::make_shared<Config>();
+            if (auto parsed = section->parseJsonObject(value.dump()); !parsed) {
+                return parsed.error();
+            }
+            sections_[key] = std::move(section);
+        } else if (value.is_string()) {
+            config_data_[key] = value.get<std::string>();
+        } else if (!value.is_null()) {
+            config_data_[key] = value.dump();
+        }
+    }
+    return {};
 }
 
 }  // namespace trading::utils
\ No newline at end of file
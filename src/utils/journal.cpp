@@ -0,0 +1,117 @@
+#include "trading/utils/journal.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+namespace trading::utils {
+
+namespace {
+struct RecordHeader {
+    uint32_t size;
+    uint32_t checksum;
+};
+
+// FNV-1a; enough to detect a torn tail, not meant to detect tampering
+uint32_t checksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+}  // namespace
+
+Journal::Journal(const Config& config) : config_(config) {
+    buffer_.reserve(config_.buffer_size);
+}
+
+Journal::~Journal() {
+    close();
+}
+
+bool Journal::open() {
+    if (fd_ >= 0) {
+        return true;
+    }
+    fd_ = ::open(config_.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    return fd_ >= 0;
+}
+
+void Journal::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    flush();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+bool Journal::append(const void* data, uint32_t size) {
+    if (fd_ < 0 || size > kMaxRecordSize) {
+        return false;
+    }
+
+    const char* bytes = static_cast<const char*>(data);
+    const RecordHeader header{size, checksum(bytes, size)};
+    const char* header_bytes = reinterpret_cast<const char*>(&header);
+    buffer_.insert(buffer_.end(), header_bytes, header_bytes + sizeof(header));
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+    ++record_count_;
+
+    return buffer_.size() < config_.buffer_size || flush();
+}
+
+bool Journal::flush() {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < buffer_.size()) {
+        const ssize_t n = ::write(fd_, buffer_.data() + written, buffer_.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Keep only the unwritten tail so a retry does not append the prefix twice
+            buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<ptrdiff_t>(written));
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    buffer_.clear();
+
+    return !config_.sync_on_flush || ::fdatasync(fd_) == 0;
+}
+
+size_t Journal::replay(const std::string& path,
+                       const std::function<void(std::string_view record)>& handler) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return 0;
+    }
+
+    size_t replayed = 0;
+    std::vector<char> payload;
+    RecordHeader header;
+    while (in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        if (header.size > kMaxRecordSize) {
+            break;
+        }
+        payload.resize(header.size);
+        if (!in.read(payload.data(), header.size) ||
+            checksum(payload.data(), header.size) != header.checksum) {
+            break;
+        }
+        handler(std::string_view(payload.data(), payload.size()));
+        ++replayed;
+    }
+    return replayed;
+}
+
+}  // namespace trading::utils
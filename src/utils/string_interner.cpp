@@ -0,0 +1,33 @@
+#include "trading/utils/string_interner.hpp"
+
+namespace trading::utils {
+
+uint32_t StringInterner::intern(std::string_view value) {
+    {
+        std::shared_lock<std::shared_mutex> lock(index_mutex_);
+        auto it = index_.find(value);
+        if (it != index_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(index_mutex_);
+    auto it = index_.find(value);
+    if (it != index_.end()) {
+        return it->second;  // Another thread interned it in the meantime
+    }
+    const auto id = static_cast<uint32_t>(table_.append(value));
+    index_.emplace(std::string(value), id);
+    return id;
+}
+
+std::optional<uint32_t> StringInterner::find(std::string_view value) const {
+    std::shared_lock<std::shared_mutex> lock(index_mutex_);
+    auto it = index_.find(value);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+}  // namespace trading::utils
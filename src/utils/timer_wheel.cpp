@@ -0,0 +1,196 @@
+#include "trading/utils/timer_wheel.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace trading::utils {
+
+TimerWheel::TimerWheel(std::chrono::nanoseconds tick, int64_t start_ns)
+    : tick_ns_(tick.count()), origin_ns_(start_ns), now_ns_(start_ns) {
+    if (tick_ns_ <= 0) {
+        throw std::invalid_argument("TimerWheel tick must be positive");
+    }
+    for (auto& level : slots_) {
+        level.fill(kNil);
+    }
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAt(int64_t deadline_ns, Callback callback) {
+    uint32_t index;
+    if (!free_nodes_.empty()) {
+        index = free_nodes_.back();
+        free_nodes_.pop_back();
+    } else {
+        if (nodes_.size() >= kNil - 1) {
+            throw std::length_error("TimerWheel capacity exhausted");
+        }
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    // Round up so a timer never fires before its deadline
+    const int64_t offset = deadline_ns - origin_ns_;
+    const uint64_t expiry =
+        offset > 0 ? static_cast<uint64_t>((offset + tick_ns_ - 1) / tick_ns_) : 0;
+
+    Node& node = nodes_[index];
+    node.expiry_tick = std::max(expiry, current_tick_);
+    node.callback = std::move(callback);
+    node.active = true;
+    place(index);
+    ++pending_;
+    return (static_cast<uint64_t>(node.generation) << 32) | (index + 1);
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAfter(std::chrono::nanoseconds delay, Callback callback) {
+    return scheduleAt(now_ns_ + delay.count(), std::move(callback));
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    const uint64_t slot = id & 0xFFFFFFFFu;
+    if (slot == 0 || slot > nodes_.size()) {
+        return false;
+    }
+    const auto index = static_cast<uint32_t>(slot - 1);
+    const Node& node = nodes_[index];
+    if (!node.active || node.generation != static_cast<uint32_t>(id >> 32)) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+size_t TimerWheel::advance(int64_t now_ns) {
+    now_ns_ = std::max(now_ns_, now_ns);
+    if (now_ns < origin_ns_) {
+        return 0;
+    }
+    const auto target = static_cast<uint64_t>((now_ns - origin_ns_) / tick_ns_);
+
+    size_t fired = 0;
+    while (current_tick_ <= target) {
+        if (pending_ == 0) {
+            current_tick_ = target + 1;
+            break;
+        }
+
+        // When the finest levels are empty nothing can fire or cascade until the next boundary
+        // of the first occupied level, so jump straight to it
+        size_t skip_bits = 0;
+        for (size_t level = 0; level < kLevels && level_counts_[level] == 0; ++level) {
+            skip_bits += kSlotBits;
+        }
+        const uint64_t skip_mask = (uint64_t{1} << skip_bits) - 1;
+        if (skip_bits > 0 && (current_tick_ & skip_mask) != 0) {
+            current_tick_ = std::min((current_tick_ | skip_mask) + 1, target + 1);
+            continue;
+        }
+
+        fired += processTick();
+    }
+    return fired;
+}
+
+void TimerWheel::place(uint32_t index) {
+    Node& node = nodes_[index];
+    const uint64_t delta = node.expiry_tick - current_tick_;
+
+    size_t level = 0;
+    while (level + 1 < kLevels && delta >= (uint64_t{1} << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+
+    // Deadlines beyond the top level's range park in its furthest slot and are re-placed each
+    // time that slot cascades
+    uint64_t expiry = node.expiry_tick;
+    const uint64_t range = uint64_t{1} << (kSlotBits * kLevels);
+    if (delta >= range) {
+        expiry = current_tick_ + range - 1;
+    }
+    const auto slot = static_cast<size_t>((expiry >> (kSlotBits * level)) & (kSlots - 1));
+
+    node.level = static_cast<uint8_t>(level);
+    node.slot = static_cast<uint16_t>(slot);
+    node.prev = kNil;
+    node.next = slots_[level][slot];
+    if (node.next != kNil) {
+        nodes_[node.next].prev = index;
+    }
+    slots_[level][slot] = index;
+    ++level_counts_[level];
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    uint32_t& head = node.level == kFiring ? firing_ : slots_[node.level][node.slot];
+    if (node.prev != kNil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        head = node.next;
+    }
+    if (node.next != kNil) {
+        nodes_[node.next].prev = node.prev;
+    }
+    if (node.level != kFiring) {
+        --level_counts_[node.level];
+    }
+    node.prev = node.next = kNil;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes_[index];
+    node.callback = nullptr;
+    node.active = false;
+    ++node.generation;
+    free_nodes_.push_back(index);
+    --pending_;
+}
+
+void TimerWheel::cascade(size_t level, size_t slot) {
+    // Every timer in this slot is now within range of a finer level
+    while (slots_[level][slot] != kNil) {
+        const uint32_t index = slots_[level][slot];
+        unlink(index);
+        place(index);
+    }
+}
+
+size_t TimerWheel::processTick() {
+    const uint64_t tick = current_tick_;
+    const auto slot = static_cast<size_t>(tick & (kSlots - 1));
+    if (slot == 0) {
+        for (size_t level = 1; level < kLevels; ++level) {
+            const auto level_slot =
+                static_cast<size_t>((tick >> (kSlotBits * level)) & (kSlots - 1));
+            cascade(level, level_slot);
+            if (level_slot != 0) {
+                break;
+            }
+        }
+    }
+
+    // Detach the due list before running callbacks: anything they schedule lands on a later
+    // tick, and anything they cancel is unlinked from firing_
+    firing_ = slots_[0][slot];
+    slots_[0][slot] = kNil;
+    for (uint32_t index = firing_; index != kNil; index = nodes_[index].next) {
+        nodes_[index].level = kFiring;
+        --level_counts_[0];
+    }
+    ++current_tick_;
+
+    size_t fired = 0;
+    while (firing_ != kNil) {
+        const uint32_t index = firing_;
+        unlink(index);
+        Callback callback = std::move(nodes_[index].callback);
+        release(index);
+        callback();
+        ++fired;
+    }
+    return fired;
+}
+
+}  // namespace trading::utils
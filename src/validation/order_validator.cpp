@@ -1,26 +1,67 @@
 #include "trading/validation/order_validator.hpp"
 #include <algorithm>
+#include <utility>
 
 namespace trading {
 namespace validation {
 
-OrderValidator::OrderValidator()
-    : min_quantity_(0.01),
-      max_quantity_(1000000.0),
-      min_price_(0.01),
-      max_price_(1000000.0),
-      market_open_(true) {
+namespace {
+ValidationResult symbolResult(bool valid, const std::string& symbol) {
+    ValidationResult result;
+    result.is_valid = valid;
+    result.error = valid ? ValidationError::NONE : ValidationError::INVALID_SYMBOL;
+    result.error_message = valid ? "" : "Invalid symbol: " + symbol;
+    return result;
+}
+
+ValidationResult quantityResult(bool valid, double quantity) {
+    ValidationResult result;
+    result.is_valid = valid;
+    result.error = valid ? ValidationError::NONE : ValidationError::INVALID_QUANTITY;
+    result.error_message = valid ? "" : "Invalid quantity: " + std::to_string(quantity);
+    return result;
+}
+
+ValidationResult priceResult(bool valid, double price) {
+    ValidationResult result;
+    result.is_valid = valid;
+    result.error = valid ? ValidationError::NONE : ValidationError::INVALID_PRICE;
+    result.error_message = valid ? "" : "Invalid price: " + std::to_string(price);
+    return result;
 }
+}  // namespace
+
+OrderValidator::OrderValidator() = default;
 
 ValidationResult OrderValidator::validate(std::shared_ptr<core::Order> order) const {
-    (void)order;  // Suppress unused parameter warning
+    return validateFields(order->getSymbol(), order->getQuantity(), order->getPrice(),
+                          order->getType());
+}
+
+ValidationResult OrderValidator::validate(const core::OrderRequest& request) const {
+    return validateFields(std::string(request.getSymbol()), request.quantity, request.price,
+                          request.type);
+}
+
+ValidationResult OrderValidator::validateAmend(const core::Order& resting,
+                                              const core::OrderRequest& amend) const {
+    return validateFields(resting.getSymbol(), amend.has_quantity ? amend.quantity
+                                                                  : resting.getQuantity(),
+                          amend.has_price ? amend.price : resting.getPrice(), resting.getType());
+}
+
+ValidationResult OrderValidator::validateFields(const std::string& symbol, double quantity,
+                                                double price, core::OrderType type) const {
+    // One snapshot for the whole order, even if the limits are replaced meanwhile
+    const Limits& limits = limits_.get();
+
     ValidationResult result;
     result.is_valid = true;
     result.error = ValidationError::NONE;
     result.error_message = "";
 
     // Check if market is open
-    if (!isMarketOpen()) {
+    if (!limits.market_open) {
         result.is_valid = false;
         result.error = ValidationError::MARKET_CLOSED;
         result.error_message = "Market is closed";
@@ -28,98 +69,98 @@ ValidationResult OrderValidator::validate(std::shared_ptr<core::Order> order) co
     }
 
     // Check if the symbol is valid
-    result = validateSymbol(order->getSymbol());
-    if (!result.is_valid) {
-        return result;
+    if (!isValidSymbol(limits, symbol)) {
+        return symbolResult(false, symbol);
     }
 
     // Check if the quantity is valid
-    result = validateQuantity(order->getQuantity());
-    if (!result.is_valid) {
-        return result;
+    if (!isValidQuantity(limits, quantity)) {
+        return quantityResult(false, quantity);
     }
 
     // Check if the price is valid
-    result = validatePrice(order->getPrice(), order->getType());
-    if (!result.is_valid) {
-        return result;
+    if (type != core::OrderType::MARKET && !isValidPrice(limits, price)) {
+        return priceResult(false, price);
     }
 
     return result;
 }
 
 ValidationResult OrderValidator::validateSymbol(const std::string& symbol) const {
-    ValidationResult result;
-    result.is_valid = isValidSymbol(symbol);
-    result.error = result.is_valid ? ValidationError::NONE : ValidationError::INVALID_SYMBOL;
-    result.error_message = result.is_valid ? "" : "Invalid symbol: " + symbol;
-    return result;
+    return symbolResult(isValidSymbol(limits_.get(), symbol), symbol);
 }
 
 ValidationResult OrderValidator::validateQuantity(double quantity) const {
-    ValidationResult result;
-    result.is_valid = isValidQuantity(quantity);
-    result.error = result.is_valid ? ValidationError::NONE : ValidationError::INVALID_QUANTITY;
-    result.error_message = result.is_valid ? "" : "Invalid quantity: " + std::to_string(quantity);
-    return result;
+    return quantityResult(isValidQuantity(limits_.get(), quantity), quantity);
 }
 
 ValidationResult OrderValidator::validatePrice(double price, core::OrderType type) const {
-    ValidationResult result;
-    result.is_valid = (type == core::OrderType::MARKET) || isValidPrice(price);
-    result.error = result.is_valid ? ValidationError::NONE : ValidationError::INVALID_PRICE;
-    result.error_message = result.is_valid ? "" : "Invalid price: " + std::to_string(price);
-    return result;
+    return priceResult(type == core::OrderType::MARKET || isValidPrice(limits_.get(), price),
+                       price);
+}
+
+void OrderValidator::setLimits(Limits limits) {
+    limits_.publish(std::move(limits));
+}
+
+OrderValidator::Limits OrderValidator::getLimits() const {
+    return limits_.get();
 }
 
 void OrderValidator::addValidSymbol(const std::string& symbol) {
-    if (std::find(valid_symbols_.begin(), valid_symbols_.end(), symbol) == valid_symbols_.end()) {
-        valid_symbols_.push_back(symbol);
-    }
+    limits_.update([&symbol](Limits& limits) {
+        auto& symbols = limits.valid_symbols;
+        if (std::find(symbols.begin(), symbols.end(), symbol) == symbols.end()) {
+            symbols.push_back(symbol);
+        }
+    });
 }
 
 void OrderValidator::removeValidSymbol(const std::string& symbol) {
-    valid_symbols_.erase(std::remove(valid_symbols_.begin(), valid_symbols_.end(), symbol),
-                         valid_symbols_.end());
+    limits_.update([&symbol](Limits& limits) {
+        auto& symbols = limits.valid_symbols;
+        symbols.erase(std::remove(symbols.begin(), symbols.end(), symbol), symbols.end());
+    });
 }
 
 void OrderValidator::setMinQuantity(double min_quantity) {
-    min_quantity_ = min_quantity;
+    limits_.update([min_quantity](Limits& limits) { limits.min_quantity = min_quantity; });
 }
 
 void OrderValidator::setMaxQuantity(double max_quantity) {
-    max_quantity_ = max_quantity;
+    limits_.update([max_quantity](Limits& limits) { limits.max_quantity = max_quantity; });
 }
 
 void OrderValidator::setMinPrice(double min_price) {
-    min_price_ = min_price;
+    limits_.update([min_price](Limits& limits) { limits.min_price = min_price; });
 }
 
 void OrderValidator::setMaxPrice(double max_price) {
-    max_price_ = max_price;
+    limits_.update([max_price](Limits& limits) { limits.max_price = max_price; });
 }
 
 void OrderValidator::setMarketOpen(bool is_open) {
-    market_open_ = is_open;
+    limits_.update([is_open](Limits& limits) { limits.market_open = is_open; });
 }
 
 bool OrderValidator::isMarketOpen() const {
-    return market_open_;
+    return limits_.get().market_open;
 }
 
-bool OrderValidator::isValidSymbol(const std::string& symbol) const {
-    if (valid_symbols_.empty()) {
+bool OrderValidator::isValidSymbol(const Limits& limits, const std::string& symbol) {
+    if (limits.valid_symbols.empty()) {
         return !symbol.empty();
     }
-    return std::find(valid_symbols_.begin(), valid_symbols_.end(), symbol) != valid_symbols_.end();
+    return std::find(limits.valid_symbols.begin(), limits.valid_symbols.end(), symbol) !=
+           limits.valid_symbols.end();
 }
 
-bool OrderValidator::isValidQuantity(double quantity) const {
-    return quantity >= min_quantity_ && quantity <= max_quantity_;
+bool OrderValidator::isValidQuantity(const Limits& limits, double quantity) {
+    return quantity >= limits.min_quantity && quantity <= limits.max_quantity;
 }
 
-bool OrderValidator::isValidPrice(double price) const {
-    return price >= min_price_ && price <= max_price_;
+bool OrderValidator::isValidPrice(const Limits& limits, double price) {
+    return price >= limits.min_price && price <= limits.max_price;
 }
 
 }  // namespace validation
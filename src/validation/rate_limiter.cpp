@@ -0,0 +1,223 @@
+#include "trading/validation/rate_limiter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace trading {
+namespace validation {
+
+namespace {
+constexpr uint32_t kEmpty = 0;
+constexpr uint32_t kWriting = 1;  // Claimed; key not yet published
+constexpr uint32_t kReady = 2;
+
+uint64_t hashKey(std::string_view key) {
+    return std::hash<std::string_view>{}(key);
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+uint64_t packTier(uint32_t generation, uint32_t tier) {
+    return static_cast<uint64_t>(generation) << 32 | tier;
+}
+}  // namespace
+
+struct RateLimiter::Slot {
+    std::atomic<uint32_t> state{kEmpty};
+    // Written once by the claiming thread before state becomes kReady
+    uint64_t hash = 0;
+    std::string user_id;
+    // Theoretical arrival time: the bucket is full again at this time. 0 starts it full.
+    std::atomic<int64_t> full_at_ns{0};
+    // Tier generation in the high half, tier index in the low half; refreshed when stale
+    std::atomic<uint64_t> tier{0};
+};
+
+RateLimiter::RateLimiter() : RateLimiter(Config()) {
+}
+
+RateLimiter::RateLimiter(const Config& config)
+    : capacity_(roundUpToPowerOfTwo(std::max<size_t>(config.capacity, 16))),
+      mask_(capacity_ - 1),
+      max_size_(capacity_ / 4 * 3),
+      slots_(std::make_unique<Slot[]>(capacity_)),
+      tiers_(buildTiers(config, 0)) {
+}
+
+RateLimiter::~RateLimiter() = default;
+
+RateLimiter::TierTable RateLimiter::buildTiers(const Config& config, uint32_t generation) {
+    TierTable table;
+    table.generation = generation;
+    std::unordered_map<std::string, uint32_t> tier_index;
+    for (const auto& [name, tier] : config.tiers) {
+        TierParams params{0, 0};
+        if (tier.orders_per_second > 0.0) {
+            params.interval_ns = std::max<int64_t>(
+                1, static_cast<int64_t>(std::llround(1e9 / tier.orders_per_second)));
+            params.tolerance_ns =
+                static_cast<int64_t>(std::max(tier.burst, 1.0) * params.interval_ns);
+        }
+        tier_index.emplace(name, static_cast<uint32_t>(table.params.size()));
+        table.params.push_back(params);
+    }
+
+    auto lookup = [&tier_index](const std::string& name) {
+        auto it = tier_index.find(name);
+        if (it == tier_index.end()) {
+            throw std::invalid_argument("Unknown rate limit tier: " + name);
+        }
+        return it->second;
+    };
+    table.default_tier = lookup(config.default_tier);
+    for (const auto& [user_id, tier_name] : config.user_tiers) {
+        table.user_tiers.emplace(user_id, lookup(tier_name));
+    }
+    return table;
+}
+
+void RateLimiter::reconfigure(const Config& config) {
+    // Built inside the update so that a throw publishes nothing
+    tiers_.update([&config](TierTable& table) {
+        table = buildTiers(config, table.generation + 1);
+    });
+}
+
+uint32_t RateLimiter::tierFor(const TierTable& tiers, std::string_view user_id) {
+    auto it = tiers.user_tiers.find(std::string(user_id));
+    return it == tiers.user_tiers.end() ? tiers.default_tier : it->second;
+}
+
+uint32_t RateLimiter::slotTier(Slot& slot, std::string_view user_id, const TierTable& tiers) {
+    const uint64_t packed = slot.tier.load(std::memory_order_relaxed);
+    if (packed >> 32 == tiers.generation) {
+        return static_cast<uint32_t>(packed);
+    }
+    // First use since a reconfigure; racing refreshers store the same value
+    const uint32_t tier = tierFor(tiers, user_id);
+    slot.tier.store(packTier(tiers.generation, tier), std::memory_order_relaxed);
+    return tier;
+}
+
+const RateLimiter::Slot* RateLimiter::findSlot(std::string_view user_id, uint64_t hash) const {
+    for (size_t i = hash & mask_, probes = 0; probes < capacity_; ++probes, i = (i + 1) & mask_) {
+        const Slot& slot = slots_[i];
+        uint32_t state = slot.state.load(std::memory_order_acquire);
+        if (state == kEmpty) {
+            return nullptr;
+        }
+        while (state == kWriting) {
+            std::this_thread::yield();
+            state = slot.state.load(std::memory_order_acquire);
+        }
+        if (slot.hash == hash && slot.user_id == user_id) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+RateLimiter::Slot* RateLimiter::findOrClaimSlot(std::string_view user_id, uint64_t hash,
+                                                const TierTable& tiers) {
+    for (size_t i = hash & mask_, probes = 0; probes < capacity_; ++probes, i = (i + 1) & mask_) {
+        Slot& slot = slots_[i];
+        uint32_t state = slot.state.load(std::memory_order_acquire);
+        if (state == kEmpty) {
+            // Racing claimers may overshoot the cap by a few slots; probing still terminates
+            if (size_.load(std::memory_order_relaxed) >= max_size_) {
+                return nullptr;
+            }
+            if (slot.state.compare_exchange_strong(state, kWriting, std::memory_order_acquire)) {
+                slot.tier.store(packTier(tiers.generation, tierFor(tiers, user_id)),
+                                std::memory_order_relaxed);
+                slot.hash = hash;
+                slot.user_id.assign(user_id);
+                slot.state.store(kReady, std::memory_order_release);
+                size_.fetch_add(1, std::memory_order_relaxed);
+                return &slot;
+            }
+            // Lost the claim; state now holds the winner's progress
+        }
+        // A claim in progress is a handful of stores; wait for its key rather than skip it,
+        // or two threads could insert the same user
+        while (state == kWriting) {
+            std::this_thread::yield();
+            state = slot.state.load(std::memory_order_acquire);
+        }
+        if (slot.hash == hash && slot.user_id == user_id) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+RateLimiter::Decision RateLimiter::tryAcquire(std::string_view user_id, int64_t now_ns,
+                                              uint32_t cost) {
+    const TierTable& tiers = tiers_.get();
+    Slot* slot = findOrClaimSlot(user_id, hashKey(user_id), tiers);
+    if (!slot) {
+        untracked_.fetch_add(1, std::memory_order_relaxed);
+        return take(overflow_full_at_ns_, tiers.params[tierFor(tiers, user_id)], now_ns, cost);
+    }
+    return take(slot->full_at_ns, tiers.params[slotTier(*slot, user_id, tiers)], now_ns, cost);
+}
+
+RateLimiter::Decision RateLimiter::take(std::atomic<int64_t>& full_at_ns, const TierParams& tier,
+                                        int64_t now_ns, uint32_t cost) {
+    if (tier.interval_ns == 0) {
+        allowed_.fetch_add(1, std::memory_order_relaxed);
+        return {true, 0};
+    }
+
+    const int64_t increment = static_cast<int64_t>(cost) * tier.interval_ns;
+    int64_t full_at = full_at_ns.load(std::memory_order_relaxed);
+    while (true) {
+        // Refill and take in one step: the bucket drains by moving full_at forward
+        const int64_t next = std::max(full_at, now_ns) + increment;
+        if (next - now_ns > tier.tolerance_ns) {
+            limited_.fetch_add(1, std::memory_order_relaxed);
+            return {false, next - now_ns - tier.tolerance_ns};
+        }
+        if (full_at_ns.compare_exchange_weak(full_at, next, std::memory_order_relaxed)) {
+            allowed_.fetch_add(1, std::memory_order_relaxed);
+            return {true, 0};
+        }
+    }
+}
+
+double RateLimiter::availableTokens(std::string_view user_id, int64_t now_ns) const {
+    const TierTable& tiers = tiers_.get();
+    const Slot* slot = findSlot(user_id, hashKey(user_id));
+    const TierParams& tier = tiers.params[tierFor(tiers, user_id)];
+    if (tier.interval_ns == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    int64_t full_at = 0;
+    if (slot) {
+        full_at = slot->full_at_ns.load(std::memory_order_relaxed);
+    } else if (size_.load(std::memory_order_relaxed) >= max_size_) {
+        full_at = overflow_full_at_ns_.load(std::memory_order_relaxed);
+    }
+    const int64_t debt = std::max<int64_t>(full_at - now_ns, 0);
+    return static_cast<double>(tier.tolerance_ns - debt) / static_cast<double>(tier.interval_ns);
+}
+
+RateLimiter::Metrics RateLimiter::getMetrics() const {
+    return Metrics{allowed_.load(std::memory_order_relaxed),
+                   limited_.load(std::memory_order_relaxed),
+                   untracked_.load(std::memory_order_relaxed),
+                   size_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace validation
+}  // namespace trading
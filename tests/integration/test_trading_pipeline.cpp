@@ -215,8 +215,8 @@ TEST_F(TradingPipelineTest, CompleteAAPLTradingScenario) {
     ASSERT_EQ(trades.size(), 1);
     EXPECT_EQ(trades[0].quantity, 25.0);  // Partial fill
     EXPECT_EQ(trades[0].price, 150.50);
-    EXPECT_EQ(trades[0].buy_user_id, "trader-002");
-    EXPECT_EQ(trades[0].sell_user_id, "trader-001");
+    EXPECT_EQ(core::userName(trades[0].buy_user), "trader-002");
+    EXPECT_EQ(core::userName(trades[0].sell_user), "trader-001");
 
     // Verify callback was triggered
     EXPECT_EQ(trade_count_, 1);
@@ -327,9 +327,9 @@ TEST_F(TradingPipelineTest, MultipleSymbolTrading) {
     // Verify that we have trades for both symbols
     bool has_aapl_trade = false, has_googl_trade = false;
     for (const auto& trade : trades_) {
-        if (trade.symbol == "AAPL")
+        if (core::symbolName(trade.symbol) == "AAPL")
             has_aapl_trade = true;
-        if (trade.symbol == "GOOGL")
+        if (core::symbolName(trade.symbol) == "GOOGL")
             has_googl_trade = true;
     }
 
@@ -0,0 +1,121 @@
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "trading/network/admission_controller.hpp"
+
+using namespace trading::network;
+using namespace std::chrono_literals;
+
+namespace {
+AdmissionController::Config smallConfig() {
+    AdmissionController::Config config;
+    config.orders.max_in_flight = 2;
+    config.orders.min_in_flight = 1;
+    config.orders.max_queued = 10;
+    config.reads.max_in_flight = 1;
+    config.reads.min_in_flight = 1;
+    config.reads.max_queued = 4;
+    config.retry_after_seconds = 3;
+    return config;
+}
+}  // namespace
+
+TEST(AdmissionControllerTest, RejectsWith429OverConcurrencyLimit) {
+    AdmissionController admission(smallConfig());
+
+    EXPECT_TRUE(admission.admit(RequestClass::ORDER, 0).admitted);
+    EXPECT_TRUE(admission.admit(RequestClass::ORDER, 0).admitted);
+    auto decision = admission.admit(RequestClass::ORDER, 0);
+    EXPECT_FALSE(decision.admitted);
+    EXPECT_EQ(decision.status_code, 429);
+
+    admission.release(RequestClass::ORDER, 1ms);
+    EXPECT_TRUE(admission.admit(RequestClass::ORDER, 0).admitted);
+
+    auto metrics = admission.getMetrics();
+    EXPECT_EQ(metrics.orders.admitted, 3u);
+    EXPECT_EQ(metrics.orders.rejected_busy, 1u);
+    EXPECT_EQ(metrics.orders.in_flight, 2u);
+    EXPECT_EQ(admission.retryAfterSeconds(), 3);
+}
+
+TEST(AdmissionControllerTest, ClassesHaveSeparateBudgets) {
+    AdmissionController admission(smallConfig());
+
+    EXPECT_TRUE(admission.admit(RequestClass::READ, 0).admitted);
+    EXPECT_EQ(admission.admit(RequestClass::READ, 0).status_code, 429);
+
+    // Saturated reads leave order entry untouched
+    EXPECT_TRUE(admission.admit(RequestClass::ORDER, 0).admitted);
+    EXPECT_TRUE(admission.admit(RequestClass::ORDER, 0).admitted);
+}
+
+TEST(AdmissionControllerTest, ShedsReadsBeforeOrdersAsQueueGrows) {
+    AdmissionController admission(smallConfig());
+
+    auto read = admission.admit(RequestClass::READ, 4);
+    EXPECT_FALSE(read.admitted);
+    EXPECT_EQ(read.status_code, 503);
+    EXPECT_TRUE(admission.admit(RequestClass::ORDER, 4).admitted);
+    EXPECT_EQ(admission.admit(RequestClass::ORDER, 10).status_code, 503);
+
+    // Connections are only refused at accept once every class would refuse them
+    EXPECT_FALSE(admission.shedConnection(9));
+    EXPECT_TRUE(admission.shedConnection(10));
+
+    auto metrics = admission.getMetrics();
+    EXPECT_EQ(metrics.reads.rejected_overloaded, 1u);
+    EXPECT_EQ(metrics.orders.rejected_overloaded, 1u);
+    EXPECT_EQ(metrics.rejected_connections, 1u);
+}
+
+TEST(AdmissionControllerTest, ShedsOrdersWhileBacklogged) {
+    auto config = smallConfig();
+    config.max_order_backlog = 100;
+    AdmissionController admission(config);
+    size_t backlog = 99;
+    admission.setBacklogProbe([&backlog]() { return backlog; });
+
+    EXPECT_TRUE(admission.admit(RequestClass::ORDER, 0).admitted);
+    backlog = 100;
+    EXPECT_EQ(admission.admit(RequestClass::ORDER, 0).status_code, 503);
+    // Reads do not depend on the order pipeline
+    EXPECT_TRUE(admission.admit(RequestClass::READ, 0).admitted);
+}
+
+TEST(AdmissionControllerTest, ExemptRequestsAreNeverShed) {
+    AdmissionController admission(smallConfig());
+    admission.setBacklogProbe([]() { return size_t{1'000'000}; });
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(admission.admit(RequestClass::EXEMPT, 1'000).admitted);
+    }
+    admission.release(RequestClass::EXEMPT, 1s);
+    EXPECT_EQ(admission.getMetrics().orders.admitted, 0u);
+}
+
+TEST(AdmissionControllerTest, LimitShrinksUnderSlowHandlersAndRecovers) {
+    AdmissionController::Config config;
+    config.orders.max_in_flight = 20;
+    config.orders.min_in_flight = 5;
+    config.orders.target_latency = 1ms;
+    AdmissionController admission(config);
+
+    // Sustained slow handlers pull the smoothed latency over target and the limit down to the
+    // floor, one decrease per target interval
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(admission.admit(RequestClass::ORDER, 0).admitted);
+        admission.release(RequestClass::ORDER, 50ms);
+        std::this_thread::sleep_for(1100us);
+    }
+    EXPECT_EQ(admission.getMetrics().orders.limit, 5u);
+
+    // Fast handlers bring the average back under target and grow the limit again
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(admission.admit(RequestClass::ORDER, 0).admitted);
+        admission.release(RequestClass::ORDER, 10us);
+    }
+    EXPECT_EQ(admission.getMetrics().orders.limit, 20u);
+}
@@ -0,0 +1,168 @@
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/network/body_writer.hpp"
+#include "../../apps/json.hpp"
+
+using namespace trading::network;
+using json = nlohmann::json;
+
+namespace {
+json decode(BodyFormat format, const std::string& body) {
+    if (format == BodyFormat::JSON) {
+        return json::parse(body);
+    }
+    const std::vector<uint8_t> bytes(body.begin(), body.end());
+    return format == BodyFormat::CBOR ? json::from_cbor(bytes) : json::from_msgpack(bytes);
+}
+
+// Exercises every size class of each encoding
+std::string writeSample(BodyFormat format) {
+    const std::vector<int64_t> integers = {0,       23,      24,         127,        128,
+                                           255,     256,     65535,      65536,      4294967295,
+                                           -1,      -32,     -33,        -128,       -129,
+                                           -32768,  -32769,  INT32_MIN,  INT64_MIN,  INT64_MAX};
+    BodyWriter writer(format);
+    writer.beginMap(8);
+    writer.key("integers").beginArray(integers.size());
+    for (int64_t value : integers) {
+        writer.value(value);
+    }
+    writer.endArray();
+    writer.field("max_unsigned", std::numeric_limits<uint64_t>::max());
+    writer.key("strings").beginArray(5);
+    for (size_t length : {0, 31, 32, 256, 70000}) {
+        writer.value(std::string(length, 'x'));
+    }
+    writer.endArray();
+    writer.field("price", 101.25).field("fraction", 0.1).field("flag", true);
+    writer.key("missing").null();
+    writer.key("levels").beginArray(20);
+    for (int i = 0; i < 20; ++i) {
+        writer.beginMap(2).field("price", 100.0 + i).field("quantity", i).endMap();
+    }
+    writer.endArray().endMap();
+    return writer.take();
+}
+
+json expectedSample() {
+    json levels = json::array();
+    for (int i = 0; i < 20; ++i) {
+        levels.push_back({{"price", 100.0 + i}, {"quantity", i}});
+    }
+    json strings = json::array();
+    for (size_t length : {0, 31, 32, 256, 70000}) {
+        strings.push_back(std::string(length, 'x'));
+    }
+    return json{{"integers",
+                 {0,      23,     24,        127,       128,       255,       256,
+                  65535,  65536,  4294967295LL, -1,     -32,       -33,       -128,
+                  -129,   -32768, -32769,    INT32_MIN, INT64_MIN, INT64_MAX}},
+                {"max_unsigned", std::numeric_limits<uint64_t>::max()},
+                {"strings", strings},
+                {"price", 101.25},
+                {"fraction", 0.1},
+                {"flag", true},
+                {"missing", nullptr},
+                {"levels", levels}};
+}
+}  // namespace
+
+TEST(BodyWriterTest, CborDecodesToSameDocument) {
+    EXPECT_EQ(decode(BodyFormat::CBOR, writeSample(BodyFormat::CBOR)), expectedSample());
+}
+
+TEST(BodyWriterTest, MessagePackDecodesToSameDocument) {
+    EXPECT_EQ(decode(BodyFormat::MSGPACK, writeSample(BodyFormat::MSGPACK)), expectedSample());
+}
+
+TEST(BodyWriterTest, JsonParsesToSameDocument) {
+    EXPECT_EQ(json::parse(writeSample(BodyFormat::JSON)), expectedSample());
+}
+
+TEST(BodyWriterTest, JsonEscapesStringsLikeNlohmann) {
+    // Escapes at every offset of a 16-byte block, and in the scalar tail
+    std::string text = "plain \"quoted\" back\\slash caf\xc3\xa9 \x7f";
+    for (int byte = 0; byte < 0x20; ++byte) {
+        text += std::string(static_cast<size_t>(byte % 17), 'a') + static_cast<char>(byte);
+    }
+    for (size_t length = 0; length < text.size(); length += 7) {
+        const std::string prefix = text.substr(0, length);
+        BodyWriter writer(BodyFormat::JSON);
+        writer.beginMap(1).field(prefix, prefix).endMap();
+        const json expected = {{prefix, prefix}};
+        EXPECT_EQ(writer.take(), expected.dump()) << "length " << length;
+    }
+}
+
+TEST(BodyWriterTest, JsonFormatsNumbersLikeNlohmann) {
+    const std::vector<double> doubles = {0.0,   -0.5,   100.0, 101.25, 0.1,   1e-7,
+                                         1e300, -2e-12, 1e21,  123456789.125};
+    BodyWriter writer(BodyFormat::JSON);
+    writer.beginArray(doubles.size() + 3);
+    for (double value : doubles) {
+        writer.value(value);
+    }
+    writer.value(std::numeric_limits<double>::quiet_NaN())
+        .value(std::numeric_limits<double>::infinity())
+        .value(INT64_MIN)
+        .endArray();
+    const std::string body = writer.take();
+
+    json expected = doubles;
+    expected.push_back(nullptr);
+    expected.push_back(nullptr);
+    expected.push_back(INT64_MIN);
+    EXPECT_EQ(json::parse(body), expected);
+    EXPECT_EQ(body.substr(0, 16), "[0.0,-0.5,100.0,");
+}
+
+TEST(BodyWriterTest, ReusesCallerBuffer) {
+    std::string buffer = "stale";
+    {
+        BodyWriter writer(BodyFormat::JSON, buffer);
+        writer.beginArray(0).endArray();
+        EXPECT_EQ(writer.take(), "[]");
+    }
+    buffer.reserve(4096);
+    const size_t capacity = buffer.capacity();
+    BodyWriter writer(BodyFormat::JSON, buffer);
+    writer.beginMap(2).field("a", 1).key("b").beginArray(2).value(true).null().endArray().endMap();
+    EXPECT_EQ(writer.view(), R"({"a":1,"b":[true,null]})");
+    EXPECT_EQ(writer.take(), R"({"a":1,"b":[true,null]})");
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.capacity(), capacity);
+}
+
+TEST(BodyWriterTest, LargeContainersUseWideSizes) {
+    for (BodyFormat format : {BodyFormat::CBOR, BodyFormat::MSGPACK, BodyFormat::JSON}) {
+        BodyWriter writer(format);
+        writer.beginMap(1).key("values").beginArray(70000);
+        for (int i = 0; i < 70000; ++i) {
+            writer.value(i);
+        }
+        writer.endArray().endMap();
+        const json decoded = decode(format, writer.take());
+        ASSERT_EQ(decoded["values"].size(), 70000u);
+        EXPECT_EQ(decoded["values"][69999], 69999);
+    }
+}
+
+TEST(BodyWriterTest, NegotiatesFormatFromAccept) {
+    EXPECT_EQ(negotiateBodyFormat(""), BodyFormat::JSON);
+    EXPECT_EQ(negotiateBodyFormat("*/*"), BodyFormat::JSON);
+    EXPECT_EQ(negotiateBodyFormat("text/html"), BodyFormat::JSON);
+    EXPECT_EQ(negotiateBodyFormat("application/cbor"), BodyFormat::CBOR);
+    EXPECT_EQ(negotiateBodyFormat("Application/MsgPack"), BodyFormat::MSGPACK);
+    EXPECT_EQ(negotiateBodyFormat("application/x-msgpack"), BodyFormat::MSGPACK);
+    EXPECT_EQ(negotiateBodyFormat("application/json, application/cbor"), BodyFormat::JSON);
+    EXPECT_EQ(negotiateBodyFormat("application/json;q=0.5, application/cbor"), BodyFormat::CBOR);
+    EXPECT_EQ(negotiateBodyFormat("application/cbor;q=0.2, */*;q=0.8"), BodyFormat::JSON);
+    EXPECT_EQ(negotiateBodyFormat("application/msgpack; q=0.9, application/cbor; q=0.95"),
+              BodyFormat::CBOR);
+    EXPECT_EQ(negotiateBodyFormat("application/cbor;q=0"), BodyFormat::JSON);
+    EXPECT_STREQ(contentTypeFor(BodyFormat::MSGPACK), "application/msgpack");
+}
@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "trading/core/matching_engine.hpp"
+#include "trading/utils/clock.hpp"
+
+using namespace trading;
+using namespace trading::utils;
+
+namespace {
+int64_t systemNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
+TEST(ClockTest, TscClockTracksSystemClock) {
+    TscClock clock;
+    constexpr int64_t kToleranceNs = 5'000'000;  // 5ms
+
+    EXPECT_LT(std::llabs(clock.nowNanos() - systemNanos()), kToleranceNs);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    clock.recalibrate();
+    EXPECT_LT(std::llabs(clock.nowNanos() - systemNanos()), kToleranceNs);
+}
+
+TEST(ClockTest, TscClockAdvances) {
+    TscClock clock;
+    int64_t first = clock.nowNanos();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    int64_t second = clock.nowNanos();
+
+    EXPECT_GE(second - first, 4'000'000);
+}
+
+TEST(ClockTest, TscClockNeverStepsBackwards) {
+    if (!TscClock::isSupported()) {
+        GTEST_SKIP() << "No invariant cycle counter";
+    }
+    auto wall = std::make_shared<SimulatedClock>(1'700'000'000'000'000'000);
+    TscClock clock(wall);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    int64_t last = clock.nowNanos();
+
+    // An NTP step puts the wall clock a second behind what the clock has handed out
+    wall->advance(std::chrono::seconds(-1));
+    for (int i = 0; i < 5; ++i) {
+        clock.recalibrate();
+        const int64_t now = clock.nowNanos();
+        EXPECT_GE(now, last);
+        last = now;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        wall->advance(std::chrono::milliseconds(1));
+    }
+
+    // Once the wall clock is ahead again, the clock steps forward to it
+    wall->advance(std::chrono::seconds(10));
+    clock.recalibrate();
+    EXPECT_GE(clock.nowNanos(), wall->nowNanos());
+    EXPECT_GT(clock.nowNanos(), last);
+}
+
+TEST(ClockTest, SimulatedClockIsDrivenByCaller) {
+    SimulatedClock clock(1'000'000'000);
+    EXPECT_EQ(clock.nowNanos(), 1'000'000'000);
+    EXPECT_EQ(clock.nowSeconds(), 1);
+
+    clock.advance(std::chrono::milliseconds(1500));
+    EXPECT_EQ(clock.nowMillis(), 2500);
+
+    clock.setNanos(42);
+    EXPECT_EQ(clock.nowNanos(), 42);
+}
+
+TEST(ClockTest, CoarseClockCachesSource) {
+    auto source = std::make_shared<SimulatedClock>(100);
+    CoarseClock coarse(source, std::chrono::microseconds(200));
+
+    // Without the ticker the cached value only changes on tick()
+    source->setNanos(200);
+    EXPECT_EQ(coarse.nowNanos(), 100);
+    coarse.tick();
+    EXPECT_EQ(coarse.nowNanos(), 200);
+
+    coarse.start();
+    source->setNanos(300);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (coarse.nowNanos() != 300 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    coarse.stop();
+
+    EXPECT_EQ(coarse.nowNanos(), 300);
+    EXPECT_FALSE(coarse.isRunning());
+}
+
+TEST(ClockTest, MatchingEngineUsesInjectedClock) {
+    auto clock = std::make_shared<SimulatedClock>(1'700'000'000'000'000'000);
+    core::MatchingEngine engine;
+    engine.setClock(clock);
+
+    auto book = std::make_shared<core::OrderBook>("AAPL");
+    engine.addOrderBook("AAPL", book);
+
+    auto sell = std::make_shared<core::Order>("S1", "seller", "AAPL", core::OrderType::LIMIT,
+                                              core::OrderSide::SELL, 10.0, 100.0);
+    book->addOrder(sell);
+
+    auto buy = std::make_shared<core::Order>("B1", "buyer", "AAPL", core::OrderType::LIMIT,
+                                             core::OrderSide::BUY, 10.0, 100.0);
+    auto trades = engine.matchOrder(buy, *book);
+
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].timestamp_ns, 1'700'000'000'000'000'000);
+}
@@ -0,0 +1,70 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "trading/utils/completion_registry.hpp"
+
+using namespace trading::utils;
+using namespace std::chrono_literals;
+
+TEST(CompletionRegistryTest, DeliversResultToWaiter) {
+    CompletionRegistry<std::string> registry;
+    auto ticket = registry.expect("u1/o1");
+    ASSERT_NE(ticket, nullptr);
+
+    std::thread producer([&] { EXPECT_TRUE(registry.complete("u1/o1", "FILLED")); });
+    auto result = registry.wait("u1/o1", ticket, 5000ms);
+    producer.join();
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "FILLED");
+    EXPECT_EQ(registry.pendingCount(), 0u);
+}
+
+TEST(CompletionRegistryTest, TimeoutWithdrawsRegistration) {
+    CompletionRegistry<int> registry;
+    auto ticket = registry.expect("u1/o1");
+    ASSERT_NE(ticket, nullptr);
+
+    // A second waiter for the same key is refused while the first is pending
+    EXPECT_EQ(registry.expect("u1/o1"), nullptr);
+
+    EXPECT_FALSE(registry.wait("u1/o1", ticket, 1ms).has_value());
+    EXPECT_EQ(registry.pendingCount(), 0u);
+
+    // Late results are dropped, and the key can be reused
+    EXPECT_FALSE(registry.complete("u1/o1", 42));
+    EXPECT_NE(registry.expect("u1/o1"), nullptr);
+}
+
+TEST(CompletionRegistryTest, AbandonOnlyRemovesOwnTicket) {
+    CompletionRegistry<int> registry;
+    auto first = registry.expect("k");
+    registry.abandon("k", first);
+    auto second = registry.expect("k");
+    ASSERT_NE(second, nullptr);
+
+    registry.abandon("k", first);  // Stale ticket: must not withdraw the new registration
+    EXPECT_TRUE(registry.complete("k", 7));
+    EXPECT_EQ(registry.wait("k", second, 0ms), 7);
+}
+
+TEST(CompletionRegistryTest, OnCompleteCallsBackWithoutBlocking) {
+    CompletionRegistry<int> registry;
+    auto ticket = registry.expect("k");
+    int calls = 0;
+    registry.onComplete(ticket, [&]() { ++calls; });
+    EXPECT_EQ(calls, 0);
+
+    std::thread producer([&] { EXPECT_TRUE(registry.complete("k", 5)); });
+    producer.join();
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(registry.wait("k", ticket, 0ms), 5);
+
+    // Registered after delivery: called at once
+    auto late = registry.expect("k2");
+    EXPECT_TRUE(registry.complete("k2", 6));
+    registry.onComplete(late, [&]() { ++calls; });
+    EXPECT_EQ(calls, 2);
+}
@@ -101,6 +101,26 @@ TEST_F(ConcurrentQueueTest, FillToCapacity) {
     EXPECT_EQ(queue_.size(), 0);
 }
 
+// Test case for the non-blocking enqueue on a full queue
+TEST_F(ConcurrentQueueTest, TryEnqueueFailsWhenFull) {
+    const size_t capacity = queue_.capacity();
+    for (size_t i = 0; i < capacity; ++i) {
+        int value = static_cast<int>(i);
+        ASSERT_TRUE(queue_.try_enqueue(std::move(value)));
+    }
+
+    int overflow = -1;
+    EXPECT_FALSE(queue_.try_enqueue(std::move(overflow)));
+
+    // Freeing one slot makes room for exactly one more item
+    int value;
+    ASSERT_TRUE(queue_.try_dequeue(value));
+    EXPECT_EQ(value, 0);
+    int next = 100;
+    EXPECT_TRUE(queue_.try_enqueue(std::move(next)));
+    EXPECT_EQ(queue_.size(), capacity);
+}
+
 // Test case for a single producer and a single consumer thread
 TEST_F(ConcurrentQueueTest, SingleProducerSingleConsumer) {
     std::vector<int> produced_items;
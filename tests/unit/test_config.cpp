@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "trading/utils/config.hpp"
+
+using namespace trading::utils;
+
+TEST(ConfigTest, LoadsTypedValuesAndSections) {
+    Config config;
+    ASSERT_TRUE(config.loadFromJson(R"({
+        "name": "engine",
+        "threads": 40,
+        "ratio": 0.25,
+        "enabled": true,
+        "symbols": ["AAPL", "MSFT"],
+        "http": {"port": 8080, "tls": {"enabled": false}}
+    })"));
+
+    EXPECT_EQ(config.getString("name", ""), "engine");
+    EXPECT_EQ(config.getInt("threads", 0), 40);
+    EXPECT_DOUBLE_EQ(config.getDouble("ratio", 0.0), 0.25);
+    EXPECT_TRUE(config.getBool("enabled", false));
+    EXPECT_EQ(config.getString("symbols", ""), R"(["AAPL","MSFT"])");
+
+    auto http = config.getSection("http");
+    ASSERT_TRUE(http);
+    EXPECT_EQ((*http)->getInt("port", 0), 8080);
+    auto tls = (*http)->getSection("tls");
+    ASSERT_TRUE(tls);
+    EXPECT_FALSE((*tls)->getBool("enabled", true));
+    EXPECT_EQ(config.getSection("missing").error(), ConfigError::KEY_NOT_FOUND);
+}
+
+TEST(ConfigTest, RejectsMalformedJson) {
+    Config config;
+    EXPECT_EQ(config.loadFromJson("{\"port\": ").error(), ConfigError::INVALID_JSON);
+    EXPECT_EQ(config.loadFromJson("[1, 2]").error(), ConfigError::INVALID_JSON);
+    EXPECT_EQ(config.getInt("port").error(), ConfigError::KEY_NOT_FOUND);
+    EXPECT_EQ(config.loadFromFile("/nonexistent/config.json").error(),
+              ConfigError::FILE_NOT_FOUND);
+}
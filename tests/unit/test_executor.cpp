@@ -0,0 +1,141 @@
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/execution/executor.hpp"
+#include "trading/execution/simulated_venue.hpp"
+
+using namespace trading;
+using namespace trading::execution;
+using namespace std::chrono_literals;
+
+namespace {
+core::Trade makeTrade(double quantity, double price) {
+    core::Trade trade{};
+    trade.trade_id = 1;
+    trade.quantity = quantity;
+    trade.price = price;
+    return trade;
+}
+
+// Collects results delivered on the executor's completion thread
+struct Collector {
+    std::mutex mutex;
+    std::vector<ExecutionResult> results;
+
+    Executor::ExecutionCallback callback() {
+        return [this](const ExecutionResult& result) {
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(result);
+        };
+    }
+};
+}  // namespace
+
+TEST(ExecutorTest, ExecutionsCompleteAsynchronously) {
+    Executor executor;
+    Collector collector;
+    executor.setExecutionCallback(collector.callback());
+    ASSERT_TRUE(executor.start());
+
+    auto result = executor.execute(makeTrade(2.0, 50.0));
+    EXPECT_EQ(result.status, ExecutionStatus::PENDING);
+    EXPECT_FALSE(result.execution_id.empty());
+
+    ASSERT_TRUE(executor.waitForIdle(2s));
+    ASSERT_EQ(collector.results.size(), 1u);
+    EXPECT_EQ(collector.results[0].status, ExecutionStatus::SUCCESS);
+    EXPECT_EQ(collector.results[0].execution_id, result.execution_id);
+    EXPECT_EQ(executor.getTotalExecutions(), 1u);
+    EXPECT_DOUBLE_EQ(executor.getTotalExecutedVolume(), 2.0);
+
+    // Invalid trades are rejected synchronously
+    EXPECT_EQ(executor.execute(makeTrade(0.0, 50.0)).status, ExecutionStatus::FAILED);
+    executor.stop();
+    EXPECT_EQ(executor.execute(makeTrade(1.0, 50.0)).status, ExecutionStatus::FAILED);
+}
+
+TEST(ExecutorTest, ThroughputIsNotBoundByVenueLatency) {
+    SimulatedVenue::Config venue_config;
+    venue_config.latency = 20ms;
+    auto venue = std::make_shared<SimulatedVenue>(venue_config);
+    Executor executor(venue, 64);
+    Collector collector;
+    executor.setExecutionCallback(collector.callback());
+    executor.start();
+
+    constexpr int kTrades = 200;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTrades; ++i) {
+        executor.execute(makeTrade(1.0, 10.0));
+        EXPECT_LE(executor.getInFlightCount(), 64u);
+    }
+    ASSERT_TRUE(executor.waitForIdle(5s));
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    // Serial round trips would take kTrades * 20ms = 4s; a 64-wide window needs ~4 of them
+    EXPECT_LT(elapsed, 1s);
+    EXPECT_EQ(collector.results.size(), static_cast<size_t>(kTrades));
+    EXPECT_EQ(executor.getTotalExecutions(), static_cast<uint64_t>(kTrades));
+}
+
+TEST(ExecutorTest, RejectsAreRetriedUntilTheVenueAccepts) {
+    SimulatedVenue::Config venue_config;
+    venue_config.reject_probability = 1.0;
+    auto venue = std::make_shared<SimulatedVenue>(venue_config);
+    Executor executor(venue);
+    Collector collector;
+    executor.setExecutionCallback(collector.callback());
+    executor.start();
+
+    // A second submission means the first attempt was rejected and retried
+    executor.execute(makeTrade(1.0, 10.0));
+    for (int i = 0; i < 200 && venue->getSubmittedCount() < 2; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    venue->setRejectProbability(0.0);
+
+    ASSERT_TRUE(executor.waitForIdle(2s));
+    EXPECT_GE(venue->getSubmittedCount(), 2u);
+    ASSERT_EQ(collector.results.size(), 1u);
+    EXPECT_EQ(collector.results[0].status, ExecutionStatus::SUCCESS);
+}
+
+TEST(ExecutorTest, RetriesStopAtLimit) {
+    SimulatedVenue::Config venue_config;
+    venue_config.reject_probability = 1.0;
+    auto venue = std::make_shared<SimulatedVenue>(venue_config);
+    Executor executor(venue);
+    executor.setMaxRetries(2);
+    Collector collector;
+    executor.setExecutionCallback(collector.callback());
+    executor.start();
+
+    executor.execute(makeTrade(1.0, 10.0));
+    ASSERT_TRUE(executor.waitForIdle(2s));
+    EXPECT_EQ(venue->getSubmittedCount(), 3u);  // First attempt plus two retries
+    ASSERT_EQ(collector.results.size(), 1u);
+    EXPECT_EQ(collector.results[0].status, ExecutionStatus::FAILED);
+    EXPECT_EQ(collector.results[0].error_message, "Rejected by venue");
+    EXPECT_EQ(executor.getTotalExecutions(), 0u);
+}
+
+TEST(ExecutorTest, UnansweredRequestsTimeOut) {
+    SimulatedVenue::Config venue_config;
+    venue_config.drop_probability = 1.0;
+    auto venue = std::make_shared<SimulatedVenue>(venue_config);
+    Executor executor(venue);
+    executor.setTimeout(20);
+    executor.setMaxRetries(1);
+    Collector collector;
+    executor.setExecutionCallback(collector.callback());
+    executor.start();
+
+    executor.execute(makeTrade(1.0, 10.0));
+    ASSERT_TRUE(executor.waitForIdle(2s));
+    EXPECT_EQ(venue->getSubmittedCount(), 2u);
+    ASSERT_EQ(collector.results.size(), 1u);
+    EXPECT_EQ(collector.results[0].error_message, "Venue timed out");
+}
@@ -1,8 +1,11 @@
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 #include <arpa/inet.h>
 #include <gtest/gtest.h>
 #include <netinet/in.h>
@@ -978,3 +981,487 @@ TEST_F(HttpServerTest, EmptyQueryParameters) {
     EXPECT_NE(response.find("HTTP/1.1 200 OK"), std::string::npos);
     EXPECT_NE(response.find(R"("query_count": 0)"), std::string::npos);
 }
+
+TEST_F(HttpServerTest, WebSocketUpgradeHandsConnectionToHub) {
+    auto hub = std::make_shared<WebSocketHub>();
+    ASSERT_TRUE(hub->start());
+    server_->registerWebSocket("/ws", hub);
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // A plain request to the WebSocket path is told to upgrade
+    std::string response = sendHttpRequest("GET /ws HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+    EXPECT_NE(response.find("HTTP/1.1 426"), std::string::npos);
+
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(sock, 0);
+    struct sockaddr_in server_addr {};
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_port = htons(8081);
+    server_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    ASSERT_EQ(connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr)), 0);
+
+    const std::string handshake =
+        "GET /ws HTTP/1.1\r\n"
+        "Host: 127.0.0.1:8081\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: keep-alive, Upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "Sec-WebSocket-Version: 13\r\n"
+        "\r\n";
+    send(sock, handshake.c_str(), handshake.length(), 0);
+
+    std::string reply;
+    char buffer[1024];
+    while (reply.find("\r\n\r\n") == std::string::npos) {
+        ssize_t n = recv(sock, buffer, sizeof(buffer), 0);
+        ASSERT_GT(n, 0);
+        reply.append(buffer, static_cast<size_t>(n));
+    }
+    EXPECT_NE(reply.find("HTTP/1.1 101 Switching Protocols"), std::string::npos);
+    EXPECT_NE(reply.find("Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo="), std::string::npos);
+
+    // The socket now belongs to the hub rather than being closed after the response
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (hub->getMetrics().connections == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(hub->getMetrics().connections, 1u);
+
+    close(sock);
+    server_->stop();
+    hub->stop();
+}
+
+TEST_F(HttpServerTest, ShardedAcceptorsServeConcurrentRequests) {
+    server_->setAcceptors(4);
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Clients that connect and send nothing must not hold up their acceptor
+    std::vector<int> idle_sockets;
+    for (int i = 0; i < 8; ++i) {
+        int sock = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_GE(sock, 0);
+        struct sockaddr_in server_addr {};
+        server_addr.sin_family = AF_INET;
+        server_addr.sin_port = htons(8081);
+        server_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        ASSERT_EQ(connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr)), 0);
+        idle_sockets.push_back(sock);
+    }
+
+    const int num_requests = 40;
+    std::vector<std::thread> threads;
+    std::atomic<int> success_count{0};
+    for (int i = 0; i < num_requests; ++i) {
+        threads.emplace_back([this, &success_count]() {
+            std::string response =
+                sendHttpRequest("GET /health HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+            if (response.find("HTTP/1.1 200 OK") != std::string::npos) {
+                success_count++;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(success_count.load(), num_requests);
+
+    for (int sock : idle_sockets) {
+        close(sock);
+    }
+    server_->stop();
+    EXPECT_FALSE(server_->isRunning());
+}
+
+TEST_F(HttpServerTest, ShardedAcceptorsContainBadAndSlowRequests) {
+    server_->setAcceptors(2);
+    server_->registerRoute("GET", "/throw", [](const HttpRequest&) -> HttpResponse {
+        throw std::runtime_error("handler failed");
+    });
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Clients stalled mid-body wait in the epoll set instead of blocking their acceptor
+    std::vector<int> slow_sockets;
+    for (int i = 0; i < 8; ++i) {
+        int sock = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_GE(sock, 0);
+        struct sockaddr_in server_addr {};
+        server_addr.sin_family = AF_INET;
+        server_addr.sin_port = htons(8081);
+        server_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        ASSERT_EQ(connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr)), 0);
+        const std::string head = "POST /orders HTTP/1.1\r\nContent-Length: 10\r\n\r\nabc";
+        ASSERT_EQ(send(sock, head.data(), head.size(), 0), static_cast<ssize_t>(head.size()));
+        slow_sockets.push_back(sock);
+    }
+
+    std::string reply = sendHttpRequest("GET /health HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+    EXPECT_NE(reply.find("HTTP/1.1 200 OK"), std::string::npos);
+
+    reply = sendHttpRequest("POST /orders HTTP/1.1\r\nContent-Length: abc\r\n\r\n{}");
+    EXPECT_NE(reply.find("HTTP/1.1 400 Bad Request"), std::string::npos);
+
+    reply = sendHttpRequest("GET /throw HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+    EXPECT_NE(reply.find("HTTP/1.1 500 Internal Server Error"), std::string::npos);
+
+    // The stalled requests are served once the rest of their bodies arrives
+    for (int sock : slow_sockets) {
+        ASSERT_EQ(send(sock, "defghij", 7, 0), 7);
+        char buffer[256];
+        const ssize_t n = recv(sock, buffer, sizeof(buffer), 0);
+        ASSERT_GT(n, 0);
+        EXPECT_EQ(std::string(buffer, static_cast<size_t>(n)).rfind("HTTP/1.1 202", 0), 0u);
+        close(sock);
+    }
+}
+
+TEST_F(HttpServerTest, AdmissionControlRejectsOverLimitWithRetryAfter) {
+    AdmissionController::Config config;
+    config.orders.max_in_flight = 1;
+    config.orders.min_in_flight = 1;
+    config.retry_after_seconds = 2;
+    auto admission = std::make_shared<AdmissionController>(config);
+    server_->setAdmissionController(admission);
+
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+    server_->registerRoute("POST", "/slow_order",
+                           [&](const HttpRequest&) {
+                               entered = true;
+                               while (!release) {
+                                   std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                               }
+                               HttpResponse resp;
+                               resp.status_code = 200;
+                               resp.body = "{}";
+                               return resp;
+                           },
+                           RequestClass::ORDER);
+    server_->registerRoute("GET", "/status", [](const HttpRequest&) {
+        HttpResponse resp;
+        resp.status_code = 200;
+        resp.body = "{}";
+        return resp;
+    });
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const std::string order = "POST /slow_order HTTP/1.1\r\nContent-Length: 0\r\n\r\n";
+    std::string first;
+    std::thread holder([&]() { first = sendHttpRequest(order); });
+    while (!entered) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // The order budget is used up; reads and health checks draw on their own
+    std::string second = sendHttpRequest(order);
+    EXPECT_NE(second.find("HTTP/1.1 429 Too Many Requests"), std::string::npos);
+    EXPECT_NE(second.find("Retry-After: 2"), std::string::npos);
+    EXPECT_NE(sendHttpRequest("GET /status HTTP/1.1\r\n\r\n").find("HTTP/1.1 200"),
+              std::string::npos);
+    EXPECT_NE(sendHttpRequest("GET /health HTTP/1.1\r\n\r\n").find("HTTP/1.1 200"),
+              std::string::npos);
+
+    release = true;
+    holder.join();
+    EXPECT_NE(first.find("HTTP/1.1 200"), std::string::npos);
+    EXPECT_TRUE(sendHttpRequest(order).find("HTTP/1.1 200") != std::string::npos);
+    EXPECT_EQ(admission->getMetrics().orders.rejected_busy, 1u);
+}
+
+TEST_F(HttpServerTest, TranscodesJsonBodiesForBinaryAccept) {
+    server_->registerRoute("GET", "/quote", [](const HttpRequest&) {
+        HttpResponse resp;
+        resp.status_code = 200;
+        resp.body = R"({"symbol":"AAPL","bid":100.5,"size":3})";
+        resp.headers["Content-Type"] = "application/json";
+        return resp;
+    });
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::string json_response = sendHttpRequest("GET /quote HTTP/1.1\r\n\r\n");
+    EXPECT_NE(json_response.find("Content-Type: application/json"), std::string::npos);
+    EXPECT_NE(json_response.find("Vary: Accept"), std::string::npos);
+
+    // CBOR map(3), text(6) "symbol" ...
+    std::string cbor_response =
+        sendHttpRequest("GET /quote HTTP/1.1\r\nAccept: application/cbor\r\n\r\n");
+    EXPECT_NE(cbor_response.find("Content-Type: application/cbor"), std::string::npos);
+    const size_t body = cbor_response.find("\r\n\r\n") + 4;
+    ASSERT_LT(body, cbor_response.size());
+    EXPECT_EQ(static_cast<uint8_t>(cbor_response[body]), 0xa3);
+
+    std::string msgpack_response = sendHttpRequest(
+        "GET /quote HTTP/1.1\r\nAccept: application/json;q=0.1, application/msgpack\r\n\r\n");
+    EXPECT_NE(msgpack_response.find("Content-Type: application/msgpack"), std::string::npos);
+    const size_t msgpack_body = msgpack_response.find("\r\n\r\n") + 4;
+    ASSERT_LT(msgpack_body, msgpack_response.size());
+    EXPECT_EQ(static_cast<uint8_t>(msgpack_response[msgpack_body]), 0x83);
+}
+
+TEST_F(HttpServerTest, CompressesLargeBodiesForAcceptEncoding) {
+    if (!contentEncodingSupported(ContentEncoding::GZIP)) {
+        GTEST_SKIP() << "built without zlib";
+    }
+    ResponseCompressor::Config config;
+    config.min_size = 256;
+    auto compressor = std::make_shared<ResponseCompressor>(config);
+    server_->setResponseCompressor(compressor);
+    const std::string large = "{\"levels\":[" + std::string(4000, '1') + "]}";
+    server_->registerRoute("GET", "/book", [&large](const HttpRequest&) {
+        HttpResponse resp;
+        resp.status_code = 200;
+        resp.body = large;
+        resp.headers["ETag"] = "\"7\"";
+        return resp;
+    });
+    server_->registerRoute("GET", "/small", [](const HttpRequest&) {
+        HttpResponse resp;
+        resp.status_code = 200;
+        resp.body = "{}";
+        return resp;
+    });
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const std::string gzip_request = "GET /book HTTP/1.1\r\nAccept-Encoding: br, gzip\r\n\r\n";
+    std::string response = sendHttpRequest(gzip_request);
+    EXPECT_NE(response.find("Content-Encoding: gzip"), std::string::npos);
+    EXPECT_NE(response.find("Vary: Accept, Accept-Encoding"), std::string::npos);
+    const size_t length_at = response.find("Content-Length: ");
+    ASSERT_NE(length_at, std::string::npos);
+    EXPECT_LT(std::stoul(response.substr(length_at + 16)), large.size());
+
+    // The same version is served from the cache
+    sendHttpRequest(gzip_request);
+    EXPECT_EQ(compressor->getMetrics().compressed, 1u);
+    EXPECT_EQ(compressor->getMetrics().cache_hits, 1u);
+
+    response = sendHttpRequest("GET /book HTTP/1.1\r\n\r\n");
+    EXPECT_EQ(response.find("Content-Encoding"), std::string::npos);
+    EXPECT_NE(response.find("Content-Length: " + std::to_string(large.size())), std::string::npos);
+
+    response = sendHttpRequest("GET /small HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+    EXPECT_EQ(response.find("Content-Encoding"), std::string::npos);
+}
+
+TEST_F(HttpServerTest, IoUringBackendServesRequests) {
+    if (!HttpServer::ioUringSupported()) {
+        GTEST_SKIP() << "io_uring not available";
+    }
+    server_->setBackend(HttpServer::Backend::IO_URING);
+    server_->setAcceptors(2);
+    server_->registerRoute("POST", "/echo", [](const HttpRequest& req) -> HttpResponse {
+        HttpResponse resp;
+        resp.status_code = 200;
+        resp.body = req.body;
+        return resp;
+    });
+    server_->registerRoute("GET", "/throw", [](const HttpRequest&) -> HttpResponse {
+        throw std::runtime_error("handler failed");
+    });
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::string response = sendHttpRequest("GET /health HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+    EXPECT_NE(response.find("HTTP/1.1 200 OK"), std::string::npos);
+    EXPECT_NE(response.find("healthy"), std::string::npos);
+
+    // A throwing handler is answered, and stop() below does not wait on it
+    response = sendHttpRequest("GET /throw HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+    EXPECT_NE(response.find("HTTP/1.1 500 Internal Server Error"), std::string::npos);
+
+    // A body larger than one receive buffer is reassembled before the handler runs
+    const std::string body(20000, 'x');
+    response = sendHttpRequest("POST /echo HTTP/1.1\r\nHost: 127.0.0.1:8081\r\nContent-Length: " +
+                               std::to_string(body.size()) + "\r\n\r\n" + body);
+    EXPECT_NE(response.find("HTTP/1.1 200 OK"), std::string::npos);
+    EXPECT_NE(response.find("\r\n\r\n" + body), std::string::npos);
+
+    const int num_requests = 40;
+    std::vector<std::thread> threads;
+    std::atomic<int> success_count{0};
+    for (int i = 0; i < num_requests; ++i) {
+        threads.emplace_back([this, &success_count]() {
+            std::string reply =
+                sendHttpRequest("GET /missing HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+            if (reply.find("HTTP/1.1 404 Not Found") != std::string::npos) {
+                success_count++;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(success_count.load(), num_requests);
+
+    server_->stop();
+    EXPECT_FALSE(server_->isRunning());
+}
+
+TEST_F(HttpServerTest, IoUringBackendHandsWebSocketUpgradeToHub) {
+    if (!HttpServer::ioUringSupported()) {
+        GTEST_SKIP() << "io_uring not available";
+    }
+    auto hub = std::make_shared<WebSocketHub>();
+    ASSERT_TRUE(hub->start());
+    server_->setBackend(HttpServer::Backend::IO_URING);
+    server_->registerWebSocket("/ws", hub);
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(sock, 0);
+    struct sockaddr_in server_addr {};
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_port = htons(8081);
+    server_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    ASSERT_EQ(connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr)), 0);
+
+    const std::string handshake =
+        "GET /ws HTTP/1.1\r\n"
+        "Host: 127.0.0.1:8081\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "Sec-WebSocket-Version: 13\r\n"
+        "\r\n";
+    send(sock, handshake.c_str(), handshake.length(), 0);
+
+    std::string reply;
+    char buffer[1024];
+    while (reply.find("\r\n\r\n") == std::string::npos) {
+        ssize_t n = recv(sock, buffer, sizeof(buffer), 0);
+        ASSERT_GT(n, 0);
+        reply.append(buffer, static_cast<size_t>(n));
+    }
+    EXPECT_NE(reply.find("HTTP/1.1 101 Switching Protocols"), std::string::npos);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (hub->getMetrics().connections == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(hub->getMetrics().connections, 1u);
+
+    close(sock);
+    server_->stop();
+    hub->stop();
+}
+
+namespace {
+// Registers a route that parks until notified or 5 s pass, collecting the notifiers
+void registerParkingRoute(HttpServer& server, std::mutex& mutex,
+                          std::vector<std::function<void()>>& notifiers) {
+    server.registerAsyncRoute(
+        "GET", "/park", [&](const HttpRequest&) -> trading::utils::Task<HttpResponse> {
+            auto parked = server.waitFor(
+                [&](std::function<void()> notify) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    notifiers.push_back(std::move(notify));
+                },
+                std::chrono::seconds(5));
+            const bool notified = co_await parked;
+            co_return HttpResponse{200, notified ? "notified" : "timed out", {}};
+        });
+}
+}  // namespace
+
+TEST_F(HttpServerTest, AsyncRoutesParkWithoutHoldingWorkers) {
+    for (const auto backend : {HttpServer::Backend::BLOCKING, HttpServer::Backend::IO_URING}) {
+        if (backend == HttpServer::Backend::IO_URING && !HttpServer::ioUringSupported()) {
+            continue;
+        }
+        // Two workers, far fewer than the requests parked at once
+        server_ = std::make_unique<HttpServer>("127.0.0.1", 8081, 2);
+        server_->setBackend(backend);
+        server_->setHealthHandler([](const HttpRequest&) {
+            return HttpResponse{200, "healthy", {}};
+        });
+        std::mutex mutex;
+        std::vector<std::function<void()>> notifiers;
+        registerParkingRoute(*server_, mutex, notifiers);
+        ASSERT_TRUE(server_->start());
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const int num_requests = 32;
+        std::vector<std::thread> clients;
+        std::atomic<int> notified{0};
+        for (int i = 0; i < num_requests; ++i) {
+            clients.emplace_back([this, &notified]() {
+                std::string reply =
+                    sendHttpRequest("GET /park HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+                if (reply.find("\r\n\r\nnotified") != std::string::npos) {
+                    notified++;
+                }
+            });
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+        auto parked = [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return notifiers.size();
+        };
+        while (parked() < static_cast<size_t>(num_requests) &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        ASSERT_EQ(parked(), static_cast<size_t>(num_requests));
+
+        // Every request is parked, and the workers are still free for other work
+        std::string health =
+            sendHttpRequest("GET /health HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+        EXPECT_NE(health.find("healthy"), std::string::npos);
+
+        for (auto& notify : notifiers) {
+            notify();
+            notify();  // Later calls are ignored
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+        EXPECT_EQ(notified.load(), num_requests);
+        server_->stop();
+    }
+}
+
+TEST_F(HttpServerTest, AsyncRouteTimeoutsAndErrors) {
+    using trading::utils::Task;
+    server_->registerAsyncRoute(
+        "GET", "/sleep/{ms}", [this](const HttpRequest& req) -> Task<HttpResponse> {
+            const auto started = std::chrono::steady_clock::now();
+            const auto delay = std::chrono::milliseconds(std::stoi(req.path_params.at("ms")));
+            const bool notified = co_await server_->sleepFor(delay);
+            const auto slept = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started);
+            co_return HttpResponse{200, notified ? "notified" : std::to_string(slept.count()), {}};
+        });
+    server_->registerAsyncRoute("GET", "/throw", [](const HttpRequest&) -> Task<HttpResponse> {
+        throw std::runtime_error("handler failed");
+        co_return HttpResponse{200, "", {}};
+    });
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::string reply =
+        sendHttpRequest("GET /sleep/50 HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+    ASSERT_NE(reply.find("HTTP/1.1 200 OK"), std::string::npos);
+    EXPECT_GE(std::stoi(reply.substr(reply.find("\r\n\r\n") + 4)), 50);
+
+    reply = sendHttpRequest("GET /throw HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+    EXPECT_NE(reply.find("HTTP/1.1 500 Internal Server Error"), std::string::npos);
+
+    // Stopping answers a parked request at once rather than after its timeout
+    std::thread client([this, &reply]() {
+        reply =
+            sendHttpRequest("GET /sleep/10000 HTTP/1.1\r\nHost: 127.0.0.1:8081\r\n\r\n");
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const auto stopping = std::chrono::steady_clock::now();
+    server_->stop();
+    client.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopping, std::chrono::seconds(5));
+    EXPECT_NE(reply.find("HTTP/1.1 200 OK"), std::string::npos);
+}
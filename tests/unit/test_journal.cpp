@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/core/order_request.hpp"
+#include "trading/utils/journal.hpp"
+
+using namespace trading::utils;
+using trading::core::OrderRequest;
+
+namespace {
+std::string tempJournalPath(const std::string& name) {
+    auto path = std::filesystem::temp_directory_path() / ("trading_journal_" + name + ".bin");
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+OrderRequest makeRequest(const std::string& id, double quantity) {
+    OrderRequest request;
+    OrderRequest::setField(request.id, id);
+    OrderRequest::setField(request.user_id, "user1");
+    OrderRequest::setField(request.symbol, "AAPL");
+    request.has_quantity = true;
+    request.quantity = quantity;
+    return request;
+}
+}  // namespace
+
+TEST(JournalTest, ReplaysRecordsInOrderAcrossReopen) {
+    Journal::Config config;
+    config.path = tempJournalPath("reopen");
+    {
+        Journal journal(config);
+        ASSERT_TRUE(journal.open());
+        EXPECT_TRUE(journal.appendRecord(makeRequest("o1", 1.0)));
+        EXPECT_TRUE(journal.appendRecord(makeRequest("o2", 2.0)));
+        EXPECT_TRUE(journal.flush());
+    }
+    {
+        // Reopening appends after the existing records; close() flushes the buffer
+        Journal journal(config);
+        ASSERT_TRUE(journal.open());
+        EXPECT_TRUE(journal.appendRecord(makeRequest("o3", 3.0)));
+    }
+
+    std::vector<OrderRequest> replayed;
+    size_t count = Journal::replay(config.path, [&](std::string_view record) {
+        ASSERT_EQ(record.size(), sizeof(OrderRequest));
+        OrderRequest request;
+        std::memcpy(&request, record.data(), sizeof(request));
+        replayed.push_back(request);
+    });
+
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(replayed[0].getId(), "o1");
+    EXPECT_EQ(replayed[2].getId(), "o3");
+    EXPECT_DOUBLE_EQ(replayed[1].quantity, 2.0);
+    std::filesystem::remove(config.path);
+}
+
+TEST(JournalTest, ReplayStopsAtTornTail) {
+    Journal::Config config;
+    config.path = tempJournalPath("torn");
+    {
+        Journal journal(config);
+        ASSERT_TRUE(journal.open());
+        journal.appendRecord(makeRequest("o1", 1.0));
+        journal.appendRecord(makeRequest("o2", 2.0));
+    }
+
+    // Simulate a crash in the middle of writing the last record
+    auto size = std::filesystem::file_size(config.path);
+    std::filesystem::resize_file(config.path, size - 10);
+
+    size_t count = Journal::replay(config.path, [](std::string_view) {});
+    EXPECT_EQ(count, 1u);
+    std::filesystem::remove(config.path);
+}
+
+TEST(JournalTest, RejectsAppendWhenClosedAndOversizedFields) {
+    Journal::Config config;
+    config.path = tempJournalPath("closed");
+    Journal journal(config);
+    EXPECT_FALSE(journal.appendRecord(makeRequest("o1", 1.0)));
+    EXPECT_FALSE(journal.flush());
+
+    OrderRequest request;
+    EXPECT_FALSE(OrderRequest::setField(request.symbol, "A_SYMBOL_THAT_IS_TOO_LONG"));
+    EXPECT_TRUE(OrderRequest::setField(request.symbol, "MSFT"));
+    EXPECT_EQ(request.getSymbol(), "MSFT");
+}
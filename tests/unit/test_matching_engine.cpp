@@ -2,6 +2,7 @@
 #include "trading/core/order.hpp"
 #include "trading/core/orderbook.hpp"
 #include "trading/core/user.hpp"
+#include <cstring>
 #include <gtest/gtest.h>
 
 using namespace trading::core;
@@ -59,8 +60,8 @@ TEST_F(MatchingEngineTest, LimitOrderMatchingSamePriceBuyFirst) {
     ASSERT_EQ(trades.size(), 1);
     EXPECT_EQ(trades[0].quantity, 100.0);
     EXPECT_EQ(trades[0].price, 50.0);  // Should match at sell order's price
-    EXPECT_EQ(trades[0].buy_user_id, "user-001");
-    EXPECT_EQ(trades[0].sell_user_id, "user-002");
+    EXPECT_EQ(userName(trades[0].buy_user), "user-001");
+    EXPECT_EQ(userName(trades[0].sell_user), "user-002");
 
     EXPECT_EQ(matching_engine_->getTotalTrades(), 1);
     EXPECT_NEAR(matching_engine_->getTotalVolume(), 5000.0, 1e-9);
@@ -80,8 +81,8 @@ TEST_F(MatchingEngineTest, LimitOrderMatchingSamePriceSellFirst) {
     ASSERT_EQ(trades.size(), 1);
     EXPECT_EQ(trades[0].quantity, 100.0);
     EXPECT_EQ(trades[0].price, 50.0);  // Should match at buy order's price
-    EXPECT_EQ(trades[0].buy_user_id, "user-001");
-    EXPECT_EQ(trades[0].sell_user_id, "user-002");
+    EXPECT_EQ(userName(trades[0].buy_user), "user-001");
+    EXPECT_EQ(userName(trades[0].sell_user), "user-002");
 }
 
 TEST_F(MatchingEngineTest, LimitOrderPartialMatch) {
@@ -199,7 +200,7 @@ TEST_F(MatchingEngineTest, TradeCallbackFunctionality) {
 
     EXPECT_TRUE(callback_called);
     EXPECT_EQ(received_trades.size(), 1);
-    EXPECT_EQ(received_trades[0].symbol, "AAPL");
+    EXPECT_EQ(symbolName(received_trades[0].symbol), "AAPL");
     EXPECT_EQ(received_trades[0].quantity, 100.0);
     EXPECT_EQ(received_trades[0].price, 50.0);
 }
@@ -232,8 +233,8 @@ TEST_F(MatchingEngineTest, MatchingUpdatesUserPortfolios) {
     ASSERT_EQ(trades.size(), 1);
     EXPECT_EQ(trades[0].quantity, 50.0);
     EXPECT_EQ(trades[0].price, 60.0);
-    EXPECT_EQ(trades[0].buy_user_id, "user-001");
-    EXPECT_EQ(trades[0].sell_user_id, "user-002");
+    EXPECT_EQ(userName(trades[0].buy_user), "user-001");
+    EXPECT_EQ(userName(trades[0].sell_user), "user-002");
 
     // Verify buyer's portfolio updated
     EXPECT_NEAR(buyer_->getCashBalance(), 10000.0 - (50.0 * 60.0), 1e-9);  // 10000 - 3000 = 7000
@@ -280,9 +281,9 @@ TEST_F(MatchingEngineTest, TradeCallbackWithUserPortfolios) {
 
     // Verify trade data passed to callback
     EXPECT_EQ(received_trade.quantity, 25.0);
-    EXPECT_EQ(received_trade.buy_user_id, "user-001");
-    EXPECT_EQ(received_trade.sell_user_id, "user-002");
-    EXPECT_EQ(received_trade.symbol, "AAPL");
+    EXPECT_EQ(userName(received_trade.buy_user), "user-001");
+    EXPECT_EQ(userName(received_trade.sell_user), "user-002");
+    EXPECT_EQ(symbolName(received_trade.symbol), "AAPL");
 }
 
 TEST_F(MatchingEngineTest, UserRegistryFunctionality) {
@@ -300,3 +301,227 @@ TEST_F(MatchingEngineTest, UserRegistryFunctionality) {
     EXPECT_EQ(matching_engine_->getUser("user-001"), buyer_);
     EXPECT_EQ(matching_engine_->getUser("user-999"), nullptr);
 }
+
+TEST_F(MatchingEngineTest, TradesCarryCompactIds) {
+    auto sell_order = std::make_shared<Order>("sell-1", "user-002", "AAPL", OrderType::LIMIT,
+                                              OrderSide::SELL, 10.0, 50.0);
+    auto buy_order = std::make_shared<Order>("buy-1", "user-001", "AAPL", OrderType::LIMIT,
+                                             OrderSide::BUY, 20.0, 50.0);
+    orderbook_->addOrder(sell_order);
+    auto trades = matching_engine_->matchOrder(buy_order, *orderbook_);
+    ASSERT_EQ(trades.size(), 1);
+
+    // Trade ids are plain integers assigned in sequence
+    EXPECT_EQ(trades[0].trade_id, 1u);
+    EXPECT_EQ(tradeIdString(trades[0]), "1");
+
+    // Order handles and interned ids render back to the original strings at the edge
+    EXPECT_EQ(trades[0].buy_order, buy_order->getHandle());
+    EXPECT_EQ(trades[0].sell_order, sell_order->getHandle());
+    EXPECT_EQ(clientOrderId(trades[0].buy_order), "buy-1");
+    EXPECT_EQ(clientOrderId(trades[0].sell_order), "sell-1");
+    EXPECT_EQ(trades[0].symbol, internSymbol("AAPL"));
+    EXPECT_GT(trades[0].timestamp_ns, 0);
+
+    // Trades can be copied around as raw bytes
+    Trade copy;
+    std::memcpy(&copy, &trades[0], sizeof(Trade));
+    EXPECT_EQ(copy.trade_id, trades[0].trade_id);
+    EXPECT_EQ(copy.buy_user, trades[0].buy_user);
+}
+
+// Stop order tests
+TEST_F(MatchingEngineTest, StopOrderWaitsForTriggerPrice) {
+    auto resting_sell = std::make_shared<Order>("sell-1", "user-002", "AAPL", OrderType::LIMIT,
+                                                OrderSide::SELL, 10.0, 106.0);
+    orderbook_->addOrder(resting_sell);
+
+    // Buy stop at 105 does not trade on arrival and does not rest in the book
+    auto buy_stop = std::make_shared<Order>("stop-1", "user-001", "AAPL", OrderType::STOP,
+                                            OrderSide::BUY, 4.0, 105.0);
+    EXPECT_TRUE(matching_engine_->matchOrder(buy_stop, *orderbook_).empty());
+    EXPECT_EQ(matching_engine_->getPendingStopCount("AAPL"), 1u);
+    EXPECT_TRUE(orderbook_->getBuyOrders().empty());
+
+    // A trade at 106 crosses the stop level and releases it into matching
+    auto buy_limit = std::make_shared<Order>("buy-1", "user-001", "AAPL", OrderType::LIMIT,
+                                             OrderSide::BUY, 1.0, 106.0);
+    auto trades = matching_engine_->matchOrder(buy_limit, *orderbook_);
+
+    ASSERT_EQ(trades.size(), 2u);
+    EXPECT_EQ(clientOrderId(trades[1].buy_order), "stop-1");
+    EXPECT_EQ(trades[1].quantity, 4.0);
+    EXPECT_EQ(trades[1].price, 106.0);
+    EXPECT_EQ(matching_engine_->getPendingStopCount("AAPL"), 0u);
+    EXPECT_EQ(matching_engine_->getLastTradePrice("AAPL"), 106.0);
+}
+
+TEST_F(MatchingEngineTest, StopOrdersCascade) {
+    orderbook_->addOrder(std::make_shared<Order>("buy-1", "user-001", "AAPL", OrderType::LIMIT,
+                                                 OrderSide::BUY, 1.0, 99.0));
+    orderbook_->addOrder(std::make_shared<Order>("buy-2", "user-001", "AAPL", OrderType::LIMIT,
+                                                 OrderSide::BUY, 5.0, 98.0));
+    orderbook_->addOrder(std::make_shared<Order>("buy-3", "user-001", "AAPL", OrderType::LIMIT,
+                                                 OrderSide::BUY, 5.0, 97.0));
+
+    matching_engine_->matchOrder(std::make_shared<Order>("stop-1", "user-002", "AAPL",
+                                                         OrderType::STOP, OrderSide::SELL, 5.0,
+                                                         99.0),
+                                 *orderbook_);
+    matching_engine_->matchOrder(std::make_shared<Order>("stop-2", "user-002", "AAPL",
+                                                         OrderType::STOP, OrderSide::SELL, 5.0,
+                                                         98.0),
+                                 *orderbook_);
+    EXPECT_EQ(matching_engine_->getPendingStopCount("AAPL"), 2u);
+
+    // Trade at 99 releases stop-1, which trades at 98 and releases stop-2, which trades at 97
+    auto sell = std::make_shared<Order>("sell-1", "user-002", "AAPL", OrderType::LIMIT,
+                                        OrderSide::SELL, 1.0, 99.0);
+    auto trades = matching_engine_->matchOrder(sell, *orderbook_);
+
+    ASSERT_EQ(trades.size(), 3u);
+    EXPECT_EQ(trades[0].price, 99.0);
+    EXPECT_EQ(trades[1].price, 98.0);
+    EXPECT_EQ(clientOrderId(trades[1].sell_order), "stop-1");
+    EXPECT_EQ(trades[2].price, 97.0);
+    EXPECT_EQ(clientOrderId(trades[2].sell_order), "stop-2");
+    EXPECT_EQ(matching_engine_->getPendingStopCount("AAPL"), 0u);
+}
+
+TEST_F(MatchingEngineTest, StopOrderAlreadyThroughLevelExecutesImmediately) {
+    orderbook_->addOrder(std::make_shared<Order>("sell-1", "user-002", "AAPL", OrderType::LIMIT,
+                                                 OrderSide::SELL, 10.0, 50.0));
+    matching_engine_->matchOrder(std::make_shared<Order>("buy-1", "user-001", "AAPL",
+                                                         OrderType::LIMIT, OrderSide::BUY, 1.0,
+                                                         50.0),
+                                 *orderbook_);
+
+    // Last trade is 50, so a buy stop at 45 is already triggered
+    auto buy_stop = std::make_shared<Order>("stop-1", "user-001", "AAPL", OrderType::STOP,
+                                            OrderSide::BUY, 2.0, 45.0);
+    auto trades = matching_engine_->matchOrder(buy_stop, *orderbook_);
+
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].quantity, 2.0);
+    EXPECT_EQ(matching_engine_->getPendingStopCount("AAPL"), 0u);
+}
+
+TEST_F(MatchingEngineTest, TriggeredStopsWithoutLiquidityAreCancelled) {
+    orderbook_->addOrder(std::make_shared<Order>("sell-1", "user-002", "AAPL", OrderType::LIMIT,
+                                                 OrderSide::SELL, 3.0, 50.0));
+    auto buy_stop = std::make_shared<Order>("stop-1", "user-001", "AAPL", OrderType::STOP,
+                                            OrderSide::BUY, 4.0, 50.0);
+    matching_engine_->matchOrder(buy_stop, *orderbook_);
+    EXPECT_EQ(buy_stop->getStatus(), OrderStatus::PENDING);
+
+    // The trade at 50 releases the stop, which finds only 2 of its 4 left to buy
+    auto trades = matching_engine_->matchOrder(
+        std::make_shared<Order>("buy-1", "user-003", "AAPL", OrderType::LIMIT, OrderSide::BUY,
+                                1.0, 50.0),
+        *orderbook_);
+    ASSERT_EQ(trades.size(), 2u);
+    auto cancelled = matching_engine_->takeCancelledStops();
+    ASSERT_EQ(cancelled.size(), 1u);
+    EXPECT_EQ(cancelled[0], buy_stop);
+    EXPECT_EQ(buy_stop->getStatus(), OrderStatus::CANCELLED);
+    EXPECT_NEAR(buy_stop->getQuantity(), 2.0, 1e-9);
+    EXPECT_TRUE(matching_engine_->takeCancelledStops().empty());
+
+    // Already triggered on arrival against an empty book: dropped, not parked
+    auto late_stop = std::make_shared<Order>("stop-2", "user-001", "AAPL", OrderType::STOP,
+                                             OrderSide::BUY, 1.0, 45.0);
+    EXPECT_TRUE(matching_engine_->matchOrder(late_stop, *orderbook_).empty());
+    EXPECT_EQ(late_stop->getStatus(), OrderStatus::CANCELLED);
+    EXPECT_EQ(matching_engine_->getPendingStopCount("AAPL"), 0u);
+}
+
+TEST_F(MatchingEngineTest, AmendRepriceCrossesSpread) {
+    auto resting_sell = std::make_shared<Order>("sell-1", "user-002", "AAPL", OrderType::LIMIT,
+                                                OrderSide::SELL, 10.0, 52.0);
+    auto resting_buy = std::make_shared<Order>("buy-1", "user-001", "AAPL", OrderType::LIMIT,
+                                               OrderSide::BUY, 4.0, 50.0);
+    orderbook_->addOrder(resting_sell);
+    orderbook_->addOrder(resting_buy);
+    const UserId buyer = resting_buy->getUserKey();
+
+    // Quantity-only amend stays in place and trades nothing
+    auto in_place = matching_engine_->amendOrder(buyer, "buy-1", 3.0, std::nullopt, *orderbook_);
+    EXPECT_EQ(in_place.status, AmendStatus::AMENDED_IN_PLACE);
+    EXPECT_TRUE(in_place.trades.empty());
+
+    // Repricing through the ask matches immediately and the filled order leaves the book
+    auto repriced = matching_engine_->amendOrder(buyer, "buy-1", std::nullopt, 52.0, *orderbook_);
+    EXPECT_EQ(repriced.status, AmendStatus::REQUEUED);
+    ASSERT_EQ(repriced.trades.size(), 1u);
+    EXPECT_EQ(repriced.trades[0].quantity, 3.0);
+    EXPECT_EQ(repriced.trades[0].price, 52.0);
+    EXPECT_EQ(orderbook_->findOrder(buyer, "buy-1"), nullptr);
+    EXPECT_NEAR(resting_sell->getQuantity(), 7.0, 1e-9);
+
+    EXPECT_EQ(matching_engine_->amendOrder(buyer, "nope", 1.0, 1.0, *orderbook_).status,
+              AmendStatus::NOT_FOUND);
+}
+
+TEST_F(MatchingEngineTest, MassCancelCoversBooksAndStops) {
+    auto msft_book = std::make_shared<OrderBook>("MSFT");
+    matching_engine_->addOrderBook("MSFT", msft_book);
+
+    orderbook_->addOrder(std::make_shared<Order>("a1", "user-001", "AAPL", OrderType::LIMIT,
+                                                 OrderSide::BUY, 1.0, 10.0));
+    orderbook_->addOrder(std::make_shared<Order>("a2", "user-002", "AAPL", OrderType::LIMIT,
+                                                 OrderSide::SELL, 1.0, 20.0));
+    msft_book->addOrder(std::make_shared<Order>("m1", "user-001", "MSFT", OrderType::LIMIT,
+                                                OrderSide::BUY, 1.0, 10.0));
+    matching_engine_->matchOrder(std::make_shared<Order>("s1", "user-001", "AAPL",
+                                                         OrderType::STOP, OrderSide::BUY, 1.0,
+                                                         30.0),
+                                 *orderbook_);
+
+    // Per-symbol user cancel leaves the other book alone
+    EXPECT_EQ(matching_engine_->cancelUserOrders("user-001", "MSFT").size(), 1u);
+    EXPECT_EQ(orderbook_->getBuyOrders().size(), 1u);
+
+    // User cancel across symbols includes pending stops
+    EXPECT_EQ(matching_engine_->cancelUserOrders("user-001").size(), 2u);
+    EXPECT_EQ(matching_engine_->getPendingStopCount("AAPL"), 0u);
+    EXPECT_EQ(orderbook_->getSellOrders().size(), 1u);
+
+    EXPECT_EQ(matching_engine_->cancelSymbolOrders("AAPL").size(), 1u);
+    EXPECT_TRUE(orderbook_->getSellOrders().empty());
+
+    auto symbols = matching_engine_->getSymbols();
+    EXPECT_EQ(symbols, (std::vector<std::string>{"AAPL", "MSFT"}));
+}
+
+TEST_F(MatchingEngineTest, GoodTillTimeOrdersExpire) {
+    auto clock = std::make_shared<trading::utils::SimulatedClock>(1'000'000'000);
+    matching_engine_->setClock(clock);
+
+    auto expiring = std::make_shared<Order>("g1", "user-001", "AAPL", OrderType::LIMIT,
+                                            OrderSide::BUY, 1.0, 10.0);
+    auto filled = std::make_shared<Order>("g2", "user-001", "AAPL", OrderType::LIMIT,
+                                          OrderSide::BUY, 1.0, 11.0);
+    orderbook_->addOrder(expiring);
+    orderbook_->addOrder(filled);
+    matching_engine_->scheduleExpiry(expiring, 1'500'000'000);
+    matching_engine_->scheduleExpiry(filled, 1'500'000'000);
+
+    // g2 leaves the book before its deadline and must not be touched by the expiry
+    auto sell = std::make_shared<Order>("g3", "user-002", "AAPL", OrderType::LIMIT,
+                                        OrderSide::SELL, 1.0, 11.0);
+    orderbook_->addOrder(sell);
+    EXPECT_EQ(matching_engine_->matchOrder(sell, *orderbook_).size(), 1u);
+
+    clock->setNanos(1'499'000'000);
+    EXPECT_TRUE(matching_engine_->expireOrders().empty());
+    EXPECT_EQ(orderbook_->getBuyOrders().size(), 1u);
+
+    clock->setNanos(1'500'000'000);
+    auto expired = matching_engine_->expireOrders();
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0], expiring);
+    EXPECT_EQ(expiring->getStatus(), OrderStatus::EXPIRED);
+    EXPECT_NE(filled->getStatus(), OrderStatus::EXPIRED);
+    EXPECT_TRUE(orderbook_->getBuyOrders().empty());
+    EXPECT_EQ(matching_engine_->getPendingExpiryCount(), 0u);
+}
@@ -0,0 +1,182 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/core/order_state_store.hpp"
+
+using namespace trading::core;
+using namespace std::chrono_literals;
+
+namespace {
+constexpr int64_t kSecond = 1'000'000'000;
+
+Order makeLimit(const std::string& id, const std::string& user, double quantity = 10.0) {
+    return Order(id, user, "AAPL", OrderType::LIMIT, OrderSide::BUY, quantity, 100.0);
+}
+
+OrderStateStore::Config smallStore(size_t capacity, std::chrono::seconds ttl = 4s) {
+    OrderStateStore::Config config;
+    config.capacity = capacity;
+    config.terminal_ttl = ttl;
+    return config;
+}
+}  // namespace
+
+TEST(OrderStateStoreTest, TracksFillsAndStatus) {
+    OrderStateStore store;
+    ASSERT_TRUE(store.recordNew(makeLimit("o1", "alice"), 1));
+
+    auto state = store.find("alice", "o1");
+    ASSERT_TRUE(state.has_value());
+    EXPECT_EQ(state->status, OrderStatus::PENDING);
+    EXPECT_EQ(state->getUserId(), "alice");
+    EXPECT_DOUBLE_EQ(state->remaining_quantity, 10.0);
+
+    EXPECT_TRUE(store.recordFill("alice", "o1", 4.0, 100.0, 2));
+    EXPECT_TRUE(store.recordFill("alice", "o1", 6.0, 101.0, 3));
+    state = store.find("alice", "o1");
+    EXPECT_EQ(state->status, OrderStatus::FILLED);
+    EXPECT_DOUBLE_EQ(state->filled_quantity, 10.0);
+    EXPECT_DOUBLE_EQ(state->remaining_quantity, 0.0);
+    EXPECT_DOUBLE_EQ(state->average_fill_price, 100.6);
+    EXPECT_EQ(state->updated_ns, 3);
+
+    EXPECT_FALSE(store.find("alice", "missing").has_value());
+    EXPECT_FALSE(store.recordFill("alice", "missing", 1.0, 1.0, 4));
+}
+
+TEST(OrderStateStoreTest, FindByUserAndAmend) {
+    OrderStateStore store;
+    store.recordNew(makeLimit("a1", "alice"), 1);
+    store.recordNew(makeLimit("a2", "alice"), 1);
+    store.recordNew(makeLimit("b1", "bob"), 1);
+
+    EXPECT_EQ(store.findByUser("alice").size(), 2u);
+    EXPECT_EQ(store.findByUser("bob").size(), 1u);
+    EXPECT_TRUE(store.findByUser("carol").empty());
+
+    store.recordFill("alice", "a1", 2.0, 100.0, 2);
+    EXPECT_TRUE(store.recordAmend("alice", "a1", 5.0, 99.5, 3));
+    auto state = store.find("alice", "a1");
+    EXPECT_DOUBLE_EQ(state->quantity, 7.0);
+    EXPECT_DOUBLE_EQ(state->remaining_quantity, 5.0);
+    EXPECT_DOUBLE_EQ(state->price, 99.5);
+
+    store.recordStatus("alice", "a1", OrderStatus::CANCELLED, 5.0, 4);
+    EXPECT_FALSE(store.recordAmend("alice", "a1", 1.0, 99.0, 5));
+}
+
+TEST(OrderStateStoreTest, ClientIdsAreScopedToTheirUser) {
+    OrderStateStore store;
+    ASSERT_TRUE(store.recordNew(makeLimit("o1", "alice", 10.0), 1));
+    ASSERT_TRUE(store.recordNew(makeLimit("o1", "bob", 20.0), 1));
+    EXPECT_EQ(store.size(), 2u);
+
+    EXPECT_TRUE(store.recordFill("bob", "o1", 5.0, 100.0, 2));
+    EXPECT_DOUBLE_EQ(store.find("alice", "o1")->filled_quantity, 0.0);
+    EXPECT_DOUBLE_EQ(store.find("bob", "o1")->filled_quantity, 5.0);
+
+    EXPECT_TRUE(store.recordStatus("alice", "o1", OrderStatus::CANCELLED, 0.0, 3));
+    EXPECT_EQ(store.find("alice", "o1")->status, OrderStatus::CANCELLED);
+    EXPECT_EQ(store.find("bob", "o1")->status, OrderStatus::PARTIALLY_FILLED);
+    EXPECT_FALSE(store.find("carol", "o1").has_value());
+}
+
+TEST(OrderStateStoreTest, EvictsTerminalOrdersAfterTtlOnly) {
+    OrderStateStore store(smallStore(64, 4s));  // One generation per second
+    store.evictExpired(0);
+
+    for (int i = 0; i < 40; ++i) {
+        store.recordNew(makeLimit("o" + std::to_string(i), "alice"), 0);
+    }
+    // Terminate every other order; the rest stay live
+    for (int i = 0; i < 40; i += 2) {
+        store.recordStatus("alice", "o" + std::to_string(i), OrderStatus::CANCELLED, 0.0, 0);
+    }
+
+    EXPECT_EQ(store.evictExpired(3 * kSecond), 0u);
+    EXPECT_EQ(store.size(), 40u);
+
+    EXPECT_EQ(store.evictExpired(5 * kSecond), 20u);
+    EXPECT_EQ(store.size(), 20u);
+
+    // Backward-shift deletion must leave every survivor reachable
+    for (int i = 0; i < 40; ++i) {
+        EXPECT_EQ(store.find("alice", "o" + std::to_string(i)).has_value(), i % 2 == 1) << i;
+    }
+}
+
+TEST(OrderStateStoreTest, UserChainsSurviveEviction) {
+    OrderStateStore store(smallStore(64, 4s));
+    store.evictExpired(0);
+
+    const std::string users[] = {"alice", "bob", "carol"};
+    for (int i = 0; i < 45; ++i) {
+        store.recordNew(makeLimit("o" + std::to_string(i), users[i % 3]), 0);
+    }
+    // All of carol's orders and every other order of alice's and bob's go terminal
+    for (int i = 0; i < 45; ++i) {
+        if (i % 3 == 2 || i % 2 == 0) {
+            store.recordStatus(users[i % 3], "o" + std::to_string(i), OrderStatus::FILLED, 0.0, 0);
+        }
+    }
+    store.evictExpired(5 * kSecond);
+
+    for (const std::string& user : users) {
+        size_t expected = 0;
+        for (int i = 0; i < 45; ++i) {
+            expected += users[i % 3] == user && i % 3 != 2 && i % 2 == 1;
+        }
+        auto states = store.findByUser(user);
+        EXPECT_EQ(states.size(), expected) << user;
+        for (const auto& state : states) {
+            EXPECT_EQ(state.getUserId(), user);
+            EXPECT_NE(state.status, OrderStatus::FILLED);
+        }
+    }
+
+    // Users whose chains emptied can start new ones
+    store.recordNew(makeLimit("again", "carol"), 6 * kSecond);
+    ASSERT_EQ(store.findByUser("carol").size(), 1u);
+    EXPECT_EQ(store.findByUser("carol")[0].getId(), "again");
+}
+
+TEST(OrderStateStoreTest, FullTableRetiresTerminalOrdersEarly) {
+    OrderStateStore store(smallStore(16, 3600s));  // Holds 12 before it is full
+
+    for (int i = 0; i < 12; ++i) {
+        const std::string id = "o" + std::to_string(i);
+        ASSERT_TRUE(store.recordNew(makeLimit(id, "alice"), 0));
+        store.recordStatus("alice", id, OrderStatus::FILLED, 0.0, 0);
+    }
+
+    // Terminal records age a generation per forced eviction until there is room
+    EXPECT_TRUE(store.recordNew(makeLimit("fresh", "alice"), 0));
+    EXPECT_TRUE(store.find("alice", "fresh").has_value());
+    EXPECT_LE(store.size(), 12u);
+}
+
+TEST(OrderStateStoreTest, ReadersSeeConsistentRecordsDuringWrites) {
+    OrderStateStore store;
+    store.recordNew(makeLimit("hot", "alice", 1e9), 0);
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 1; i <= 20000; ++i) {
+            store.recordFill("alice", "hot", 1.0, 100.0, i);
+        }
+        done = true;
+    });
+
+    // filled + remaining is invariant within any consistent snapshot
+    while (!done) {
+        auto state = store.find("alice", "hot");
+        ASSERT_TRUE(state.has_value());
+        EXPECT_DOUBLE_EQ(state->filled_quantity + state->remaining_quantity, 1e9);
+    }
+    writer.join();
+    EXPECT_DOUBLE_EQ(store.find("alice", "hot")->filled_quantity, 20000.0);
+}
@@ -1,6 +1,8 @@
 #include "trading/core/order.hpp"
 #include "trading/validation/order_validator.hpp"
 #include <memory>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 using namespace trading::core;
@@ -98,4 +100,67 @@ TEST_F(OrderValidatorTest, MarketClosed) {
     EXPECT_EQ(result.error, ValidationError::MARKET_CLOSED);
 }
 
+// Test decoded requests go through the same checks as orders
+TEST_F(OrderValidatorTest, ValidatesOrderRequest) {
+    OrderRequest request;
+    OrderRequest::setField(request.id, "ord-008");
+    OrderRequest::setField(request.user_id, "user-001");
+    OrderRequest::setField(request.symbol, "AAPL");
+    request.quantity = 100.0;
+    request.price = 150.0;
+    EXPECT_TRUE(validator.validate(request).is_valid);
+
+    request.price = 6000.0;
+    EXPECT_EQ(validator.validate(request).error, ValidationError::INVALID_PRICE);
+
+    OrderRequest::setField(request.symbol, "MSFT");
+    EXPECT_EQ(validator.validate(request).error, ValidationError::INVALID_SYMBOL);
+}
+
+// Test amends are checked against the order they would leave resting
+TEST_F(OrderValidatorTest, ValidatesAmendAgainstRestingOrder) {
+    OrderRequest amend;
+    amend.action = OrderRequest::Action::AMEND;
+    amend.has_price = true;
+    amend.price = 200.0;
+    EXPECT_TRUE(validator.validateAmend(*valid_limit_order, amend).is_valid);
+
+    // Out of band on either field, including one the amend leaves unchanged
+    amend.price = 6000.0;
+    EXPECT_EQ(validator.validateAmend(*valid_limit_order, amend).error,
+              ValidationError::INVALID_PRICE);
+    amend.has_price = false;
+    amend.has_quantity = true;
+    amend.quantity = 5000.0;
+    EXPECT_EQ(validator.validateAmend(*valid_limit_order, amend).error,
+              ValidationError::INVALID_QUANTITY);
+    valid_limit_order->setPrice(6000.0);
+    amend.quantity = 10.0;
+    EXPECT_EQ(validator.validateAmend(*valid_limit_order, amend).error,
+              ValidationError::INVALID_PRICE);
+
+    valid_limit_order->setPrice(150.0);
+    validator.setMarketOpen(false);
+    EXPECT_EQ(validator.validateAmend(*valid_limit_order, amend).error,
+              ValidationError::MARKET_CLOSED);
+}
+
+// Test a new set of limits replaces the old one as a whole
+TEST_F(OrderValidatorTest, SetLimitsReplacesAllLimits) {
+    OrderValidator::Limits limits = validator.getLimits();
+    EXPECT_EQ(limits.valid_symbols, (std::vector<std::string>{"AAPL", "GOOGL"}));
+    EXPECT_DOUBLE_EQ(limits.max_price, 5000.0);
+
+    limits.valid_symbols = {"MSFT"};
+    limits.max_quantity = 50.0;
+    validator.setLimits(limits);
+    EXPECT_EQ(validator.validate(valid_limit_order).error, ValidationError::INVALID_SYMBOL);
+
+    auto msft_order = std::make_shared<Order>("ord-009", "user-001", "MSFT", OrderType::LIMIT,
+                                              OrderSide::BUY, 100.0, 150.0);
+    EXPECT_EQ(validator.validate(msft_order).error, ValidationError::INVALID_QUANTITY);
+    msft_order->setQuantity(50.0);
+    EXPECT_TRUE(validator.validate(msft_order).is_valid);
+}
+
 }  // namespace trading::validation
\ No newline at end of file
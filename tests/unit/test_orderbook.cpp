@@ -1,5 +1,6 @@
 #include "trading/core/order.hpp"
 #include "trading/core/orderbook.hpp"
+#include <cstdint>
 #include <memory>
 #include <gtest/gtest.h>
 #include "../../apps/json.hpp"
@@ -120,6 +121,29 @@ TEST_F(OrderBookTest, GetOrdersReturnsCorrectlySorted) {
     EXPECT_EQ(sell_orders[1]->getPrice(), 151.0);
 }
 
+TEST_F(OrderBookTest, DepthAggregatesLevelsBestFirst) {
+    auto add = [this](const char* id, OrderSide side, double quantity, double price) {
+        orderbook_->addOrder(
+            std::make_shared<Order>(id, "user1", "AAPL", OrderType::LIMIT, side, quantity, price));
+    };
+    add("1", OrderSide::BUY, 100, 150.0);
+    add("2", OrderSide::BUY, 50, 150.0);
+    add("3", OrderSide::BUY, 30, 151.0);
+    add("4", OrderSide::SELL, 20, 152.0);
+
+    auto bids = orderbook_->getDepth(OrderSide::BUY, 10);
+    ASSERT_EQ(bids.size(), 2);
+    EXPECT_EQ(bids[0].price, 151.0);
+    EXPECT_EQ(bids[0].quantity, 30.0);
+    EXPECT_EQ(bids[1].price, 150.0);
+    EXPECT_EQ(bids[1].quantity, 150.0);
+
+    EXPECT_EQ(orderbook_->getDepth(OrderSide::BUY, 1).size(), 1);
+    auto asks = orderbook_->getDepth(OrderSide::SELL, 10);
+    ASSERT_EQ(asks.size(), 1);
+    EXPECT_EQ(asks[0].price, 152.0);
+}
+
 TEST_F(OrderBookTest, ToJSONSerialization) {
     auto buy_order1 =
         std::make_shared<Order>("1", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 100, 150.0);
@@ -156,4 +180,158 @@ TEST_F(OrderBookTest, ToJSONSerialization) {
     EXPECT_EQ(asks[0]["quantity"], 75);
     EXPECT_EQ(asks[1]["price"], 151.0);
     EXPECT_EQ(asks[1]["quantity"], 100);
-}
\ No newline at end of file
+}
+TEST(OrderLayoutTest, ColdMetadataResolvesByHandle) {
+    Order order("cold-1", "user-cold", "AAPL", OrderType::LIMIT, OrderSide::BUY, 10, 99.5);
+
+    EXPECT_LE(sizeof(Order), 64u);
+    EXPECT_EQ(order.getId(), "cold-1");
+    EXPECT_EQ(order.getUserId(), "user-cold");
+    EXPECT_EQ(order.getSymbol(), "AAPL");
+    EXPECT_GT(order.getCreatedNanos(), 0);
+
+    const auto metadata = orderMetadata(order.getHandle());
+    EXPECT_EQ(metadata.getClientOrderId(), "cold-1");
+    EXPECT_EQ(metadata.user, order.getUserKey());
+    EXPECT_EQ(metadata.symbol, order.getSymbolKey());
+
+    // Copies share the handle and therefore the metadata
+    Order copy = order;
+    EXPECT_EQ(copy.getId(), "cold-1");
+}
+
+TEST(OrderLayoutTest, PooledOrdersArePackedInCacheLines) {
+    auto first = makeOrder("pool-1", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 1, 1.0);
+    auto second = makeOrder("pool-2", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 1, 1.0);
+
+    auto first_addr = reinterpret_cast<std::uintptr_t>(first.get());
+    auto second_addr = reinterpret_cast<std::uintptr_t>(second.get());
+    EXPECT_EQ(second.get()->getId(), "pool-2");
+
+    // Each node (control block + order) is a whole number of cache lines
+    auto distance = second_addr > first_addr ? second_addr - first_addr : first_addr - second_addr;
+    EXPECT_EQ(distance % 64, 0u);
+
+    OrderBook book("AAPL");
+    EXPECT_TRUE(book.addOrder(first));
+    EXPECT_EQ(book.getBestBid(), 1.0);
+}
+
+TEST_F(OrderBookTest, RemoveAndFindOrderById) {
+    auto first =
+        std::make_shared<Order>("r1", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 10, 100.0);
+    auto second =
+        std::make_shared<Order>("r2", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 10, 100.0);
+    ASSERT_TRUE(orderbook_->addOrder(first));
+    ASSERT_TRUE(orderbook_->addOrder(second));
+
+    // Duplicate live client ids are rejected
+    EXPECT_FALSE(orderbook_->addOrder(
+        std::make_shared<Order>("r1", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 1, 1.0)));
+
+    EXPECT_EQ(orderbook_->findOrder(internUser("user1"), "r2"), second);
+    EXPECT_TRUE(orderbook_->removeOrder(internUser("user1"), "r1"));
+    EXPECT_FALSE(orderbook_->removeOrder(internUser("user1"), "r1"));
+    EXPECT_EQ(orderbook_->findOrder(internUser("user1"), "r1"), nullptr);
+    ASSERT_EQ(orderbook_->getBuyOrders().size(), 1u);
+
+    // Removing the last order at a level removes the level
+    EXPECT_TRUE(orderbook_->removeOrder(internUser("user1"), "r2"));
+    EXPECT_EQ(orderbook_->getBestBid(), 0.0);
+}
+
+TEST_F(OrderBookTest, ClientIdsAreScopedToTheirUser) {
+    auto mine =
+        std::make_shared<Order>("same", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 8, 99.0);
+    auto theirs =
+        std::make_shared<Order>("same", "user2", "AAPL", OrderType::LIMIT, OrderSide::BUY, 5, 99.0);
+    ASSERT_TRUE(orderbook_->addOrder(mine));
+    ASSERT_TRUE(orderbook_->addOrder(theirs));
+
+    EXPECT_EQ(orderbook_->findOrder(internUser("user1"), "same"), mine);
+    EXPECT_EQ(orderbook_->findOrder(internUser("user2"), "same"), theirs);
+
+    // Neither user can amend or remove the other's order
+    EXPECT_EQ(orderbook_->amendOrder(internUser("user1"), "same", 1, 99.0),
+              AmendStatus::AMENDED_IN_PLACE);
+    EXPECT_EQ(theirs->getQuantity(), 5);
+    EXPECT_TRUE(orderbook_->removeOrder(internUser("user2"), "same"));
+    EXPECT_EQ(orderbook_->findOrder(internUser("user1"), "same"), mine);
+    EXPECT_EQ(orderbook_->findOrder(internUser("user2"), "same"), nullptr);
+}
+
+TEST_F(OrderBookTest, AmendQuantityDownKeepsPriority) {
+    auto first =
+        std::make_shared<Order>("a1", "user1", "AAPL", OrderType::LIMIT, OrderSide::SELL, 10, 50.0);
+    auto second =
+        std::make_shared<Order>("a2", "user2", "AAPL", OrderType::LIMIT, OrderSide::SELL, 10, 50.0);
+    orderbook_->addOrder(first);
+    orderbook_->addOrder(second);
+
+    EXPECT_EQ(orderbook_->amendOrder(internUser("user1"), "a1", 4, 50.0),
+              AmendStatus::AMENDED_IN_PLACE);
+    auto asks = orderbook_->getSellOrders();
+    ASSERT_EQ(asks.size(), 2u);
+    EXPECT_EQ(asks[0], first);
+    EXPECT_EQ(first->getQuantity(), 4);
+}
+
+TEST_F(OrderBookTest, AmendPriceOrSizeUpRequeues) {
+    auto first =
+        std::make_shared<Order>("q1", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 10, 50.0);
+    auto second =
+        std::make_shared<Order>("q2", "user2", "AAPL", OrderType::LIMIT, OrderSide::BUY, 10, 50.0);
+    orderbook_->addOrder(first);
+    orderbook_->addOrder(second);
+
+    // Size increase goes to the back of the same level
+    EXPECT_EQ(orderbook_->amendOrder(internUser("user1"), "q1", 20, 50.0), AmendStatus::REQUEUED);
+    EXPECT_EQ(orderbook_->getBuyOrders()[0], second);
+
+    // Price change moves the order to its new level and drops the empty one
+    EXPECT_EQ(orderbook_->amendOrder(internUser("user2"), "q2", 10, 51.0), AmendStatus::REQUEUED);
+    EXPECT_EQ(orderbook_->getBestBid(), 51.0);
+    EXPECT_EQ(orderbook_->amendOrder(internUser("user1"), "q1", 20, 51.0), AmendStatus::REQUEUED);
+    EXPECT_EQ(orderbook_->getBuyOrders().size(), 2u);
+    EXPECT_EQ(orderbook_->getBuyOrdersMap().size(), 1u);
+
+    EXPECT_EQ(orderbook_->amendOrder(internUser("user1"), "missing", 1, 1.0),
+              AmendStatus::NOT_FOUND);
+    EXPECT_EQ(orderbook_->amendOrder(internUser("user1"), "q1", 0, 51.0), AmendStatus::INVALID);
+}
+
+TEST_F(OrderBookTest, CancelUserOrdersWalksOnlyThatUser) {
+    for (int i = 0; i < 5; ++i) {
+        orderbook_->addOrder(std::make_shared<Order>("u1-" + std::to_string(i), "user1", "AAPL",
+                                                     OrderType::LIMIT, OrderSide::BUY, 10,
+                                                     100.0 + i));
+        orderbook_->addOrder(std::make_shared<Order>("u2-" + std::to_string(i), "user2", "AAPL",
+                                                     OrderType::LIMIT, OrderSide::SELL, 10,
+                                                     110.0 + i));
+    }
+
+    // Removal from the middle of a user's list keeps the list intact
+    EXPECT_TRUE(orderbook_->removeOrder(internUser("user1"), "u1-2"));
+    EXPECT_EQ(orderbook_->getUserOrders(internUser("user1")).size(), 4u);
+
+    auto cancelled = orderbook_->cancelUserOrders(internUser("user1"));
+    ASSERT_EQ(cancelled.size(), 4u);
+    for (const auto& order : cancelled) {
+        EXPECT_EQ(order->getUserId(), "user1");
+        EXPECT_EQ(order->getStatus(), OrderStatus::CANCELLED);
+    }
+
+    EXPECT_TRUE(orderbook_->getBuyOrders().empty());
+    EXPECT_EQ(orderbook_->getSellOrders().size(), 5u);
+    EXPECT_EQ(orderbook_->findOrder(internUser("user1"), "u1-0"), nullptr);
+    EXPECT_TRUE(orderbook_->getUserOrders(internUser("user1")).empty());
+    EXPECT_TRUE(orderbook_->cancelUserOrders(internUser("user1")).empty());
+
+    // Cancelled ids can be reused
+    EXPECT_TRUE(orderbook_->addOrder(
+        std::make_shared<Order>("u1-0", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 1, 1.0)));
+
+    EXPECT_EQ(orderbook_->cancelAllOrders().size(), 6u);
+    EXPECT_TRUE(orderbook_->getSellOrders().empty());
+    EXPECT_TRUE(orderbook_->getUserOrders(internUser("user2")).empty());
+}
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <vector>
@@ -5,7 +6,9 @@
 #include <gtest/gtest.h>
 
 #include "trading/logging/app_logger.hpp"
+#include "trading/messaging/inprocess_transport.hpp"
 #include "trading/messaging/queue_client.hpp"
+#include "trading/messaging/shm_transport.hpp"
 
 using namespace trading::messaging;
 using namespace trading::logging;
@@ -209,4 +212,84 @@ TEST_F(QueueClientTest, ConcurrentMessageProcessing) {
 
     // Check that the handler was called for each message
     EXPECT_EQ(counter.count, 10);
-}
\ No newline at end of file
+}
+// Test round trip through the in-process transport
+TEST(QueueClientTransportTest, InProcessRoundTrip) {
+    auto logger = std::make_shared<MockAppLogger>();
+    QueueClient consumer(std::make_unique<InProcessTransport>("queue_client_test"), logger);
+    QueueClient producer(std::make_unique<InProcessTransport>("queue_client_test"), logger);
+    consumer.setTimeout(10);
+    producer.setTimeout(10);
+    ASSERT_TRUE(consumer.connect());
+    ASSERT_TRUE(producer.connect());
+
+    std::atomic<int> received{0};
+    std::string last_value;
+    ASSERT_TRUE(consumer.subscribe("orders", [&](const Message& msg) {
+        last_value = msg.value;
+        received++;
+    }));
+
+    EXPECT_TRUE(producer.publish("orders", "key", "payload"));
+    EXPECT_TRUE(producer.publish("ignored", "key", "dropped"));
+
+    for (int i = 0; i < 200 && received == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(received, 1);
+    EXPECT_EQ(last_value, "payload");
+
+    EXPECT_TRUE(consumer.unsubscribe("orders"));
+    producer.disconnect();
+    consumer.disconnect();
+}
+
+// Test round trip through the shared-memory ring, with publishers on other threads
+TEST(QueueClientTransportTest, SharedMemoryRoundTrip) {
+    const std::string name = "/trading_queue_client_test";
+    SharedMemoryTransport::removeSegment(name);
+
+    auto logger = std::make_shared<MockAppLogger>();
+    QueueClient consumer(std::make_unique<SharedMemoryTransport>(name, 64, 256), logger);
+    consumer.setTimeout(10);
+    ASSERT_TRUE(consumer.connect());
+
+    std::atomic<int> received{0};
+    ASSERT_TRUE(consumer.subscribe("trades", [&](const Message&) { received++; }));
+
+    // More messages than slots, so producers wrap the ring while the consumer drains it
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 100;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&name, &logger]() {
+            QueueClient producer(std::make_unique<SharedMemoryTransport>(name), logger);
+            producer.setTimeout(10);
+            ASSERT_TRUE(producer.connect());
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!producer.publish("trades", "", "trade " + std::to_string(i))) {
+                    std::this_thread::yield();
+                }
+            }
+            producer.disconnect();
+        });
+    }
+    for (auto& thread : producers) {
+        thread.join();
+    }
+
+    for (int i = 0; i < 400 && received < kProducers * kPerProducer; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(received, kProducers * kPerProducer);
+
+    // A message larger than a slot is rejected rather than truncated
+    QueueClient producer(std::make_unique<SharedMemoryTransport>(name), logger);
+    producer.setTimeout(10);
+    ASSERT_TRUE(producer.connect());
+    EXPECT_FALSE(producer.publish("trades", "", std::string(1024, 'x')));
+
+    producer.disconnect();
+    consumer.disconnect();
+    SharedMemoryTransport::removeSegment(name);
+}
@@ -0,0 +1,160 @@
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/validation/rate_limiter.hpp"
+
+using namespace trading::validation;
+
+namespace {
+constexpr int64_t kSecond = 1'000'000'000;
+constexpr int64_t kStart = 1'000 * kSecond;
+
+RateLimiter::Config tieredConfig() {
+    RateLimiter::Config config;
+    config.tiers = {{"standard", RateLimiter::Tier(10.0, 5.0)},
+                    {"market_maker", RateLimiter::Tier(1000.0, 100.0)},
+                    {"unlimited", RateLimiter::Tier(0.0, 0.0)}};
+    config.user_tiers = {{"mm", "market_maker"}, {"ops", "unlimited"}};
+    return config;
+}
+}  // namespace
+
+TEST(RateLimiterTest, AllowsBurstThenRefillsAtRate) {
+    RateLimiter limiter(tieredConfig());
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(limiter.tryAcquire("alice", kStart).allowed) << i;
+    }
+    auto refused = limiter.tryAcquire("alice", kStart);
+    EXPECT_FALSE(refused.allowed);
+    EXPECT_EQ(refused.retry_after_ns, kSecond / 10);
+
+    // 10/s earns one token every 100 ms
+    EXPECT_FALSE(limiter.tryAcquire("alice", kStart + kSecond / 10 - 1).allowed);
+    EXPECT_TRUE(limiter.tryAcquire("alice", kStart + kSecond / 10).allowed);
+    EXPECT_FALSE(limiter.tryAcquire("alice", kStart + kSecond / 10).allowed);
+
+    // A long idle period refills to the burst and no further
+    EXPECT_DOUBLE_EQ(limiter.availableTokens("alice", kStart + 60 * kSecond), 5.0);
+
+    auto metrics = limiter.getMetrics();
+    EXPECT_EQ(metrics.allowed, 6u);
+    EXPECT_EQ(metrics.limited, 3u);
+    EXPECT_EQ(metrics.tracked_users, 1u);
+}
+
+TEST(RateLimiterTest, UsersHaveIndependentBucketsAndTiers) {
+    RateLimiter limiter(tieredConfig());
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire("alice", kStart).allowed);
+    }
+    EXPECT_FALSE(limiter.tryAcquire("alice", kStart).allowed);
+    EXPECT_TRUE(limiter.tryAcquire("bob", kStart).allowed);
+
+    EXPECT_DOUBLE_EQ(limiter.availableTokens("mm", kStart), 100.0);
+    EXPECT_TRUE(limiter.tryAcquire("mm", kStart, 100).allowed);
+    EXPECT_FALSE(limiter.tryAcquire("mm", kStart).allowed);
+
+    for (int i = 0; i < 10'000; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire("ops", kStart).allowed);
+    }
+}
+
+TEST(RateLimiterTest, CostIsAllOrNothing) {
+    RateLimiter limiter(tieredConfig());
+
+    EXPECT_TRUE(limiter.tryAcquire("alice", kStart, 3).allowed);
+    auto refused = limiter.tryAcquire("alice", kStart, 3);
+    EXPECT_FALSE(refused.allowed);
+    EXPECT_EQ(refused.retry_after_ns, kSecond / 10);
+    EXPECT_DOUBLE_EQ(limiter.availableTokens("alice", kStart), 2.0);
+    EXPECT_TRUE(limiter.tryAcquire("alice", kStart, 2).allowed);
+}
+
+TEST(RateLimiterTest, RejectsUnknownTiers) {
+    RateLimiter::Config config = tieredConfig();
+    config.user_tiers["carol"] = "gold";
+    EXPECT_THROW(RateLimiter{config}, std::invalid_argument);
+
+    config = tieredConfig();
+    config.default_tier = "gold";
+    EXPECT_THROW(RateLimiter{config}, std::invalid_argument);
+}
+
+TEST(RateLimiterTest, ReconfigureRetiersExistingUsers) {
+    RateLimiter limiter(tieredConfig());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire("alice", kStart).allowed);
+    }
+    EXPECT_FALSE(limiter.tryAcquire("alice", kStart).allowed);
+
+    // alice moves to market_maker: once refilled, she gets its burst
+    RateLimiter::Config config = tieredConfig();
+    config.user_tiers["alice"] = "market_maker";
+    limiter.reconfigure(config);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire("alice", kStart + kSecond).allowed) << i;
+    }
+    EXPECT_FALSE(limiter.tryAcquire("alice", kStart + kSecond).allowed);
+    EXPECT_DOUBLE_EQ(limiter.availableTokens("bob", kStart), 5.0);
+
+    // A bad config is refused whole
+    config.default_tier = "gold";
+    EXPECT_THROW(limiter.reconfigure(config), std::invalid_argument);
+    EXPECT_DOUBLE_EQ(limiter.availableTokens("alice", kStart + 2 * kSecond), 100.0);
+}
+
+TEST(RateLimiterTest, UntrackedUsersShareOneBucketWhenTableIsFull) {
+    RateLimiter::Config config = tieredConfig();
+    config.capacity = 16;  // Load factor cap of 12 users
+    RateLimiter limiter(config);
+
+    for (int i = 0; i < 12; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire("user" + std::to_string(i), kStart).allowed);
+    }
+
+    // Fresh ids past the cap cannot each get a full bucket of their own
+    int allowed = 0;
+    for (int i = 0; i < 100; ++i) {
+        allowed += limiter.tryAcquire("late" + std::to_string(i), kStart).allowed;
+    }
+    EXPECT_EQ(allowed, 5);
+    EXPECT_DOUBLE_EQ(limiter.availableTokens("another", kStart), 0.0);
+    EXPECT_TRUE(limiter.tryAcquire("late0", kStart + kSecond / 10).allowed);
+
+    auto metrics = limiter.getMetrics();
+    EXPECT_EQ(metrics.tracked_users, 12u);
+    EXPECT_EQ(metrics.untracked, 101u);
+}
+
+TEST(RateLimiterTest, ConcurrentCallersNeverExceedTheBucket) {
+    RateLimiter::Config config;
+    config.tiers = {{"standard", RateLimiter::Tier(1.0, 1000.0)}};
+    RateLimiter limiter(config);
+
+    // Threads race to create the same users and drain their buckets at a fixed instant
+    std::atomic<int> allowed{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 1000; ++i) {
+                for (const char* user : {"u1", "u2", "u3"}) {
+                    if (limiter.tryAcquire(user, kStart).allowed) {
+                        allowed.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(allowed.load(), 3000);
+    EXPECT_EQ(limiter.getMetrics().tracked_users, 3u);
+}
@@ -0,0 +1,117 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/network/response_compressor.hpp"
+
+#if defined(TRADING_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+using namespace trading::network;
+
+namespace {
+std::string sampleBody() {
+    std::string body = "[";
+    for (int i = 0; i < 500; ++i) {
+        body += "{\"price\":" + std::to_string(100 + i % 7) + ",\"quantity\":" +
+                std::to_string(i) + "},";
+    }
+    body.back() = ']';
+    return body;
+}
+
+#if defined(TRADING_HAVE_ZLIB)
+std::string gunzip(const std::string& compressed) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) {
+        return "";
+    }
+    std::string out(1 << 20, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    const int result = inflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END ? out : "";
+}
+#endif
+}  // namespace
+
+TEST(ResponseCompressorTest, NegotiatesSupportedEncoding) {
+    EXPECT_EQ(negotiateContentEncoding(""), ContentEncoding::IDENTITY);
+    EXPECT_EQ(negotiateContentEncoding("br, deflate"), ContentEncoding::IDENTITY);
+    EXPECT_EQ(negotiateContentEncoding("gzip;q=0"), ContentEncoding::IDENTITY);
+    if (contentEncodingSupported(ContentEncoding::GZIP)) {
+        EXPECT_EQ(negotiateContentEncoding("gzip, deflate, br"), ContentEncoding::GZIP);
+        EXPECT_EQ(negotiateContentEncoding("X-GZIP"), ContentEncoding::GZIP);
+        EXPECT_EQ(negotiateContentEncoding("zstd;q=0.5, gzip"), ContentEncoding::GZIP);
+    }
+    if (contentEncodingSupported(ContentEncoding::ZSTD)) {
+        EXPECT_EQ(negotiateContentEncoding("gzip, zstd"), ContentEncoding::ZSTD);
+        EXPECT_EQ(negotiateContentEncoding("*"), ContentEncoding::ZSTD);
+    } else {
+        EXPECT_EQ(negotiateContentEncoding("zstd"), ContentEncoding::IDENTITY);
+    }
+    EXPECT_STREQ(contentEncodingToken(ContentEncoding::GZIP), "gzip");
+}
+
+#if defined(TRADING_HAVE_ZLIB)
+TEST(ResponseCompressorTest, GzipRoundTripsOnEveryThread) {
+    ResponseCompressor compressor;
+    const std::string body = sampleBody();
+
+    // Each thread reuses its own deflate stream across bodies
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 20; ++i) {
+                std::string compressed;
+                if (!compressor.compress(ContentEncoding::GZIP, body, compressed) ||
+                    compressed.size() >= body.size() || gunzip(compressed) != body) {
+                    ++failures[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(failures, std::vector<int>(4, 0));
+    EXPECT_EQ(compressor.getMetrics().compressed, 80u);
+}
+
+TEST(ResponseCompressorTest, CachesCompressedBodyPerKey) {
+    ResponseCompressor compressor;
+    const std::string body = sampleBody();
+
+    auto first = compressor.compressCached(ContentEncoding::GZIP, "/book \"1\"", body);
+    auto second = compressor.compressCached(ContentEncoding::GZIP, "/book \"1\"", body);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(gunzip(*second), body);
+
+    // A new version is compressed again
+    const std::string changed = body + " ";
+    auto third = compressor.compressCached(ContentEncoding::GZIP, "/book \"2\"", changed);
+    ASSERT_NE(third, nullptr);
+    EXPECT_EQ(gunzip(*third), changed);
+
+    const auto metrics = compressor.getMetrics();
+    EXPECT_EQ(metrics.compressed, 2u);
+    EXPECT_EQ(metrics.cache_hits, 1u);
+    EXPECT_EQ(metrics.bytes_in, 3 * body.size() + 1);
+}
+#endif
+
+TEST(ResponseCompressorTest, UnsupportedEncodingFails) {
+    ResponseCompressor compressor;
+    std::string out;
+    EXPECT_FALSE(compressor.compress(ContentEncoding::IDENTITY, "body", out));
+    EXPECT_EQ(compressor.compressCached(ContentEncoding::IDENTITY, "key", "body"), nullptr);
+}
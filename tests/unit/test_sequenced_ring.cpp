@@ -0,0 +1,197 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/utils/sequenced_ring.hpp"
+
+using namespace trading::utils;
+
+// Test case for basic construction and capacity
+TEST(SequencedRingTest, ConstructionAndCapacity) {
+    SequencedRing<int> ring(100);
+    EXPECT_EQ(ring.capacity(), 128);  // 100 rounded up to 128
+    EXPECT_FALSE(ring.isRunning());
+
+    EXPECT_THROW(SequencedRing<int>(0), std::invalid_argument);
+}
+
+// Every consumer must see every event, in sequence order
+TEST(SequencedRingTest, EveryConsumerSeesEveryEventInOrder) {
+    SequencedRing<int> ring(16);
+    std::vector<int> first_seen;
+    std::vector<int> second_seen;
+
+    ring.addConsumer("first",
+                     [&](const int& value, int64_t, bool) { first_seen.push_back(value); });
+    ring.addConsumer("second",
+                     [&](const int& value, int64_t, bool) { second_seen.push_back(value); });
+    ring.start();
+
+    constexpr int kEvents = 1000;  // Far more than capacity, so the producer must be gated
+    for (int i = 0; i < kEvents; ++i) {
+        EXPECT_EQ(ring.publish(i), i);
+    }
+    ring.stop();
+
+    ASSERT_EQ(first_seen.size(), static_cast<size_t>(kEvents));
+    ASSERT_EQ(second_seen.size(), static_cast<size_t>(kEvents));
+    for (int i = 0; i < kEvents; ++i) {
+        EXPECT_EQ(first_seen[i], i);
+        EXPECT_EQ(second_seen[i], i);
+    }
+
+    auto metrics = ring.getMetrics();
+    EXPECT_EQ(metrics.published, static_cast<uint64_t>(kEvents));
+    ASSERT_EQ(metrics.consumers.size(), 2);
+    EXPECT_EQ(metrics.consumers[0].processed, static_cast<uint64_t>(kEvents));
+    EXPECT_EQ(metrics.consumers[1].processed, static_cast<uint64_t>(kEvents));
+    EXPECT_EQ(metrics.consumers[0].lag, 0);
+}
+
+// A slow consumer must gate the producer rather than lose events
+TEST(SequencedRingTest, SlowConsumerAppliesBackpressure) {
+    SequencedRing<int> ring(4);
+    std::atomic<int> slow_count{0};
+    std::atomic<int> fast_count{0};
+
+    ring.addConsumer("fast", [&](const int&, int64_t, bool) { fast_count++; });
+    ring.addConsumer("slow", [&](const int&, int64_t, bool) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        slow_count++;
+    });
+    ring.start();
+
+    for (int i = 0; i < 32; ++i) {
+        ring.publish(i);
+    }
+    ring.stop();
+
+    EXPECT_EQ(fast_count.load(), 32);
+    EXPECT_EQ(slow_count.load(), 32);
+    EXPECT_GT(ring.getMetrics().producer_stalls, 0);
+}
+
+// Consumers pick up whatever is available as one batch
+TEST(SequencedRingTest, ConsumersProcessInBatches) {
+    SequencedRing<int> ring(64, 8);
+    std::vector<bool> end_flags;
+    ring.addConsumer("batched", [&](const int&, int64_t, bool end_of_batch) {
+        end_flags.push_back(end_of_batch);
+    });
+
+    // Publish before starting so the consumer finds a full backlog
+    for (int i = 0; i < 20; ++i) {
+        ring.publish(i);
+    }
+    ring.start();
+    ring.stop();
+
+    ASSERT_EQ(end_flags.size(), 20);
+    auto metrics = ring.getMetrics();
+    EXPECT_LE(metrics.consumers[0].max_batch, 8);
+    EXPECT_EQ(metrics.consumers[0].batches, 3);  // 8 + 8 + 4
+    EXPECT_TRUE(end_flags.back());
+}
+
+TEST(SequencedRingTest, TryPublishFailsWhenFull) {
+    SequencedRing<int> ring(4);
+    ring.addConsumer("idle", [](const int&, int64_t, bool) {});
+
+    // Consumer not started, so nothing frees slots
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.tryPublish(i));
+    }
+    EXPECT_FALSE(ring.tryPublish(4));
+
+    // A blocking publish on a stopped, full ring is dropped instead of hanging
+    EXPECT_EQ(ring.publish(5), -1);
+    EXPECT_EQ(ring.getMetrics().dropped, 1);
+}
+
+TEST(SequencedRingTest, MultipleProducers) {
+    SequencedRing<int> ring(32);
+    std::atomic<long> sum{0};
+    std::atomic<int> count{0};
+    ring.addConsumer("summer", [&](const int& value, int64_t, bool) {
+        sum += value;
+        count++;
+    });
+    ring.start();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&ring]() {
+            for (int i = 1; i <= 250; ++i) {
+                ring.publish(i);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    ring.stop();
+
+    EXPECT_EQ(count.load(), 1000);
+    EXPECT_EQ(sum.load(), 4L * (250L * 251L / 2));
+}
+
+// A batch occupies consecutive sequences even with other producers running
+TEST(SequencedRingTest, PublishBatchIsContiguous) {
+    SequencedRing<int> ring(64);
+    std::vector<int> seen;
+    ring.addConsumer("collector", [&](const int& value, int64_t, bool) { seen.push_back(value); });
+    ring.start();
+
+    std::thread single([&ring]() {
+        for (int i = 0; i < 200; ++i) {
+            ring.publish(-1);
+        }
+    });
+    const std::vector<int> batch{1, 2, 3, 4, 5, 6, 7, 8};
+    for (int round = 0; round < 20; ++round) {
+        EXPECT_GE(ring.publishBatch(batch.data(), batch.size()), 0);
+    }
+    single.join();
+    ring.stop();
+
+    ASSERT_EQ(seen.size(), 200u + 20u * batch.size());
+    for (size_t i = 0; i < seen.size(); ++i) {
+        if (seen[i] == 1) {
+            ASSERT_LE(i + batch.size(), seen.size());
+            for (size_t j = 0; j < batch.size(); ++j) {
+                EXPECT_EQ(seen[i + j], batch[j]);
+            }
+        }
+    }
+
+    EXPECT_THROW(ring.publishBatch(batch.data(), 0), std::invalid_argument);
+    std::vector<int> oversized(ring.capacity() + 1, 0);
+    EXPECT_THROW(ring.publishBatch(oversized.data(), oversized.size()), std::invalid_argument);
+}
+
+TEST(SequencedRingTest, PublishAfterStopIsRefused) {
+    SequencedRing<int> ring(8);
+    std::atomic<int> consumed{0};
+    ring.addConsumer("count", [&](const int&, int64_t, bool) { ++consumed; });
+    ring.start();
+    EXPECT_EQ(ring.publish(1), 0);
+    ring.stop();
+    EXPECT_EQ(consumed.load(), 1);
+
+    // The ring has room, but nobody would ever consume these
+    const std::vector<int> batch{2, 3};
+    EXPECT_EQ(ring.publish(2), -1);
+    EXPECT_EQ(ring.publishBatch(batch.data(), batch.size()), -1);
+    EXPECT_FALSE(ring.tryPublish(4));
+    EXPECT_EQ(ring.getMetrics().published, 1u);
+    EXPECT_EQ(ring.getMetrics().dropped, 4u);
+}
+
+TEST(SequencedRingTest, AddConsumerWhileRunningThrows) {
+    SequencedRing<int> ring(8);
+    ring.start();
+    EXPECT_THROW(ring.addConsumer("late", [](const int&, int64_t, bool) {}), std::logic_error);
+    ring.stop();
+}
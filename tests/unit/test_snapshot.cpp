@@ -0,0 +1,66 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/utils/snapshot.hpp"
+
+using namespace trading::utils;
+
+namespace {
+struct Band {
+    int low = 0;
+    int high = 0;
+    std::string name;
+};
+}  // namespace
+
+TEST(SnapshotTest, PublishReplacesValue) {
+    Snapshot<Band> band(Band{1, 10, "initial"});
+    const Band& before = band.get();
+    band.publish(Band{2, 20, "reloaded"});
+
+    EXPECT_EQ(band.get().high, 20);
+    EXPECT_EQ(band.get().name, "reloaded");
+    // Earlier values stay readable by whoever still holds them
+    EXPECT_EQ(before.name, "initial");
+}
+
+TEST(SnapshotTest, ConcurrentUpdatesKeepEveryChange) {
+    Snapshot<Band> band;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&band]() {
+            for (int i = 0; i < 250; ++i) {
+                band.update([](Band& value) { ++value.high; });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(band.get().high, 1000);
+}
+
+TEST(SnapshotTest, ReadersNeverSeeHalfPublishedValues) {
+    Snapshot<Band> band(Band{0, 0, "0"});
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    std::thread reader([&]() {
+        while (!done.load(std::memory_order_relaxed)) {
+            const Band& value = band.get();
+            if (value.high != value.low * 2 || value.name != std::to_string(value.low)) {
+                torn.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    for (int i = 1; i <= 2000; ++i) {
+        band.publish(Band{i, i * 2, std::to_string(i)});
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(band.get().low, 2000);
+}
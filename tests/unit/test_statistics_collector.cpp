@@ -29,16 +29,17 @@ class StatisticsCollectorTest : public ::testing::Test {
     // Helper function to create a sample trade
     Trade createTrade(const std::string& symbol, double price, double quantity) {
         Trade trade;
-        trade.trade_id = "trade-" + std::to_string(trade_counter_++);
-        trade.buy_order_id = "buy-" + std::to_string(trade_counter_);
-        trade.sell_order_id = "sell-" + std::to_string(trade_counter_);
-        trade.buy_user_id = "buyer-001";
-        trade.sell_user_id = "seller-001";
-        trade.symbol = symbol;
+        trade.trade_id = trade_counter_++;
+        trade.buy_order = trading::core::registerOrder("buy-" + std::to_string(trade_counter_));
+        trade.sell_order = trading::core::registerOrder("sell-" + std::to_string(trade_counter_));
+        trade.buy_user = trading::core::internUser("buyer-001");
+        trade.sell_user = trading::core::internUser("seller-001");
+        trade.symbol = trading::core::internSymbol(symbol);
         trade.quantity = quantity;
         trade.price = price;
-        trade.timestamp = static_cast<uint64_t>(
-            std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+        trade.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::system_clock::now().time_since_epoch())
+                                 .count();
         return trade;
     }
 
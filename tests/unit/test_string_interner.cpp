@@ -0,0 +1,147 @@
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/core/ids.hpp"
+#include "trading/core/order.hpp"
+#include "trading/utils/string_interner.hpp"
+
+using namespace trading::utils;
+
+TEST(StringInternerTest, InternIsStableAndDeduplicated) {
+    StringInterner interner;
+    uint32_t aapl = interner.intern("AAPL");
+    uint32_t msft = interner.intern("MSFT");
+
+    EXPECT_NE(aapl, 0u);
+    EXPECT_NE(aapl, msft);
+    EXPECT_EQ(interner.intern("AAPL"), aapl);
+    EXPECT_EQ(interner.name(aapl), "AAPL");
+    EXPECT_EQ(interner.name(msft), "MSFT");
+    EXPECT_EQ(interner.size(), 2u);
+}
+
+TEST(StringInternerTest, UnknownIdsRenderEmpty) {
+    StringInterner interner;
+    EXPECT_EQ(interner.name(0), "");
+    EXPECT_EQ(interner.name(42), "");
+    EXPECT_FALSE(interner.find("nope").has_value());
+
+    interner.intern("yes");
+    ASSERT_TRUE(interner.find("yes").has_value());
+}
+
+TEST(StringInternerTest, ConcurrentInternAgreesOnIds) {
+    StringInterner interner;
+    std::vector<std::vector<uint32_t>> ids(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 500; ++i) {
+                ids[t].push_back(interner.intern("user-" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(interner.size(), 500u);
+    for (int t = 1; t < 4; ++t) {
+        EXPECT_EQ(ids[t], ids[0]);
+    }
+}
+
+TEST(StringTableTest, AppendAcrossSegments) {
+    StringTable table;
+    std::set<uint64_t> seen;
+    for (int i = 0; i < 40000; ++i) {  // Crosses several segment boundaries
+        seen.insert(table.append(std::to_string(i)));
+    }
+    EXPECT_EQ(seen.size(), 40000u);
+    EXPECT_EQ(table.get(1), "0");
+    EXPECT_EQ(table.get(40000), "39999");
+    EXPECT_EQ(table.get(40001), "");
+}
+
+TEST(CoreIdsTest, OrderHandlesRenderClientIds) {
+    auto first = trading::core::registerOrder("client-1");
+    auto second = trading::core::registerOrder("client-1");
+
+    // Handles are unique per order even if clients reuse ids
+    EXPECT_NE(first, second);
+    EXPECT_EQ(trading::core::clientOrderId(first), "client-1");
+    EXPECT_EQ(trading::core::clientOrderId(trading::core::kInvalidOrderHandle), "");
+}
+
+TEST(CoreIdsTest, ReleasedOrderSlotsAreReused) {
+    using namespace trading::core;
+    OrderHandle released;
+    {
+        auto order =
+            makeOrder("reused-1", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 1, 1.0);
+        released = order->getHandle();
+    }
+    // Still resolvable while held back from reuse
+    EXPECT_EQ(clientOrderId(released), "reused-1");
+
+    // Churn orders until the slot comes back; the table stops growing once it does
+    const uint64_t slot = released & 0xFFFFFFFFu;
+    std::set<uint64_t> slots;
+    bool reused = false;
+    for (size_t i = 0; i < 4 * kOrderHandleReuseDelay && !reused; ++i) {
+        auto order =
+            makeOrder("churn", "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 1, 1.0);
+        slots.insert(order->getHandle() & 0xFFFFFFFFu);
+        reused = (order->getHandle() & 0xFFFFFFFFu) == slot;
+        if (reused) {
+            EXPECT_NE(order->getHandle(), released);
+            EXPECT_EQ(clientOrderId(order->getHandle()), "churn");
+        }
+    }
+    ASSERT_TRUE(reused);
+    EXPECT_LE(slots.size(), 2 * kOrderHandleReuseDelay);
+    // The stale handle no longer resolves to anything
+    EXPECT_EQ(clientOrderId(released), "");
+}
+
+TEST(CoreIdsTest, StaleHandleReadsNeverSeeAnotherOrder) {
+    using namespace trading::core;
+    const std::string original(OrderMetadata::kMaxClientOrderIdLength, 'x');
+    OrderHandle released;
+    {
+        auto order =
+            makeOrder(original, "user1", "AAPL", OrderType::LIMIT, OrderSide::BUY, 1, 1.0);
+        released = order->getHandle();
+    }
+
+    // A post-trade consumer keeps rendering the stale handle while the slot is rewritten
+    std::atomic<bool> done{false};
+    std::atomic<size_t> wrong{0};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            const std::string id = clientOrderId(released);
+            if (!id.empty() && id != original) {
+                wrong.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    const uint64_t slot = released & 0xFFFFFFFFu;
+    bool reused = false;
+    for (size_t i = 0; i < 4 * kOrderHandleReuseDelay && !reused; ++i) {
+        auto order = makeOrder("c" + std::to_string(i), "user1", "AAPL", OrderType::LIMIT,
+                               OrderSide::BUY, 1, 1.0);
+        reused = (order->getHandle() & 0xFFFFFFFFu) == slot;
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    ASSERT_TRUE(reused);
+    EXPECT_EQ(wrong.load(), 0u);
+    EXPECT_EQ(clientOrderId(released), "");
+    EXPECT_THROW(registerOrder(original + "y"), std::invalid_argument);
+}
@@ -0,0 +1,106 @@
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "trading/utils/task.hpp"
+
+using namespace trading::utils;
+
+namespace {
+// Suspends the awaiting coroutine until the test resumes it by hand
+struct ManualEvent {
+    std::coroutine_handle<> waiter;
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        waiter = handle;
+    }
+    void await_resume() const noexcept {}
+};
+
+Task<int> answer() {
+    co_return 42;
+}
+
+Task<int> addAfter(ManualEvent& event, int value) {
+    co_await event;
+    co_return value + co_await answer();
+}
+
+Task<std::string> failing() {
+    throw std::runtime_error("boom");
+    co_return "";
+}
+
+Task<> countUp(int& counter, int times) {
+    for (int i = 0; i < times; ++i) {
+        counter += co_await answer() - 41;
+    }
+}
+}  // namespace
+
+TEST(TaskTest, IsLazyAndReturnsValue) {
+    bool started = false;
+    auto task = [&]() -> Task<int> {
+        started = true;
+        co_return 7;
+    }();
+    EXPECT_FALSE(started);
+
+    std::optional<int> result;
+    spawn(std::move(task), [&](int value) { result = value; });
+    EXPECT_TRUE(started);
+    EXPECT_EQ(result, 7);
+}
+
+TEST(TaskTest, ResumesAwaiterWhenSuspendedTaskFinishes) {
+    ManualEvent event;
+    std::optional<int> result;
+    spawn(addAfter(event, 1), [&](int value) { result = value; });
+
+    // Parked on the event; the spawn returned at the first suspension
+    ASSERT_TRUE(event.waiter);
+    EXPECT_FALSE(result);
+    event.waiter.resume();
+    EXPECT_EQ(result, 43);
+}
+
+TEST(TaskTest, RethrowsExceptionAtAwait) {
+    std::string caught;
+    spawn(
+        [&]() -> Task<> {
+            try {
+                co_await failing();
+            } catch (const std::runtime_error& e) {
+                caught = e.what();
+            }
+        }(),
+        [] {});
+    EXPECT_EQ(caught, "boom");
+}
+
+TEST(TaskTest, LoopsOverSynchronousTasks) {
+    // Each iteration awaits a task that completes without suspending
+    int counter = 0;
+    bool done = false;
+    spawn(countUp(counter, 10'000), [&] { done = true; });
+    EXPECT_TRUE(done);
+    EXPECT_EQ(counter, 10'000);
+}
+
+TEST(TaskTest, UnstartedTaskReleasesItsFrame) {
+    auto marker = std::make_shared<int>(0);
+    std::weak_ptr<int> watch = marker;
+    {
+        auto task = [](std::shared_ptr<int> held) -> Task<int> { co_return *held; }(
+            std::move(marker));
+        EXPECT_TRUE(task.valid());
+        EXPECT_FALSE(watch.expired());
+    }
+    EXPECT_TRUE(watch.expired());
+}
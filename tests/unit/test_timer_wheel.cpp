@@ -0,0 +1,103 @@
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "trading/utils/timer_wheel.hpp"
+
+using namespace trading::utils;
+using namespace std::chrono_literals;
+
+namespace {
+constexpr int64_t kMs = 1'000'000;
+}  // namespace
+
+TEST(TimerWheelTest, FiresAtDeadlineNotBefore) {
+    TimerWheel wheel(1ms);
+    int fired = 0;
+    wheel.scheduleAt(5 * kMs + 1, [&] { ++fired; });
+
+    EXPECT_EQ(wheel.advance(5 * kMs), 0u);
+    EXPECT_EQ(fired, 0);
+    EXPECT_EQ(wheel.advance(6 * kMs), 1u);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheelTest, CancelPreventsFiringAndRejectsStaleIds) {
+    TimerWheel wheel(1ms);
+    int fired = 0;
+    auto id = wheel.scheduleAfter(10ms, [&] { ++fired; });
+
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.cancel(TimerWheel::kInvalidTimer));
+
+    // The recycled node gets a new generation, so the old id stays dead
+    auto other = wheel.scheduleAfter(10ms, [&] { fired += 10; });
+    EXPECT_NE(other, id);
+    EXPECT_FALSE(wheel.cancel(id));
+
+    wheel.advance(20 * kMs);
+    EXPECT_EQ(fired, 10);
+}
+
+TEST(TimerWheelTest, CascadesLongDeadlinesInOrder) {
+    TimerWheel wheel(1ms);
+    std::vector<int64_t> deadlines;
+    std::mt19937_64 rng(7);
+    // Spread across all four levels, including beyond the top level's range
+    for (int i = 0; i < 2000; ++i) {
+        deadlines.push_back(static_cast<int64_t>(rng() % (int64_t{1} << (8 * (i % 5) + 4))) *
+                            kMs / 4);
+    }
+
+    std::vector<int64_t> fired_late;
+    int64_t now = 0;
+    for (int64_t deadline : deadlines) {
+        wheel.scheduleAt(deadline, [&, deadline] { fired_late.push_back(now - deadline); });
+    }
+
+    // Jump in coarse, irregular steps; every timer must fire at the first advance past it
+    int64_t step = kMs;
+    while (wheel.size() > 0) {
+        const int64_t previous = now;
+        now += step;
+        step = step * 3 + 7;
+        const size_t before = fired_late.size();
+        wheel.advance(now);
+        for (size_t i = before; i < fired_late.size(); ++i) {
+            EXPECT_GE(fired_late[i], 0);
+            EXPECT_LT(fired_late[i], now - previous + kMs);
+        }
+    }
+    EXPECT_EQ(fired_late.size(), deadlines.size());
+}
+
+TEST(TimerWheelTest, CallbacksMayScheduleAndCancel) {
+    TimerWheel wheel(1ms);
+    std::vector<int> order;
+    TimerWheel::TimerId first = TimerWheel::kInvalidTimer;
+    TimerWheel::TimerId second = TimerWheel::kInvalidTimer;
+
+    // Both are due on the same tick; whichever runs first cancels the other
+    first = wheel.scheduleAt(kMs, [&] {
+        order.push_back(1);
+        EXPECT_TRUE(wheel.cancel(second));
+        wheel.scheduleAt(0, [&] { order.push_back(3); });
+    });
+    second = wheel.scheduleAt(kMs, [&] {
+        order.push_back(2);
+        EXPECT_TRUE(wheel.cancel(first));
+        // Already due: runs on the next tick, not re-entrantly
+        wheel.scheduleAt(0, [&] { order.push_back(3); });
+    });
+
+    wheel.advance(kMs);
+    ASSERT_EQ(order.size(), 1u);
+    wheel.advance(2 * kMs);
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order[1], 3);
+    EXPECT_EQ(wheel.size(), 0u);
+}
@@ -0,0 +1,68 @@
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "trading/utils/version_counter.hpp"
+
+using namespace trading::utils;
+using namespace std::chrono_literals;
+
+TEST(VersionCounterTest, BumpAdvancesVersion) {
+    VersionCounter version;
+    const uint64_t initial = version.current();
+    version.bump();
+    version.bump();
+    EXPECT_EQ(version.current(), initial + 2);
+}
+
+TEST(VersionCounterTest, WaitReturnsImmediatelyIfAlreadyChanged) {
+    VersionCounter version;
+    const uint64_t seen = version.current();
+    version.bump();
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(version.waitForChange(seen, 5s), seen + 1);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+}
+
+TEST(VersionCounterTest, WaitTimesOutWithoutChange) {
+    VersionCounter version;
+    const uint64_t seen = version.current();
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(version.waitForChange(seen, 20ms), seen);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+}
+
+TEST(VersionCounterTest, BumpWakesWaiter) {
+    VersionCounter version;
+    const uint64_t seen = version.current();
+
+    std::thread bumper([&]() {
+        std::this_thread::sleep_for(20ms);
+        version.bump();
+    });
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(version.waitForChange(seen, 10s), seen + 1);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+    bumper.join();
+}
+
+TEST(VersionCounterTest, OnChangeCallsBackOnNextBump) {
+    VersionCounter version;
+    const uint64_t seen = version.current();
+
+    int calls = 0;
+    version.onChange(seen, [&]() { ++calls; });
+    version.onChange(seen, [&]() { ++calls; });
+    EXPECT_EQ(calls, 0);
+    version.bump();
+    EXPECT_EQ(calls, 2);
+    version.bump();  // Each callback runs once
+    EXPECT_EQ(calls, 2);
+
+    // A version already past seen calls back at once
+    version.onChange(seen, [&]() { ++calls; });
+    EXPECT_EQ(calls, 3);
+}
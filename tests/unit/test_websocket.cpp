@@ -0,0 +1,302 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "trading/network/websocket.hpp"
+#include "trading/network/websocket_hub.hpp"
+
+using namespace trading::network;
+using websocket::Opcode;
+
+namespace {
+
+std::string hex(const std::array<uint8_t, 20>& digest) {
+    static constexpr char kDigits[] = "0123456789abcdef";
+    std::string result;
+    for (uint8_t byte : digest) {
+        result.push_back(kDigits[byte >> 4]);
+        result.push_back(kDigits[byte & 0xF]);
+    }
+    return result;
+}
+
+// Client frames must be masked
+std::string clientFrame(Opcode opcode, const std::string& payload, bool fin = true) {
+    std::string frame;
+    frame.push_back(static_cast<char>((fin ? 0x80 : 0x00) | static_cast<uint8_t>(opcode)));
+    if (payload.size() < 126) {
+        frame.push_back(static_cast<char>(0x80 | payload.size()));
+    } else {
+        frame.push_back(static_cast<char>(0x80 | 126));
+        frame.push_back(static_cast<char>(payload.size() >> 8));
+        frame.push_back(static_cast<char>(payload.size() & 0xFF));
+    }
+    const char mask[4] = {0x12, 0x34, 0x56, 0x78};
+    frame.append(mask, 4);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        frame.push_back(static_cast<char>(payload[i] ^ mask[i & 3]));
+    }
+    return frame;
+}
+
+// Reads one unmasked server frame; returns false on EOF
+bool readFrame(int fd, Opcode& opcode, std::string& payload) {
+    auto readExactly = [fd](char* out, size_t size) {
+        size_t got = 0;
+        while (got < size) {
+            const ssize_t n = ::recv(fd, out + got, size - got, 0);
+            if (n <= 0) {
+                return false;
+            }
+            got += static_cast<size_t>(n);
+        }
+        return true;
+    };
+
+    unsigned char header[2];
+    if (!readExactly(reinterpret_cast<char*>(header), 2)) {
+        return false;
+    }
+    opcode = static_cast<Opcode>(header[0] & 0x0F);
+    uint64_t length = header[1] & 0x7F;
+    if (length == 126) {
+        unsigned char extended[2];
+        readExactly(reinterpret_cast<char*>(extended), 2);
+        length = (uint64_t(extended[0]) << 8) | extended[1];
+    } else if (length == 127) {
+        unsigned char extended[8];
+        readExactly(reinterpret_cast<char*>(extended), 8);
+        length = 0;
+        for (unsigned char byte : extended) {
+            length = (length << 8) | byte;
+        }
+    }
+    payload.assign(length, '\0');
+    return readExactly(payload.data(), length);
+}
+
+std::string readText(int fd) {
+    Opcode opcode;
+    std::string payload;
+    if (!readFrame(fd, opcode, payload) || opcode != Opcode::TEXT) {
+        return "";
+    }
+    return payload;
+}
+
+void sendAll(int fd, const std::string& data) {
+    ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+}
+
+}  // namespace
+
+TEST(WebSocketCodecTest, Sha1MatchesKnownVectors) {
+    EXPECT_EQ(hex(websocket::sha1("")), "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    EXPECT_EQ(hex(websocket::sha1("abc")), "a9993e364706816aba3e25717850c26c9cd0d89d");
+    // Two-block message
+    EXPECT_EQ(hex(websocket::sha1("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+              "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+}
+
+TEST(WebSocketCodecTest, AcceptKeyMatchesRfcExample) {
+    EXPECT_EQ(websocket::acceptKey("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+
+    const uint8_t bytes[] = {'f', 'o', 'o', 'b'};
+    EXPECT_EQ(websocket::base64Encode(bytes, 4), "Zm9vYg==");
+    EXPECT_EQ(websocket::base64Encode(bytes, 3), "Zm9v");
+}
+
+TEST(WebSocketCodecTest, EncodesLengthForms) {
+    EXPECT_EQ(websocket::encodeFrame(Opcode::TEXT, "hi"), std::string("\x81\x02hi", 4));
+
+    const std::string medium(300, 'x');
+    const std::string frame = websocket::encodeFrame(Opcode::TEXT, medium);
+    ASSERT_EQ(frame.size(), 4 + medium.size());
+    EXPECT_EQ(static_cast<uint8_t>(frame[1]), 126);
+    EXPECT_EQ((static_cast<uint8_t>(frame[2]) << 8) | static_cast<uint8_t>(frame[3]), 300);
+}
+
+TEST(WebSocketCodecTest, ParserReassemblesSplitAndFragmentedMessages) {
+    websocket::FrameParser parser(1024);
+    Opcode opcode;
+    std::string payload;
+
+    // A frame delivered one byte at a time
+    const std::string frame = clientFrame(Opcode::TEXT, "hello");
+    for (size_t i = 0; i + 1 < frame.size(); ++i) {
+        parser.feed(&frame[i], 1);
+        EXPECT_EQ(parser.next(opcode, payload), websocket::FrameParser::Result::NEED_MORE);
+    }
+    parser.feed(&frame.back(), 1);
+    ASSERT_EQ(parser.next(opcode, payload), websocket::FrameParser::Result::MESSAGE);
+    EXPECT_EQ(opcode, Opcode::TEXT);
+    EXPECT_EQ(payload, "hello");
+
+    // A fragmented message with a ping between its fragments
+    const std::string stream = clientFrame(Opcode::TEXT, "hel", false) +
+                               clientFrame(Opcode::PING, "p") +
+                               clientFrame(Opcode::CONTINUATION, "lo");
+    parser.feed(stream.data(), stream.size());
+    ASSERT_EQ(parser.next(opcode, payload), websocket::FrameParser::Result::MESSAGE);
+    EXPECT_EQ(opcode, Opcode::PING);
+    ASSERT_EQ(parser.next(opcode, payload), websocket::FrameParser::Result::MESSAGE);
+    EXPECT_EQ(opcode, Opcode::TEXT);
+    EXPECT_EQ(payload, "hello");
+    EXPECT_EQ(parser.next(opcode, payload), websocket::FrameParser::Result::NEED_MORE);
+}
+
+TEST(WebSocketCodecTest, ParserRejectsUnmaskedAndOversizedFrames) {
+    Opcode opcode;
+    std::string payload;
+
+    websocket::FrameParser unmasked(1024);
+    const std::string server_frame = websocket::encodeFrame(Opcode::TEXT, "hi");
+    unmasked.feed(server_frame.data(), server_frame.size());
+    EXPECT_EQ(unmasked.next(opcode, payload), websocket::FrameParser::Result::ERROR);
+
+    websocket::FrameParser small(16);
+    const std::string large = clientFrame(Opcode::TEXT, std::string(200, 'x'));
+    small.feed(large.data(), large.size());
+    EXPECT_EQ(small.next(opcode, payload), websocket::FrameParser::Result::ERROR);
+}
+
+class WebSocketHubTest : public ::testing::Test {
+  protected:
+    void startHub(const WebSocketHub::Config& config) {
+        hub_ = std::make_unique<WebSocketHub>(config);
+        hub_->setChannelFilter([](const std::string& channel) { return channel != "secret"; });
+        hub_->setSnapshotProvider(
+            [](const std::string& channel, const WebSocketHub::Sender& send) {
+                if (channel == "book.AAPL") {
+                    send(R"({"best_bid":100})");
+                }
+            });
+        ASSERT_TRUE(hub_->start());
+    }
+
+    // Returns the client end of a connection adopted by the hub
+    int connect() {
+        int fds[2];
+        EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        EXPECT_TRUE(hub_->adopt(fds[0]));
+        return fds[1];
+    }
+
+    void subscribe(int client, const std::string& channel) {
+        sendAll(client,
+                clientFrame(Opcode::TEXT, R"({"op":"subscribe","channel":")" + channel + "\"}"));
+        EXPECT_EQ(readText(client), R"({"channel":")" + channel + R"(","type":"subscribed"})");
+    }
+
+    void TearDown() override {
+        if (hub_) {
+            hub_->stop();
+        }
+    }
+
+    std::unique_ptr<WebSocketHub> hub_;
+};
+
+TEST_F(WebSocketHubTest, SubscribersReceiveSnapshotThenUpdates) {
+    startHub(WebSocketHub::Config());
+    const int first = connect();
+    const int second = connect();
+
+    subscribe(first, "book.AAPL");
+    EXPECT_EQ(readText(first),
+              R"({"type":"snapshot","channel":"book.AAPL","data":{"best_bid":100}})");
+    subscribe(second, "trades.AAPL");
+    EXPECT_TRUE(hub_->hasSubscribers("trades.AAPL"));
+    EXPECT_FALSE(hub_->hasSubscribers("trades.MSFT"));
+
+    hub_->publish("trades.AAPL", R"({"price":101})");
+    hub_->publish("book.AAPL", R"({"best_bid":101})");
+    EXPECT_EQ(readText(second),
+              R"({"type":"update","channel":"trades.AAPL","data":{"price":101}})");
+    EXPECT_EQ(readText(first),
+              R"({"type":"update","channel":"book.AAPL","data":{"best_bid":101}})");
+
+    // Filtered channels are refused; pings are answered
+    sendAll(first, clientFrame(Opcode::TEXT, R"({"op":"subscribe","channel":"secret"})"));
+    EXPECT_EQ(readText(first), R"({"message":"Unknown channel: secret","type":"error"})");
+    sendAll(first, clientFrame(Opcode::PING, "ping"));
+    Opcode opcode;
+    std::string payload;
+    ASSERT_TRUE(readFrame(first, opcode, payload));
+    EXPECT_EQ(opcode, Opcode::PONG);
+    EXPECT_EQ(payload, "ping");
+
+    // Closing drops the subscriptions
+    sendAll(second, clientFrame(Opcode::CLOSE, ""));
+    ASSERT_TRUE(readFrame(second, opcode, payload));
+    EXPECT_EQ(opcode, Opcode::CLOSE);
+    EXPECT_FALSE(readFrame(second, opcode, payload));
+    EXPECT_FALSE(hub_->hasSubscribers("trades.AAPL"));
+
+    ::close(first);
+    ::close(second);
+}
+
+TEST_F(WebSocketHubTest, SlowReaderIsConflatedToLatestUpdate) {
+    WebSocketHub::Config config;
+    config.conflate_threshold_bytes = 1024;
+    config.max_backlog_bytes = 64 * 1024 * 1024;
+    startHub(config);
+    const int client = connect();
+    subscribe(client, "depth.AAPL");
+
+    // The client reads nothing while far more than a socket buffer is published
+    constexpr int kUpdates = 50000;
+    const std::string padding(100, 'x');
+    for (int i = 1; i <= kUpdates; ++i) {
+        hub_->publish("depth.AAPL",
+                      "{\"seq\":" + std::to_string(i) + ",\"pad\":\"" + padding + "\"}", "level");
+    }
+    EXPECT_GT(hub_->getMetrics().conflated, 0u);
+
+    // Updates arrive in order and end with the latest one
+    int received = 0;
+    int last_seq = 0;
+    while (last_seq != kUpdates) {
+        const std::string text = readText(client);
+        ASSERT_FALSE(text.empty());
+        const int seq = std::stoi(text.substr(text.find("\"seq\":") + 6));
+        EXPECT_GT(seq, last_seq);
+        last_seq = seq;
+        ++received;
+    }
+    EXPECT_LT(received, kUpdates);
+    ::close(client);
+}
+
+TEST_F(WebSocketHubTest, ReaderPastMaxBacklogIsDropped) {
+    WebSocketHub::Config config;
+    config.max_backlog_bytes = 256 * 1024;
+    startHub(config);
+    const int client = connect();
+    subscribe(client, "trades.AAPL");
+
+    // Trades cannot be conflated, so a reader that stops reading is eventually cut off
+    const std::string payload = "{\"pad\":\"" + std::string(1000, 'x') + "\"}";
+    for (int i = 0; i < 5000 && hub_->getMetrics().slow_disconnects == 0; ++i) {
+        hub_->publish("trades.AAPL", payload);
+    }
+    EXPECT_EQ(hub_->getMetrics().slow_disconnects, 1u);
+
+    Opcode opcode;
+    std::string received;
+    while (readFrame(client, opcode, received)) {
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (hub_->getMetrics().connections > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(hub_->getMetrics().connections, 0u);
+    EXPECT_FALSE(hub_->hasSubscribers("trades.AAPL"));
+    ::close(client);
+}